@@ -0,0 +1,140 @@
+#include "sdk/platform/file_system.h"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace sdk::platform;
+
+namespace {
+
+// 每个基准在自己的临时目录中读写，结束时删除
+class TempDir {
+public:
+    TempDir() {
+        auto stamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        path_ = (std::filesystem::temp_directory_path() / ("sdk_bench_" + std::to_string(stamp))).string();
+        FileSystem::createDirectories(path_);
+    }
+    ~TempDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+
+    std::string file(const std::string& name) const {
+        return FileSystem::joinPath(path_, name);
+    }
+
+private:
+    std::string path_;
+};
+
+std::vector<uint8_t> makeData(int64_t size) {
+    std::vector<uint8_t> data(static_cast<size_t>(size));
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 131);
+    }
+    return data;
+}
+
+} // namespace
+
+static void BM_WriteBinaryFile(benchmark::State& state) {
+    TempDir dir;
+    const std::string path = dir.file("write.bin");
+    const std::vector<uint8_t> data = makeData(state.range(0));
+    for (auto _ : state) {
+        if (!FileSystem::writeBinaryFile(path, data)) {
+            state.SkipWithError("writeBinaryFile failed");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_WriteBinaryFile)->Arg(4 << 10)->Arg(1 << 20)->Arg(16 << 20)->UseRealTime();
+
+// 文件在页缓存中，测得的是读取路径本身的开销
+static void BM_ReadBinaryFile(benchmark::State& state) {
+    TempDir dir;
+    const std::string path = dir.file("read.bin");
+    FileSystem::writeBinaryFile(path, makeData(state.range(0)));
+    for (auto _ : state) {
+        std::vector<uint8_t> data = FileSystem::readBinaryFile(path);
+        benchmark::DoNotOptimize(data.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadBinaryFile)->Arg(4 << 10)->Arg(1 << 20)->Arg(16 << 20)->UseRealTime();
+
+// 映射后顺序扫描一遍，不复制文件内容
+static void BM_MappedFileScan(benchmark::State& state) {
+    TempDir dir;
+    const std::string path = dir.file("mapped.bin");
+    FileSystem::writeBinaryFile(path, makeData(state.range(0)));
+    for (auto _ : state) {
+        MappedFile mapped;
+        if (!mapped.open(path)) {
+            state.SkipWithError("MappedFile::open failed");
+            break;
+        }
+        mapped.advise(MappedFile::Access::SEQUENTIAL);
+        uint64_t sum = 0;
+        for (size_t i = 0; i < mapped.size(); i += 4096) {
+            sum += mapped.data()[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MappedFileScan)->Arg(1 << 20)->Arg(16 << 20)->UseRealTime();
+
+// 用固定大小的缓冲区分块读取整个文件
+static void BM_FileReaderChunked(benchmark::State& state) {
+    TempDir dir;
+    const std::string path = dir.file("chunked.bin");
+    FileSystem::writeBinaryFile(path, makeData(16 << 20));
+    std::vector<uint8_t> buffer(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        FileReader reader;
+        if (!reader.open(path)) {
+            state.SkipWithError("FileReader::open failed");
+            break;
+        }
+        while (reader.read(buffer.data(), buffer.size()) > 0) {
+            benchmark::DoNotOptimize(buffer.data());
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * (16 << 20));
+}
+BENCHMARK(BM_FileReaderChunked)->Arg(64 << 10)->Arg(1 << 20)->UseRealTime();
+
+static void BM_ReadTextFile(benchmark::State& state) {
+    TempDir dir;
+    const std::string path = dir.file("read.txt");
+    FileSystem::writeTextFile(path, std::string(static_cast<size_t>(state.range(0)), 'a'));
+    for (auto _ : state) {
+        std::string text = FileSystem::readTextFile(path);
+        benchmark::DoNotOptimize(text.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ReadTextFile)->Arg(4 << 10)->Arg(1 << 20)->UseRealTime();
+
+static void BM_CopyFile(benchmark::State& state) {
+    TempDir dir;
+    const std::string src = dir.file("src.bin");
+    const std::string dst = dir.file("dst.bin");
+    FileSystem::writeBinaryFile(src, makeData(state.range(0)));
+    for (auto _ : state) {
+        if (!FileSystem::copyFile(src, dst)) {
+            state.SkipWithError("copyFile failed");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CopyFile)->Arg(1 << 20)->Arg(16 << 20)->UseRealTime();
@@ -0,0 +1,74 @@
+#include "sdk/network/http_client.h"
+#include "loopback_server.h"
+
+#include <benchmark/benchmark.h>
+
+#include <future>
+#include <vector>
+
+using namespace sdk;
+
+// 复用连接的同步GET，参数为响应体字节数
+static void BM_HttpGet(benchmark::State& state) {
+    bench::LoopbackServer server(static_cast<size_t>(state.range(0)));
+    HttpClient client;
+    const std::string url = server.url("/get");
+    for (auto _ : state) {
+        HttpResponse response = client.get(url);
+        if (response.getStatusCode() != 200) {
+            state.SkipWithError(response.getError().c_str());
+            break;
+        }
+        benchmark::DoNotOptimize(response.getBody().data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HttpGet)->Arg(64)->Arg(16 << 10)->Arg(1 << 20)->UseRealTime();
+
+// 关闭句柄池与连接共享时每个请求都新建连接
+static void BM_HttpGetNoReuse(benchmark::State& state) {
+    bench::LoopbackServer server(64);
+    HttpClientConfig config;
+    config.max_idle_handles_per_host = 0;
+    config.share_connections = false;
+    HttpClient client(config);
+    const std::string url = server.url("/get");
+    for (auto _ : state) {
+        HttpResponse response = client.get(url);
+        if (response.getStatusCode() != 200) {
+            state.SkipWithError(response.getError().c_str());
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HttpGetNoReuse)->UseRealTime();
+
+// 异步请求的吞吐量，参数为并发上限
+static void BM_HttpAsyncThroughput(benchmark::State& state) {
+    constexpr int kRequestsPerIteration = 256;
+    bench::LoopbackServer server(1024);
+    HttpClientConfig config;
+    config.max_concurrent_requests = static_cast<size_t>(state.range(0));
+    HttpClient client(config);
+    // 各请求的URL不同，避免相同的GET被合并为一次传输
+    std::vector<std::string> urls;
+    for (int i = 0; i < kRequestsPerIteration; ++i) {
+        urls.push_back(server.url("/async/" + std::to_string(i)));
+    }
+
+    std::vector<std::future<HttpResponse>> futures;
+    futures.reserve(kRequestsPerIteration);
+    for (auto _ : state) {
+        futures.clear();
+        for (const auto& url : urls) {
+            futures.push_back(client.getAsync(url));
+        }
+        for (auto& future : futures) {
+            benchmark::DoNotOptimize(future.get().getStatusCode());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kRequestsPerIteration);
+}
+BENCHMARK(BM_HttpAsyncThroughput)->Arg(1)->Arg(16)->Arg(64)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,131 @@
+#include "sdk/logging/logger.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+using namespace sdk;
+
+namespace {
+
+// 完整渲染每一行但不产生I/O，测得的是日志器自身的开销
+class NullAppender : public LogAppender {
+public:
+    explicit NullAppender(std::unique_ptr<LogFormatter> formatter) {
+        formatter_ = std::move(formatter);
+    }
+
+    void append(const LogRecord& record) override {
+        line_.clear();
+        formatter_->formatTo(record, line_);
+        bytes_ += line_.size();
+    }
+
+    bool acceptsFormatted() const override { return true; }
+
+    void appendFormatted(const LogRecord&, std::string_view line) override {
+        bytes_ += line.size();
+    }
+
+    void flush() override {
+        benchmark::DoNotOptimize(bytes_);
+    }
+
+private:
+    std::string line_;
+    size_t bytes_ = 0;
+};
+
+std::unique_ptr<LogFormatter> makeFormatter(int64_t kind) {
+    if (kind == 1) {
+        return std::make_unique<JsonFormatter>();
+    }
+    return std::make_unique<DefaultFormatter>();
+}
+
+const char* formatterName(int64_t kind) {
+    return kind == 1 ? "json" : "pattern";
+}
+
+// kind：0为默认模式格式，1为JSON；async为true时经AsyncAppender写出
+std::unique_ptr<Logger> makeLogger(int64_t kind, bool async) {
+    auto logger = std::make_unique<Logger>("bench");
+    logger->removeAllAppenders();
+    logger->setLevel(LogLevel::INFO);
+
+    std::unique_ptr<LogAppender> appender = std::make_unique<NullAppender>(makeFormatter(kind));
+    if (async) {
+        AsyncAppenderOptions options;
+        options.queue_capacity = 65536;
+        appender = std::make_unique<AsyncAppender>(std::move(appender), options);
+    }
+    logger->addAppender(std::move(appender));
+    return logger;
+}
+
+} // namespace
+
+static void BM_LogSync(benchmark::State& state) {
+    auto logger = makeLogger(state.range(0), false);
+    state.SetLabel(formatterName(state.range(0)));
+    int64_t i = 0;
+    for (auto _ : state) {
+        logger->info("request {} finished with status {} in {} ms", ++i, 200, 12.5);
+    }
+    logger->flush();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogSync)->Arg(0)->Arg(1);
+
+// 调用线程的开销；后台线程的写出在计时结束后的flush中完成
+static void BM_LogAsync(benchmark::State& state) {
+    auto logger = makeLogger(state.range(0), true);
+    state.SetLabel(formatterName(state.range(0)));
+    int64_t i = 0;
+    for (auto _ : state) {
+        logger->info("request {} finished with status {} in {} ms", ++i, 200, 12.5);
+    }
+    logger->flush();
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogAsync)->Arg(0)->Arg(1);
+
+// 多个线程同时写同一个异步日志器
+static void BM_LogAsyncContended(benchmark::State& state) {
+    // 线程0在计时开始前创建，计时循环开始时各线程在屏障处同步
+    static std::unique_ptr<Logger> logger;
+    if (state.thread_index() == 0) {
+        logger = makeLogger(0, true);
+    }
+    int64_t i = 0;
+    for (auto _ : state) {
+        logger->info("worker {} message {}", state.thread_index(), ++i);
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        logger->flush();
+    }
+}
+BENCHMARK(BM_LogAsyncContended)->Threads(1)->Threads(4)->UseRealTime();
+
+// 级别被过滤时的开销
+static void BM_LogFiltered(benchmark::State& state) {
+    auto logger = makeLogger(0, false);
+    for (auto _ : state) {
+        logger->debug("filtered {} {}", 1, "value");
+    }
+}
+BENCHMARK(BM_LogFiltered);
+
+// 非字面量格式串需要立即渲染消息
+static void BM_LogPlainString(benchmark::State& state) {
+    auto logger = makeLogger(0, false);
+    const std::string message = "connection pool warmed up";
+    for (auto _ : state) {
+        logger->info(message);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LogPlainString);
@@ -0,0 +1,136 @@
+#include "sdk/threading/thread_pool.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+using namespace sdk;
+
+namespace {
+
+constexpr int kTasksPerIteration = 10000;
+
+// 约一百纳秒的计算，代表细粒度任务
+void smallWork() {
+    uint64_t value = 0;
+    for (int i = 0; i < 64; ++i) {
+        benchmark::DoNotOptimize(value += static_cast<uint64_t>(i));
+    }
+}
+
+ThreadPoolConfig configFor(int64_t threads, int64_t mode) {
+    ThreadPoolConfig config;
+    config.thread_count = static_cast<size_t>(threads);
+    config.max_threads = static_cast<size_t>(threads);
+    if (mode == 1) {
+        config.scheduling_mode = SchedulingMode::WORK_STEALING;
+    } else if (mode == 2) {
+        config.queue_backend = QueueBackend::RING_BUFFER;
+        config.ring_capacity = 16384;
+    }
+    return config;
+}
+
+const char* modeName(int64_t mode) {
+    switch (mode) {
+        case 1: return "work_stealing";
+        case 2: return "ring_buffer";
+        default: return "shared_heap";
+    }
+}
+
+} // namespace
+
+// 投递到执行完成的往返延迟，包括唤醒工作线程
+static void BM_PostRoundTrip(benchmark::State& state) {
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    std::atomic<uint64_t> done{0};
+    uint64_t expected = 0;
+    for (auto _ : state) {
+        pool.post([&done] { done.fetch_add(1, std::memory_order_release); });
+        ++expected;
+        while (done.load(std::memory_order_acquire) != expected) {
+        }
+    }
+}
+BENCHMARK(BM_PostRoundTrip)->Arg(1)->Arg(4)->UseRealTime();
+
+// submit()带future与任务记录的往返延迟
+static void BM_SubmitRoundTrip(benchmark::State& state) {
+    ThreadPool pool(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pool.submit([] { return 1; }).get());
+    }
+}
+BENCHMARK(BM_SubmitRoundTrip)->Arg(1)->Arg(4)->UseRealTime();
+
+// 调用线程上的入队开销，任务在计时结束后才等待完成
+static void BM_PostEnqueue(benchmark::State& state) {
+    ThreadPool pool(configFor(4, state.range(0)));
+    state.SetLabel(modeName(state.range(0)));
+    for (auto _ : state) {
+        pool.post([] {});
+    }
+    pool.waitForAll();
+}
+BENCHMARK(BM_PostEnqueue)->DenseRange(0, 2);
+
+// 吞吐量随线程数与调度模式的变化
+static void BM_Throughput(benchmark::State& state) {
+    ThreadPool pool(configFor(state.range(0), state.range(1)));
+    state.SetLabel(modeName(state.range(1)));
+    for (auto _ : state) {
+        for (int i = 0; i < kTasksPerIteration; ++i) {
+            pool.post(smallWork);
+        }
+        pool.waitForAll();
+    }
+    state.SetItemsProcessed(state.iterations() * kTasksPerIteration);
+}
+BENCHMARK(BM_Throughput)->ArgsProduct({{1, 2, 4, 8}, {0, 1, 2}})->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// 混合优先级：参数为HIGH与CRITICAL任务所占的百分比
+static void BM_PriorityMix(benchmark::State& state) {
+    ThreadPool pool(4);
+    const int64_t urgent_percent = state.range(0);
+    for (auto _ : state) {
+        for (int i = 0; i < kTasksPerIteration; ++i) {
+            int64_t bucket = i % 100;
+            TaskPriority priority = TaskPriority::NORMAL;
+            if (bucket < urgent_percent / 4) {
+                priority = TaskPriority::CRITICAL;
+            } else if (bucket < urgent_percent) {
+                priority = TaskPriority::HIGH;
+            } else if (bucket >= 90) {
+                priority = TaskPriority::LOW;
+            }
+            pool.post(priority, smallWork);
+        }
+        pool.waitForAll();
+    }
+    state.SetItemsProcessed(state.iterations() * kTasksPerIteration);
+}
+BENCHMARK(BM_PriorityMix)->Arg(0)->Arg(10)->Arg(50)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// 批量提交与逐个投递的对比
+static void BM_SubmitBatch(benchmark::State& state) {
+    ThreadPool pool(4);
+    std::vector<int> items(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        pool.submitBatch(items, [](int&) { smallWork(); }).wait();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SubmitBatch)->Arg(1000)->Arg(100000)->UseRealTime();
+
+static void BM_ParallelFor(benchmark::State& state) {
+    ThreadPool pool(4);
+    const int64_t count = state.range(0);
+    for (auto _ : state) {
+        pool.parallelFor<int64_t>(0, count, 0, [](int64_t) { smallWork(); }).wait();
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_ParallelFor)->Arg(1000)->Arg(100000)->UseRealTime();
@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""比较两次Google Benchmark的JSON结果，任一基准变慢超过阈值时以非零状态退出。
+
+用法:
+    compare.py baseline.json contender.json [--threshold 0.05] [--metric real_time]
+
+结果带有重复统计（--benchmark_repetitions）时使用中位数，否则使用单次结果。
+"""
+
+import argparse
+import json
+import sys
+
+UNIT_TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path, metric):
+    with open(path, encoding="utf-8") as f:
+        data = json.load(f)
+
+    medians = {}
+    singles = {}
+    for bench in data.get("benchmarks", []):
+        if bench.get("error_occurred"):
+            continue
+        name = bench.get("run_name", bench["name"])
+        value = bench[metric] * UNIT_TO_NS[bench.get("time_unit", "ns")]
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") == "median":
+                medians[name] = value
+        else:
+            singles.setdefault(name, value)
+
+    singles.update(medians)
+    return singles
+
+
+def format_ns(value):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if value >= scale:
+            return "%.2f %s" % (value / scale, unit)
+    return "%.1f ns" % value
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("contender")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="relative slowdown treated as a regression (default: 0.05)")
+    parser.add_argument("--metric", choices=("real_time", "cpu_time"), default="real_time")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    contender = load(args.contender, args.metric)
+
+    regressions = []
+    width = max([len(name) for name in baseline] + [9])
+    print("%-*s %12s %12s %9s" % (width, "benchmark", "baseline", "contender", "change"))
+    for name in sorted(baseline):
+        if name not in contender:
+            print("%-*s %12s %12s %9s" % (width, name, format_ns(baseline[name]), "-", "missing"))
+            continue
+        old, new = baseline[name], contender[name]
+        change = (new - old) / old if old > 0 else 0.0
+        marker = ""
+        if change > args.threshold:
+            marker = "  REGRESSION"
+            regressions.append(name)
+        print("%-*s %12s %12s %+8.1f%%%s" % (width, name, format_ns(old), format_ns(new), change * 100, marker))
+
+    for name in sorted(set(contender) - set(baseline)):
+        print("%-*s %12s %12s %9s" % (width, name, "-", format_ns(contender[name]), "new"))
+
+    if regressions:
+        print("\n%d benchmark(s) slower than baseline by more than %.0f%%"
+              % (len(regressions), args.threshold * 100))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
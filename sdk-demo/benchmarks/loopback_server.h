@@ -0,0 +1,111 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+// 进程内HTTP/1.1回环服务器：支持keep-alive，对任意请求返回固定大小的响应体，
+// 基准测试只测量客户端与本机协议栈，不依赖外部主机
+class LoopbackServer {
+public:
+    explicit LoopbackServer(size_t body_size) : body_(body_size, 'x') {
+        listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        ::listen(listen_fd_, 128);
+
+        socklen_t len = sizeof(addr);
+        ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+
+        response_ = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(body_.size()) +
+                    "\r\nContent-Type: application/octet-stream\r\n\r\n" + body_;
+        acceptor_ = std::thread([this] { acceptLoop(); });
+    }
+
+    ~LoopbackServer() {
+        stopping_ = true;
+        ::shutdown(listen_fd_, SHUT_RDWR);
+        ::close(listen_fd_);
+        acceptor_.join();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int fd : client_fds_) {
+            ::shutdown(fd, SHUT_RDWR);
+        }
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        for (int fd : client_fds_) {
+            ::close(fd);
+        }
+    }
+
+    LoopbackServer(const LoopbackServer&) = delete;
+    LoopbackServer& operator=(const LoopbackServer&) = delete;
+
+    std::string url(const std::string& path = "/") const {
+        return "http://127.0.0.1:" + std::to_string(port_) + path;
+    }
+
+private:
+    void acceptLoop() {
+        while (!stopping_) {
+            int fd = ::accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            client_fds_.push_back(fd);
+            workers_.emplace_back([this, fd] { serve(fd); });
+        }
+    }
+
+    // 只处理不带请求体的请求，基准中只发送GET
+    void serve(int fd) {
+        std::string buffer;
+        char chunk[4096];
+        for (;;) {
+            size_t header_end;
+            while ((header_end = buffer.find("\r\n\r\n")) == std::string::npos) {
+                ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) {
+                    return;
+                }
+                buffer.append(chunk, static_cast<size_t>(n));
+            }
+            buffer.erase(0, header_end + 4);
+
+            if (::send(fd, response_.data(), response_.size(), MSG_NOSIGNAL) < 0) {
+                return;
+            }
+        }
+    }
+
+    std::string body_;
+    std::string response_;
+    int listen_fd_ = -1;
+    int port_ = 0;
+    std::atomic<bool> stopping_{false};
+    std::thread acceptor_;
+    std::mutex mutex_;
+    std::vector<int> client_fds_;
+    std::vector<std::thread> workers_;
+};
+
+} // namespace bench
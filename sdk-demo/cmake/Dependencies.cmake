@@ -38,6 +38,9 @@ else()
     set(CURL_INCLUDE_DIRS "")
 endif()
 
+# zlib - 可选，用于压缩轮转后的日志文件
+find_package(ZLIB)
+
 # spdlog - 日志库（头文件版本，避免链接问题）
 FetchContent_Declare(
     spdlog
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "sdk/logging/logger.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace sdk {
+
+    // 二进制日志文件格式（整数均为小端序，varint为LEB128）：
+    //   文件头  "SDKBLOG1" | 基准时间戳 int64（system_clock纳秒）
+    //   FORMAT  id varint | 格式串
+    //   STRING  id varint | 字符串（日志器名、文件名、函数名）
+    //   THREAD  id varint | 线程标识 u64
+    //   EVENT   级别 u8 | 格式id | 日志器id | 文件id | 行号 | 函数id | 线程id | 时间差（相对上一条，zigzag纳秒）
+    //           | 参数个数 u8 | 参数字节数 varint | LogArgs编码的参数
+    //   CONTEXT 键值对个数 varint | (键id varint | 值字符串)...，属于紧随其后的EVENT
+    // 字典项在首次使用前写出，字符串编码为varint长度加内容，id 0表示空字符串
+    // 已格式化的记录以"{}"格式串加一个字符串参数写出
+    namespace binary_log {
+        constexpr char kMagic[8] = {'S', 'D', 'K', 'B', 'L', 'O', 'G', '1'};
+
+        enum class Tag : uint8_t {
+            FORMAT = 1,
+            STRING = 2,
+            THREAD = 3,
+            EVENT = 4,
+            CONTEXT = 5
+        };
+    }
+
+    // 二进制文件输出器：不做文本渲染，直接写出格式id与参数原始字节，由sdk_log_decode离线解码
+    // 与FileAppender一样不是线程安全的，多线程使用时应包装在AsyncAppender中
+    class BinaryFileAppender : public LogAppender {
+    public:
+        explicit BinaryFileAppender(const std::string& file_path, size_t buffer_size = 64 * 1024);
+        ~BinaryFileAppender();
+
+        void append(const LogRecord& record) override;
+        void flush() override;
+
+        // 直接写出参数，不需要先格式化
+        bool acceptsDeferred() const override { return true; }
+
+        bool isOpen() const;
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> pImpl_;
+    };
+
+    // 解码出的一条日志，record.format指向读取器内部保存的格式串，在读取器销毁前有效
+    struct BinaryLogEntry {
+        LogRecord record;
+        uint64_t thread = 0;
+    };
+
+    // 二进制日志读取器
+    class BinaryLogReader {
+    public:
+        explicit BinaryLogReader(const std::string& file_path);
+        ~BinaryLogReader();
+
+        // 文件存在且文件头有效
+        bool isOpen() const;
+
+        // 读取下一条日志，文件结束或内容损坏时返回false
+        bool next(BinaryLogEntry& entry);
+
+        // 是否因内容损坏（而非文件结束）停止读取
+        bool corrupted() const;
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> pImpl_;
+    };
+}
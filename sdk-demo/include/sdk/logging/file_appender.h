@@ -0,0 +1,65 @@
+#pragma once
+
+#include "sdk/logging/logger.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace sdk {
+
+    // 轮转后历史文件的压缩方式
+    enum class LogCompression {
+        NONE,
+        GZIP    // 需要构建时找到zlib，否则退化为NONE
+    };
+
+    // 高吞吐文件输出器配置
+    struct BufferedFileAppenderOptions {
+        // 用户态缓冲区大小，写满后整块交给后台线程，一次系统调用写出
+        size_t buffer_size = 256 * 1024;
+
+        // 缓冲区中的日志最多驻留flush_interval后写出
+        std::chrono::milliseconds flush_interval{1000};
+
+        // 不低于flush_level的记录立即交给后台线程写出（调用线程不等待）
+        LogLevel flush_level = LogLevel::ERROR;
+
+        // 等待写出的缓冲区个数上限，超过时调用线程等待
+        size_t max_pending_buffers = 8;
+
+        // 文件达到max_file_size字节时轮转，0表示不轮转；保留max_files个历史文件（file.1最新）
+        size_t max_file_size = 0;
+        size_t max_files = 5;
+        LogCompression compression = LogCompression::NONE;
+    };
+
+    // 高吞吐文件输出器：调用线程只把整行追加到内存缓冲区，写文件、轮转和压缩都在后台线程上完成，
+    // 轮转时日志延迟不受影响。文件以追加方式打开，轮转只在行边界处切分。线程安全
+    class BufferedFileAppender : public LogAppender {
+    public:
+        explicit BufferedFileAppender(const std::string& file_path,
+                                      const BufferedFileAppenderOptions& options = BufferedFileAppenderOptions());
+        ~BufferedFileAppender();
+
+        void append(const LogRecord& record) override;
+
+        bool acceptsFormatted() const override { return true; }
+        void appendFormatted(const LogRecord& record, std::string_view line) override;
+
+        // 等待已追加的日志全部写入文件，以及已开始的轮转和压缩完成
+        void flush() override;
+
+        bool isOpen() const;
+
+        // 已完成的轮转次数
+        size_t rotationCount() const;
+
+        // 当前构建是否支持该压缩方式
+        static bool compressionSupported(LogCompression compression);
+
+    private:
+        class Impl;
+        std::unique_ptr<Impl> pImpl_;
+    };
+}
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace sdk {
+
+    // 延迟格式化参数的类型标记
+    enum class LogArgType : uint8_t {
+        INT64 = 1,
+        UINT64 = 2,
+        DOUBLE = 3,
+        BOOL = 4,
+        CHAR = 5,
+        STRING = 6,
+        POINTER = 7
+    };
+
+    // 解码后的单个参数，STRING指向LogArgs内部的字节
+    struct LogArg {
+        LogArgType type = LogArgType::INT64;
+        union {
+            int64_t i;
+            uint64_t u;
+            double d;
+            bool b;
+            char c;
+            const void* p;
+        };
+        const char* str = nullptr;
+        size_t len = 0;
+
+        LogArg() : u(0) {}
+    };
+
+    // 按值捕获的日志参数
+    // 参数依次编码为1字节类型标记加原始字节，字符串编码为4字节长度加内容，全部存放在定长内联缓冲区中，
+    // 捕获和拷贝只是memcpy已用部分；缓冲区不足时字符串被截断，放不下的参数被丢弃
+    class LogArgs {
+    public:
+        static constexpr size_t kCapacity = 240;
+
+        LogArgs() = default;
+        LogArgs(const LogArgs& other) { assign(other.data_, other.size_, other.count_); }
+        LogArgs& operator=(const LogArgs& other) {
+            if (this != &other) {
+                assign(other.data_, other.size_, other.count_);
+            }
+            return *this;
+        }
+
+        template<typename... Args>
+        static LogArgs capture(const Args&... args) {
+            LogArgs result;
+            (result.add(args), ...);
+            return result;
+        }
+
+        template<typename T>
+        void add(const T& value);
+
+        // 从编码后的字节恢复，供离线解码使用；超出容量时返回false
+        bool assign(const unsigned char* data, size_t size, size_t count) {
+            if (size > kCapacity) {
+                return false;
+            }
+            std::memcpy(data_, data, size);
+            size_ = static_cast<uint16_t>(size);
+            count_ = static_cast<uint8_t>(count);
+            return true;
+        }
+
+        // 按顺序解码，offset从0开始；没有更多参数时返回false
+        bool next(size_t& offset, LogArg& arg) const;
+
+        void clear() { size_ = 0; count_ = 0; }
+        bool empty() const { return count_ == 0; }
+        size_t count() const { return count_; }
+        size_t size() const { return size_; }
+        const unsigned char* data() const { return data_; }
+
+    private:
+        static constexpr size_t kMaxArgs = 255;
+
+        bool put(LogArgType type, const void* value, size_t size) {
+            if (count_ >= kMaxArgs || size_ + 1 + size > kCapacity) {
+                return false;
+            }
+            data_[size_] = static_cast<unsigned char>(type);
+            std::memcpy(data_ + size_ + 1, value, size);
+            size_ = static_cast<uint16_t>(size_ + 1 + size);
+            ++count_;
+            return true;
+        }
+
+        void putString(const char* str, size_t len) {
+            size_t room = kCapacity - size_;
+            if (count_ >= kMaxArgs || room < 1 + sizeof(uint32_t)) {
+                return;
+            }
+            len = std::min(len, room - 1 - sizeof(uint32_t));
+            uint32_t stored = static_cast<uint32_t>(len);
+            data_[size_] = static_cast<unsigned char>(LogArgType::STRING);
+            std::memcpy(data_ + size_ + 1, &stored, sizeof(stored));
+            std::memcpy(data_ + size_ + 1 + sizeof(stored), str, len);
+            size_ = static_cast<uint16_t>(size_ + 1 + sizeof(stored) + len);
+            ++count_;
+        }
+
+        template<typename T>
+        void putValue(LogArgType type, T value) {
+            put(type, &value, sizeof(value));
+        }
+
+        unsigned char data_[kCapacity];
+        uint16_t size_ = 0;
+        uint8_t count_ = 0;
+    };
+
+    namespace detail {
+        template<typename T, typename = void>
+        struct IsStreamable : std::false_type {};
+
+        template<typename T>
+        struct IsStreamable<T, std::void_t<decltype(std::declval<std::ostream&>() << std::declval<const T&>())>>
+            : std::true_type {};
+
+        // 统计格式串中的占位符，格式错误（括号不配对、使用位置参数）时返回-1
+        constexpr int countPlaceholders(const char* format) {
+            int count = 0;
+            for (size_t i = 0; format[i] != '\0'; ++i) {
+                if (format[i] == '{') {
+                    if (format[i + 1] == '{') {
+                        ++i;
+                        continue;
+                    }
+                    if (format[i + 1] != '}' && format[i + 1] != ':') {
+                        return -1;
+                    }
+                    size_t j = i + 1;
+                    while (format[j] != '\0' && format[j] != '}') {
+                        if (format[j] == '{') {
+                            return -1;
+                        }
+                        ++j;
+                    }
+                    if (format[j] == '\0') {
+                        return -1;
+                    }
+                    ++count;
+                    i = j;
+                } else if (format[i] == '}') {
+                    if (format[i + 1] != '}') {
+                        return -1;
+                    }
+                    ++i;
+                }
+            }
+            return count;
+        }
+
+        constexpr bool formatMatches(const char* format, size_t arg_count) {
+            return countPlaceholders(format) == static_cast<int>(arg_count);
+        }
+
+        // 只用于decltype，统计格式串之后的参数个数
+        template<typename Format, typename... Args>
+        std::integral_constant<size_t, sizeof...(Args)> countFormatArgs(const Format&, const Args&...);
+    }
+
+    template<typename T>
+    void LogArgs::add(const T& value) {
+        using U = typename std::decay<T>::type;
+
+        if constexpr (std::is_same<U, bool>::value) {
+            putValue(LogArgType::BOOL, value);
+        } else if constexpr (std::is_same<U, char>::value) {
+            putValue(LogArgType::CHAR, value);
+        } else if constexpr (std::is_enum<U>::value) {
+            add(static_cast<typename std::underlying_type<U>::type>(value));
+        } else if constexpr (std::is_integral<U>::value && std::is_signed<U>::value) {
+            putValue(LogArgType::INT64, static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral<U>::value) {
+            putValue(LogArgType::UINT64, static_cast<uint64_t>(value));
+        } else if constexpr (std::is_floating_point<U>::value) {
+            putValue(LogArgType::DOUBLE, static_cast<double>(value));
+        } else if constexpr (std::is_array<T>::value && (std::is_same<U, const char*>::value || std::is_same<U, char*>::value)) {
+            putString(value, std::strlen(value));
+        } else if constexpr (std::is_same<U, const char*>::value || std::is_same<U, char*>::value) {
+            const char* str = value ? value : "(null)";
+            putString(str, std::strlen(str));
+        } else if constexpr (std::is_same<U, std::string>::value || std::is_same<U, std::string_view>::value) {
+            putString(value.data(), value.size());
+        } else if constexpr (std::is_pointer<U>::value || std::is_null_pointer<U>::value) {
+            putValue(LogArgType::POINTER, static_cast<const void*>(value));
+        } else {
+            // 其他类型只能在调用线程上转换为文本
+            static_assert(detail::IsStreamable<U>::value, "log argument type is not supported");
+            std::ostringstream oss;
+            oss << value;
+            auto text = oss.str();
+            putString(text.data(), text.size());
+        }
+    }
+
+    // 成员函数接口的格式串：const char*无法在类型上区分字面量与c_str()、栈上缓冲区，
+    // 因此一律在调用线程上立即格式化；只有SDK_LOG_*宏的静态调用点才推迟格式化
+    class LogFormat {
+    public:
+        LogFormat(const char* format) : str_(format ? format : "") {}
+        LogFormat(const std::string& format) : str_(format.c_str()) {}
+
+        const char* c_str() const { return str_; }
+
+    private:
+        const char* str_;
+    };
+
+    // 按格式串展开参数，覆盖out原有内容
+    // 支持{}与{:[[fill]align][sign][#][0][width][.precision][type]}，{{和}}输出括号本身；
+    // 参数不足的占位符原样保留，多余的参数被忽略
+    void formatLogMessage(std::string& out, const char* format, const LogArgs& args);
+}
+
+// 编译期检查格式串与参数个数，格式串必须是字符串字面量
+#define SDK_LOG_EXPAND(x) x
+#define SDK_LOG_FORMAT_STRING(format, ...) format
+#define SDK_LOG_CHECK_FORMAT(...) \
+    static_assert(::sdk::detail::formatMatches( \
+                      SDK_LOG_EXPAND(SDK_LOG_FORMAT_STRING(__VA_ARGS__, 0)), \
+                      decltype(::sdk::detail::countFormatArgs(__VA_ARGS__))::value), \
+                  "log format string does not match its arguments")
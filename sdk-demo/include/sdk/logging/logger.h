@@ -1,12 +1,21 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <vector>
 #include <unordered_map>
 #include <functional>
 #include <chrono>
 #include <sstream>
+#include <thread>
+#include <iosfwd>
+
+#include "sdk/logging/log_format.h"
+#include "sdk/metrics/metrics.h"
 
 namespace sdk {
     
@@ -21,40 +30,228 @@ namespace sdk {
         OFF = 6
     };
     
+    // 源码位置，字符串均为以NUL结尾的静态字符串
+    struct SourceLocation {
+        const char* file = nullptr;
+        int line = 0;
+        const char* function = nullptr;
+    };
+    
+    // 调用点描述：每个SDK_LOG_*宏展开处一个静态实例，常量初始化，首次使用时登记到全局列表
+    // 调用点自带开关、1/N采样和令牌桶限流状态，宏在求值参数之前调用shouldLog()；
+    // 未配置任何规则时只多一次原子读
+    class LogCallSite {
+    public:
+        constexpr LogCallSite(LogLevel level, const char* file, int line, const char* function, const char* format)
+            : level_(level), location_{file, line, function}, format_(format) {}
+        
+        LogCallSite(const LogCallSite&) = delete;
+        LogCallSite& operator=(const LogCallSite&) = delete;
+        
+        LogLevel level() const { return level_; }
+        const SourceLocation& location() const { return location_; }
+        const char* format() const { return format_; }
+        
+        // 调用点编号，从1开始按首次使用的顺序分配
+        uint32_t id() {
+            uint32_t current = id_.load(std::memory_order_acquire);
+            return current != 0 ? current : registerSite();
+        }
+        
+        // 是否放行本次日志，被拦截时计入suppressedCount()
+        bool shouldLog() {
+            if (id_.load(std::memory_order_acquire) == 0) {
+                // 登记时应用LogManager中已有的规则
+                registerSite();
+            }
+            uint32_t flags = flags_.load(std::memory_order_relaxed);
+            return flags == 0 || admit(flags);
+        }
+        
+        void setEnabled(bool enabled);
+        bool isEnabled() const { return (flags_.load(std::memory_order_relaxed) & kDisabled) == 0; }
+        
+        // 每N条放行1条，0或1表示不采样
+        void setSampling(uint32_t one_in_n);
+        
+        // 每秒最多放行per_second条，允许burst条的突发；per_second不大于0时取消限流
+        void setRateLimit(double per_second, uint32_t burst);
+        
+        uint64_t suppressedCount() const { return suppressed_.load(std::memory_order_relaxed); }
+        
+        // 遍历已登记的调用点
+        static void forEach(const std::function<void(LogCallSite&)>& visitor);
+        
+    private:
+        static constexpr uint32_t kDisabled = 1;
+        static constexpr uint32_t kSampled = 2;
+        static constexpr uint32_t kRateLimited = 4;
+        
+        uint32_t registerSite();
+        bool admit(uint32_t flags);
+        void updateFlag(uint32_t flag, bool set);
+        
+        const LogLevel level_;
+        const SourceLocation location_;
+        const char* const format_;
+        std::atomic<uint32_t> id_{0};
+        LogCallSite* next_ = nullptr;
+        
+        std::atomic<uint32_t> flags_{0};
+        std::atomic<uint32_t> sample_every_{0};
+        std::atomic<uint32_t> sample_counter_{0};
+        
+        // 限流采用GCRA：tat_为理论到达时间，等价于令牌桶但只需一个原子变量
+        std::atomic<int64_t> rate_interval_ns_{0};
+        std::atomic<int64_t> rate_tolerance_ns_{0};
+        std::atomic<int64_t> tat_ns_{0};
+        std::atomic<uint64_t> suppressed_{0};
+    };
+    
+    // 日志上下文：少量键值对内联存放，超出kInlineCapacity后才使用堆上的后备数组
+    class LogContext {
+    public:
+        using Entry = std::pair<std::string, std::string>;
+        static constexpr size_t kInlineCapacity = 4;
+        
+        LogContext() = default;
+        LogContext(const LogContext& other) { *this = other; }
+        LogContext(LogContext&&) = default;
+        LogContext& operator=(LogContext&&) = default;
+        
+        // 只拷贝已使用的内联项
+        LogContext& operator=(const LogContext& other) {
+            if (this != &other) {
+                for (size_t i = 0; i < other.inline_size_; ++i) {
+                    inline_[i] = other.inline_[i];
+                }
+                inline_size_ = other.inline_size_;
+                overflow_ = other.overflow_;
+            }
+            return *this;
+        }
+        
+        void add(std::string key, std::string value) {
+            if (inline_size_ < kInlineCapacity) {
+                inline_[inline_size_].first = std::move(key);
+                inline_[inline_size_].second = std::move(value);
+                ++inline_size_;
+            } else {
+                overflow_.emplace_back(std::move(key), std::move(value));
+            }
+        }
+        
+        const std::string* find(std::string_view key) const {
+            for (size_t i = 0; i < size(); ++i) {
+                if ((*this)[i].first == key) {
+                    return &(*this)[i].second;
+                }
+            }
+            return nullptr;
+        }
+        
+        const Entry& operator[](size_t index) const {
+            return index < kInlineCapacity ? inline_[index] : overflow_[index - kInlineCapacity];
+        }
+        
+        size_t size() const { return inline_size_ + overflow_.size(); }
+        bool empty() const { return inline_size_ == 0; }
+        
+        // 保留字符串容量，供复用的记录使用
+        void clear() {
+            inline_size_ = 0;
+            overflow_.clear();
+        }
+        
+    private:
+        std::array<Entry, kInlineCapacity> inline_;
+        size_t inline_size_ = 0;
+        std::vector<Entry> overflow_;
+    };
+    
     // 日志记录结构
+    // logger_name、file、function引用日志器名与调用点的字符串，不做拷贝；
+    // 日志器名在日志器销毁前有效，file与function为以NUL结尾的静态字符串
     struct LogRecord {
-        LogLevel level;
+        LogLevel level = LogLevel::INFO;
         std::string message;
-        std::string logger_name;
-        std::string file;
-        int line;
-        std::string function;
+        std::string_view logger_name;
+        std::string_view file;
+        int line = 0;
+        std::string_view function;
         std::chrono::system_clock::time_point timestamp;
         std::thread::id thread_id;
-        std::unordered_map<std::string, std::string> context;
+        LogContext context;
+        
+        // 延迟格式化：format非空时message尚未生成，参数按值保存在args中
+        const char* format = nullptr;
+        LogArgs args;
     };
     
+    // 生成延迟格式化的消息，已格式化的记录不变
+    void formatRecordMessage(LogRecord& record);
+    
     // 日志格式化器接口
     class LogFormatter {
     public:
         virtual ~LogFormatter() = default;
         virtual std::string format(const LogRecord& record) = 0;
+        
+        // 追加到out末尾，输出器传入复用的缓冲区以避免每条日志分配；默认通过format()实现
+        virtual void formatTo(const LogRecord& record, std::string& out) {
+            out += format(record);
+        }
+        
+        // 对同一条记录是否与other产生相同的输出，Logger据此在多个输出器之间共享渲染结果
+        virtual bool sameOutput(const LogFormatter& other) const { return this == &other; }
     };
     
-    // 默认格式化器
+    // 默认格式化器：构造时把pattern编译为片段序列，格式化时直接写入输出缓冲区
+    // 支持 %Y %m %d %H %M %S %T(%H:%M:%S) %e(毫秒) %f(微秒) %F(纳秒) %l(级别) %L(级别首字母)
+    //      %n(日志器名) %v(消息) %t(线程) %s(文件名) %g(文件路径) %#(行号) %!(函数) %%
+    // 精确到秒的时间字段按线程缓存，同一秒内只重新生成亚秒部分
     class DefaultFormatter : public LogFormatter {
     public:
         explicit DefaultFormatter(const std::string& pattern = "[%Y-%m-%d %H:%M:%S.%e] [%l] [%n] %v");
         std::string format(const LogRecord& record) override;
+        void formatTo(const LogRecord& record, std::string& out) override;
+        bool sameOutput(const LogFormatter& other) const override;
+        
+        const std::string& pattern() const { return pattern_; }
         
     private:
+        enum class Field : uint8_t {
+            LITERAL, TIME_BLOCK,
+            YEAR, MONTH, DAY, HOUR, MINUTE, SECOND,
+            MILLIS, MICROS, NANOS,
+            LEVEL, SHORT_LEVEL, LOGGER, MESSAGE, THREAD,
+            FILE_NAME, FILE_PATH, LINE, FUNCTION
+        };
+        
+        struct Token {
+            Field field;
+            std::string literal;    // LITERAL的文本
+            size_t block = 0;       // TIME_BLOCK在time_blocks_中的下标
+        };
+        
+        void compile();
+        
         std::string pattern_;
+        std::vector<Token> tokens_;
+        
+        // 相邻的秒级时间字段（及其间的字面量）合并为一个块，按秒缓存渲染结果
+        std::vector<std::vector<Token>> time_blocks_;
+        
+        // 区分线程缓存属于哪个格式化器实例
+        const uint64_t cache_key_;
     };
     
-    // JSON格式化器
+    // JSON格式化器：字段一次遍历完成转义，直接写入输出缓冲区
     class JsonFormatter : public LogFormatter {
     public:
         std::string format(const LogRecord& record) override;
+        void formatTo(const LogRecord& record, std::string& out) override;
+        bool sameOutput(const LogFormatter& other) const override;
     };
     
     // 日志输出器接口
@@ -64,7 +261,19 @@ namespace sdk {
         virtual void append(const LogRecord& record) = 0;
         virtual void flush() = 0;
         
+        // 是否接受尚未格式化的记录；返回false时Logger在调用append()前先生成message
+        virtual bool acceptsDeferred() const { return false; }
+        
+        // 文本输出器返回true，Logger用getFormatter()渲染一次整行，
+        // 格式相同的输出器共享同一份字节，通过appendFormatted()写出（line不含换行符）
+        virtual bool acceptsFormatted() const { return false; }
+        virtual void appendFormatted(const LogRecord& record, std::string_view line) {
+            (void)line;
+            append(record);
+        }
+        
         void setFormatter(std::unique_ptr<LogFormatter> formatter);
+        LogFormatter* getFormatter() const { return formatter_.get(); }
         void setLevel(LogLevel level);
         LogLevel getLevel() const { return level_; }
         
@@ -80,6 +289,9 @@ namespace sdk {
         void append(const LogRecord& record) override;
         void flush() override;
         
+        bool acceptsFormatted() const override { return true; }
+        void appendFormatted(const LogRecord& record, std::string_view line) override;
+        
     private:
         bool use_colors_;
         std::string getColorCode(LogLevel level);
@@ -94,6 +306,9 @@ namespace sdk {
         void append(const LogRecord& record) override;
         void flush() override;
         
+        bool acceptsFormatted() const override { return true; }
+        void appendFormatted(const LogRecord& record, std::string_view line) override;
+        
         // 设置文件轮转
         void setRotation(size_t max_size, size_t max_files);
         
@@ -104,24 +319,62 @@ namespace sdk {
         size_t max_files_ = 0;
         size_t current_size_ = 0;
         
+        void write(const std::string& buffer);
         void rotateFile();
     };
     
-    // 异步输出器
+    // 异步输出器队列写满时的处理方式
+    enum class AsyncOverflowPolicy {
+        BLOCK,          // 等待后台线程腾出空位
+        DROP_OLDEST,    // 丢弃队列中最早的记录
+        DROP_NEWEST     // 丢弃当前记录
+    };
+    
+    // 异步输出器配置
+    struct AsyncAppenderOptions {
+        // 环形队列容量（向上取整为2的幂），槽位在构造时一次性分配并反复复用
+        size_t queue_capacity = 8192;
+        AsyncOverflowPolicy overflow_policy = AsyncOverflowPolicy::BLOCK;
+        
+        // 后台线程每批最多写出的记录数
+        size_t batch_size = 256;
+        
+        // 不低于flush_level的记录写出后立即刷新，调用线程最多等待flush_timeout
+        LogLevel flush_level = LogLevel::ERROR;
+        std::chrono::milliseconds flush_timeout{100};
+        
+        // 空闲时的定期刷新间隔
+        std::chrono::milliseconds flush_interval{1000};
+    };
+    
+    // 异步输出器：调用线程只把记录复制进预分配的环形队列，由唯一的后台线程批量写入被包装的输出器
+    // 被包装的输出器只在后台线程上调用，不需要自身线程安全
     class AsyncAppender : public LogAppender {
     public:
-        explicit AsyncAppender(std::unique_ptr<LogAppender> wrapped_appender);
+        explicit AsyncAppender(std::unique_ptr<LogAppender> wrapped_appender,
+                               const AsyncAppenderOptions& options = AsyncAppenderOptions());
         ~AsyncAppender();
         
         void append(const LogRecord& record) override;
+        
+        // 延迟格式化的记录在后台线程上生成message
+        bool acceptsDeferred() const override { return true; }
+        
+        // 等待已提交的记录全部写出并刷新被包装的输出器
         void flush() override;
         
+        // 因队列写满而丢弃的记录数
+        size_t droppedCount() const;
+        
+        // 调用线程把记录放入队列的耗时分布，包括队列写满时的等待，不包括高级别日志的刷新等待
+        HistogramSnapshot enqueueLatency() const;
+        
     private:
         class Impl;
         std::unique_ptr<Impl> pImpl_;
     };
     
-    // 日志过滤器
+    // 日志过滤器，延迟格式化的记录在过滤时message尚未生成
     class LogFilter {
     public:
         virtual ~LogFilter() = default;
@@ -140,7 +393,8 @@ namespace sdk {
         LogLevel min_level_;
     };
     
-    // 日志器类
+    // 日志器类：过滤器在所有输出端之前统一执行，消息只格式化一次
+    // 构造时默认带一个写入同名spdlog日志器的输出器，它与自定义输出器地位相同，removeAllAppenders()会一并移除
     class Logger {
     public:
         explicit Logger(const std::string& name);
@@ -160,34 +414,35 @@ namespace sdk {
         void error(const std::string& message);
         void critical(const std::string& message);
         
-        // 格式化日志方法
+        // 格式化日志方法，格式串为fmt风格的{}占位符，在调用线程上格式化；
+        // 需要把格式化推迟到输出端（异步输出器的后台线程）时使用SDK_LOG_*宏
         template<typename... Args>
-        void trace(const std::string& format, Args&&... args);
+        void trace(LogFormat format, const Args&... args);
         
         template<typename... Args>
-        void debug(const std::string& format, Args&&... args);
+        void debug(LogFormat format, const Args&... args);
         
         template<typename... Args>
-        void info(const std::string& format, Args&&... args);
+        void info(LogFormat format, const Args&... args);
         
         template<typename... Args>
-        void warn(const std::string& format, Args&&... args);
+        void warn(LogFormat format, const Args&... args);
         
         template<typename... Args>
-        void error(const std::string& format, Args&&... args);
+        void error(LogFormat format, const Args&... args);
         
         template<typename... Args>
-        void critical(const std::string& format, Args&&... args);
+        void critical(LogFormat format, const Args&... args);
         
         // 通用日志方法
         void log(LogLevel level, const std::string& message);
         
         template<typename... Args>
-        void log(LogLevel level, const std::string& format, Args&&... args);
+        void log(LogLevel level, LogFormat format, const Args&... args);
         
         // 条件日志
         template<typename... Args>
-        void log_if(bool condition, LogLevel level, const std::string& format, Args&&... args);
+        void log_if(bool condition, LogLevel level, LogFormat format, const Args&... args);
         
         // 带上下文的日志
         void logWithContext(LogLevel level, const std::string& message, 
@@ -203,13 +458,18 @@ namespace sdk {
         void addFilter(std::unique_ptr<LogFilter> filter);
         void removeAllFilters();
         
+        // 运行时开关，关闭后所有级别都不输出
+        void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+        bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+        
         // 检查是否启用某个级别
-        bool isTraceEnabled() const { return level_ <= LogLevel::TRACE; }
-        bool isDebugEnabled() const { return level_ <= LogLevel::DEBUG; }
-        bool isInfoEnabled() const { return level_ <= LogLevel::INFO; }
-        bool isWarnEnabled() const { return level_ <= LogLevel::WARN; }
-        bool isErrorEnabled() const { return level_ <= LogLevel::ERROR; }
-        bool isCriticalEnabled() const { return level_ <= LogLevel::CRITICAL; }
+        bool isLevelEnabled(LogLevel level) const { return level_ <= level && isEnabled(); }
+        bool isTraceEnabled() const { return isLevelEnabled(LogLevel::TRACE); }
+        bool isDebugEnabled() const { return isLevelEnabled(LogLevel::DEBUG); }
+        bool isInfoEnabled() const { return isLevelEnabled(LogLevel::INFO); }
+        bool isWarnEnabled() const { return isLevelEnabled(LogLevel::WARN); }
+        bool isErrorEnabled() const { return isLevelEnabled(LogLevel::ERROR); }
+        bool isCriticalEnabled() const { return isLevelEnabled(LogLevel::CRITICAL); }
         
         // 获取名称
         const std::string& getName() const { return name_; }
@@ -217,17 +477,23 @@ namespace sdk {
         // 刷新所有输出器
         void flush();
         
+        // 带源码位置的日志，供C接口使用
+        void logImpl(LogLevel level, const std::string& message, 
+                    const char* file, int line, const char* function);
+        
+        // 按调用点记录，供SDK_LOG_*宏使用；格式串取自调用点，format参数只用于宏的编译期检查
+        template<typename... Args>
+        void logSite(LogCallSite& site, const char* format, const Args&... args);
+        
     private:
         class Impl;
         std::unique_ptr<Impl> pImpl_;
         std::string name_;
         LogLevel level_ = LogLevel::INFO;
+        std::atomic<bool> enabled_{true};
         
-        void logImpl(LogLevel level, const std::string& message, 
-                    const char* file, int line, const char* function);
-        
-        template<typename... Args>
-        std::string formatMessage(const std::string& format, Args&&... args);
+        void logFormat(LogLevel level, const LogFormat& format, const LogArgs& args);
+        void logAt(LogCallSite& site, const LogArgs& args);
     };
     
     // 日志管理器
@@ -253,30 +519,54 @@ namespace sdk {
         // 刷新所有日志器
         void flushAll();
         
+        // 开关指定日志器，对之后创建的同名日志器同样生效
+        void setLoggerEnabled(const std::string& name, bool enabled);
+        
+        // 调用点规则，对已登记和之后登记的调用点都生效，同一调用点以最后设置的规则为准
+        // selector为空时匹配全部调用点；"file.cpp"匹配以该路径结尾的文件；"file.cpp:42"另外要求行号相同
+        void setCallSiteEnabled(const std::string& selector, bool enabled);
+        void setCallSiteSampling(const std::string& selector, uint32_t one_in_n);
+        void setCallSiteRateLimit(const std::string& selector, double per_second, uint32_t burst);
+        
+        // 清除全部调用点规则并恢复调用点的默认状态
+        void clearCallSiteRules();
+        
+        // 被调用点规则拦截的日志总数
+        uint64_t suppressedCount() const;
+        
     private:
-        LogManager() = default;
+        LogManager();
         class Impl;
         std::unique_ptr<Impl> pImpl_;
     };
     
-    // 便利宏
+    // 便利宏：编译期检查格式串与参数个数（格式串必须是字符串字面量），
+    // 每处展开生成一个静态调用点，记录__FILE__、__LINE__与__func__；级别和调用点规则在参数求值前检查
+    #define SDK_LOG_AT(logger, level, enabled, ...) \
+        do { \
+            SDK_LOG_CHECK_FORMAT(__VA_ARGS__); \
+            static ::sdk::LogCallSite sdk_log_site_{level, __FILE__, __LINE__, __func__, \
+                                                    SDK_LOG_EXPAND(SDK_LOG_FORMAT_STRING(__VA_ARGS__, 0))}; \
+            if ((logger)->enabled() && sdk_log_site_.shouldLog()) (logger)->logSite(sdk_log_site_, __VA_ARGS__); \
+        } while (0)
+    
     #define SDK_LOG_TRACE(logger, ...) \
-        if (logger->isTraceEnabled()) logger->trace(__VA_ARGS__)
+        SDK_LOG_AT(logger, ::sdk::LogLevel::TRACE, isTraceEnabled, __VA_ARGS__)
     
     #define SDK_LOG_DEBUG(logger, ...) \
-        if (logger->isDebugEnabled()) logger->debug(__VA_ARGS__)
+        SDK_LOG_AT(logger, ::sdk::LogLevel::DEBUG, isDebugEnabled, __VA_ARGS__)
     
     #define SDK_LOG_INFO(logger, ...) \
-        if (logger->isInfoEnabled()) logger->info(__VA_ARGS__)
+        SDK_LOG_AT(logger, ::sdk::LogLevel::INFO, isInfoEnabled, __VA_ARGS__)
     
     #define SDK_LOG_WARN(logger, ...) \
-        if (logger->isWarnEnabled()) logger->warn(__VA_ARGS__)
+        SDK_LOG_AT(logger, ::sdk::LogLevel::WARN, isWarnEnabled, __VA_ARGS__)
     
     #define SDK_LOG_ERROR(logger, ...) \
-        if (logger->isErrorEnabled()) logger->error(__VA_ARGS__)
+        SDK_LOG_AT(logger, ::sdk::LogLevel::ERROR, isErrorEnabled, __VA_ARGS__)
     
     #define SDK_LOG_CRITICAL(logger, ...) \
-        if (logger->isCriticalEnabled()) logger->critical(__VA_ARGS__)
+        SDK_LOG_AT(logger, ::sdk::LogLevel::CRITICAL, isCriticalEnabled, __VA_ARGS__)
     
     // 全局日志器便利函数
     namespace log {
@@ -315,71 +605,63 @@ namespace sdk {
     
     // 模板实现
     template<typename... Args>
-    std::string Logger::formatMessage(const std::string& format, Args&&... args) {
-        if constexpr (sizeof...(args) == 0) {
-            return format;
-        } else {
-            std::ostringstream oss;
-            // 简单的格式化实现，实际项目中可以使用fmt库
-            oss << format;
-            ((oss << " " << args), ...);
-            return oss.str();
-        }
-    }
-    
-    template<typename... Args>
-    void Logger::trace(const std::string& format, Args&&... args) {
+    void Logger::trace(LogFormat format, const Args&... args) {
         if (isTraceEnabled()) {
-            log(LogLevel::TRACE, formatMessage(format, std::forward<Args>(args)...));
+            logFormat(LogLevel::TRACE, format, LogArgs::capture(args...));
         }
     }
     
     template<typename... Args>
-    void Logger::debug(const std::string& format, Args&&... args) {
+    void Logger::debug(LogFormat format, const Args&... args) {
         if (isDebugEnabled()) {
-            log(LogLevel::DEBUG, formatMessage(format, std::forward<Args>(args)...));
+            logFormat(LogLevel::DEBUG, format, LogArgs::capture(args...));
         }
     }
     
     template<typename... Args>
-    void Logger::info(const std::string& format, Args&&... args) {
+    void Logger::info(LogFormat format, const Args&... args) {
         if (isInfoEnabled()) {
-            log(LogLevel::INFO, formatMessage(format, std::forward<Args>(args)...));
+            logFormat(LogLevel::INFO, format, LogArgs::capture(args...));
         }
     }
     
     template<typename... Args>
-    void Logger::warn(const std::string& format, Args&&... args) {
+    void Logger::warn(LogFormat format, const Args&... args) {
         if (isWarnEnabled()) {
-            log(LogLevel::WARN, formatMessage(format, std::forward<Args>(args)...));
+            logFormat(LogLevel::WARN, format, LogArgs::capture(args...));
         }
     }
     
     template<typename... Args>
-    void Logger::error(const std::string& format, Args&&... args) {
+    void Logger::error(LogFormat format, const Args&... args) {
         if (isErrorEnabled()) {
-            log(LogLevel::ERROR, formatMessage(format, std::forward<Args>(args)...));
+            logFormat(LogLevel::ERROR, format, LogArgs::capture(args...));
         }
     }
     
     template<typename... Args>
-    void Logger::critical(const std::string& format, Args&&... args) {
+    void Logger::critical(LogFormat format, const Args&... args) {
         if (isCriticalEnabled()) {
-            log(LogLevel::CRITICAL, formatMessage(format, std::forward<Args>(args)...));
+            logFormat(LogLevel::CRITICAL, format, LogArgs::capture(args...));
         }
     }
     
     template<typename... Args>
-    void Logger::log(LogLevel level, const std::string& format, Args&&... args) {
-        if (level >= level_) {
-            log(level, formatMessage(format, std::forward<Args>(args)...));
+    void Logger::log(LogLevel level, LogFormat format, const Args&... args) {
+        if (isLevelEnabled(level)) {
+            logFormat(level, format, LogArgs::capture(args...));
         }
     }
     
     template<typename... Args>
-    void Logger::log_if(bool condition, LogLevel level, const std::string& format, Args&&... args) {
-        if (condition && level >= level_) {
-            log(level, formatMessage(format, std::forward<Args>(args)...));
+    void Logger::logSite(LogCallSite& site, const char*, const Args&... args) {
+        logAt(site, LogArgs::capture(args...));
+    }
+    
+    template<typename... Args>
+    void Logger::log_if(bool condition, LogLevel level, LogFormat format, const Args&... args) {
+        if (condition && isLevelEnabled(level)) {
+            logFormat(level, format, LogArgs::capture(args...));
         }
     }
 }
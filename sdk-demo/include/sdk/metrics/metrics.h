@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sdk {
+
+    // 内置直方图的登记名称
+    namespace metric_names {
+        constexpr const char* kThreadPoolQueueWait = "thread_pool.queue_wait";
+        constexpr const char* kThreadPoolRunTime = "thread_pool.run_time";
+        constexpr const char* kHttpDns = "http.dns";
+        constexpr const char* kHttpConnect = "http.connect";
+        constexpr const char* kHttpTls = "http.tls";
+        constexpr const char* kHttpTtfb = "http.ttfb";
+        constexpr const char* kHttpTotal = "http.total";
+        constexpr const char* kLogEnqueue = "log.enqueue";
+    }
+
+    // 计数器与直方图的分片数，线程按首次使用的顺序轮流分配到各分片
+    constexpr size_t kMetricsShards = 16;
+
+    namespace detail {
+        size_t metricsShardIndex();
+    }
+
+    // 延迟摘要（微秒）
+    struct LatencySummary {
+        uint64_t count = 0;
+        double mean_us = 0.0;
+        uint64_t p50_us = 0;
+        uint64_t p90_us = 0;
+        uint64_t p99_us = 0;
+        uint64_t p999_us = 0;
+        uint64_t max_us = 0;
+    };
+
+    // 直方图快照：分桶计数可以直接相加合并；分位数取所在桶的上界，相对误差不超过1/32
+    struct HistogramSnapshot {
+        uint64_t count = 0;
+        uint64_t sum_us = 0;
+        uint64_t max_us = 0;
+        std::vector<uint64_t> buckets;
+
+        void merge(const HistogramSnapshot& other);
+
+        // q取值[0, 1]，没有样本时返回0
+        uint64_t percentile(double q) const;
+        double mean() const;
+        LatencySummary summary() const;
+    };
+
+    // 微秒精度的对数-线性直方图（HDR风格）：小于32us的值精确记录，之后每个2的幂区间分为32个桶，
+    // 超过kMaxValueUs的值记入最后一个桶。记录只有几次relaxed原子加，分片在线程首次写入时分配
+    class LatencyHistogram {
+    public:
+        static constexpr unsigned kSubBucketBits = 5;
+        static constexpr size_t kSubBucketCount = size_t(1) << kSubBucketBits;
+        static constexpr unsigned kMaxValueBits = 36;   // 约19小时
+        static constexpr uint64_t kMaxValueUs = (uint64_t(1) << kMaxValueBits) - 1;
+        static constexpr size_t kBucketCount = (kMaxValueBits - kSubBucketBits + 1) * kSubBucketCount;
+
+        LatencyHistogram() = default;
+        ~LatencyHistogram();
+
+        LatencyHistogram(const LatencyHistogram&) = delete;
+        LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+        void recordMicros(uint64_t micros);
+
+        template<typename Rep, typename Period>
+        void record(std::chrono::duration<Rep, Period> duration) {
+            auto micros = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+            recordMicros(micros > 0 ? static_cast<uint64_t>(micros) : 0);
+        }
+
+        // 合并全部分片
+        HistogramSnapshot snapshot() const;
+
+        // 只读取各分片的计数与总和，不复制分桶
+        uint64_t count() const;
+        double meanMicros() const;
+
+        void reset();
+
+        static size_t bucketIndex(uint64_t micros);
+        static uint64_t bucketUpperBound(size_t index);
+
+    private:
+        struct Shard {
+            std::atomic<uint64_t> count;
+            std::atomic<uint64_t> sum;
+            std::atomic<uint64_t> max;
+            std::atomic<uint64_t> buckets[kBucketCount];
+        };
+
+        Shard& shard();
+
+        std::array<std::atomic<Shard*>, kMetricsShards> shards_{};
+    };
+
+    // 按线程分片的计数器：add只写本线程所在分片的缓存行，value合并全部分片
+    class ShardedCounter {
+    public:
+        ShardedCounter() = default;
+
+        ShardedCounter(const ShardedCounter&) = delete;
+        ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+        void add(uint64_t value = 1) {
+            cells_[detail::metricsShardIndex()].value.fetch_add(value, std::memory_order_relaxed);
+        }
+
+        uint64_t value() const;
+        void reset();
+
+    private:
+        struct alignas(64) Cell {
+            std::atomic<uint64_t> value{0};
+        };
+        std::array<Cell, kMetricsShards> cells_;
+    };
+
+    // 直方图登记表：组件创建自己的直方图并按名称登记，同名的多个实例（例如多个线程池）在快照时合并。
+    // 登记表只持有弱引用，实例销毁后自动移除
+    class MetricsRegistry {
+    public:
+        static MetricsRegistry& getInstance();
+
+        std::shared_ptr<LatencyHistogram> createHistogram(const std::string& name);
+
+        // 合并指定名称下仍存活的全部实例，名称不存在时返回false
+        bool snapshot(const std::string& name, HistogramSnapshot& snapshot) const;
+
+        // 按名称排序的全部直方图
+        std::vector<std::pair<std::string, HistogramSnapshot>> snapshotAll() const;
+
+    private:
+        MetricsRegistry() = default;
+
+        mutable std::mutex mutex_;
+        std::map<std::string, std::vector<std::weak_ptr<LatencyHistogram>>> histograms_;
+    };
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "sdk/metrics/metrics.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sdk {
+
+    class ThreadPool;
+    class HttpClient;
+
+    // 一次采样的全部指标；直方图以微秒摘要保存，编码时换算为秒
+    struct MetricsSnapshot {
+        int64_t timestamp_ms = 0;
+        std::vector<std::pair<std::string, double>> gauges;
+        std::vector<std::pair<std::string, double>> counters;
+        std::vector<std::pair<std::string, LatencySummary>> summaries;
+    };
+
+    // 指标上报配置
+    struct MetricsReporterOptions {
+        // 推送目标，为空时只在本地采样；请求体为带时间戳的Prometheus文本格式，
+        // 接收端需要支持导入带时间戳的样本（例如VictoriaMetrics的/api/v1/import/prometheus）
+        std::string endpoint;
+
+        // 采样周期；攒够batch_size个快照才推送一次，未推送的快照最多保留max_pending个，超出时丢弃最旧的
+        std::chrono::milliseconds interval{10000};
+        size_t batch_size = 6;
+        size_t max_pending = 60;
+
+        // 附加到每个序列上的标签，例如设备或应用版本
+        std::map<std::string, std::string> labels;
+
+        // 本地拉取端点：在127.0.0.1:listen_port上提供GET /metrics，端口为0时由系统分配
+        bool listen = false;
+        uint16_t listen_port = 9464;
+    };
+
+    // 指标上报器：在线程池的定时任务中采样线程池、HTTP客户端、直方图登记表与进程指标，
+    // 通过HTTP客户端异步推送，不占用业务线程；同一时刻最多只有一个推送请求
+    class MetricsReporter {
+    public:
+        struct Stats {
+            size_t samples = 0;          // 采样次数
+            size_t pushes = 0;           // 成功的推送请求数
+            size_t push_failures = 0;    // 失败的推送请求数
+            size_t dropped_samples = 0;  // 因积压超过max_pending而丢弃的快照数
+            size_t scrapes = 0;          // 本地拉取次数
+        };
+
+        // pool用于定时采样，必须非空；client为空时不推送
+        MetricsReporter(const MetricsReporterOptions& options, std::shared_ptr<ThreadPool> pool,
+                        std::shared_ptr<HttpClient> client);
+        ~MetricsReporter();
+
+        MetricsReporter(const MetricsReporter&) = delete;
+        MetricsReporter& operator=(const MetricsReporter&) = delete;
+
+        // 立即采样一次，达到批量时推送
+        void sampleNow();
+
+        // 本地拉取端点实际监听的端口，未监听时返回0
+        uint16_t listenPort() const;
+
+        Stats getStats() const;
+
+        // 采样当前指标，pool与client可以为空；CPU占用的采样区间在全部直接调用方之间共享，
+        // 与各上报器自己的采样区间互不影响
+        static MetricsSnapshot collect(const ThreadPool* pool, const HttpClient* client);
+
+        // Prometheus文本格式；with_timestamp为true时每个样本附带毫秒时间戳
+        static std::string encode(const MetricsSnapshot& snapshot, const std::map<std::string, std::string>& labels,
+                                  bool with_timestamp);
+
+    private:
+        class CpuSampler;
+        static MetricsSnapshot collect(const ThreadPool* pool, const HttpClient* client, CpuSampler& cpu);
+
+        class Impl;
+        std::shared_ptr<Impl> pImpl_;
+    };
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace sdk {
+
+    namespace detail {
+        extern std::atomic<bool> g_tracing_enabled;
+    }
+
+    // 一条追踪事件；名称、类别与参数名必须是静态字符串，记录时只保存指针
+    struct TraceEvent {
+        const char* category = nullptr;
+        const char* name = nullptr;
+        const char* arg_name = nullptr;
+        int64_t arg_value = 0;
+        uint64_t timestamp_ns = 0;
+        uint64_t duration_ns = 0;   // 仅完整事件('X')使用
+        uint64_t id = 0;            // 异步事件('b'/'e')的配对ID
+        char phase = 'X';
+    };
+
+    // 进程级追踪器：每个线程写自己的缓冲区，记录路径无锁、不分配内存（每512条事件分配一个块）；
+    // 未开启时每个埋点只有一次relaxed原子读
+    class Tracer {
+    public:
+        static Tracer& getInstance();
+
+        static bool isEnabled() {
+            return detail::g_tracing_enabled.load(std::memory_order_relaxed);
+        }
+
+        // 开始新的会话并丢弃上一次会话的事件；每个线程最多保留max_events_per_thread条，超出的计入丢弃数
+        void start(size_t max_events_per_thread = 65536);
+        // 停止记录，已记录的事件保留到下一次start()
+        void stop();
+
+        // 导出为Chrome trace JSON，可用chrome://tracing或Perfetto UI打开
+        std::string toChromeTraceJson() const;
+        bool writeChromeTrace(const std::string& path) const;
+
+        // 当前会话中的事件数与丢弃数
+        size_t eventCount() const;
+        size_t droppedEvents() const;
+
+        // 追踪时间基准：steady_clock纳秒
+        static uint64_t now() {
+            return toNanos(std::chrono::steady_clock::now());
+        }
+        static uint64_t toNanos(std::chrono::steady_clock::time_point time) {
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+        }
+
+        // 异步事件的配对ID，进程内唯一
+        static uint64_t nextId();
+
+        // 以下记录函数不检查开关，调用方应先判断isEnabled()
+        static void record(const TraceEvent& event);
+        static void recordComplete(const char* category, const char* name, uint64_t start_ns, uint64_t end_ns,
+                                   const char* arg_name = nullptr, int64_t arg_value = 0);
+        // 开始与结束可以在不同线程上，按(category, name, id)配对
+        static void recordAsyncBegin(const char* category, const char* name, uint64_t id, uint64_t timestamp_ns);
+        static void recordAsyncEnd(const char* category, const char* name, uint64_t id, uint64_t timestamp_ns);
+
+    private:
+        Tracer() = default;
+    };
+
+    // RAII区间：构造时开启追踪才记录开始时间，析构时写入一条完整事件
+    class TraceSpan {
+    public:
+        TraceSpan(const char* category, const char* name)
+            : category_(category), name_(name), start_ns_(Tracer::isEnabled() ? Tracer::now() : 0) {}
+
+        ~TraceSpan() {
+            if (start_ns_ != 0) {
+                Tracer::recordComplete(category_, name_, start_ns_, Tracer::now(), arg_name_, arg_value_);
+            }
+        }
+
+        TraceSpan(const TraceSpan&) = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+
+        // 附加一个整数参数，例如状态码或字节数
+        void setArg(const char* name, int64_t value) {
+            arg_name_ = name;
+            arg_value_ = value;
+        }
+
+        // 放弃本区间，例如没有做任何事情的空批次
+        void cancel() {
+            start_ns_ = 0;
+        }
+
+    private:
+        const char* category_;
+        const char* name_;
+        const char* arg_name_ = nullptr;
+        int64_t arg_value_ = 0;
+        uint64_t start_ns_;
+    };
+}
+
+// 定义SDK_DISABLE_TRACING时SDK_TRACE_SPAN在编译期移除
+#define SDK_TRACE_CONCAT_IMPL(a, b) a##b
+#define SDK_TRACE_CONCAT(a, b) SDK_TRACE_CONCAT_IMPL(a, b)
+
+#ifndef SDK_DISABLE_TRACING
+    #define SDK_TRACE_SPAN(category, name) \
+        ::sdk::TraceSpan SDK_TRACE_CONCAT(sdk_trace_span_, __LINE__)(category, name)
+#else
+    #define SDK_TRACE_SPAN(category, name) ((void)0)
+#endif
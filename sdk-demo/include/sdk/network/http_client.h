@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 #include <memory>
@@ -8,8 +10,12 @@
 #include <chrono>
 #include <functional>
 
+#include "sdk/metrics/metrics.h"
+
 namespace sdk {
     
+    class ThreadPool;
+    
     // HTTP方法
     enum class HttpMethod {
         GET,
@@ -38,6 +44,15 @@ namespace sdk {
     // HTTP头部类型
     using HttpHeaders = std::unordered_map<std::string, std::string>;
     
+    // 传输进度：下载时为已接收/总字节数，上传时为已发送/总字节数，总数未知时为0
+    using ProgressCallback = std::function<void(size_t transferred, size_t total)>;
+    
+    // 响应体分块回调：每收到一块数据调用一次，返回false中止请求；设置后响应体不再保存在HttpResponse中
+    using BodyChunkCallback = std::function<bool(const char* data, size_t size)>;
+    
+    // 请求体读取回调：最多写入size字节到buffer，返回实际字节数，返回0表示结束
+    using BodyReader = std::function<size_t(char* buffer, size_t size)>;
+    
     // HTTP请求类
     class HttpRequest {
     public:
@@ -56,8 +71,24 @@ namespace sdk {
         
         // 设置请求体
         HttpRequest& setBody(const std::string& body);
+        HttpRequest& setBody(std::string&& body);
         HttpRequest& setBody(const std::vector<uint8_t>& body);
         
+        // 零拷贝请求体：只保存视图，调用方保证数据在请求完成前有效
+        HttpRequest& setBodyView(std::string_view body);
+        
+        // 流式请求体：发送时按需调用reader读取，content_length未知时传-1（使用分块传输编码）
+        HttpRequest& setBodyReader(BodyReader reader, int64_t content_length = -1);
+        
+        // multipart/form-data上传文件，文件内容在发送时直接从磁盘读取
+        HttpRequest& setUploadFile(const std::string& field_name, const std::string& file_path);
+        
+        // 流式接收响应体
+        HttpRequest& setResponseSink(BodyChunkCallback sink);
+        
+        // 传输进度回调
+        HttpRequest& setProgressCallback(ProgressCallback progress);
+        
         // 设置超时
         HttpRequest& setTimeout(std::chrono::milliseconds timeout);
         
@@ -79,14 +110,26 @@ namespace sdk {
         HttpMethod getMethod() const { return method_; }
         const HttpHeaders& getHeaders() const { return headers_; }
         const std::string& getBody() const { return body_; }
+        std::string_view getBodyView() const { return body_is_view_ ? body_view_ : std::string_view(body_); }
         std::chrono::milliseconds getTimeout() const { return timeout_; }
         
     private:
+        void clearBody();
+        
         std::string url_;
         HttpMethod method_ = HttpMethod::GET;
         HttpHeaders headers_;
         std::string body_;
+        std::string_view body_view_;
+        bool body_is_view_ = false;
+        BodyReader body_reader_;
+        int64_t body_length_ = -1;
+        std::string upload_field_;
+        std::string upload_file_;
+        BodyChunkCallback response_sink_;
+        ProgressCallback progress_;
         std::chrono::milliseconds timeout_{30000};  // 30秒默认超时
+        bool timeout_set_ = false;                   // 未设置时使用客户端的default_timeout
         std::string user_agent_;
         std::string proxy_url_;
         bool verify_ssl_ = true;
@@ -135,6 +178,14 @@ namespace sdk {
         friend class HttpClient;
     };
     
+    // HTTP协议版本
+    enum class HttpVersion {
+        HTTP_1_1,
+        HTTP_2_TLS,              // HTTPS通过ALPN协商HTTP/2，明文HTTP使用HTTP/1.1
+        HTTP_2,                  // HTTPS通过ALPN协商，明文HTTP尝试Upgrade: h2c
+        HTTP_2_PRIOR_KNOWLEDGE   // 明文HTTP直接使用HTTP/2（服务端必须支持h2c）
+    };
+    
     // HTTP客户端配置
     struct HttpClientConfig {
         std::string user_agent = "CrossPlatformSDK/1.0.0";
@@ -143,14 +194,59 @@ namespace sdk {
         int max_redirects = 5;
         bool verify_ssl = true;
         std::string ca_cert_path;
-        size_t max_concurrent_requests = 10;
+        size_t max_concurrent_requests = 10;     // 同时进行的异步请求上限，0表示不限制
         bool enable_compression = true;
         bool enable_cookies = false;
         std::string proxy_url;
+        
+        // 句柄池：请求结束后easy句柄按主机缓存复用，每个主机最多保留max_idle_handles_per_host个，
+        // 空闲超过handle_idle_timeout的句柄在下次归还时释放
+        size_t max_idle_handles_per_host = 8;
+        std::chrono::milliseconds handle_idle_timeout{60000};
+        
+        // 所有句柄共享DNS缓存、TLS会话缓存和连接缓存
+        bool share_connections = true;
+        std::chrono::seconds dns_cache_timeout{60};
+        
+        // TCP keepalive，保持空闲连接不被中间设备回收
+        bool tcp_keepalive = true;
+        std::chrono::seconds keepalive_idle{60};
+        std::chrono::seconds keepalive_interval{30};
+        
+        // HTTP/2：异步请求在同一连接上多路复用，每个连接最多max_streams_per_connection个并发流；
+        // max_connections_per_host限制每个主机的连接数，0表示不限制，超出的请求在libcurl内排队。
+        // share_connections开启时已建立的HTTP/2连接总会被复用，enable_multiplexing只影响新连接的建立
+        HttpVersion http_version = HttpVersion::HTTP_2_TLS;
+        bool enable_multiplexing = true;
+        size_t max_streams_per_connection = 100;
+        size_t max_connections_per_host = 0;
+        
+        // 响应缓存：缓存GET的200响应，遵循Cache-Control/Expires；过期后用If-None-Match/If-Modified-Since
+        // 重新验证，304时复用缓存的正文。内存层按LRU淘汰，总大小不超过cache_memory_budget字节
+        bool enable_cache = false;
+        size_t cache_memory_budget = 16 * 1024 * 1024;
+        
+        // 磁盘层：cache_directory为空时使用PlatformUtils::getApplicationDataPath()下的sdk/http_cache
+        bool cache_on_disk = false;
+        std::string cache_directory;
+        size_t cache_disk_budget = 256 * 1024 * 1024;
+        
+        // 请求合并：方法、URL和请求头都相同的并发GET/HEAD只发送一次，所有调用方共享同一响应
+        bool coalesce_requests = true;
+        
+        // 重试：幂等请求遇到网络错误或408/429/5xx时最多重试max_retries次，第n次重试前等待
+        // [0, min(retry_max_delay, retry_base_delay × 2^(n-1))]内的随机时长。异步请求由反应器计时，不占用线程
+        size_t max_retries = 0;
+        std::chrono::milliseconds retry_base_delay{100};
+        std::chrono::milliseconds retry_max_delay{5000};
+        
+        // 对冲：GET超过阈值仍未完成时再发一个相同请求，先成功者为准；
+        // 阈值取最近成功请求耗时的p95，不低于hedge_min_delay，积累足够样本前不对冲
+        bool enable_hedging = false;
+        std::chrono::milliseconds hedge_min_delay{20};
     };
     
     // 请求回调类型
-    using ProgressCallback = std::function<void(size_t downloaded, size_t total)>;
     using ResponseCallback = std::function<void(const HttpResponse&)>;
     
     // HTTP客户端类
@@ -182,9 +278,12 @@ namespace sdk {
         std::future<HttpResponse> deleteAsync(const std::string& url);
         std::future<HttpResponse> requestAsync(const HttpRequest& request);
         
-        // 带回调的异步请求
+        // 带回调的异步请求，回调在setCallbackPool()设置的线程池中执行
         void requestAsync(const HttpRequest& request, ResponseCallback callback);
         
+        // 异步请求回调的执行线程池，未设置时回调在反应器线程上执行（不应阻塞）
+        void setCallbackPool(std::shared_ptr<ThreadPool> pool);
+        
         // 文件下载
         HttpResponse downloadFile(const std::string& url, const std::string& file_path);
         std::future<HttpResponse> downloadFileAsync(const std::string& url, 
@@ -201,18 +300,21 @@ namespace sdk {
         
         // 配置管理
         void setConfig(const HttpClientConfig& config);
-        const HttpClientConfig& getConfig() const;
+        // 返回当前配置的副本，可以与setConfig并发调用
+        HttpClientConfig getConfig() const;
         
         // 设置全局头部
         void setGlobalHeader(const std::string& key, const std::string& value);
         void removeGlobalHeader(const std::string& key);
         void clearGlobalHeaders();
         
-        // 连接池管理
+        // 异步请求由单个反应器线程通过curl_multi驱动，超出并发上限的请求排队等待
         void setMaxConcurrentRequests(size_t max_requests);
+        
+        // 进行中和排队中的异步请求数
         size_t getActiveRequestCount() const;
         
-        // 取消所有请求
+        // 取消所有异步请求，它们以"Request cancelled"错误完成
         void cancelAllRequests();
         
         // 获取统计信息
@@ -222,9 +324,42 @@ namespace sdk {
             size_t failed_requests = 0;
             std::chrono::milliseconds total_time{0};
             std::chrono::milliseconds average_time{0};
+            
+            // 句柄池命中与新建次数
+            size_t handle_reuses = 0;
+            size_t handles_created = 0;
+            
+            // 复用已有连接（未建立新连接）的请求数
+            size_t connection_reuses = 0;
+            
+            // 新建的连接总数，以及以HTTP/2流完成的请求数
+            size_t connections_opened = 0;
+            size_t http2_requests = 0;
+            
+            // 响应缓存：未访问网络的命中、经304重新验证的命中、需要完整传输的请求
+            size_t cache_hits = 0;
+            size_t cache_revalidations = 0;
+            size_t cache_misses = 0;
+            
+            // 合并到已有请求的调用数、重试次数、发出的对冲副本数及副本先完成的次数
+            size_t coalesced_requests = 0;
+            size_t retries = 0;
+            size_t hedged_requests = 0;
+            size_t hedge_wins = 0;
+            
+            // 各阶段耗时分布（微秒）：DNS、TCP连接与TLS握手只统计新建连接的请求，
+            // 首字节时间与总耗时统计全部完成的网络请求
+            LatencySummary dns_latency;
+            LatencySummary connect_latency;
+            LatencySummary tls_latency;
+            LatencySummary ttfb_latency;
+            LatencySummary total_latency;
         };
         Stats getStats() const;
         
+        // 清空响应缓存（包括磁盘层）
+        void clearCache();
+        
     private:
         class Impl;
         std::unique_ptr<Impl> pImpl_;
@@ -232,9 +367,13 @@ namespace sdk {
     
     // 便利函数
     namespace http {
-        // 快速GET请求
+        // 快速GET请求，共用的客户端启用内存响应缓存
         inline HttpResponse get(const std::string& url) {
-            static HttpClient client;
+            static HttpClient client([] {
+                HttpClientConfig config;
+                config.enable_cache = true;
+                return config;
+            }());
             return client.get(url);
         }
         
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sdk {
+namespace platform {
+
+    // 只读内存映射文件：内容直接映射到进程地址空间，读取时不经过用户态缓冲区；
+    // 空文件视为打开成功、大小为0。只能移动，不能复制
+    class MappedFile {
+    public:
+        // 访问模式提示
+        enum class Access {
+            NORMAL,
+            SEQUENTIAL,
+            RANDOM,
+            WILL_NEED
+        };
+        
+        MappedFile() = default;
+        ~MappedFile();
+        
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        
+        bool open(const std::string& path);
+        void close();
+        
+        bool isOpen() const { return open_; }
+        const uint8_t* data() const { return data_; }
+        size_t size() const { return size_; }
+        std::string_view view() const {
+            return std::string_view(reinterpret_cast<const char*>(data_), size_);
+        }
+        
+        // madvise/PrefetchVirtualMemory，平台不支持时忽略
+        void advise(Access access) const;
+        
+    private:
+        const uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+        bool open_ = false;
+    };
+    
+    struct FileReaderOptions {
+        bool sequential = true;            // 提示内核加大预读
+        bool drop_cache_behind = false;    // 读过的部分从页缓存中释放，适合只读一遍的大文件
+    };
+    
+    // 分块读取：数据直接读入调用方提供的缓冲区，整个文件不会同时驻留内存
+    class FileReader {
+    public:
+        FileReader() = default;
+        ~FileReader();
+        
+        FileReader(FileReader&& other) noexcept;
+        FileReader& operator=(FileReader&& other) noexcept;
+        FileReader(const FileReader&) = delete;
+        FileReader& operator=(const FileReader&) = delete;
+        
+        bool open(const std::string& path, const FileReaderOptions& options = FileReaderOptions());
+        void close();
+        bool isOpen() const { return handle_ != -1; }
+        
+        // 读满size字节，只有到达文件末尾时才会少于size；返回0表示文件结束或出错
+        size_t read(void* buffer, size_t size);
+        bool seek(uint64_t offset);
+        uint64_t position() const { return position_; }
+        uint64_t size() const { return size_; }
+        
+    private:
+        intptr_t handle_ = -1;             // POSIX为文件描述符，Windows为HANDLE
+        uint64_t position_ = 0;
+        uint64_t size_ = 0;
+        uint64_t dropped_ = 0;             // 该位置之前的页缓存已释放
+        FileReaderOptions options_;
+    };
+    
+    // 分块写入：数据由调用方按块提供，直接交给系统调用，不做额外缓冲
+    class FileWriter {
+    public:
+        FileWriter() = default;
+        ~FileWriter();
+        
+        FileWriter(FileWriter&& other) noexcept;
+        FileWriter& operator=(FileWriter&& other) noexcept;
+        FileWriter(const FileWriter&) = delete;
+        FileWriter& operator=(const FileWriter&) = delete;
+        
+        // append为false时截断已有文件
+        bool open(const std::string& path, bool append = false);
+        bool close();
+        bool isOpen() const { return handle_ != -1; }
+        
+        // 写入全部数据，内部处理部分写入与EINTR
+        bool write(const void* data, size_t size);
+        // 把已写入的数据落盘（fdatasync/FlushFileBuffers）
+        bool sync();
+        uint64_t bytesWritten() const { return bytes_written_; }
+        
+    private:
+        intptr_t handle_ = -1;
+        uint64_t bytes_written_ = 0;
+    };
+    
+    // 文件系统工具类
+    class FileSystem {
+    public:
+        // 路径操作
+        static std::string normalizePath(const std::string& path);
+        static std::string joinPath(const std::string& path1, const std::string& path2);
+        static std::string getParentPath(const std::string& path);
+        static std::string getFileName(const std::string& path);
+        static std::string getFileExtension(const std::string& path);
+        static std::string getDirectoryName(const std::string& path);
+        static std::string getAbsolutePath(const std::string& path);
+        
+        // 当前工作目录
+        static std::string getCurrentDirectory();
+        static bool setCurrentDirectory(const std::string& path);
+        
+        // 文件/目录检查
+        static bool exists(const std::string& path);
+        static bool isFile(const std::string& path);
+        static bool isDirectory(const std::string& path);
+        static uint64_t getFileSize(const std::string& path);
+        static std::chrono::system_clock::time_point getLastModifiedTime(const std::string& path);
+        
+        // 文件/目录操作
+        static bool createDirectory(const std::string& path);
+        static bool createDirectories(const std::string& path);
+        static bool removeFile(const std::string& path);
+        static bool removeDirectory(const std::string& path);
+        // 优先使用内核内复制或写时复制（copy_file_range/sendfile、CopyFileEx、clonefile），不经过用户态缓冲区
+        static bool copyFile(const std::string& src, const std::string& dst);
+        static bool moveFile(const std::string& src, const std::string& dst);
+        
+        // 文件内容操作
+        static std::string readTextFile(const std::string& path);
+        static std::vector<uint8_t> readBinaryFile(const std::string& path);
+        // 从offset处读取最多size字节到调用方提供的缓冲区，返回实际读取的字节数
+        static size_t readInto(const std::string& path, void* buffer, size_t size, uint64_t offset = 0);
+        static bool writeTextFile(const std::string& path, const std::string& content);
+        static bool writeBinaryFile(const std::string& path, const std::vector<uint8_t>& data);
+        
+        // 目录遍历
+        static std::vector<std::string> listDirectory(const std::string& path);
+        static std::vector<std::string> findFiles(const std::string& path, const std::string& pattern);
+        
+        // 临时文件
+        static std::string createTempFile();
+        static std::string createTempDirectory();
+        
+        // 权限操作
+        static bool setFilePermissions(const std::string& path, uint32_t permissions);
+        static uint32_t getFilePermissions(const std::string& path);
+        
+    private:
+        FileSystem() = delete;
+    };
+
+}} // namespace sdk::platform
@@ -5,6 +5,8 @@
 #include <chrono>
 #include <cstdint>
 
+#include "sdk/platform/file_system.h"
+
 namespace sdk {
 namespace platform {
     
@@ -83,6 +85,11 @@ namespace platform {
         
         // CPU信息
         static uint32_t getCpuCoreCount();
+        
+        // 本进程累计占用的CPU时间（用户态+内核态，微秒），调用方自行保存上一次采样计算区间占用
+        static uint64_t getProcessCpuTimeUs();
+        
+        // 自上次调用以来本进程占用的CPU比例（0-100，按全部核心归一化），各调用方共享同一个采样区间
         static double getCpuUsage();
         
         // 网络信息
@@ -114,53 +121,6 @@ namespace platform {
         PlatformUtils() = delete;
     };
     
-    // 文件系统工具类
-    class FileSystem {
-    public:
-        // 路径操作
-        static std::string normalizePath(const std::string& path);
-        static std::string joinPath(const std::string& path1, const std::string& path2);
-        static std::string getParentPath(const std::string& path);
-        static std::string getFileName(const std::string& path);
-        static std::string getFileExtension(const std::string& path);
-        
-        // 文件/目录检查
-        static bool exists(const std::string& path);
-        static bool isFile(const std::string& path);
-        static bool isDirectory(const std::string& path);
-        static uint64_t getFileSize(const std::string& path);
-        static std::chrono::system_clock::time_point getLastModifiedTime(const std::string& path);
-        
-        // 文件/目录操作
-        static bool createDirectory(const std::string& path);
-        static bool createDirectories(const std::string& path);
-        static bool removeFile(const std::string& path);
-        static bool removeDirectory(const std::string& path);
-        static bool copyFile(const std::string& src, const std::string& dst);
-        static bool moveFile(const std::string& src, const std::string& dst);
-        
-        // 文件内容操作
-        static std::string readTextFile(const std::string& path);
-        static std::vector<uint8_t> readBinaryFile(const std::string& path);
-        static bool writeTextFile(const std::string& path, const std::string& content);
-        static bool writeBinaryFile(const std::string& path, const std::vector<uint8_t>& data);
-        
-        // 目录遍历
-        static std::vector<std::string> listDirectory(const std::string& path);
-        static std::vector<std::string> findFiles(const std::string& path, const std::string& pattern);
-        
-        // 临时文件
-        static std::string createTempFile();
-        static std::string createTempDirectory();
-        
-        // 权限操作
-        static bool setFilePermissions(const std::string& path, uint32_t permissions);
-        static uint32_t getFilePermissions(const std::string& path);
-        
-    private:
-        FileSystem() = delete;
-    };
-    
     // 网络工具类
     class NetworkUtils {
     public:
@@ -220,10 +180,31 @@ namespace platform {
         // 获取线程名称
         static std::string getCurrentThreadName();
         
-        // 线程亲和性（仅Linux/Windows）
+        // 线程QoS类别：Apple平台直接映射到系统QoS，其他平台映射到线程优先级
+        enum class QoS {
+            BACKGROUND,
+            UTILITY,
+            DEFAULT,
+            USER_INITIATED,
+            USER_INTERACTIVE
+        };
+        
+        // 设置当前线程QoS
+        static bool setCurrentThreadQoS(QoS qos);
+        
+        // 线程亲和性（仅Linux/Android/Windows）
         static bool setThreadAffinity(uint64_t cpu_mask);
         
-        // 获取当前线程的CPU使用率
+        // 将当前线程绑定到指定CPU集合，支持超过64个CPU（Windows上只使用第一个CPU所在的处理器组）
+        static bool setCurrentThreadAffinity(const std::vector<uint32_t>& cpus);
+        
+        // 获取当前线程所在的CPU编号，不支持时返回-1
+        static int getCurrentCpu();
+        
+        // 获取NUMA拓扑：每个元素为一个节点上的CPU编号列表，不支持NUMA的平台返回单个节点
+        static std::vector<std::vector<uint32_t>> getNumaNodes();
+        
+        // 获取当前线程的CPU使用率（百分比，相对于上一次调用）
         static double getCurrentThreadCpuUsage();
         
     private:
@@ -127,7 +127,8 @@ typedef enum {
     SDK_TASK_STATUS_RUNNING = 1,
     SDK_TASK_STATUS_COMPLETED = 2,
     SDK_TASK_STATUS_FAILED = 3,
-    SDK_TASK_STATUS_CANCELLED = 4
+    SDK_TASK_STATUS_CANCELLED = 4,
+    SDK_TASK_STATUS_UNKNOWN = 5      // 任务ID不存在或记录已被淘汰
 } sdk_task_status_t;
 
 // 任务信息
@@ -161,6 +162,15 @@ typedef void (*sdk_task_func_t)(void* user_data);
 // 任务完成回调类型
 typedef void (*sdk_task_callback_t)(sdk_task_id_t task_id, sdk_task_status_t status, void* user_data);
 
+// 并行循环的下标函数类型
+typedef void (*sdk_index_func_t)(uint64_t index, void* user_data);
+
+// 批量任务句柄（不透明类型）
+typedef struct sdk_task_batch sdk_task_batch_t;
+
+// 定时器ID类型
+typedef uint64_t sdk_timer_id_t;
+
 /**
  * 提交任务到线程池
  * @param func 任务函数
@@ -193,10 +203,89 @@ SDK_API sdk_task_id_t sdk_thread_pool_submit_task_with_id(
     sdk_task_callback_t callback
 );
 
+/**
+ * 定时提交任务：delay_ms之后投递到线程池，等待期间不占用工作线程
+ * @param func 任务函数
+ * @param user_data 用户数据
+ * @param delay_ms 延迟时间（毫秒），周期任务的首次触发时间为period_ms
+ * @param period_ms 触发周期（毫秒），0表示只执行一次
+ * @param priority 任务优先级
+ * @return 定时器ID，0表示失败
+ */
+SDK_API sdk_timer_id_t sdk_thread_pool_schedule_task(
+    sdk_task_func_t func,
+    void* user_data,
+    uint32_t delay_ms,
+    uint32_t period_ms,
+    sdk_task_priority_t priority
+);
+
+/**
+ * 取消定时器（已投递的任务不受影响）
+ * @param timer_id 定时器ID
+ * @return 是否成功取消
+ */
+SDK_API bool sdk_thread_pool_cancel_timer(sdk_timer_id_t timer_id);
+
+/**
+ * 批量提交任务：对user_data_array中每个元素调用一次func，整批只加一次队列锁
+ * @param func 任务函数
+ * @param user_data_array 每个子任务的用户数据
+ * @param count 子任务数量
+ * @param priority 任务优先级
+ * @return 批量任务句柄，NULL表示失败，需通过sdk_task_batch_release释放
+ */
+SDK_API sdk_task_batch_t* sdk_thread_pool_submit_batch(
+    sdk_task_func_t func,
+    void* const* user_data_array,
+    uint32_t count,
+    sdk_task_priority_t priority
+);
+
+/**
+ * 并行循环：把[begin, end)按grain切分为子任务，每个下标调用一次func
+ * @param begin 起始下标
+ * @param end 结束下标（不含）
+ * @param grain 每个子任务处理的下标数，0表示自动切分
+ * @param func 下标函数
+ * @param user_data 用户数据
+ * @param priority 任务优先级
+ * @return 批量任务句柄，NULL表示失败，需通过sdk_task_batch_release释放
+ */
+SDK_API sdk_task_batch_t* sdk_thread_pool_parallel_for(
+    uint64_t begin,
+    uint64_t end,
+    uint64_t grain,
+    sdk_index_func_t func,
+    void* user_data,
+    sdk_task_priority_t priority
+);
+
+/**
+ * 等待批量任务全部结束
+ * @param batch 批量任务句柄
+ * @param timeout_ms 超时时间（毫秒），0表示无限等待
+ * @return 是否在超时前结束
+ */
+SDK_API bool sdk_task_batch_wait(sdk_task_batch_t* batch, uint32_t timeout_ms);
+
+/**
+ * 获取批量任务中尚未结束的子任务数
+ * @param batch 批量任务句柄
+ * @return 未结束的子任务数
+ */
+SDK_API uint32_t sdk_task_batch_pending(const sdk_task_batch_t* batch);
+
+/**
+ * 释放批量任务句柄（不会取消尚未执行的子任务）
+ * @param batch 批量任务句柄
+ */
+SDK_API void sdk_task_batch_release(sdk_task_batch_t* batch);
+
 /**
  * 获取任务状态
  * @param task_id 任务ID
- * @return 任务状态
+ * @return 任务状态，找不到任务记录时返回SDK_TASK_STATUS_UNKNOWN
  */
 SDK_API sdk_task_status_t sdk_thread_pool_get_task_status(sdk_task_id_t task_id);
 
@@ -219,7 +308,7 @@ SDK_API bool sdk_thread_pool_cancel_task(sdk_task_id_t task_id);
  * 等待任务完成
  * @param task_id 任务ID
  * @param timeout_ms 超时时间（毫秒），0表示无限等待
- * @return true表示任务完成
+ * @return true表示任务完成；超时或找不到任务记录时返回false
  */
 SDK_API bool sdk_thread_pool_wait_task(sdk_task_id_t task_id, uint32_t timeout_ms);
 
@@ -406,6 +495,44 @@ SDK_API void sdk_log(sdk_log_level_t level, const char* format, ...);
 SDK_API void sdk_log_with_context(sdk_log_level_t level, const char* file, int line, 
                                  const char* func, const char* format, ...);
 
+/**
+ * 开关指定日志器
+ * @param logger_name 日志器名称，NULL表示默认日志器
+ * @param enabled 是否输出
+ * @return 成功返回true
+ */
+SDK_API bool sdk_log_set_logger_enabled(const char* logger_name, bool enabled);
+
+/**
+ * 开关匹配的日志调用点，在格式化参数之前生效
+ * @param selector "file.cpp"匹配以该路径结尾的文件，"file.cpp:42"另外匹配行号，NULL或空串匹配全部
+ * @param enabled 是否输出
+ * @return 成功返回true
+ */
+SDK_API bool sdk_log_set_site_enabled(const char* selector, bool enabled);
+
+/**
+ * 对匹配的日志调用点采样，每one_in_n条输出1条
+ * @param selector 调用点选择器，规则同sdk_log_set_site_enabled
+ * @param one_in_n 采样间隔，0或1表示取消采样
+ * @return 成功返回true
+ */
+SDK_API bool sdk_log_set_site_sampling(const char* selector, uint32_t one_in_n);
+
+/**
+ * 对匹配的日志调用点限流
+ * @param selector 调用点选择器，规则同sdk_log_set_site_enabled
+ * @param per_second 每秒最多输出条数，不大于0表示取消限流
+ * @param burst 允许的突发条数
+ * @return 成功返回true
+ */
+SDK_API bool sdk_log_set_site_rate_limit(const char* selector, double per_second, uint32_t burst);
+
+/**
+ * 清除全部调用点规则
+ */
+SDK_API void sdk_log_clear_site_rules(void);
+
 // 便利宏
 #define SDK_LOG_TRACE(fmt, ...) sdk_log_with_context(SDK_LOG_LEVEL_TRACE, __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
 #define SDK_LOG_DEBUG(fmt, ...) sdk_log_with_context(SDK_LOG_LEVEL_DEBUG, __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
@@ -414,6 +541,51 @@ SDK_API void sdk_log_with_context(sdk_log_level_t level, const char* file, int l
 #define SDK_LOG_ERROR(fmt, ...) sdk_log_with_context(SDK_LOG_LEVEL_ERROR, __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
 #define SDK_LOG_CRITICAL(fmt, ...) sdk_log_with_context(SDK_LOG_LEVEL_CRITICAL, __FILE__, __LINE__, __func__, fmt, ##__VA_ARGS__)
 
+// =============================================================================
+// 指标API
+// =============================================================================
+
+// 延迟摘要（微秒），分位数的相对误差不超过1/32
+typedef struct {
+    uint64_t count;
+    double mean_us;
+    uint64_t p50_us;
+    uint64_t p90_us;
+    uint64_t p99_us;
+    uint64_t p999_us;
+    uint64_t max_us;
+} sdk_latency_summary_t;
+
+/**
+ * 获取延迟直方图的摘要，同名的多个实例（例如多个HTTP客户端）合并计算
+ * @param name 直方图名称："thread_pool.queue_wait"、"thread_pool.run_time"、
+ *             "http.dns"、"http.connect"、"http.tls"、"http.ttfb"、"http.total"、"log.enqueue"
+ * @param summary 输出摘要
+ * @return 名称存在时返回true
+ */
+SDK_API bool sdk_metrics_get_latency(const char* name, sdk_latency_summary_t* summary);
+
+/**
+ * 以Prometheus文本格式导出当前的SDK与进程指标，可用于应用自己提供拉取端点
+ * @param buffer 输出缓冲区
+ * @param buffer_size 缓冲区大小，不足时截断到最后一个完整的行
+ * @return 实际写入的字符数
+ */
+SDK_API uint32_t sdk_metrics_export_text(char* buffer, uint32_t buffer_size);
+
+/**
+ * 开始追踪会话：记录线程池任务排队与执行、HTTP请求各阶段与异步日志写出的时间线，并丢弃上一次会话的事件
+ * @param max_events_per_thread 每个线程最多保留的事件数，为0时使用默认值65536
+ */
+SDK_API void sdk_trace_start(uint32_t max_events_per_thread);
+
+/**
+ * 停止追踪并把本次会话写为Chrome trace JSON，可用chrome://tracing或Perfetto UI打开
+ * @param file_path 输出文件路径，为NULL时只停止记录
+ * @return 停止成功且文件写入成功时返回true
+ */
+SDK_API bool sdk_trace_stop(const char* file_path);
+
 // =============================================================================
 // 错误处理API
 // =============================================================================
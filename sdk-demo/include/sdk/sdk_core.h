@@ -9,6 +9,7 @@ namespace sdk {
     class ThreadPool;
     class HttpClient;
     class Logger;
+    class MetricsReporter;
     
     // SDK配置结构
     struct SDKConfig {
@@ -19,6 +20,7 @@ namespace sdk {
         std::string user_agent = "CrossPlatformSDK/1.0.0";
         int connection_timeout_ms = 5000;
         int request_timeout_ms = 30000;
+        size_t max_concurrent_requests = 10;   // 同时进行的异步请求上限
         
         // 日志配置
         std::string log_level = "info";
@@ -27,9 +29,17 @@ namespace sdk {
         size_t max_log_file_size = 10 * 1024 * 1024;  // 10MB
         size_t max_log_files = 5;
         
-        // 其他配置
+        // 异步日志：输出端在spdlog线程池中写出，队列写满时调用线程等待
+        bool async_logging = false;
+        size_t async_log_queue_size = 8192;
+        size_t async_log_threads = 1;
+        
+        // 指标上报：metrics_endpoint非空时按周期采样并批量推送（Prometheus文本格式），
+        // metrics_listen_port大于0时在127.0.0.1上提供GET /metrics拉取端点
         bool enable_metrics = true;
         std::string metrics_endpoint = "";
+        int metrics_interval_ms = 10000;
+        int metrics_listen_port = 0;
     };
     
     // SDK初始化结果
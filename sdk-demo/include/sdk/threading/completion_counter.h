@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace sdk {
+
+    // 在途任务计数器：计数归零时唤醒等待者
+    // Linux/Android使用futex，Windows使用WaitOnAddress，其他平台退化为互斥锁+条件变量
+    // 没有等待者时add/done只有一次原子操作；计数归零后不再访问计数器之外的成员，
+    // 等待者被唤醒后可以立即销毁计数器
+    class CompletionCounter {
+    public:
+        CompletionCounter() = default;
+
+        CompletionCounter(const CompletionCounter&) = delete;
+        CompletionCounter& operator=(const CompletionCounter&) = delete;
+
+        void add(size_t count = 1) noexcept;
+
+        // 完成count个任务，计数归零时唤醒全部等待者
+        void done(size_t count = 1) noexcept;
+
+        size_t count() const noexcept;
+
+        // 等待计数归零
+        void wait() const;
+        bool waitFor(const std::chrono::milliseconds& timeout) const;
+
+    private:
+        // 最高位表示存在等待者，其余位为计数
+        static constexpr uint32_t kWaiterBit = 0x80000000u;
+        static constexpr uint32_t kCountMask = ~kWaiterBit;
+
+        bool waitUntil(const std::chrono::steady_clock::time_point* deadline) const;
+
+        mutable std::atomic<uint32_t> state_{0};
+
+        // 仅在没有地址等待原语的平台上使用
+        mutable std::mutex mutex_;
+        mutable std::condition_variable condition_;
+    };
+}
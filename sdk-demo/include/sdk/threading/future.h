@@ -0,0 +1,507 @@
+#pragma once
+
+#include "sdk/threading/thread_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace sdk {
+
+    template<typename T> class Future;
+    template<typename T> class Promise;
+
+    // whenAny的结果：最先就绪的下标以及全部输入（下标处的Future已就绪）
+    template<typename T>
+    struct WhenAnyResult {
+        size_t index = static_cast<size_t>(-1);
+        std::vector<Future<T>> futures;
+    };
+
+    namespace detail {
+        struct FutureAccess;
+
+        // Future/Promise共享状态中与结果类型无关的部分
+        class FutureStateBase {
+        public:
+            FutureStateBase() = default;
+            virtual ~FutureStateBase() = default;
+
+            FutureStateBase(const FutureStateBase&) = delete;
+            FutureStateBase& operator=(const FutureStateBase&) = delete;
+
+            bool isReady() const { return ready_.load(std::memory_order_acquire); }
+
+            void wait() const;
+            bool waitFor(const std::chrono::milliseconds& timeout) const;
+
+            // 注册完成回调：已就绪时在当前线程立即执行，否则由写入结果的线程执行
+            // 回调只应做投递任务这类轻量操作，不能抛出异常
+            void onReady(TaskFunction callback);
+
+            // 就绪后才能读取
+            const std::exception_ptr& error() const { return error_; }
+
+            void setException(std::exception_ptr error);
+
+            // 未写入结果时写入异常，已写入时返回false
+            bool trySetException(std::exception_ptr error) noexcept;
+
+        protected:
+            // 占用写入权：每个状态只能写入一次结果
+            bool claim() noexcept;
+
+            // 结果写入后发布就绪状态，执行已注册的回调
+            void publish() noexcept;
+
+            // 已占用写入权时以异常作为结果发布
+            void publishError(std::exception_ptr error) noexcept;
+
+        private:
+            mutable std::mutex mutex_;
+            mutable std::condition_variable condition_;
+            std::atomic<bool> ready_{false};
+            bool satisfied_ = false;
+            std::exception_ptr error_;
+            std::vector<TaskFunction> callbacks_;
+        };
+
+        template<typename T>
+        class FutureState : public FutureStateBase {
+        public:
+            template<typename U>
+            void setValue(U&& value) {
+                if (!claim()) {
+                    throw std::future_error(std::future_errc::promise_already_satisfied);
+                }
+                // 构造结果时抛出的异常也要发布，否则写入权已被占用，等待方永远不会就绪
+                try {
+                    value_.emplace(std::forward<U>(value));
+                } catch (...) {
+                    publishError(std::current_exception());
+                    throw;
+                }
+                publish();
+            }
+
+            // 取出结果，只能调用一次
+            T take() {
+                if constexpr (std::is_reference<T>::value) {
+                    return value_->get();
+                } else {
+                    return std::move(*value_);
+                }
+            }
+
+        private:
+            using Storage = typename std::conditional<std::is_reference<T>::value,
+                std::reference_wrapper<typename std::remove_reference<T>::type>, T>::type;
+
+            std::optional<Storage> value_;
+        };
+
+        template<>
+        class FutureState<void> : public FutureStateBase {
+        public:
+            void setValue() {
+                if (!claim()) {
+                    throw std::future_error(std::future_errc::promise_already_satisfied);
+                }
+                publish();
+            }
+
+            void take() {}
+        };
+
+        inline std::exception_ptr brokenPromise() {
+            return std::make_exception_ptr(std::future_error(std::future_errc::broken_promise));
+        }
+
+        // 调用fn并把返回值或异常写入out
+        template<typename R, typename F, typename... Args>
+        void fulfill(FutureState<R>& out, F& fn, Args&&... args) noexcept {
+            try {
+                if constexpr (std::is_void<R>::value) {
+                    fn(std::forward<Args>(args)...);
+                    out.setValue();
+                } else {
+                    out.setValue(fn(std::forward<Args>(args)...));
+                }
+            } catch (...) {
+                out.trySetException(std::current_exception());
+            }
+        }
+
+        // 延续的返回类型：前驱为void时调用f()，否则调用f(value)
+        template<typename T, typename F, typename = void>
+        struct ContinuationResult {
+            using type = typename std::invoke_result<F, T>::type;
+        };
+
+        template<typename F>
+        struct ContinuationResult<void, F> {
+            using type = typename std::invoke_result<F>::type;
+        };
+
+        // 写入结果的线程池任务：执行时调用body，未执行就被销毁（线程池关闭）时设置broken_promise
+        template<typename R, typename Body>
+        class PromiseTask {
+        public:
+            PromiseTask(std::shared_ptr<FutureState<R>> result, Body&& body)
+                : result_(std::move(result)), body_(std::move(body)) {}
+            PromiseTask(PromiseTask&& other) noexcept = default;
+            PromiseTask& operator=(PromiseTask&&) = delete;
+            PromiseTask(const PromiseTask&) = delete;
+
+            ~PromiseTask() {
+                if (result_) {
+                    result_->trySetException(brokenPromise());
+                }
+            }
+
+            void operator()() {
+                std::shared_ptr<FutureState<R>> result = std::move(result_);
+                body_(*result);
+            }
+
+        private:
+            std::shared_ptr<FutureState<R>> result_;
+            Body body_;
+        };
+
+        template<typename R, typename Body>
+        PromiseTask<R, Body> makePromiseTask(std::shared_ptr<FutureState<R>> result, Body&& body) {
+            return PromiseTask<R, Body>(std::move(result), std::move(body));
+        }
+
+        // 把任务投递到线程池；线程池已关闭时任务对象随异常销毁，结果为broken_promise
+        template<typename Task>
+        void postOrDrop(ThreadPool& pool, TaskPriority priority, Task&& task) noexcept {
+            try {
+                pool.post(priority, std::move(task));
+            } catch (...) {
+            }
+        }
+    }
+
+    // 可组合的异步结果
+    // 与std::future不同，结果就绪后通过then()注册的延续直接投递到线程池，不需要任何线程阻塞在get()上
+    template<typename T>
+    class Future {
+    public:
+        Future() = default;
+        Future(Future&&) noexcept = default;
+        Future& operator=(Future&&) noexcept = default;
+        Future(const Future&) = delete;
+        Future& operator=(const Future&) = delete;
+
+        bool valid() const { return state_ != nullptr; }
+
+        bool isReady() const { return state_ && state_->isReady(); }
+
+        void wait() const { checkValid(); state_->wait(); }
+
+        bool waitFor(const std::chrono::milliseconds& timeout) const {
+            checkValid();
+            return state_->waitFor(timeout);
+        }
+
+        // 等待并取出结果，异常结果重新抛出；调用后Future失效
+        T get() {
+            checkValid();
+            state_->wait();
+            auto state = std::move(state_);
+            if (state->error()) {
+                std::rethrow_exception(state->error());
+            }
+            return state->take();
+        }
+
+        // 结果就绪后把f投递到线程池执行，f的参数为前驱结果（前驱为void时无参数）
+        // 前驱失败时不调用f，异常直接传递给返回的Future；调用后当前Future失效
+        template<typename F>
+        auto then(ThreadPool& pool, F&& f, TaskPriority priority = TaskPriority::NORMAL)
+            -> Future<typename detail::ContinuationResult<T, typename std::decay<F>::type>::type> {
+            using Fn = typename std::decay<F>::type;
+            using R = typename detail::ContinuationResult<T, Fn>::type;
+
+            checkValid();
+            auto next = std::make_shared<detail::FutureState<R>>();
+            auto state = std::move(state_);
+            detail::FutureState<T>* antecedent = state.get();
+
+            antecedent->onReady([&pool, priority, state = std::move(state), next,
+                                 fn = Fn(std::forward<F>(f))]() mutable {
+                if (state->error()) {
+                    next->trySetException(state->error());
+                    return;
+                }
+                detail::postOrDrop(pool, priority, detail::makePromiseTask(next,
+                    [state = std::move(state), fn = std::move(fn)](detail::FutureState<R>& out) mutable {
+                        if constexpr (std::is_void<T>::value) {
+                            detail::fulfill(out, fn);
+                        } else {
+                            detail::fulfill(out, fn, state->take());
+                        }
+                    }));
+            });
+            return Future<R>(std::move(next));
+        }
+
+        // 结果就绪后在写入结果的线程上直接执行f，只适合轻量操作
+        template<typename F>
+        auto then(F&& f)
+            -> Future<typename detail::ContinuationResult<T, typename std::decay<F>::type>::type> {
+            using Fn = typename std::decay<F>::type;
+            using R = typename detail::ContinuationResult<T, Fn>::type;
+
+            checkValid();
+            auto next = std::make_shared<detail::FutureState<R>>();
+            auto state = std::move(state_);
+            detail::FutureState<T>* antecedent = state.get();
+
+            antecedent->onReady([state = std::move(state), next, fn = Fn(std::forward<F>(f))]() mutable {
+                if (state->error()) {
+                    next->trySetException(state->error());
+                } else if constexpr (std::is_void<T>::value) {
+                    detail::fulfill(*next, fn);
+                } else {
+                    detail::fulfill(*next, fn, state->take());
+                }
+            });
+            return Future<R>(std::move(next));
+        }
+
+    private:
+        template<typename> friend class Future;
+        friend struct detail::FutureAccess;
+
+        explicit Future(std::shared_ptr<detail::FutureState<T>> state) : state_(std::move(state)) {}
+
+        void checkValid() const {
+            if (!state_) {
+                throw std::future_error(std::future_errc::no_state);
+            }
+        }
+
+        std::shared_ptr<detail::FutureState<T>> state_;
+    };
+
+    namespace detail {
+        // 组合函数访问Future内部状态的入口
+        struct FutureAccess {
+            template<typename T>
+            static Future<T> make(std::shared_ptr<FutureState<T>> state) {
+                return Future<T>(std::move(state));
+            }
+
+            template<typename T>
+            static std::shared_ptr<FutureState<T>> state(const Future<T>& future) {
+                future.checkValid();
+                return future.state_;
+            }
+
+            template<typename T>
+            static std::shared_ptr<FutureState<T>> release(Future<T>& future) {
+                future.checkValid();
+                return std::move(future.state_);
+            }
+        };
+    }
+
+    // 结果的写入端，销毁时仍未写入结果则Future得到broken_promise
+    template<typename T>
+    class Promise {
+    public:
+        Promise() : state_(std::make_shared<detail::FutureState<T>>()) {}
+        Promise(Promise&&) noexcept = default;
+        Promise& operator=(Promise&& other) noexcept {
+            if (this != &other) {
+                abandon();
+                state_ = std::move(other.state_);
+                retrieved_ = other.retrieved_;
+            }
+            return *this;
+        }
+        Promise(const Promise&) = delete;
+        Promise& operator=(const Promise&) = delete;
+
+        ~Promise() {
+            abandon();
+        }
+
+        // 只能获取一次
+        Future<T> getFuture() {
+            if (!state_) {
+                throw std::future_error(std::future_errc::no_state);
+            }
+            if (retrieved_) {
+                throw std::future_error(std::future_errc::future_already_retrieved);
+            }
+            retrieved_ = true;
+            return detail::FutureAccess::make(state_);
+        }
+
+        template<typename U = T, typename = typename std::enable_if<!std::is_void<U>::value>::type>
+        void setValue(U&& value) {
+            checkState();
+            state_->setValue(std::forward<U>(value));
+        }
+
+        template<typename U = T, typename = typename std::enable_if<std::is_void<U>::value>::type>
+        void setValue() {
+            checkState();
+            state_->setValue();
+        }
+
+        void setException(std::exception_ptr error) {
+            checkState();
+            state_->setException(std::move(error));
+        }
+
+    private:
+        void checkState() const {
+            if (!state_) {
+                throw std::future_error(std::future_errc::no_state);
+            }
+        }
+
+        void abandon() noexcept {
+            if (state_) {
+                state_->trySetException(detail::brokenPromise());
+            }
+        }
+
+        std::shared_ptr<detail::FutureState<T>> state_;
+        bool retrieved_ = false;
+    };
+
+    // 在线程池上执行f，返回可组合的Future；不登记任务记录，开销与post()相同
+    template<typename F>
+    auto runAsync(ThreadPool& pool, F&& f, TaskPriority priority = TaskPriority::NORMAL)
+        -> Future<typename std::invoke_result<typename std::decay<F>::type>::type> {
+        using Fn = typename std::decay<F>::type;
+        using R = typename std::invoke_result<Fn>::type;
+
+        auto result = std::make_shared<detail::FutureState<R>>();
+        pool.post(priority, detail::makePromiseTask(result,
+            [fn = Fn(std::forward<F>(f))](detail::FutureState<R>& out) mutable {
+                detail::fulfill(out, fn);
+            }));
+        return detail::FutureAccess::make(std::move(result));
+    }
+
+    // 已就绪的Future
+    template<typename T>
+    Future<typename std::decay<T>::type> makeReadyFuture(T&& value) {
+        Promise<typename std::decay<T>::type> promise;
+        promise.setValue(std::forward<T>(value));
+        return promise.getFuture();
+    }
+
+    inline Future<void> makeReadyFuture() {
+        Promise<void> promise;
+        promise.setValue();
+        return promise.getFuture();
+    }
+
+    namespace detail {
+        // whenAll的聚合状态：全部输入就绪后按输入顺序交付结果，有失败时交付第一个异常
+        template<typename T>
+        struct WhenAllState {
+            explicit WhenAllState(size_t count) : remaining(count), inputs(count) {}
+
+            std::atomic<size_t> remaining;
+            std::vector<std::shared_ptr<FutureState<T>>> inputs;
+            std::shared_ptr<FutureState<std::vector<T>>> result = std::make_shared<FutureState<std::vector<T>>>();
+
+            void arrive() {
+                if (remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                    return;
+                }
+
+                std::vector<T> values;
+                values.reserve(inputs.size());
+                for (auto& input : inputs) {
+                    if (input->error()) {
+                        result->trySetException(input->error());
+                        return;
+                    }
+                    values.push_back(input->take());
+                }
+                result->setValue(std::move(values));
+            }
+        };
+
+        template<typename T>
+        struct WhenAnyState {
+            std::atomic<bool> done{false};
+            std::vector<Future<T>> futures;
+            std::shared_ptr<FutureState<WhenAnyResult<T>>> result =
+                std::make_shared<FutureState<WhenAnyResult<T>>>();
+        };
+    }
+
+    // 全部输入就绪后就绪，结果按输入顺序排列；任一输入失败时交付第一个失败输入的异常
+    template<typename T>
+    Future<std::vector<T>> whenAll(std::vector<Future<T>> futures) {
+        auto state = std::make_shared<detail::WhenAllState<T>>(futures.size());
+        Future<std::vector<T>> result = detail::FutureAccess::make(state->result);
+        if (futures.empty()) {
+            state->result->setValue(std::vector<T>());
+            return result;
+        }
+
+        for (size_t i = 0; i < futures.size(); ++i) {
+            state->inputs[i] = detail::FutureAccess::release(futures[i]);
+        }
+
+        // 先取出全部输入再注册回调，回调可能在注册时立即执行
+        for (size_t i = 0; i < state->inputs.size(); ++i) {
+            state->inputs[i]->onReady([state]() { state->arrive(); });
+        }
+        return result;
+    }
+
+    // 最先就绪的输入（成功或失败）决定结果，输入原样交还给调用方
+    template<typename T>
+    Future<WhenAnyResult<T>> whenAny(std::vector<Future<T>> futures) {
+        auto state = std::make_shared<detail::WhenAnyState<T>>();
+        Future<WhenAnyResult<T>> result = detail::FutureAccess::make(state->result);
+        if (futures.empty()) {
+            state->result->setValue(WhenAnyResult<T>());
+            return result;
+        }
+
+        std::vector<std::shared_ptr<detail::FutureState<T>>> inputs;
+        inputs.reserve(futures.size());
+        for (auto& future : futures) {
+            inputs.push_back(detail::FutureAccess::state(future));
+        }
+        state->futures = std::move(futures);
+
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            inputs[i]->onReady([state, i]() {
+                if (state->done.exchange(true, std::memory_order_acq_rel)) {
+                    return;
+                }
+                WhenAnyResult<T> any;
+                any.index = i;
+                any.futures = std::move(state->futures);
+                state->result->setValue(std::move(any));
+            });
+        }
+        return result;
+    }
+
+    // whenAll的void版本
+    Future<void> whenAll(std::vector<Future<void>> futures);
+}
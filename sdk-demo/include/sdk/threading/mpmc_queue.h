@@ -0,0 +1,226 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace sdk {
+
+    // 任务队列的存储方式
+    enum class QueueBackend {
+        PRIORITY_HEAP,  // 互斥锁保护的二叉堆，O(log n)
+        RING_BUFFER     // 每个优先级一个有界无锁环形队列，O(1)
+    };
+
+    // 环形队列写满时的处理方式
+    enum class QueueOverflowPolicy {
+        SPILL,          // 溢出到互斥锁保护的后备队列，不丢任务
+        REJECT,         // 拒绝入队
+        BLOCK           // 让出CPU直到有空位
+    };
+
+    // 有界多生产者多消费者环形队列（Dmitry Vyukov算法）
+    // 每个槽位带序号，入队和出队各自只CAS一次位置计数，元素直接在槽位中构造和移出
+    template<typename T>
+    class MpmcRingQueue {
+    public:
+        // 容量向上取整为2的幂
+        explicit MpmcRingQueue(size_t capacity)
+            : mask_(roundUp(capacity) - 1), cells_(new Cell[mask_ + 1]) {
+            for (size_t i = 0; i <= mask_; ++i) {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ~MpmcRingQueue() {
+            T value;
+            while (tryPop(value)) {
+            }
+        }
+
+        MpmcRingQueue(const MpmcRingQueue&) = delete;
+        MpmcRingQueue& operator=(const MpmcRingQueue&) = delete;
+
+        // 队列已满时返回false，value保持不变
+        bool tryPush(T&& value) {
+            Cell* cell;
+            size_t position = enqueue_pos_.load(std::memory_order_relaxed);
+            while (true) {
+                cell = &cells_[position & mask_];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+                if (diff == 0) {
+                    if (enqueue_pos_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    position = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            new (cell->storage) T(std::move(value));
+            cell->sequence.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        // 队列为空时返回false
+        bool tryPop(T& value) {
+            Cell* cell;
+            size_t position = dequeue_pos_.load(std::memory_order_relaxed);
+            while (true) {
+                cell = &cells_[position & mask_];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+                if (diff == 0) {
+                    if (dequeue_pos_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    position = dequeue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            T* stored = std::launder(reinterpret_cast<T*>(cell->storage));
+            value = std::move(*stored);
+            stored->~T();
+            cell->sequence.store(position + mask_ + 1, std::memory_order_release);
+            return true;
+        }
+
+        // 近似元素数，并发修改时仅供参考
+        size_t sizeApprox() const {
+            size_t enqueued = enqueue_pos_.load(std::memory_order_relaxed);
+            size_t dequeued = dequeue_pos_.load(std::memory_order_relaxed);
+            return enqueued > dequeued ? enqueued - dequeued : 0;
+        }
+
+        size_t capacity() const { return mask_ + 1; }
+
+    private:
+        struct Cell {
+            std::atomic<size_t> sequence;
+            alignas(T) unsigned char storage[sizeof(T)];
+        };
+
+        static size_t roundUp(size_t capacity) {
+            size_t result = 2;
+            while (result < capacity) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        // 入队与出队位置分处不同缓存行，避免生产者与消费者互相失效
+        const size_t mask_;
+        const std::unique_ptr<Cell[]> cells_;
+        alignas(64) std::atomic<size_t> enqueue_pos_{0};
+        alignas(64) std::atomic<size_t> dequeue_pos_{0};
+    };
+
+    // 按优先级分级的无锁队列：每个级别一个有界环形队列，出队时从最高级别开始查找
+    // 同一级别内按入队顺序出队；SPILL策略下环形队列写满的任务进入该级别的后备队列，
+    // 后备队列非空期间新任务也进入后备队列，保持同级别的先后顺序
+    template<typename T, size_t Levels>
+    class PriorityRingQueue {
+    public:
+        PriorityRingQueue(size_t capacity_per_level, QueueOverflowPolicy policy)
+            : policy_(policy) {
+            for (auto& level : levels_) {
+                level.ring = std::make_unique<MpmcRingQueue<T>>(capacity_per_level);
+            }
+        }
+
+        PriorityRingQueue(const PriorityRingQueue&) = delete;
+        PriorityRingQueue& operator=(const PriorityRingQueue&) = delete;
+
+        // REJECT策略下队列已满时返回false，value保持不变
+        bool push(size_t level, T&& value) {
+            Level& target = levels_[level];
+
+            if (target.spilled.load(std::memory_order_acquire) == 0 && target.ring->tryPush(std::move(value))) {
+                return true;
+            }
+
+            switch (policy_) {
+                case QueueOverflowPolicy::REJECT:
+                    return false;
+
+                case QueueOverflowPolicy::BLOCK:
+                    while (!target.ring->tryPush(std::move(value))) {
+                        std::this_thread::yield();
+                    }
+                    return true;
+
+                case QueueOverflowPolicy::SPILL:
+                default: {
+                    std::lock_guard<std::mutex> lock(target.spill_mutex);
+                    target.spill.push_back(std::move(value));
+                    target.spilled.fetch_add(1, std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+
+        // 从指定级别出队
+        bool tryPop(size_t level, T& value) {
+            Level& source = levels_[level];
+            if (source.ring->tryPop(value)) {
+                return true;
+            }
+            if (source.spilled.load(std::memory_order_acquire) == 0) {
+                return false;
+            }
+
+            std::lock_guard<std::mutex> lock(source.spill_mutex);
+            if (source.spill.empty()) {
+                return false;
+            }
+            value = std::move(source.spill.front());
+            source.spill.pop_front();
+            source.spilled.fetch_sub(1, std::memory_order_release);
+            return true;
+        }
+
+        // 从最高级别开始出队
+        bool tryPop(T& value) {
+            for (size_t level = Levels; level-- > 0;) {
+                if (tryPop(level, value)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        size_t sizeApprox() const {
+            size_t total = 0;
+            for (const auto& level : levels_) {
+                total += level.ring->sizeApprox() + level.spilled.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+        QueueOverflowPolicy policy() const { return policy_; }
+
+    private:
+        struct Level {
+            std::unique_ptr<MpmcRingQueue<T>> ring;
+            std::mutex spill_mutex;
+            std::deque<T> spill;
+            std::atomic<size_t> spilled{0};
+        };
+
+        const QueueOverflowPolicy policy_;
+        Level levels_[Levels];
+    };
+}
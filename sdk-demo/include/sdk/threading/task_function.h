@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sdk {
+
+    namespace detail {
+        // 任务节点池的块大小：超出内联缓冲区但不大于该值的可调用对象从池中分配
+        constexpr size_t kTaskNodeSize = 128;
+
+        // 从任务节点池分配/归还内存，池耗尽或尺寸过大时退化为operator new
+        void* allocateTaskNode(size_t size);
+        void deallocateTaskNode(void* ptr, size_t size) noexcept;
+    }
+
+    // 仅可移动的任务可调用对象，带小对象优化
+    // 捕获不超过kInlineSize字节的lambda直接存放在对象内部，提交路径上没有堆分配
+    class TaskFunction {
+    public:
+        static constexpr size_t kInlineSize = 48;
+
+        TaskFunction() noexcept = default;
+        TaskFunction(std::nullptr_t) noexcept {}
+
+        template<typename F, typename = typename std::enable_if<
+            !std::is_same<typename std::decay<F>::type, TaskFunction>::value>::type>
+        TaskFunction(F&& f) {
+            emplace(std::forward<F>(f));
+        }
+
+        TaskFunction(TaskFunction&& other) noexcept {
+            moveFrom(other);
+        }
+
+        TaskFunction& operator=(TaskFunction&& other) noexcept {
+            if (this != &other) {
+                reset();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        TaskFunction(const TaskFunction&) = delete;
+        TaskFunction& operator=(const TaskFunction&) = delete;
+
+        ~TaskFunction() {
+            reset();
+        }
+
+        void operator()() {
+            ops_->invoke(target());
+        }
+
+        explicit operator bool() const noexcept {
+            return ops_ != nullptr;
+        }
+
+        void reset() noexcept {
+            if (ops_) {
+                ops_->destroy(target());
+                if (!ops_->is_inline) {
+                    detail::deallocateTaskNode(heapPtr(), ops_->size);
+                }
+                ops_ = nullptr;
+            }
+        }
+
+    private:
+        struct Ops {
+            void (*invoke)(void* target);
+            void (*relocate)(void* dst, void* src) noexcept;  // 仅用于内联存储
+            void (*destroy)(void* target) noexcept;
+            bool is_inline;
+            size_t size;
+        };
+
+        template<typename T>
+        static constexpr bool fitsInline() {
+            return sizeof(T) <= kInlineSize &&
+                   alignof(T) <= alignof(std::max_align_t) &&
+                   std::is_nothrow_move_constructible<T>::value;
+        }
+
+        template<typename T>
+        static const Ops* opsFor() {
+            static const Ops ops = {
+                [](void* target) { (*static_cast<T*>(target))(); },
+                [](void* dst, void* src) noexcept {
+                    ::new (dst) T(std::move(*static_cast<T*>(src)));
+                    static_cast<T*>(src)->~T();
+                },
+                [](void* target) noexcept { static_cast<T*>(target)->~T(); },
+                fitsInline<T>(),
+                sizeof(T)
+            };
+            return &ops;
+        }
+
+        template<typename F>
+        void emplace(F&& f) {
+            using T = typename std::decay<F>::type;
+            if constexpr (fitsInline<T>()) {
+                ::new (static_cast<void*>(storage_)) T(std::forward<F>(f));
+            } else {
+                void* memory = detail::allocateTaskNode(sizeof(T));
+                try {
+                    ::new (memory) T(std::forward<F>(f));
+                } catch (...) {
+                    detail::deallocateTaskNode(memory, sizeof(T));
+                    throw;
+                }
+                heapPtr() = memory;
+            }
+            ops_ = opsFor<T>();
+        }
+
+        void moveFrom(TaskFunction& other) noexcept {
+            if (!other.ops_) {
+                return;
+            }
+
+            if (other.ops_->is_inline) {
+                other.ops_->relocate(storage_, other.storage_);
+            } else {
+                heapPtr() = other.heapPtr();
+            }
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+
+        void*& heapPtr() noexcept {
+            return *reinterpret_cast<void**>(storage_);
+        }
+
+        void* target() noexcept {
+            return ops_->is_inline ? static_cast<void*>(storage_) : heapPtr();
+        }
+
+        alignas(std::max_align_t) unsigned char storage_[kInlineSize];
+        const Ops* ops_ = nullptr;
+    };
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "sdk/threading/future.h"
+
+#include <functional>
+#include <vector>
+
+namespace sdk {
+
+    // 有向无环任务图：节点在全部前驱完成后投递到线程池，等待依赖时不占用工作线程
+    // 同一张图可以多次运行，run()时复制当前的节点与依赖关系
+    class TaskGraph {
+    public:
+        using NodeId = size_t;
+
+        // 添加节点，返回节点ID
+        NodeId addTask(std::function<void()> fn, TaskPriority priority = TaskPriority::NORMAL);
+
+        // 添加依赖：after在before完成后才执行
+        void precede(NodeId before, NodeId after);
+
+        // 提交到线程池执行，返回整张图完成的Future
+        // 任一节点抛出异常后，尚未开始的节点不再执行，Future交付第一个异常
+        // 图中存在环时抛出std::invalid_argument
+        Future<void> run(ThreadPool& pool) const;
+
+        size_t size() const { return nodes_.size(); }
+        bool empty() const { return nodes_.empty(); }
+
+    private:
+        struct Node {
+            std::function<void()> fn;
+            TaskPriority priority = TaskPriority::NORMAL;
+            std::vector<NodeId> successors;
+            size_t dependency_count = 0;
+        };
+
+        std::vector<Node> nodes_;
+    };
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "sdk/threading/thread_pool.h"
+#include "sdk/threading/completion_counter.h"
+
+#include <exception>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace sdk {
+
+    // 任务组：只等待本组提交的任务，不受线程池中其他任务的影响
+    // 析构时等待组内任务结束，组内任务可以安全地引用组本身
+    class TaskGroup {
+    public:
+        explicit TaskGroup(ThreadPool& pool, TaskPriority priority = TaskPriority::NORMAL);
+        ~TaskGroup();
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        // 提交任务到线程池，任务抛出的异常在wait()中重新抛出
+        template<typename F>
+        void run(F&& f);
+
+        // 等待组内全部任务结束，有任务失败时重新抛出第一个异常
+        void wait();
+
+        // 等待指定时间，组内任务全部结束时返回true（不抛出任务异常）
+        bool waitFor(const std::chrono::milliseconds& timeout);
+
+        // 未结束的任务数
+        size_t pending() const { return counter_.count(); }
+
+    private:
+        // 组内任务：执行完毕或未执行就被丢弃时都会减少计数
+        template<typename F>
+        class GroupTask {
+        public:
+            GroupTask(TaskGroup* group, F&& f) : group_(group), fn_(std::move(f)) {}
+            GroupTask(GroupTask&& other) noexcept
+                : group_(other.group_), fn_(std::move(other.fn_)) {
+                other.group_ = nullptr;
+            }
+            GroupTask& operator=(GroupTask&&) = delete;
+            GroupTask(const GroupTask&) = delete;
+
+            ~GroupTask() {
+                if (group_) {
+                    group_->counter_.done();
+                }
+            }
+
+            void operator()() {
+                TaskGroup* group = group_;
+                group_ = nullptr;
+                try {
+                    fn_();
+                } catch (...) {
+                    group->fail(std::current_exception());
+                }
+                // 计数归零后组可能立即被销毁，done()之后不能再访问group
+                group->counter_.done();
+            }
+
+        private:
+            TaskGroup* group_;
+            F fn_;
+        };
+
+        void fail(std::exception_ptr error);
+
+        ThreadPool& pool_;
+        TaskPriority priority_;
+        CompletionCounter counter_;
+        std::mutex error_mutex_;
+        std::exception_ptr error_;
+    };
+
+    template<typename F>
+    void TaskGroup::run(F&& f) {
+        using Fn = typename std::decay<F>::type;
+
+        // 先增加计数再投递；投递失败时任务对象随异常销毁，计数随之恢复
+        counter_.add();
+        pool_.post(priority_, GroupTask<Fn>(this, Fn(std::forward<F>(f))));
+    }
+}
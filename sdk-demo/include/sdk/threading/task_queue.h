@@ -0,0 +1,84 @@
+#pragma once
+
+#include "sdk/threading/thread_pool.h"
+#include "sdk/threading/mpmc_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace sdk {
+
+    // 任务队列中的任务
+    struct Task {
+        std::function<void()> function;
+        TaskPriority priority = TaskPriority::NORMAL;
+        std::shared_ptr<TaskInfo> info;
+        uint64_t sequence = 0;   // 入队序号，由队列分配
+
+        // 优先级比较器：高优先级在前，同优先级先入队的在前
+        bool operator<(const Task& other) const {
+            if (priority != other.priority) {
+                return priority < other.priority;
+            }
+            return sequence > other.sequence;
+        }
+    };
+
+    // 按优先级出队的任务队列
+    // PRIORITY_HEAP为互斥锁保护的二叉堆；RING_BUFFER为每个优先级一个无锁环形队列，push/tryPop为O(1)且不加锁
+    class TaskQueue {
+    public:
+        TaskQueue();
+        explicit TaskQueue(QueueBackend backend, size_t ring_capacity = 1024,
+                           QueueOverflowPolicy overflow_policy = QueueOverflowPolicy::SPILL);
+        ~TaskQueue();
+
+        TaskQueue(const TaskQueue&) = delete;
+        TaskQueue& operator=(const TaskQueue&) = delete;
+
+        // 入队，REJECT策略下环形队列已满时抛出std::runtime_error
+        void push(Task task);
+
+        bool tryPop(Task& task);
+
+        // 阻塞等待任务，队列停止且为空时返回false
+        bool waitAndPop(Task& task);
+        bool waitAndPop(Task& task, const std::chrono::milliseconds& timeout);
+
+        bool empty() const;
+        size_t size() const;
+
+        void stop();
+        void clear();
+
+        // 以下两个操作在RING_BUFFER下需要取出全部任务再放回，期间并发出队的线程可能看不到这些任务
+        std::vector<Task> getAllTasks();
+        void removeTasksWithId(const std::string& task_id);
+
+        QueueBackend backend() const { return backend_; }
+
+    private:
+        bool popRing(Task& task);
+        void notifyRingWaiters();
+
+        const QueueBackend backend_;
+        std::atomic<uint64_t> next_sequence_{0};
+
+        mutable std::mutex mutex_;
+        std::condition_variable condition_;
+        std::priority_queue<Task> queue_;
+        bool stop_ = false;
+
+        // RING_BUFFER：计数与等待者数量用于在无锁入队后按需唤醒等待线程
+        std::unique_ptr<PriorityRingQueue<Task, 4>> rings_;
+        std::atomic<size_t> ring_size_{0};
+        std::atomic<size_t> waiters_{0};
+    };
+}
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <queue>
+#include <algorithm>
 #include <memory>
 #include <thread>
 #include <mutex>
@@ -10,6 +11,19 @@
 #include <functional>
 #include <atomic>
 #include <chrono>
+#include <string>
+#include <unordered_map>
+#include <stdexcept>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+
+#include "sdk/threading/task_function.h"
+#include "sdk/threading/completion_counter.h"
+#include "sdk/threading/mpmc_queue.h"
+#include "sdk/metrics/metrics.h"
+#include "sdk/platform/platform_utils.h"
 
 namespace sdk {
     
@@ -48,8 +62,263 @@ namespace sdk {
         size_t pending_tasks;
         size_t completed_tasks;
         size_t failed_tasks;
-        double average_task_duration_ms;
+        double average_task_duration_ms;   // 由微秒精度的运行时间直方图计算
         std::chrono::system_clock::time_point start_time;
+        
+        // 任务从入队到开始执行的等待时间，以及执行时间
+        LatencySummary queue_wait;
+        LatencySummary run_time;
+    };
+    
+    // 调度模式
+    enum class SchedulingMode {
+        SHARED_QUEUE,   // 所有工作线程共享一个全局优先级队列
+        WORK_STEALING   // 每个工作线程拥有本地队列，空闲线程从其他线程窃取任务
+    };
+    
+    // 自动伸缩策略：根据积压任务数与平均任务耗时在[min_threads, max_threads]之间调整线程数
+    struct AutoScalePolicy {
+        bool enabled = false;
+        size_t min_threads = 1;
+        size_t max_threads = 0;                         // 0表示取ThreadPoolConfig::max_threads
+        
+        // 每线程积压任务数超过该值时扩容
+        size_t queue_depth_per_thread = 16;
+        
+        // 预计排队时间（积压任务数 × 平均耗时 / 线程数）超过该值时扩容
+        double max_queue_delay_ms = 100.0;
+        
+        // 队列为空且存在空闲线程持续超过该时长后收缩
+        std::chrono::milliseconds idle_timeout{10000};
+        
+        // 检查间隔
+        std::chrono::milliseconds check_interval{100};
+    };
+    
+    // 工作线程的CPU绑定方式
+    enum class CpuAffinityMode {
+        NONE,           // 不绑定，由系统调度
+        PER_CORE,       // 每个工作线程绑定到一个CPU，按NUMA节点依次分配
+        NUMA_NODE       // 工作线程按NUMA节点轮流分组，绑定到所在节点的全部CPU
+    };
+    
+    // 线程池配置
+    struct ThreadPoolConfig {
+        size_t thread_count = std::thread::hardware_concurrency();
+        SchedulingMode scheduling_mode = SchedulingMode::SHARED_QUEUE;
+        
+        // 线程数上限（工作窃取模式下决定本地队列的数量），0表示取max(thread_count, 硬件并发数)
+        size_t max_threads = 0;
+        
+        // 任务记录保留策略：只保留最近task_history_capacity条记录（向上取整为2的幂）
+        size_t task_history_capacity = 4096;
+        
+        // 已结束任务记录的保留时长，0表示只按数量淘汰
+        std::chrono::milliseconds task_history_retention{0};
+        
+        // 空闲线程休眠前自旋等待新任务的时长，兼顾突发负载下的唤醒延迟与空闲时的CPU占用
+        std::chrono::microseconds idle_spin{50};
+        
+        AutoScalePolicy auto_scale;
+        
+        // 共享队列模式下的任务队列实现，工作窃取模式始终使用每线程本地队列
+        // RING_BUFFER下每个优先级一个容量为ring_capacity的无锁队列，写满后按overflow_policy处理
+        // BLOCK策略下工作线程内部提交任务可能与其他等待空位的线程互相等待，应只用于外部生产者
+        QueueBackend queue_backend = QueueBackend::PRIORITY_HEAP;
+        size_t ring_capacity = 1024;
+        QueueOverflowPolicy overflow_policy = QueueOverflowPolicy::SPILL;
+        
+        // CPU绑定与NUMA分组；工作窃取模式下同节点的线程优先互相窃取
+        // Apple平台不支持硬亲和性，绑定设置被忽略，只有qos生效
+        CpuAffinityMode affinity = CpuAffinityMode::NONE;
+        
+        // 参与绑定的CPU列表，为空表示使用全部CPU
+        std::vector<uint32_t> cpu_list;
+        
+        // 工作线程的QoS等级，未设置表示保持系统默认
+        std::optional<platform::ThreadUtils::QoS> qos;
+    };
+    
+    class TaskRegistry;
+    class TimerWheel;
+    
+    // 定时器ID，0表示无效
+    using TimerId = uint64_t;
+    
+    namespace detail {
+        // 批量任务的共享完成状态
+        struct BatchState {
+            explicit BatchState(size_t count);
+            virtual ~BatchState() = default;
+            
+            // 子任务执行结束，error非空表示抛出了异常
+            void complete(std::exception_ptr error) noexcept;
+            
+            // 子任务未执行即被丢弃（取消或强制关闭）
+            void drop() noexcept;
+            
+            const size_t total;
+            std::atomic<size_t> remaining;
+            std::atomic<size_t> failed;
+            std::atomic<size_t> dropped;
+            
+            std::mutex mutex;
+            std::condition_variable done;
+            std::exception_ptr first_error;
+            
+        private:
+            void arrive() noexcept;
+        };
+        
+        // 先执行并暂存结果，任务记录与统计更新后再交付给future
+        template<typename R>
+        class DeferredResult {
+        public:
+            std::future<R> getFuture() { return promise_.get_future(); }
+            
+            template<typename F>
+            void run(F& f) { value_.emplace(f()); }
+            
+            void fail(std::exception_ptr error) { error_ = std::move(error); }
+            
+            void deliver() {
+                if (error_) {
+                    promise_.set_exception(error_);
+                } else if constexpr (std::is_reference<R>::value) {
+                    promise_.set_value(value_->get());
+                } else {
+                    promise_.set_value(std::move(*value_));
+                }
+            }
+            
+        private:
+            using Storage = typename std::conditional<std::is_reference<R>::value,
+                std::reference_wrapper<typename std::remove_reference<R>::type>, R>::type;
+            
+            std::promise<R> promise_;
+            std::optional<Storage> value_;
+            std::exception_ptr error_;
+        };
+        
+        template<>
+        class DeferredResult<void> {
+        public:
+            std::future<void> getFuture() { return promise_.get_future(); }
+            
+            template<typename F>
+            void run(F& f) { f(); }
+            
+            void fail(std::exception_ptr error) { error_ = std::move(error); }
+            
+            void deliver() {
+                if (error_) {
+                    promise_.set_exception(error_);
+                } else {
+                    promise_.set_value();
+                }
+            }
+            
+        private:
+            std::promise<void> promise_;
+            std::exception_ptr error_;
+        };
+        
+        // 周期任务的共享状态
+        template<typename F>
+        struct PeriodicState {
+            explicit PeriodicState(F&& f) : fn(std::move(f)) {}
+            explicit PeriodicState(const F& f) : fn(f) {}
+            F fn;
+            std::atomic<bool> running{false};
+        };
+        
+        // 周期任务的单次执行：执行完毕或未执行就被丢弃时都会清除running标志
+        template<typename F>
+        class PeriodicRun {
+        public:
+            explicit PeriodicRun(std::shared_ptr<PeriodicState<F>> state) noexcept : state_(std::move(state)) {}
+            PeriodicRun(PeriodicRun&& other) noexcept = default;
+            PeriodicRun& operator=(PeriodicRun&&) = delete;
+            PeriodicRun(const PeriodicRun&) = delete;
+            
+            ~PeriodicRun() {
+                if (state_) {
+                    state_->running.store(false, std::memory_order_release);
+                }
+            }
+            
+            void operator()() { state_->fn(); }
+            
+        private:
+            std::shared_ptr<PeriodicState<F>> state_;
+        };
+        
+        // 持有批量可调用对象的状态，子任务只保存指向fn的裸指针
+        template<typename F>
+        struct BatchStateFor : BatchState {
+            BatchStateFor(size_t count, F&& f) : BatchState(count), fn(std::move(f)) {}
+            BatchStateFor(size_t count, const F& f) : BatchState(count), fn(f) {}
+            F fn;
+        };
+        
+        // 子任务与批量状态之间的连接：执行时报告完成，未执行就被销毁时报告丢弃
+        class BatchLink {
+        public:
+            explicit BatchLink(std::shared_ptr<BatchState> state) noexcept : state_(std::move(state)) {}
+            BatchLink(BatchLink&& other) noexcept = default;
+            BatchLink& operator=(BatchLink&&) = delete;
+            BatchLink(const BatchLink&) = delete;
+            
+            ~BatchLink() {
+                if (state_) {
+                    state_->drop();
+                }
+            }
+            
+            template<typename Body>
+            void run(Body&& body) {
+                std::shared_ptr<BatchState> state = std::move(state_);
+                try {
+                    body();
+                } catch (...) {
+                    state->complete(std::current_exception());
+                    throw;
+                }
+                state->complete(nullptr);
+            }
+            
+        private:
+            std::shared_ptr<BatchState> state_;
+        };
+    }
+    
+    // 批量任务的聚合句柄，代替N个std::future
+    class BatchHandle {
+    public:
+        BatchHandle() = default;
+        
+        bool valid() const { return state_ != nullptr; }
+        
+        // 等待全部子任务结束（含被丢弃的子任务）
+        void wait() const;
+        bool waitFor(const std::chrono::milliseconds& timeout) const;
+        
+        bool isDone() const;
+        
+        // 子任务总数、未结束数、失败数、被丢弃数
+        size_t size() const;
+        size_t pending() const;
+        size_t failedCount() const;
+        size_t droppedCount() const;
+        
+        // 等待结束并重新抛出第一个子任务异常
+        void get() const;
+        
+    private:
+        friend class ThreadPool;
+        explicit BatchHandle(std::shared_ptr<detail::BatchState> state) : state_(std::move(state)) {}
+        
+        std::shared_ptr<detail::BatchState> state_;
     };
     
     // 线程池类
@@ -57,6 +326,7 @@ namespace sdk {
     public:
         // 构造函数
         explicit ThreadPool(size_t thread_count = std::thread::hardware_concurrency());
+        explicit ThreadPool(const ThreadPoolConfig& config);
         
         // 析构函数
         ~ThreadPool();
@@ -82,7 +352,45 @@ namespace sdk {
         auto submit(const std::string& task_id, TaskPriority priority, F&& f, Args&&... args)
             -> std::future<typename std::result_of<F(Args...)>::type>;
         
-        // 等待所有任务完成
+        // 轻量级提交：不创建future和TaskInfo，返回数字任务ID
+        // 适用于大量细粒度任务，可调用对象捕获不超过TaskFunction::kInlineSize字节时无堆分配
+        template<typename F>
+        uint64_t post(F&& f);
+        
+        template<typename F>
+        uint64_t post(TaskPriority priority, F&& f);
+        
+        // 延迟执行：delay之后以priority投递到任务队列，等待期间不占用工作线程
+        template<typename F>
+        TimerId schedule(std::chrono::milliseconds delay, F&& f, 
+                         TaskPriority priority = TaskPriority::NORMAL);
+        
+        // 固定频率执行：首次在period之后触发，此后以计划时间为基准每隔period触发一次
+        // 上一次执行尚未结束时跳过本次触发，同一任务不会并发执行
+        template<typename F>
+        TimerId scheduleAtFixedRate(std::chrono::milliseconds period, F&& f,
+                                    TaskPriority priority = TaskPriority::NORMAL);
+        
+        // 取消定时器：未触发的单次定时器和周期定时器可以取消，已投递的任务不受影响
+        bool cancelTimer(TimerId timer_id);
+        
+        // 批量提交：为[first, last)中每个元素提交一个调用fn(*it)的子任务，整批只加一次锁
+        // 子任务完成前迭代器指向的元素必须保持有效
+        template<typename Iterator, typename F>
+        BatchHandle submitBatch(Iterator first, Iterator last, F&& fn,
+                                TaskPriority priority = TaskPriority::NORMAL);
+        
+        template<typename Range, typename F>
+        BatchHandle submitBatch(Range& range, F&& fn, TaskPriority priority = TaskPriority::NORMAL);
+        
+        // 并行循环：把[begin, end)按grain切分为子任务，每个下标调用一次fn(i)
+        // grain为0时按线程数自动切分
+        template<typename Index, typename F>
+        BatchHandle parallelFor(Index begin, Index end, Index grain, F&& fn,
+                                TaskPriority priority = TaskPriority::NORMAL);
+        
+        // 等待所有任务完成（含执行中的任务），只在线程池整体空闲时返回
+        // 只需要等待部分任务时使用TaskGroup
         void waitForAll();
         
         // 等待指定时间
@@ -94,7 +402,8 @@ namespace sdk {
         // 取消指定任务
         bool cancelTask(const std::string& task_id);
         
-        // 调整线程池大小
+        // 调整线程池大小，至少保留一个线程
+        // 收缩时编号最大的线程在完成当前任务后退出，其本地队列中的任务由其他线程窃取
         void resize(size_t new_size);
         
         // 获取线程池大小
@@ -106,12 +415,18 @@ namespace sdk {
         // 获取待处理任务数
         size_t pendingTasks() const;
         
+        // 获取调度模式
+        SchedulingMode schedulingMode() const;
+        
         // 获取统计信息
         ThreadPoolStats getStats() const;
         
-        // 获取任务信息
+        // 获取任务信息快照（保留期内的记录，不阻塞任务提交与调度）
         std::vector<TaskInfo> getTaskInfos() const;
         
+        // 获取单个任务的信息
+        bool getTaskInfo(const std::string& task_id, TaskInfo& info) const;
+        
         // 检查是否正在关闭
         bool isShuttingDown() const;
         
@@ -124,34 +439,130 @@ namespace sdk {
     private:
         // 内部任务包装器
         struct Task {
-            std::string id;
-            TaskPriority priority;
-            std::function<void()> function;
-            std::chrono::system_clock::time_point submit_time;
-            std::shared_ptr<TaskInfo> info;
+            uint64_t seq = 0;                        // 数字任务ID，单调递增
+            TaskPriority priority = TaskPriority::NORMAL;
+            TaskFunction function;
+            bool tracked = false;                    // submit()提交的任务：登记在任务记录表中，自行维护记录与统计
+            std::chrono::steady_clock::time_point enqueue_time;   // 入队时刻，用于统计排队时间
+            uint64_t trace_id = 0;                   // 追踪开启时入队的任务带有排队区间的事件ID
             
             // 优先级比较器
             bool operator<(const Task& other) const {
                 if (priority != other.priority) {
                     return priority < other.priority;
                 }
-                return submit_time > other.submit_time;  // 早提交的优先
+                return seq > other.seq;  // 早提交的优先
             }
         };
         
-        // 工作线程函数
-        void workerThread();
+        // 带TaskInfo跟踪的提交实现
+        template<typename F, typename... Args>
+        auto submitTracked(uint64_t seq, const std::string& task_id, TaskPriority priority, 
+                           F&& f, Args&&... args)
+            -> std::future<typename std::result_of<F(Args...)>::type>;
+        
+        // 执行submit()提交的任务：结果在任务记录与统计更新之后才交付给future
+        template<typename R, typename F>
+        void runTracked(uint64_t seq, detail::DeferredResult<R>& result, F& callable);
+        
+        // 任务记录与统计的更新，已取消的任务beginTrackedTask返回false
+        bool beginTrackedTask(uint64_t seq, std::chrono::system_clock::time_point start_time);
+        void finishTrackedTask(uint64_t seq, TaskStatus status,
+                               std::chrono::system_clock::time_point start_time,
+                               std::chrono::system_clock::time_point end_time,
+                               const std::string& error_message);
+        
+        // 获取时间轮，create为true时在首次使用时创建时间轮和定时线程
+        TimerWheel* timerWheel(bool create);
+        
+        // 添加定时器
+        TimerId addTimer(std::chrono::milliseconds delay, std::chrono::milliseconds period,
+                         TaskFunction action);
+        
+        // 分配下一个数字任务ID
+        uint64_t nextTaskSeq();
+        
+        // 在任务记录表中登记任务
+        void recordTask(uint64_t seq, const std::string& task_id, TaskPriority priority);
+        
+        // 工作窃取模式下的每线程本地队列（定义见实现文件）
+        struct WorkerQueue;
+        
+        // 工作线程函数；retiring由resize()在回收该线程时置位，每个线程独有，重新扩容不会复用
+        void workerThread(size_t worker_index, std::shared_ptr<std::atomic<bool>> retiring);
+        
+        // 根据CPU拓扑计算每个工作线程的绑定位置，以及工作窃取模式下的窃取顺序
+        void buildPlacement();
+        
+        // 在工作线程启动时应用CPU绑定与QoS
+        void applyPlacement(size_t worker_index);
         
-        // 生成任务ID
-        std::string generateTaskId();
+        // 外部线程提交任务时选择本地队列：优先选择提交线程所在NUMA节点的队列
+        size_t selectQueue();
+        
+        // 将任务放入队列：共享模式进入全局队列，工作窃取模式进入本地队列
+        void enqueueTask(Task&& task);
+        
+        // 批量入队：共享模式只加一次锁，工作窃取模式每个本地队列只加一次锁
+        void enqueueBatch(std::vector<Task>& tasks);
+        
+        // 入队前增加待处理计数，线程池已停止时回滚并抛出异常
+        void addPending(const Task& task);
+        void addPendingBatch(const std::vector<Task>& tasks);
+        
+        // 按优先级无锁获取任务：工作窃取模式查找本地队列和其他线程的队列，环形队列模式查找共享环形队列
+        bool tryPopTask(size_t worker_index, Task& task);
+        
+        // 是否还有排队中的任务（无锁）
+        bool hasPendingWork() const;
+        
+        // 休眠前自旋等待，期间出现任务或需要退出时返回true
+        bool spinForWork(const std::atomic<bool>& retiring) const;
+        
+        // 自动伸缩线程函数及单次决策
+        void autoScaleThread();
+        void autoScaleOnce(std::chrono::steady_clock::time_point& idle_since);
+        
+        // 回收已退出的线程
+        void joinWorkers(std::vector<std::thread>& threads);
+        
+        // 关闭时停止自动伸缩线程并回收全部工作线程
+        void joinAllWorkers();
+        
+        // 根据数字ID生成字符串任务ID
+        std::string generateTaskId(uint64_t seq);
         
         // 更新统计信息
-        void updateStats(const TaskInfo& info);
+        void updateStats(TaskStatus status, 
+                         std::chrono::system_clock::time_point start_time,
+                         std::chrono::system_clock::time_point end_time);
         
         // 成员变量
         std::vector<std::thread> workers_;
+        std::vector<std::shared_ptr<std::atomic<bool>>> retire_flags_;   // 与workers_一一对应
+        std::vector<std::thread> retired_workers_;   // 在自身任务中收缩而无法立即join的线程
+        std::mutex resize_mutex_;
         std::priority_queue<Task> tasks_;
-        std::unordered_map<std::string, std::shared_ptr<TaskInfo>> task_infos_;
+        std::unique_ptr<PriorityRingQueue<Task, 4>> ring_queue_;   // 共享队列模式的无锁实现，为空表示使用tasks_
+        std::unique_ptr<TaskRegistry> registry_;
+        
+        // 工作窃取模式：本地队列数量在构造时固定为max_threads，运行期间不重新分配
+        ThreadPoolConfig config_;
+        std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+        std::atomic<size_t> pending_by_priority_[4];   // 两种模式下均统计排队中的任务数
+        std::atomic<size_t> next_queue_;
+        std::atomic<size_t> sleeping_threads_;
+        std::atomic<size_t> worker_count_;
+        
+        // CPU绑定：按工作线程编号取模，构造后只读
+        struct WorkerPlacement {
+            size_t node = 0;
+            std::vector<uint32_t> cpus;
+        };
+        std::vector<WorkerPlacement> placement_;
+        std::vector<std::vector<size_t>> steal_order_;   // 每个本地队列的窃取顺序，同节点优先；为空表示环形顺序
+        std::vector<std::vector<size_t>> node_queues_;   // 每个NUMA节点上的本地队列
+        std::unordered_map<uint32_t, size_t> cpu_node_;  // CPU编号到NUMA节点
         
         // 同步原语
         mutable std::mutex queue_mutex_;
@@ -161,11 +572,25 @@ namespace sdk {
         std::atomic<bool> stop_;
         std::atomic<bool> force_stop_;
         std::atomic<size_t> active_threads_;
+        CompletionCounter in_flight_;                // 已入队但尚未结束的任务数，waitForAll/waitFor等待其归零
         std::atomic<size_t> task_counter_;
         
-        // 统计信息
+        // 统计信息：stats_只保存不常变化的字段，任务计数与耗时分布在工作线程上无锁更新
         mutable std::mutex stats_mutex_;
         ThreadPoolStats stats_;
+        ShardedCounter completed_tasks_;
+        ShardedCounter failed_tasks_;
+        std::shared_ptr<LatencyHistogram> queue_wait_;
+        std::shared_ptr<LatencyHistogram> run_time_;
+        
+        // 定时任务
+        std::unique_ptr<TimerWheel> timers_;
+        std::mutex timers_mutex_;
+        
+        // 自动伸缩
+        std::thread scaler_;
+        std::mutex scaler_mutex_;
+        std::condition_variable scaler_condition_;
     };
     
     // 模板实现
@@ -178,12 +603,22 @@ namespace sdk {
     template<typename F, typename... Args>
     auto ThreadPool::submit(TaskPriority priority, F&& f, Args&&... args)
         -> std::future<typename std::result_of<F(Args...)>::type> {
-        return submit(generateTaskId(), priority, std::forward<F>(f), std::forward<Args>(args)...);
+        uint64_t seq = nextTaskSeq();
+        return submitTracked(seq, generateTaskId(seq), priority, 
+                             std::forward<F>(f), std::forward<Args>(args)...);
     }
     
     template<typename F, typename... Args>
     auto ThreadPool::submit(const std::string& task_id, TaskPriority priority, F&& f, Args&&... args)
         -> std::future<typename std::result_of<F(Args...)>::type> {
+        return submitTracked(nextTaskSeq(), task_id, priority, 
+                             std::forward<F>(f), std::forward<Args>(args)...);
+    }
+    
+    template<typename F, typename... Args>
+    auto ThreadPool::submitTracked(uint64_t seq, const std::string& task_id, TaskPriority priority,
+                                   F&& f, Args&&... args)
+        -> std::future<typename std::result_of<F(Args...)>::type> {
         
         using return_type = typename std::result_of<F(Args...)>::type;
         
@@ -191,53 +626,178 @@ namespace sdk {
             throw std::runtime_error("ThreadPool is shutting down");
         }
         
-        auto task_info = std::make_shared<TaskInfo>();
-        task_info->id = task_id;
-        task_info->priority = priority;
-        task_info->status = TaskStatus::PENDING;
-        task_info->submit_time = std::chrono::system_clock::now();
+        detail::DeferredResult<return_type> deferred;
+        std::future<return_type> result = deferred.getFuture();
         
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
+        Task wrapper_task;
+        wrapper_task.seq = seq;
+        wrapper_task.priority = priority;
+        wrapper_task.tracked = true;
+        wrapper_task.function = [this, seq, deferred = std::move(deferred),
+                                 callable = std::bind(std::forward<F>(f), std::forward<Args>(args)...)]() mutable {
+            runTracked(seq, deferred, callable);
+        };
         
-        std::future<return_type> result = task->get_future();
+        recordTask(seq, task_id, priority);
+        enqueueTask(std::move(wrapper_task));
+        return result;
+    }
+    
+    template<typename F>
+    TimerId ThreadPool::schedule(std::chrono::milliseconds delay, F&& f, TaskPriority priority) {
+        using Fn = typename std::decay<F>::type;
         
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            
-            if (stop_.load()) {
-                throw std::runtime_error("ThreadPool is shutting down");
+        if (stop_.load()) {
+            throw std::runtime_error("ThreadPool is shutting down");
+        }
+        
+        // 定时线程上只做投递，任务本身在工作线程上执行
+        return addTimer(delay, std::chrono::milliseconds(0),
+            [this, priority, fn = Fn(std::forward<F>(f))]() mutable {
+                post(priority, std::move(fn));
+            });
+    }
+    
+    template<typename F>
+    TimerId ThreadPool::scheduleAtFixedRate(std::chrono::milliseconds period, F&& f, TaskPriority priority) {
+        using Fn = typename std::decay<F>::type;
+        
+        if (stop_.load()) {
+            throw std::runtime_error("ThreadPool is shutting down");
+        }
+        if (period.count() <= 0) {
+            throw std::invalid_argument("Period must be positive");
+        }
+        
+        auto state = std::make_shared<detail::PeriodicState<Fn>>(std::forward<F>(f));
+        return addTimer(period, period, [this, priority, state]() {
+            if (state->running.exchange(true, std::memory_order_acq_rel)) {
+                return;
             }
-            
-            Task wrapper_task;
-            wrapper_task.id = task_id;
-            wrapper_task.priority = priority;
-            wrapper_task.submit_time = task_info->submit_time;
-            wrapper_task.info = task_info;
-            wrapper_task.function = [task, task_info]() {
-                task_info->status = TaskStatus::RUNNING;
-                task_info->start_time = std::chrono::system_clock::now();
-                
-                try {
-                    (*task)();
-                    task_info->status = TaskStatus::COMPLETED;
-                } catch (const std::exception& e) {
-                    task_info->status = TaskStatus::FAILED;
-                    task_info->error_message = e.what();
-                } catch (...) {
-                    task_info->status = TaskStatus::FAILED;
-                    task_info->error_message = "Unknown exception";
-                }
-                
-                task_info->end_time = std::chrono::system_clock::now();
+            post(priority, detail::PeriodicRun<Fn>(state));
+        });
+    }
+    
+    template<typename R, typename F>
+    void ThreadPool::runTracked(uint64_t seq, detail::DeferredResult<R>& result, F& callable) {
+        auto start_time = std::chrono::system_clock::now();
+        if (!beginTrackedTask(seq, start_time)) {
+            // 已通过cancelTask取消：结果对象随任务销毁，future得到broken_promise
+            return;
+        }
+        
+        TaskStatus status = TaskStatus::COMPLETED;
+        std::string error_message;
+        try {
+            result.run(callable);
+        } catch (const std::exception& e) {
+            status = TaskStatus::FAILED;
+            error_message = e.what();
+            result.fail(std::current_exception());
+        } catch (...) {
+            status = TaskStatus::FAILED;
+            error_message = "Unknown exception";
+            result.fail(std::current_exception());
+        }
+        
+        finishTrackedTask(seq, status, start_time, std::chrono::system_clock::now(), error_message);
+        result.deliver();
+    }
+    
+    template<typename Iterator, typename F>
+    BatchHandle ThreadPool::submitBatch(Iterator first, Iterator last, F&& fn, TaskPriority priority) {
+        using Fn = typename std::decay<F>::type;
+        
+        if (stop_.load()) {
+            throw std::runtime_error("ThreadPool is shutting down");
+        }
+        
+        size_t count = static_cast<size_t>(std::distance(first, last));
+        auto state = std::make_shared<detail::BatchStateFor<Fn>>(count, std::forward<F>(fn));
+        Fn* body = &state->fn;
+        
+        std::vector<Task> tasks;
+        tasks.reserve(count);
+        for (Iterator it = first; it != last; ++it) {
+            Task task;
+            task.seq = nextTaskSeq();
+            task.priority = priority;
+            task.function = [link = detail::BatchLink(state), body, it]() mutable {
+                link.run([body, &it]() { (*body)(*it); });
             };
+            tasks.push_back(std::move(task));
+        }
+        
+        enqueueBatch(tasks);
+        return BatchHandle(std::move(state));
+    }
+    
+    template<typename Range, typename F>
+    BatchHandle ThreadPool::submitBatch(Range& range, F&& fn, TaskPriority priority) {
+        return submitBatch(std::begin(range), std::end(range), std::forward<F>(fn), priority);
+    }
+    
+    template<typename Index, typename F>
+    BatchHandle ThreadPool::parallelFor(Index begin, Index end, Index grain, F&& fn, TaskPriority priority) {
+        static_assert(std::is_integral<Index>::value, "parallelFor requires an integral index type");
+        using Fn = typename std::decay<F>::type;
+        
+        if (stop_.load()) {
+            throw std::runtime_error("ThreadPool is shutting down");
+        }
+        
+        size_t total = end > begin ? static_cast<size_t>(end - begin) : 0;
+        if (!(grain > 0)) {
+            // 每个线程约4个子任务，兼顾负载均衡与调度开销
+            size_t chunks = std::max<size_t>(worker_count_.load(), 1) * 4;
+            grain = static_cast<Index>(std::max<size_t>((total + chunks - 1) / chunks, 1));
+        }
+        
+        size_t count = total == 0 ? 0 : (total + static_cast<size_t>(grain) - 1) / static_cast<size_t>(grain);
+        auto state = std::make_shared<detail::BatchStateFor<Fn>>(count, std::forward<F>(fn));
+        Fn* body = &state->fn;
+        
+        std::vector<Task> tasks;
+        tasks.reserve(count);
+        for (Index chunk_begin = begin; chunk_begin < end;) {
+            Index chunk_end = end - chunk_begin > grain ? static_cast<Index>(chunk_begin + grain) : end;
             
-            tasks_.push(wrapper_task);
-            task_infos_[task_id] = task_info;
+            Task task;
+            task.seq = nextTaskSeq();
+            task.priority = priority;
+            task.function = [link = detail::BatchLink(state), body, chunk_begin, chunk_end]() mutable {
+                link.run([body, chunk_begin, chunk_end]() {
+                    for (Index i = chunk_begin; i < chunk_end; ++i) {
+                        (*body)(i);
+                    }
+                });
+            };
+            tasks.push_back(std::move(task));
+            chunk_begin = chunk_end;
         }
         
-        condition_.notify_one();
-        return result;
+        enqueueBatch(tasks);
+        return BatchHandle(std::move(state));
+    }
+    
+    template<typename F>
+    uint64_t ThreadPool::post(F&& f) {
+        return post(TaskPriority::NORMAL, std::forward<F>(f));
+    }
+    
+    template<typename F>
+    uint64_t ThreadPool::post(TaskPriority priority, F&& f) {
+        if (stop_.load()) {
+            throw std::runtime_error("ThreadPool is shutting down");
+        }
+        
+        Task task;
+        task.seq = nextTaskSeq();
+        task.priority = priority;
+        task.function = TaskFunction(std::forward<F>(f));
+        
+        uint64_t seq = task.seq;
+        enqueueTask(std::move(task));
+        return seq;
     }
 }
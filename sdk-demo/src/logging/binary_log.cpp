@@ -0,0 +1,466 @@
+#include "sdk/logging/binary_log.h"
+
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace sdk {
+
+namespace {
+
+using binary_log::Tag;
+
+// 已格式化的记录使用的格式串
+const char* const kTextFormat = "{}";
+
+int64_t toNanos(std::chrono::system_clock::time_point timestamp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+}
+
+void putVarint(std::vector<unsigned char>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+void putString(std::vector<unsigned char>& out, const char* data, size_t size) {
+    putVarint(out, size);
+    out.insert(out.end(), data, data + size);
+}
+
+void putFixed(std::vector<unsigned char>& out, uint64_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<unsigned char>(value >> (8 * i)));
+    }
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+} // namespace
+
+// BinaryFileAppender实现
+class BinaryFileAppender::Impl {
+public:
+    Impl(const std::string& file_path, size_t buffer_size)
+        : file_(file_path, std::ios::binary | std::ios::trunc),
+          buffer_limit_(buffer_size > 0 ? buffer_size : 1) {
+        buffer_.reserve(buffer_limit_ + 512);
+
+        base_time_ = toNanos(std::chrono::system_clock::now());
+        last_time_ = base_time_;
+        buffer_.insert(buffer_.end(), binary_log::kMagic, binary_log::kMagic + sizeof(binary_log::kMagic));
+        putFixed(buffer_, static_cast<uint64_t>(base_time_), 8);
+    }
+
+    ~Impl() {
+        flush();
+    }
+
+    bool isOpen() const {
+        return file_.is_open();
+    }
+
+    void append(const LogRecord& record) {
+        uint64_t format_id = formatId(record.format ? record.format : kTextFormat);
+        uint64_t logger_id = stringId(record.logger_name);
+        uint64_t file_id = stringId(record.file);
+        uint64_t function_id = stringId(record.function);
+        uint64_t thread_id = threadId(record.thread_id);
+
+        int64_t now = toNanos(record.timestamp);
+        int64_t delta = now - last_time_;
+        last_time_ = now;
+
+        // 键多为固定名称，进入字典；值随记录变化，直接内联
+        if (!record.context.empty()) {
+            context_keys_.clear();
+            for (size_t i = 0; i < record.context.size(); ++i) {
+                context_keys_.push_back(stringId(record.context[i].first));
+            }
+            buffer_.push_back(static_cast<unsigned char>(Tag::CONTEXT));
+            putVarint(buffer_, record.context.size());
+            for (size_t i = 0; i < record.context.size(); ++i) {
+                const std::string& value = record.context[i].second;
+                putVarint(buffer_, context_keys_[i]);
+                putString(buffer_, value.data(), value.size());
+            }
+        }
+
+        const LogArgs* args = &record.args;
+        if (!record.format) {
+            text_args_.clear();
+            text_args_.add(record.message);
+            args = &text_args_;
+        }
+
+        buffer_.push_back(static_cast<unsigned char>(Tag::EVENT));
+        buffer_.push_back(static_cast<unsigned char>(record.level));
+        putVarint(buffer_, format_id);
+        putVarint(buffer_, logger_id);
+        putVarint(buffer_, file_id);
+        putVarint(buffer_, static_cast<uint64_t>(record.line < 0 ? 0 : record.line));
+        putVarint(buffer_, function_id);
+        putVarint(buffer_, thread_id);
+        putVarint(buffer_, zigzag(delta));
+        buffer_.push_back(static_cast<unsigned char>(args->count()));
+        putVarint(buffer_, args->size());
+        buffer_.insert(buffer_.end(), args->data(), args->data() + args->size());
+
+        if (buffer_.size() >= buffer_limit_) {
+            writeBuffer();
+        }
+    }
+
+    void flush() {
+        writeBuffer();
+        if (file_.is_open()) {
+            file_.flush();
+        }
+    }
+
+private:
+    // 格式串多为调用点的字符串字面量，先按地址查找；地址命中但内容不同（非字面量格式串的内存被复用）时按内容重新查找
+    uint64_t formatId(const char* format) {
+        auto it = format_addresses_.find(format);
+        if (it != format_addresses_.end() && it->second.text == format) {
+            return it->second.id;
+        }
+
+        std::string text(format);
+        uint64_t id;
+        auto known = formats_.find(text);
+        if (known != formats_.end()) {
+            id = known->second;
+        } else {
+            id = formats_.size() + 1;
+            formats_.emplace(text, id);
+            buffer_.push_back(static_cast<unsigned char>(Tag::FORMAT));
+            putVarint(buffer_, id);
+            putString(buffer_, text.data(), text.size());
+        }
+        format_addresses_[format] = StringEntry{std::move(text), id};
+        return id;
+    }
+
+    // 记录中的字符串多为静态字符串或日志器名，先按地址查找；地址命中但内容不同（内存被复用）时按内容重新查找
+    uint64_t stringId(std::string_view value) {
+        if (value.empty()) {
+            return 0;
+        }
+
+        auto it = string_addresses_.find(value.data());
+        if (it != string_addresses_.end() && it->second.text == value) {
+            return it->second.id;
+        }
+
+        std::string text(value);
+        uint64_t id;
+        auto known = strings_.find(text);
+        if (known != strings_.end()) {
+            id = known->second;
+        } else {
+            id = strings_.size() + 1;
+            strings_.emplace(text, id);
+            buffer_.push_back(static_cast<unsigned char>(Tag::STRING));
+            putVarint(buffer_, id);
+            putString(buffer_, text.data(), text.size());
+        }
+        string_addresses_[value.data()] = StringEntry{std::move(text), id};
+        return id;
+    }
+
+    uint64_t threadId(std::thread::id thread) {
+        auto it = threads_.find(thread);
+        if (it != threads_.end()) {
+            return it->second;
+        }
+
+        uint64_t id = threads_.size() + 1;
+        threads_.emplace(thread, id);
+        buffer_.push_back(static_cast<unsigned char>(Tag::THREAD));
+        putVarint(buffer_, id);
+        putFixed(buffer_, static_cast<uint64_t>(std::hash<std::thread::id>()(thread)), 8);
+        return id;
+    }
+
+    void writeBuffer() {
+        if (!buffer_.empty() && file_.is_open()) {
+            file_.write(reinterpret_cast<const char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+        }
+        buffer_.clear();
+    }
+
+    std::ofstream file_;
+    std::vector<unsigned char> buffer_;
+    size_t buffer_limit_;
+
+    int64_t base_time_ = 0;
+    int64_t last_time_ = 0;
+    LogArgs text_args_;
+    std::vector<uint64_t> context_keys_;
+
+    struct StringEntry {
+        std::string text;
+        uint64_t id = 0;
+    };
+
+    std::unordered_map<std::string, uint64_t> formats_;
+    std::unordered_map<const char*, StringEntry> format_addresses_;
+    std::unordered_map<std::string, uint64_t> strings_;
+    std::unordered_map<const char*, StringEntry> string_addresses_;
+    std::unordered_map<std::thread::id, uint64_t> threads_;
+};
+
+BinaryFileAppender::BinaryFileAppender(const std::string& file_path, size_t buffer_size)
+    : pImpl_(std::make_unique<Impl>(file_path, buffer_size)) {}
+
+BinaryFileAppender::~BinaryFileAppender() = default;
+
+void BinaryFileAppender::append(const LogRecord& record) {
+    if (record.level < level_) {
+        return;
+    }
+    pImpl_->append(record);
+}
+
+void BinaryFileAppender::flush() {
+    pImpl_->flush();
+}
+
+bool BinaryFileAppender::isOpen() const {
+    return pImpl_->isOpen();
+}
+
+// BinaryLogReader实现
+class BinaryLogReader::Impl {
+public:
+    explicit Impl(const std::string& file_path) {
+        std::ifstream file(file_path, std::ios::binary);
+        if (!file) {
+            return;
+        }
+        data_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        if (data_.size() < sizeof(binary_log::kMagic) + 8 ||
+            std::memcmp(data_.data(), binary_log::kMagic, sizeof(binary_log::kMagic)) != 0) {
+            return;
+        }
+        pos_ = sizeof(binary_log::kMagic);
+        uint64_t base = 0;
+        readFixed(base, 8);
+        time_ = static_cast<int64_t>(base);
+        open_ = true;
+    }
+
+    bool isOpen() const {
+        return open_;
+    }
+
+    bool corrupted() const {
+        return corrupted_;
+    }
+
+    bool next(BinaryLogEntry& entry) {
+        if (!open_) {
+            return false;
+        }
+
+        while (pos_ < data_.size()) {
+            auto tag = static_cast<Tag>(data_[pos_++]);
+            bool ok = false;
+            switch (tag) {
+                case Tag::FORMAT:
+                    ok = readDefinition(formats_);
+                    break;
+                case Tag::STRING:
+                    ok = readDefinition(strings_);
+                    break;
+                case Tag::THREAD: {
+                    uint64_t id = 0;
+                    uint64_t native = 0;
+                    ok = readVarint(id) && readFixed(native, 8);
+                    if (ok) {
+                        threads_[id] = native;
+                    }
+                    break;
+                }
+                case Tag::EVENT:
+                    if (readEvent(entry)) {
+                        return true;
+                    }
+                    break;
+                case Tag::CONTEXT:
+                    ok = readContext(entry.record.context);
+                    break;
+            }
+            if (!ok) {
+                corrupted_ = true;
+                return false;
+            }
+        }
+        return false;
+    }
+
+private:
+    bool readVarint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && pos_ < data_.size(); shift += 7) {
+            unsigned char byte = data_[pos_++];
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool readFixed(uint64_t& value, size_t bytes) {
+        if (data_.size() - pos_ < bytes) {
+            return false;
+        }
+        value = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            value |= static_cast<uint64_t>(data_[pos_++]) << (8 * i);
+        }
+        return true;
+    }
+
+    bool readString(std::string& value) {
+        uint64_t size = 0;
+        if (!readVarint(size) || data_.size() - pos_ < size) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(data_.data() + pos_), static_cast<size_t>(size));
+        pos_ += static_cast<size_t>(size);
+        return true;
+    }
+
+    bool readDefinition(std::unordered_map<uint64_t, const std::string*>& table) {
+        uint64_t id = 0;
+        std::string value;
+        if (!readVarint(id) || !readString(value)) {
+            return false;
+        }
+        storage_.push_back(std::move(value));
+        table[id] = &storage_.back();
+        return true;
+    }
+
+    const std::string& lookup(const std::unordered_map<uint64_t, const std::string*>& table, uint64_t id) {
+        auto it = table.find(id);
+        return it != table.end() ? *it->second : empty_;
+    }
+
+    bool readContext(LogContext& context) {
+        uint64_t count = 0;
+        if (!readVarint(count)) {
+            return false;
+        }
+        context.clear();
+        for (uint64_t i = 0; i < count; ++i) {
+            uint64_t key_id = 0;
+            std::string value;
+            if (!readVarint(key_id) || !readString(value)) {
+                return false;
+            }
+            context.add(lookup(strings_, key_id), std::move(value));
+        }
+        has_context_ = true;
+        return true;
+    }
+
+    // 成功时返回true；失败时设置corrupted_
+    bool readEvent(BinaryLogEntry& entry) {
+        uint64_t format_id, logger_id, file_id, line, function_id, thread_id, delta, args_size;
+        if (pos_ >= data_.size()) {
+            corrupted_ = true;
+            return false;
+        }
+        unsigned char level = data_[pos_++];
+        if (!readVarint(format_id) || !readVarint(logger_id) || !readVarint(file_id) ||
+            !readVarint(line) || !readVarint(function_id) || !readVarint(thread_id) ||
+            !readVarint(delta) || pos_ >= data_.size()) {
+            corrupted_ = true;
+            return false;
+        }
+        unsigned char arg_count = data_[pos_++];
+        if (!readVarint(args_size) || data_.size() - pos_ < args_size ||
+            !entry.record.args.assign(data_.data() + pos_, static_cast<size_t>(args_size), arg_count)) {
+            corrupted_ = true;
+            return false;
+        }
+        pos_ += static_cast<size_t>(args_size);
+
+        auto format = formats_.find(format_id);
+        if (format == formats_.end()) {
+            corrupted_ = true;
+            return false;
+        }
+
+        time_ += unzigzag(delta);
+
+        LogRecord& record = entry.record;
+        record.level = static_cast<LogLevel>(level);
+        record.format = format->second->c_str();
+        record.message.clear();
+        record.logger_name = lookup(strings_, logger_id);
+        record.file = lookup(strings_, file_id);
+        record.line = static_cast<int>(line);
+        record.function = lookup(strings_, function_id);
+        record.timestamp = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(time_)));
+        if (!has_context_) {
+            record.context.clear();
+        }
+        has_context_ = false;
+
+        auto thread = threads_.find(thread_id);
+        entry.thread = thread != threads_.end() ? thread->second : 0;
+        return true;
+    }
+
+    std::vector<unsigned char> data_;
+    size_t pos_ = 0;
+    bool open_ = false;
+    bool corrupted_ = false;
+    int64_t time_ = 0;
+    bool has_context_ = false;    // 已读到属于下一条EVENT的CONTEXT
+
+    // 字典项的字符串地址在读取器生命周期内不变
+    std::deque<std::string> storage_;
+    std::unordered_map<uint64_t, const std::string*> formats_;
+    std::unordered_map<uint64_t, const std::string*> strings_;
+    std::unordered_map<uint64_t, uint64_t> threads_;
+    const std::string empty_;
+};
+
+BinaryLogReader::BinaryLogReader(const std::string& file_path)
+    : pImpl_(std::make_unique<Impl>(file_path)) {}
+
+BinaryLogReader::~BinaryLogReader() = default;
+
+bool BinaryLogReader::isOpen() const {
+    return pImpl_->isOpen();
+}
+
+bool BinaryLogReader::next(BinaryLogEntry& entry) {
+    return pImpl_->next(entry);
+}
+
+bool BinaryLogReader::corrupted() const {
+    return pImpl_->corrupted();
+}
+
+} // namespace sdk
@@ -0,0 +1,396 @@
+#include "sdk/logging/file_appender.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef SDK_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace sdk {
+
+namespace {
+
+// append()渲染整行用的线程缓冲区
+thread_local std::string t_line_buffer;
+
+std::FILE* openAppend(const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "ab");
+    if (file) {
+        // 缓冲由输出器自己管理，每个缓冲区对应一次write
+        std::setvbuf(file, nullptr, _IONBF, 0);
+    }
+    return file;
+}
+
+bool compressFile(const std::string& source, const std::string& target) {
+#ifdef SDK_HAVE_ZLIB
+    std::FILE* in = std::fopen(source.c_str(), "rb");
+    if (!in) {
+        return false;
+    }
+    gzFile out = gzopen(target.c_str(), "wb");
+    if (!out) {
+        std::fclose(in);
+        return false;
+    }
+
+    bool ok = true;
+    std::vector<char> chunk(64 * 1024);
+    size_t n = 0;
+    while ((n = std::fread(chunk.data(), 1, chunk.size(), in)) > 0) {
+        if (gzwrite(out, chunk.data(), static_cast<unsigned>(n)) != static_cast<int>(n)) {
+            ok = false;
+            break;
+        }
+    }
+    ok = ok && !std::ferror(in);
+    std::fclose(in);
+    ok = gzclose(out) == Z_OK && ok;
+    if (!ok) {
+        std::remove(target.c_str());
+    }
+    return ok;
+#else
+    (void)source;
+    (void)target;
+    return false;
+#endif
+}
+
+} // namespace
+
+// BufferedFileAppender实现
+// 调用线程在互斥锁下把行追加到current_，写满后移入pending_；写线程独占文件句柄，逐个写出pending_中的缓冲区，
+// 写完的缓冲区放回spare_复用容量。轮转时写线程只把当前文件改名为临时文件并重新打开，
+// 历史文件的编号移位和压缩交给轮转线程按顺序完成
+class BufferedFileAppender::Impl {
+public:
+    Impl(const std::string& file_path, const BufferedFileAppenderOptions& options)
+        : path_(file_path), options_(options) {
+        if (options_.buffer_size == 0) {
+            options_.buffer_size = 1;
+        }
+        if (options_.max_pending_buffers == 0) {
+            options_.max_pending_buffers = 1;
+        }
+        if (!compressionSupported(options_.compression)) {
+            options_.compression = LogCompression::NONE;
+        }
+
+        file_ = openAppend(path_);
+        open_ = file_ != nullptr;
+        std::error_code error;
+        auto size = std::filesystem::file_size(path_, error);
+        file_size_ = error ? 0 : static_cast<size_t>(size);
+
+        current_.reserve(options_.buffer_size);
+        writer_ = std::thread([this] { run(); });
+        if (options_.max_file_size > 0) {
+            rotator_ = std::thread([this] { runRotations(); });
+        }
+    }
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        space_cv_.notify_all();
+        writer_.join();
+
+        if (rotator_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(rotation_mutex_);
+                rotation_stopping_ = true;
+            }
+            rotation_cv_.notify_all();
+            rotator_.join();
+        }
+
+        if (file_) {
+            std::fclose(file_);
+        }
+    }
+
+    void write(std::string_view line, LogLevel level) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!current_.empty() && current_.size() + line.size() + 1 > options_.buffer_size) {
+            waitForSpace(lock);
+            submitLocked();
+        }
+        current_.append(line.data(), line.size());
+        current_.push_back('\n');
+
+        if (level >= options_.flush_level || current_.size() >= options_.buffer_size) {
+            waitForSpace(lock);
+            submitLocked();
+        }
+    }
+
+    void flush() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!current_.empty()) {
+                waitForSpace(lock);
+                submitLocked();
+            }
+            uint64_t target = submitted_;
+            done_cv_.wait(lock, [&] { return written_ >= target; });
+        }
+
+        std::unique_lock<std::mutex> lock(rotation_mutex_);
+        rotation_done_cv_.wait(lock, [&] { return rotations_done_ >= rotations_started_; });
+    }
+
+    bool isOpen() const {
+        return open_.load(std::memory_order_relaxed);
+    }
+
+    size_t rotationCount() const {
+        std::lock_guard<std::mutex> lock(rotation_mutex_);
+        return rotations_done_;
+    }
+
+private:
+    // 调用方持有mutex_
+    void waitForSpace(std::unique_lock<std::mutex>& lock) {
+        space_cv_.wait(lock, [&] { return stopping_ || pending_.size() < options_.max_pending_buffers; });
+    }
+
+    // 调用方持有mutex_
+    void submitLocked() {
+        pending_.push_back(std::move(current_));
+        if (spare_.empty()) {
+            current_ = std::string();
+            current_.reserve(options_.buffer_size);
+        } else {
+            current_ = std::move(spare_.back());
+            spare_.pop_back();
+        }
+        ++submitted_;
+        cv_.notify_one();
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            if (pending_.empty()) {
+                if (!current_.empty() && stopping_) {
+                    submitLocked();
+                    continue;
+                }
+                if (stopping_) {
+                    break;
+                }
+                bool woken = cv_.wait_for(lock, options_.flush_interval,
+                                          [&] { return stopping_ || !pending_.empty(); });
+                // 超时仍没有写满的缓冲区时写出当前缓冲区，限制日志的驻留时间
+                if (!woken && !current_.empty()) {
+                    submitLocked();
+                }
+                continue;
+            }
+
+            std::string buffer = std::move(pending_.front());
+            pending_.pop_front();
+            space_cv_.notify_all();
+            lock.unlock();
+
+            writeBuffer(buffer);
+            buffer.clear();
+
+            lock.lock();
+            spare_.push_back(std::move(buffer));
+            ++written_;
+            done_cv_.notify_all();
+        }
+    }
+
+    // 只在写线程上调用
+    void writeBuffer(const std::string& buffer) {
+        const size_t limit = options_.max_file_size;
+        size_t offset = 0;
+        while (offset < buffer.size()) {
+            size_t chunk = buffer.size() - offset;
+            if (limit > 0 && file_size_ + chunk > limit) {
+                // 在行边界处切分，保证每行完整地落在一个文件中
+                size_t room = limit > file_size_ ? limit - file_size_ : 0;
+                size_t cut = room > 0 ? buffer.rfind('\n', offset + room - 1) : std::string::npos;
+                if (cut != std::string::npos && cut >= offset) {
+                    chunk = cut + 1 - offset;
+                } else if (file_size_ > 0) {
+                    rotate();
+                    continue;
+                } else {
+                    // 单行超过文件上限，整行写入空文件
+                    cut = buffer.find('\n', offset);
+                    chunk = (cut == std::string::npos ? buffer.size() : cut + 1) - offset;
+                }
+            }
+
+            if (file_) {
+                std::fwrite(buffer.data() + offset, 1, chunk, file_);
+            }
+            file_size_ += chunk;
+            offset += chunk;
+
+            if (limit > 0 && file_size_ >= limit) {
+                rotate();
+            }
+        }
+    }
+
+    // 只在写线程上调用：改名和重新打开都很快，耗时的移位与压缩交给轮转线程
+    void rotate() {
+        if (file_) {
+            std::fclose(file_);
+            file_ = nullptr;
+        }
+
+        std::string segment = path_ + ".rotating." + std::to_string(++rotation_sequence_);
+        bool renamed = std::rename(path_.c_str(), segment.c_str()) == 0;
+
+        file_ = openAppend(path_);
+        open_ = file_ != nullptr;
+        file_size_ = 0;
+
+        if (renamed) {
+            {
+                std::lock_guard<std::mutex> lock(rotation_mutex_);
+                segments_.push_back(std::move(segment));
+                ++rotations_started_;
+            }
+            rotation_cv_.notify_one();
+        }
+    }
+
+    void runRotations() {
+        std::unique_lock<std::mutex> lock(rotation_mutex_);
+        for (;;) {
+            rotation_cv_.wait(lock, [&] { return rotation_stopping_ || !segments_.empty(); });
+            if (segments_.empty()) {
+                break;
+            }
+
+            std::string segment = std::move(segments_.front());
+            segments_.pop_front();
+            lock.unlock();
+
+            archive(segment);
+
+            lock.lock();
+            ++rotations_done_;
+            rotation_done_cv_.notify_all();
+        }
+    }
+
+    std::string historyPath(size_t index, bool compressed) const {
+        return path_ + "." + std::to_string(index) + (compressed ? ".gz" : "");
+    }
+
+    // 历史文件依次后移一位，再把刚轮转出的文件放到第1位
+    void archive(const std::string& segment) {
+        const bool compressed = options_.compression != LogCompression::NONE;
+        if (options_.max_files == 0) {
+            std::remove(segment.c_str());
+            return;
+        }
+
+        std::remove(historyPath(options_.max_files, compressed).c_str());
+        for (size_t i = options_.max_files; i > 1; --i) {
+            std::rename(historyPath(i - 1, compressed).c_str(), historyPath(i, compressed).c_str());
+        }
+
+        if (compressed && compressFile(segment, historyPath(1, true))) {
+            std::remove(segment.c_str());
+        } else {
+            std::rename(segment.c_str(), historyPath(1, false).c_str());
+        }
+    }
+
+    const std::string path_;
+    BufferedFileAppenderOptions options_;
+
+    // 由写线程独占
+    std::FILE* file_ = nullptr;
+    size_t file_size_ = 0;
+    uint64_t rotation_sequence_ = 0;
+    std::atomic<bool> open_{false};
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable space_cv_;
+    std::condition_variable done_cv_;
+    std::string current_;
+    std::deque<std::string> pending_;
+    std::vector<std::string> spare_;
+    uint64_t submitted_ = 0;
+    uint64_t written_ = 0;
+    bool stopping_ = false;
+
+    mutable std::mutex rotation_mutex_;
+    std::condition_variable rotation_cv_;
+    std::condition_variable rotation_done_cv_;
+    std::deque<std::string> segments_;
+    size_t rotations_started_ = 0;
+    size_t rotations_done_ = 0;
+    bool rotation_stopping_ = false;
+
+    std::thread writer_;
+    std::thread rotator_;
+};
+
+BufferedFileAppender::BufferedFileAppender(const std::string& file_path, const BufferedFileAppenderOptions& options)
+    : pImpl_(std::make_unique<Impl>(file_path, options)) {
+    formatter_ = std::make_unique<DefaultFormatter>();
+}
+
+BufferedFileAppender::~BufferedFileAppender() = default;
+
+void BufferedFileAppender::append(const LogRecord& record) {
+    if (record.level < level_) {
+        return;
+    }
+
+    std::string& line = t_line_buffer;
+    line.clear();
+    formatter_->formatTo(record, line);
+    pImpl_->write(line, record.level);
+}
+
+void BufferedFileAppender::appendFormatted(const LogRecord& record, std::string_view line) {
+    if (record.level < level_) {
+        return;
+    }
+    pImpl_->write(line, record.level);
+}
+
+void BufferedFileAppender::flush() {
+    pImpl_->flush();
+}
+
+bool BufferedFileAppender::isOpen() const {
+    return pImpl_->isOpen();
+}
+
+size_t BufferedFileAppender::rotationCount() const {
+    return pImpl_->rotationCount();
+}
+
+bool BufferedFileAppender::compressionSupported(LogCompression compression) {
+#ifdef SDK_HAVE_ZLIB
+    return compression == LogCompression::NONE || compression == LogCompression::GZIP;
+#else
+    return compression == LogCompression::NONE;
+#endif
+}
+
+} // namespace sdk
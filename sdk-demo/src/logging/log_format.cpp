@@ -0,0 +1,318 @@
+#include "sdk/logging/log_format.h"
+
+#include <charconv>
+#include <cstdio>
+
+namespace sdk {
+
+namespace {
+
+// 占位符中的格式说明
+struct FormatSpec {
+    char fill = ' ';
+    char align = 0;       // '<' '>' '^'，0表示按类型默认对齐
+    char sign = 0;        // '+' ' '
+    bool alternate = false;
+    bool zero_pad = false;
+    int width = 0;
+    int precision = -1;
+    char type = 0;
+};
+
+bool isAlign(char c) {
+    return c == '<' || c == '>' || c == '^';
+}
+
+void parseSpec(const char* begin, const char* end, FormatSpec& spec) {
+    const char* p = begin;
+    if (end - p >= 2 && isAlign(p[1])) {
+        spec.fill = p[0];
+        spec.align = p[1];
+        p += 2;
+    } else if (p < end && isAlign(*p)) {
+        spec.align = *p++;
+    }
+    if (p < end && (*p == '+' || *p == ' ' || *p == '-')) {
+        spec.sign = *p == '-' ? 0 : *p;
+        ++p;
+    }
+    if (p < end && *p == '#') {
+        spec.alternate = true;
+        ++p;
+    }
+    if (p < end && *p == '0') {
+        spec.zero_pad = true;
+        ++p;
+    }
+    while (p < end && *p >= '0' && *p <= '9') {
+        spec.width = spec.width * 10 + (*p++ - '0');
+    }
+    if (p < end && *p == '.') {
+        ++p;
+        spec.precision = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            spec.precision = spec.precision * 10 + (*p++ - '0');
+        }
+    }
+    if (p < end) {
+        spec.type = *p;
+    }
+}
+
+// 按宽度与对齐方式写出，prefix_len为符号和进制前缀的长度（补零时插在其后）
+void writePadded(std::string& out, const char* body, size_t len, size_t prefix_len,
+                 const FormatSpec& spec, bool numeric) {
+    size_t width = spec.width > 0 ? static_cast<size_t>(spec.width) : 0;
+    if (len >= width) {
+        out.append(body, len);
+        return;
+    }
+
+    size_t padding = width - len;
+    if (numeric && spec.zero_pad && spec.align == 0) {
+        out.append(body, prefix_len);
+        out.append(padding, '0');
+        out.append(body + prefix_len, len - prefix_len);
+        return;
+    }
+
+    char align = spec.align ? spec.align : (numeric ? '>' : '<');
+    size_t left = align == '>' ? padding : (align == '^' ? padding / 2 : 0);
+    out.append(left, spec.fill);
+    out.append(body, len);
+    out.append(padding - left, spec.fill);
+}
+
+void formatInteger(std::string& out, uint64_t magnitude, bool negative, const FormatSpec& spec) {
+    int base = 10;
+    const char* prefix = "";
+    switch (spec.type) {
+        case 'x': base = 16; prefix = "0x"; break;
+        case 'X': base = 16; prefix = "0X"; break;
+        case 'o': base = 8; prefix = "0"; break;
+        case 'b': base = 2; prefix = "0b"; break;
+        default: break;
+    }
+
+    char buffer[80];
+    size_t len = 0;
+    if (negative) {
+        buffer[len++] = '-';
+    } else if (spec.sign) {
+        buffer[len++] = spec.sign;
+    }
+    if (spec.alternate) {
+        for (const char* p = prefix; *p; ++p) {
+            buffer[len++] = *p;
+        }
+    }
+    size_t prefix_len = len;
+
+    auto result = std::to_chars(buffer + len, buffer + sizeof(buffer), magnitude, base);
+    if (spec.type == 'X') {
+        for (char* p = buffer + len; p < result.ptr; ++p) {
+            if (*p >= 'a' && *p <= 'f') {
+                *p = static_cast<char>(*p - 'a' + 'A');
+            }
+        }
+    }
+    len = static_cast<size_t>(result.ptr - buffer);
+    writePadded(out, buffer, len, prefix_len, spec, true);
+}
+
+void formatDouble(std::string& out, double value, const FormatSpec& spec) {
+    char conversion = 'g';
+    switch (spec.type) {
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            conversion = spec.type;
+            break;
+        default:
+            break;
+    }
+
+    // 未指定精度时使用15位有效数字，足以表示常见数值且不产生二进制舍入尾数
+    int precision = spec.precision >= 0 ? spec.precision : (conversion == 'g' ? 15 : 6);
+
+    char pattern[16];
+    size_t n = 0;
+    pattern[n++] = '%';
+    if (spec.sign) {
+        pattern[n++] = spec.sign;
+    }
+    if (spec.alternate) {
+        pattern[n++] = '#';
+    }
+    pattern[n++] = '.';
+    pattern[n++] = '*';
+    pattern[n++] = conversion;
+    pattern[n] = '\0';
+
+    char buffer[512];
+    int len = std::snprintf(buffer, sizeof(buffer), pattern, precision, value);
+    if (len < 0) {
+        return;
+    }
+    len = std::min(len, static_cast<int>(sizeof(buffer) - 1));
+    size_t prefix_len = (buffer[0] == '-' || buffer[0] == '+' || buffer[0] == ' ') ? 1 : 0;
+    writePadded(out, buffer, static_cast<size_t>(len), prefix_len, spec, true);
+}
+
+void formatArg(std::string& out, const LogArg& arg, const FormatSpec& spec) {
+    switch (arg.type) {
+        case LogArgType::INT64:
+            if (spec.type == 'c') {
+                char c = static_cast<char>(arg.i);
+                writePadded(out, &c, 1, 0, spec, false);
+            } else {
+                uint64_t magnitude = arg.i < 0 ? 0 - static_cast<uint64_t>(arg.i) : static_cast<uint64_t>(arg.i);
+                formatInteger(out, magnitude, arg.i < 0, spec);
+            }
+            break;
+
+        case LogArgType::UINT64:
+            if (spec.type == 'c') {
+                char c = static_cast<char>(arg.u);
+                writePadded(out, &c, 1, 0, spec, false);
+            } else {
+                formatInteger(out, arg.u, false, spec);
+            }
+            break;
+
+        case LogArgType::DOUBLE:
+            formatDouble(out, arg.d, spec);
+            break;
+
+        case LogArgType::BOOL:
+            if (spec.type == 'd') {
+                formatInteger(out, arg.b ? 1 : 0, false, spec);
+            } else {
+                writePadded(out, arg.b ? "true" : "false", arg.b ? 4 : 5, 0, spec, false);
+            }
+            break;
+
+        case LogArgType::CHAR:
+            if (spec.type == 'd' || spec.type == 'x' || spec.type == 'X') {
+                formatInteger(out, static_cast<unsigned char>(arg.c), false, spec);
+            } else {
+                writePadded(out, &arg.c, 1, 0, spec, false);
+            }
+            break;
+
+        case LogArgType::STRING: {
+            size_t len = arg.len;
+            if (spec.precision >= 0) {
+                len = std::min(len, static_cast<size_t>(spec.precision));
+            }
+            writePadded(out, arg.str, len, 0, spec, false);
+            break;
+        }
+
+        case LogArgType::POINTER: {
+            FormatSpec pointer_spec = spec;
+            pointer_spec.type = 'x';
+            pointer_spec.alternate = true;
+            formatInteger(out, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(arg.p)), false, pointer_spec);
+            break;
+        }
+    }
+}
+
+} // namespace
+
+bool LogArgs::next(size_t& offset, LogArg& arg) const {
+    if (offset >= size_) {
+        return false;
+    }
+
+    arg.type = static_cast<LogArgType>(data_[offset]);
+    const unsigned char* payload = data_ + offset + 1;
+    size_t remaining = size_ - offset - 1;
+
+    auto read = [&](void* value, size_t size) {
+        if (remaining < size) {
+            return false;
+        }
+        std::memcpy(value, payload, size);
+        offset += 1 + size;
+        return true;
+    };
+
+    switch (arg.type) {
+        case LogArgType::INT64:
+            return read(&arg.i, sizeof(arg.i));
+        case LogArgType::UINT64:
+            return read(&arg.u, sizeof(arg.u));
+        case LogArgType::DOUBLE:
+            return read(&arg.d, sizeof(arg.d));
+        case LogArgType::BOOL:
+            return read(&arg.b, sizeof(arg.b));
+        case LogArgType::CHAR:
+            return read(&arg.c, sizeof(arg.c));
+        case LogArgType::POINTER:
+            return read(&arg.p, sizeof(arg.p));
+        case LogArgType::STRING: {
+            uint32_t len = 0;
+            if (remaining < sizeof(len)) {
+                return false;
+            }
+            std::memcpy(&len, payload, sizeof(len));
+            if (remaining - sizeof(len) < len) {
+                return false;
+            }
+            arg.str = reinterpret_cast<const char*>(payload + sizeof(len));
+            arg.len = len;
+            offset += 1 + sizeof(len) + len;
+            return true;
+        }
+    }
+    return false;
+}
+
+void formatLogMessage(std::string& out, const char* format, const LogArgs& args) {
+    out.clear();
+    if (!format) {
+        return;
+    }
+
+    size_t offset = 0;
+    LogArg arg;
+    for (const char* p = format; *p; ++p) {
+        if (*p == '{' && p[1] == '{') {
+            out.push_back('{');
+            ++p;
+            continue;
+        }
+        if (*p == '}' && p[1] == '}') {
+            out.push_back('}');
+            ++p;
+            continue;
+        }
+        if (*p != '{') {
+            out.push_back(*p);
+            continue;
+        }
+
+        const char* close = p + 1;
+        while (*close && *close != '}') {
+            ++close;
+        }
+        if (!*close) {
+            out.append(p);
+            return;
+        }
+
+        if (!args.next(offset, arg)) {
+            // 参数不足，保留占位符
+            out.append(p, close + 1);
+        } else {
+            FormatSpec spec;
+            if (p[1] == ':') {
+                parseSpec(p + 2, close, spec);
+            }
+            formatArg(out, arg, spec);
+        }
+        p = close;
+    }
+}
+
+} // namespace sdk
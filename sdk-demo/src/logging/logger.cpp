@@ -1,4 +1,5 @@
 #include "sdk/logging/logger.h"
+#include "sdk/metrics/tracing.h"
 #include "sdk/sdk_c_api.h"
 
 #include <spdlog/spdlog.h>
@@ -7,10 +8,22 @@
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/async.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
-#include <cstdarg>
+#include <unordered_set>
 
 namespace sdk {
 
@@ -57,70 +70,544 @@ static LogLevel convertSpdlogLevel(spdlog::level::level_enum level) {
     }
 }
 
-// DefaultFormatter实现
-DefaultFormatter::DefaultFormatter(const std::string& pattern) : pattern_(pattern) {}
+namespace {
 
-std::string DefaultFormatter::format(const LogRecord& record) {
-    // 简化实现，实际项目中应该使用更完整的格式化
-    std::ostringstream oss;
-    
-    // 时间戳
-    auto time_t = std::chrono::system_clock::to_time_t(record.timestamp);
-    auto tm = *std::localtime(&time_t);
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-    
-    // 日志级别
-    oss << " [";
-    switch (record.level) {
+const char* levelName(LogLevel level) {
+    switch (level) {
         case LogLevel::TRACE:
-            oss << "TRACE";
-            break;
+            return "TRACE";
         case LogLevel::DEBUG:
-            oss << "DEBUG";
-            break;
+            return "DEBUG";
         case LogLevel::INFO:
-            oss << "INFO";
-            break;
+            return "INFO";
         case LogLevel::WARN:
-            oss << "WARN";
-            break;
+            return "WARN";
         case LogLevel::ERROR:
-            oss << "ERROR";
-            break;
+            return "ERROR";
         case LogLevel::CRITICAL:
-            oss << "CRITICAL";
-            break;
+            return "CRITICAL";
         default:
-            oss << "UNKNOWN";
-            break;
+            return "UNKNOWN";
+    }
+}
+
+// 固定宽度补零的十进制
+void appendPadded(std::string& out, uint64_t value, int width) {
+    char buffer[20];
+    int len = 0;
+    do {
+        buffer[len++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0 && len < static_cast<int>(sizeof(buffer)));
+    for (int i = len; i < width; ++i) {
+        out.push_back('0');
+    }
+    while (len > 0) {
+        out.push_back(buffer[--len]);
+    }
+}
+
+// 文本格式中上下文接在消息之后：" [key=value, key=value]"
+void appendContext(std::string& out, const LogContext& context) {
+    if (context.empty()) {
+        return;
+    }
+    out += " [";
+    for (size_t i = 0; i < context.size(); ++i) {
+        if (i > 0) {
+            out += ", ";
+        }
+        out += context[i].first;
+        out.push_back('=');
+        out += context[i].second;
+    }
+    out.push_back(']');
+}
+
+bool toLocalTime(std::time_t time, std::tm& result) {
+#ifdef _WIN32
+    return localtime_s(&result, &time) == 0;
+#else
+    return localtime_r(&time, &result) != nullptr;
+#endif
+}
+
+// 单次遍历转义，连续的普通字符整段追加
+void appendJsonString(std::string& out, std::string_view value) {
+    static const char* const kHex = "0123456789abcdef";
+    out.push_back('"');
+    size_t run = 0;
+    for (size_t i = 0; i < value.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out.append(value.data() + run, i - run);
+        run = i + 1;
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default:
+                out += "\\u00";
+                out.push_back(kHex[c >> 4]);
+                out.push_back(kHex[c & 0xf]);
+                break;
+        }
+    }
+    out.append(value.data() + run, value.size() - run);
+    out.push_back('"');
+}
+
+std::atomic<uint64_t> g_formatter_keys{0};
+
+// 按线程缓存最近一秒的时间块，少量槽位供同一线程上的多个格式化器共用
+struct TimeCacheEntry {
+    uint64_t key = 0;
+    std::time_t second = 0;
+    std::vector<std::string> blocks;
+};
+
+struct TimeCache {
+    std::array<TimeCacheEntry, 4> entries;
+    size_t next = 0;
+};
+
+thread_local TimeCache t_time_cache;
+
+// 输出器格式化用的线程缓冲区
+thread_local std::string t_format_buffer;
+thread_local std::string t_line_buffer;
+
+// Logger分发时按格式化器缓存本条记录的渲染结果，字符串容量跨记录复用
+struct RenderedLine {
+    const LogFormatter* formatter = nullptr;
+    std::string text;
+};
+
+thread_local std::vector<RenderedLine> t_rendered_lines;
+
+} // namespace
+
+// DefaultFormatter实现
+DefaultFormatter::DefaultFormatter(const std::string& pattern)
+    : pattern_(pattern), cache_key_(g_formatter_keys.fetch_add(1, std::memory_order_relaxed) + 1) {
+    compile();
+}
+
+void DefaultFormatter::compile() {
+    std::vector<Token> raw;
+    auto addLiteral = [&raw](const char* text, size_t len) {
+        if (!raw.empty() && raw.back().field == Field::LITERAL) {
+            raw.back().literal.append(text, len);
+        } else {
+            raw.push_back(Token{Field::LITERAL, std::string(text, len)});
+        }
+    };
+    auto addField = [&raw](Field field) {
+        raw.push_back(Token{field, std::string()});
+    };
+
+    for (size_t i = 0; i < pattern_.size(); ++i) {
+        char c = pattern_[i];
+        if (c != '%' || i + 1 == pattern_.size()) {
+            addLiteral(&c, 1);
+            continue;
+        }
+
+        char flag = pattern_[++i];
+        switch (flag) {
+            case 'Y': addField(Field::YEAR); break;
+            case 'm': addField(Field::MONTH); break;
+            case 'd': addField(Field::DAY); break;
+            case 'H': addField(Field::HOUR); break;
+            case 'M': addField(Field::MINUTE); break;
+            case 'S': addField(Field::SECOND); break;
+            case 'T':
+                addField(Field::HOUR);
+                addLiteral(":", 1);
+                addField(Field::MINUTE);
+                addLiteral(":", 1);
+                addField(Field::SECOND);
+                break;
+            case 'e': addField(Field::MILLIS); break;
+            case 'f': addField(Field::MICROS); break;
+            case 'F': addField(Field::NANOS); break;
+            case 'l': addField(Field::LEVEL); break;
+            case 'L': addField(Field::SHORT_LEVEL); break;
+            case 'n': addField(Field::LOGGER); break;
+            case 'v': addField(Field::MESSAGE); break;
+            case 't': addField(Field::THREAD); break;
+            case 's': addField(Field::FILE_NAME); break;
+            case 'g': addField(Field::FILE_PATH); break;
+            case '#': addField(Field::LINE); break;
+            case '!': addField(Field::FUNCTION); break;
+            case '%': addLiteral("%", 1); break;
+            default: {
+                // 不认识的标志原样输出
+                char unknown[2] = {'%', flag};
+                addLiteral(unknown, 2);
+                break;
+            }
+        }
+    }
+
+    auto isSecondField = [](Field field) {
+        return field >= Field::YEAR && field <= Field::SECOND;
+    };
+
+    // 从第一个秒级字段到该段最后一个秒级字段合并为一个时间块
+    tokens_.clear();
+    time_blocks_.clear();
+    for (size_t i = 0; i < raw.size();) {
+        if (!isSecondField(raw[i].field)) {
+            tokens_.push_back(std::move(raw[i++]));
+            continue;
+        }
+
+        size_t last = i;
+        for (size_t j = i; j < raw.size() && (isSecondField(raw[j].field) || raw[j].field == Field::LITERAL); ++j) {
+            if (isSecondField(raw[j].field)) {
+                last = j;
+            }
+        }
+
+        Token block{Field::TIME_BLOCK, std::string(), time_blocks_.size()};
+        time_blocks_.emplace_back(std::make_move_iterator(raw.begin() + i),
+                                  std::make_move_iterator(raw.begin() + last + 1));
+        tokens_.push_back(std::move(block));
+        i = last + 1;
     }
-    oss << "]";
+}
+
+std::string DefaultFormatter::format(const LogRecord& record) {
+    std::string out;
+    formatTo(record, out);
+    return out;
+}
+
+bool DefaultFormatter::sameOutput(const LogFormatter& other) const {
+    auto formatter = dynamic_cast<const DefaultFormatter*>(&other);
+    return formatter && formatter->pattern_ == pattern_;
+}
+
+void DefaultFormatter::formatTo(const LogRecord& record, std::string& out) {
+    auto since_epoch = record.timestamp.time_since_epoch();
+    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since_epoch);
+    auto nanos = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch - seconds).count());
+    std::time_t second = static_cast<std::time_t>(seconds.count());
+
+    // 查找本格式化器在当前线程的时间缓存，秒数变化时重新渲染全部时间块
+    TimeCacheEntry* cache = nullptr;
+    if (!time_blocks_.empty()) {
+        for (auto& entry : t_time_cache.entries) {
+            if (entry.key == cache_key_) {
+                cache = &entry;
+                break;
+            }
+        }
+        bool stale = cache == nullptr || cache->second != second;
+        if (!cache) {
+            cache = &t_time_cache.entries[t_time_cache.next++ % t_time_cache.entries.size()];
+            cache->key = cache_key_;
+        }
+        if (stale) {
+            std::tm tm{};
+            toLocalTime(second, tm);
+            cache->second = second;
+            cache->blocks.resize(time_blocks_.size());
+            for (size_t b = 0; b < time_blocks_.size(); ++b) {
+                std::string& rendered = cache->blocks[b];
+                rendered.clear();
+                for (const auto& token : time_blocks_[b]) {
+                    switch (token.field) {
+                        case Field::YEAR: appendPadded(rendered, static_cast<uint64_t>(tm.tm_year + 1900), 4); break;
+                        case Field::MONTH: appendPadded(rendered, static_cast<uint64_t>(tm.tm_mon + 1), 2); break;
+                        case Field::DAY: appendPadded(rendered, static_cast<uint64_t>(tm.tm_mday), 2); break;
+                        case Field::HOUR: appendPadded(rendered, static_cast<uint64_t>(tm.tm_hour), 2); break;
+                        case Field::MINUTE: appendPadded(rendered, static_cast<uint64_t>(tm.tm_min), 2); break;
+                        case Field::SECOND: appendPadded(rendered, static_cast<uint64_t>(tm.tm_sec), 2); break;
+                        default: rendered += token.literal; break;
+                    }
+                }
+            }
+        }
+    }
+
+    for (const auto& token : tokens_) {
+        switch (token.field) {
+            case Field::LITERAL:
+                out += token.literal;
+                break;
+            case Field::TIME_BLOCK:
+                out += cache->blocks[token.block];
+                break;
+            case Field::MILLIS:
+                appendPadded(out, nanos / 1000000, 3);
+                break;
+            case Field::MICROS:
+                appendPadded(out, nanos / 1000, 6);
+                break;
+            case Field::NANOS:
+                appendPadded(out, nanos, 9);
+                break;
+            case Field::LEVEL:
+                out += levelName(record.level);
+                break;
+            case Field::SHORT_LEVEL:
+                out.push_back(levelName(record.level)[0]);
+                break;
+            case Field::LOGGER:
+                out += record.logger_name;
+                break;
+            case Field::MESSAGE:
+                out += record.message;
+                appendContext(out, record.context);
+                break;
+            case Field::THREAD:
+                appendPadded(out, static_cast<uint64_t>(std::hash<std::thread::id>()(record.thread_id)), 1);
+                break;
+            case Field::FILE_NAME: {
+                size_t slash = record.file.find_last_of("/\\");
+                out += slash == std::string_view::npos ? record.file : record.file.substr(slash + 1);
+                break;
+            }
+            case Field::FILE_PATH:
+                out += record.file;
+                break;
+            case Field::LINE:
+                appendPadded(out, static_cast<uint64_t>(record.line < 0 ? 0 : record.line), 1);
+                break;
+            case Field::FUNCTION:
+                out += record.function;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+// JsonFormatter实现
+std::string JsonFormatter::format(const LogRecord& record) {
+    std::string out;
+    formatTo(record, out);
+    return out;
+}
+
+bool JsonFormatter::sameOutput(const LogFormatter& other) const {
+    return dynamic_cast<const JsonFormatter*>(&other) != nullptr;
+}
+
+void JsonFormatter::formatTo(const LogRecord& record, std::string& out) {
+    auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(record.timestamp.time_since_epoch()).count();
+
+    out += "{\"timestamp\":\"";
+    out += std::to_string(millis);
+    out += "\",\"level\":\"";
+    out += std::to_string(static_cast<int>(record.level));
+    out += "\",\"logger\":";
+    appendJsonString(out, record.logger_name);
+    out += ",\"message\":";
+    appendJsonString(out, record.message);
+    out += ",\"file\":";
+    appendJsonString(out, record.file);
+    out += ",\"line\":";
+    out += std::to_string(record.line);
+    out += ",\"function\":";
+    appendJsonString(out, record.function);
+
+    if (!record.context.empty()) {
+        out += ",\"context\":{";
+        for (size_t i = 0; i < record.context.size(); ++i) {
+            if (i > 0) {
+                out.push_back(',');
+            }
+            appendJsonString(out, record.context[i].first);
+            out.push_back(':');
+            appendJsonString(out, record.context[i].second);
+        }
+        out.push_back('}');
+    }
+    out.push_back('}');
+}
+
+void formatRecordMessage(LogRecord& record) {
+    if (record.format) {
+        formatLogMessage(record.message, record.format, record.args);
+        record.format = nullptr;
+    }
+}
+
+// LogCallSite实现
+// 调用点组成一个只增不减的侵入式链表，登记在互斥锁下压入表头，遍历不加锁
+namespace {
+std::atomic<LogCallSite*> g_call_sites{nullptr};
+std::atomic<uint32_t> g_next_site_id{0};
+std::mutex g_site_mutex;
+
+// LogManager设置的调用点规则，按设置顺序保存，新登记的调用点依次应用
+struct CallSiteRule {
+    enum Kind { ENABLE, SAMPLING, RATE_LIMIT };
     
-    // 日志器名称
-    if (!record.logger_name.empty()) {
-        oss << " [" << record.logger_name << "]";
+    Kind kind;
+    std::string file;
+    int line;           // 0表示不限行号
+    bool enabled;
+    uint32_t one_in_n;
+    double per_second;
+    uint32_t burst;
+    
+    bool matches(const LogCallSite& site) const {
+        if (line != 0 && site.location().line != line) {
+            return false;
+        }
+        if (file.empty()) {
+            return true;
+        }
+        const char* site_file = site.location().file;
+        if (!site_file) {
+            return false;
+        }
+        size_t len = std::strlen(site_file);
+        return len >= file.size() && file.compare(0, file.size(), site_file + len - file.size()) == 0;
     }
     
-    // 消息
-    oss << " " << record.message;
+    void apply(LogCallSite& site) const {
+        switch (kind) {
+            case ENABLE: site.setEnabled(enabled); break;
+            case SAMPLING: site.setSampling(one_in_n); break;
+            case RATE_LIMIT: site.setRateLimit(per_second, burst); break;
+        }
+    }
+};
+
+std::vector<CallSiteRule> g_site_rules;
+
+// 解析"file"或"file:line"，行号部分不是数字时整体视为文件名
+CallSiteRule makeRule(CallSiteRule::Kind kind, const std::string& selector) {
+    CallSiteRule rule{kind, selector, 0, true, 0, 0.0, 0};
+    size_t colon = selector.rfind(':');
+    if (colon != std::string::npos && colon + 1 < selector.size() &&
+        selector.find_first_not_of("0123456789", colon + 1) == std::string::npos) {
+        rule.file = selector.substr(0, colon);
+        rule.line = std::atoi(selector.c_str() + colon + 1);
+    }
+    return rule;
+}
+
+// 调用方需持有g_site_mutex
+void addRuleLocked(const CallSiteRule& rule) {
+    g_site_rules.push_back(rule);
+    LogCallSite::forEach([&rule](LogCallSite& site) {
+        if (rule.matches(site)) {
+            rule.apply(site);
+        }
+    });
+}
+
+int64_t steadyNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+uint32_t LogCallSite::registerSite() {
+    // 多个线程可能同时首次使用同一调用点，只允许一个登记
+    std::lock_guard<std::mutex> lock(g_site_mutex);
+    uint32_t current = id_.load(std::memory_order_acquire);
+    if (current != 0) {
+        return current;
+    }
     
-    return oss.str();
+    for (const auto& rule : g_site_rules) {
+        if (rule.matches(*this)) {
+            rule.apply(*this);
+        }
+    }
+    
+    next_ = g_call_sites.load(std::memory_order_relaxed);
+    g_call_sites.store(this, std::memory_order_release);
+    uint32_t id = g_next_site_id.fetch_add(1, std::memory_order_relaxed) + 1;
+    id_.store(id, std::memory_order_release);
+    return id;
 }
 
-// JsonFormatter实现
-std::string JsonFormatter::format(const LogRecord& record) {
-    std::ostringstream oss;
-    oss << "{";
-    oss << "\"timestamp\":\"" << std::chrono::duration_cast<std::chrono::milliseconds>(
-        record.timestamp.time_since_epoch()).count() << "\",";
-    oss << "\"level\":\"" << static_cast<int>(record.level) << "\",";
-    oss << "\"logger\":\"" << record.logger_name << "\",";
-    oss << "\"message\":\"" << record.message << "\",";
-    oss << "\"file\":\"" << record.file << "\",";
-    oss << "\"line\":" << record.line << ",";
-    oss << "\"function\":\"" << record.function << "\"";
-    oss << "}";
-    return oss.str();
+bool LogCallSite::admit(uint32_t flags) {
+    if (flags & kDisabled) {
+        suppressed_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    
+    if (flags & kSampled) {
+        uint32_t every = sample_every_.load(std::memory_order_relaxed);
+        if (every > 1 && sample_counter_.fetch_add(1, std::memory_order_relaxed) % every != 0) {
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    
+    if (flags & kRateLimited) {
+        int64_t interval = rate_interval_ns_.load(std::memory_order_relaxed);
+        int64_t tolerance = rate_tolerance_ns_.load(std::memory_order_relaxed);
+        if (interval > 0) {
+            int64_t now = steadyNanos();
+            int64_t tat = tat_ns_.load(std::memory_order_relaxed);
+            for (;;) {
+                int64_t next = std::max(tat, now) + interval;
+                // 理论到达时间超前当前时间超过突发容量，说明令牌已耗尽
+                if (next - now > tolerance + interval) {
+                    suppressed_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                if (tat_ns_.compare_exchange_weak(tat, next, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void LogCallSite::updateFlag(uint32_t flag, bool set) {
+    if (set) {
+        flags_.fetch_or(flag, std::memory_order_relaxed);
+    } else {
+        flags_.fetch_and(~flag, std::memory_order_relaxed);
+    }
+}
+
+void LogCallSite::setEnabled(bool enabled) {
+    updateFlag(kDisabled, !enabled);
+}
+
+void LogCallSite::setSampling(uint32_t one_in_n) {
+    sample_every_.store(one_in_n, std::memory_order_relaxed);
+    sample_counter_.store(0, std::memory_order_relaxed);
+    updateFlag(kSampled, one_in_n > 1);
+}
+
+void LogCallSite::setRateLimit(double per_second, uint32_t burst) {
+    if (!(per_second > 0.0)) {
+        updateFlag(kRateLimited, false);
+        rate_interval_ns_.store(0, std::memory_order_relaxed);
+        return;
+    }
+    
+    int64_t interval = std::max<int64_t>(1, static_cast<int64_t>(1e9 / per_second));
+    rate_interval_ns_.store(interval, std::memory_order_relaxed);
+    rate_tolerance_ns_.store(interval * (std::max<uint32_t>(burst, 1) - 1), std::memory_order_relaxed);
+    tat_ns_.store(0, std::memory_order_relaxed);
+    updateFlag(kRateLimited, true);
+}
+
+void LogCallSite::forEach(const std::function<void(LogCallSite&)>& visitor) {
+    for (LogCallSite* site = g_call_sites.load(std::memory_order_acquire); site; site = site->next_) {
+        visitor(*site);
+    }
 }
 
 // LogAppender实现
@@ -142,13 +629,28 @@ void ConsoleAppender::append(const LogRecord& record) {
         return;
     }
     
-    std::string formatted = formatter_->format(record);
+    std::string& line = t_line_buffer;
+    line.clear();
+    formatter_->formatTo(record, line);
+    appendFormatted(record, line);
+}
+
+void ConsoleAppender::appendFormatted(const LogRecord& record, std::string_view line) {
+    if (record.level < level_) {
+        return;
+    }
     
+    std::string& buffer = t_format_buffer;
+    buffer.clear();
     if (use_colors_) {
-        std::cout << getColorCode(record.level) << formatted << "\033[0m" << std::endl;
+        buffer += getColorCode(record.level);
+        buffer += line;
+        buffer += "\033[0m";
     } else {
-        std::cout << formatted << std::endl;
+        buffer += line;
     }
+    buffer.push_back('\n');
+    std::cout.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
 }
 
 void ConsoleAppender::flush() {
@@ -192,10 +694,28 @@ void FileAppender::append(const LogRecord& record) {
         return;
     }
     
-    std::string formatted = formatter_->format(record);
-    *file_ << formatted << std::endl;
+    std::string& buffer = t_format_buffer;
+    buffer.clear();
+    formatter_->formatTo(record, buffer);
+    buffer.push_back('\n');
+    write(buffer);
+}
+
+void FileAppender::appendFormatted(const LogRecord& record, std::string_view line) {
+    if (record.level < level_ || !file_ || !file_->is_open()) {
+        return;
+    }
+    
+    std::string& buffer = t_format_buffer;
+    buffer.assign(line.data(), line.size());
+    buffer.push_back('\n');
+    write(buffer);
+}
+
+void FileAppender::write(const std::string& buffer) {
+    file_->write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
     
-    current_size_ += formatted.length() + 1;
+    current_size_ += buffer.size();
     
     // 检查是否需要轮转
     if (max_size_ > 0 && current_size_ >= max_size_) {
@@ -230,19 +750,376 @@ void FileAppender::rotateFile() {
     std::rename(file_path_.c_str(), backup_file.c_str());
     
     // 重新打开文件
-    file_ = std::make_unique<std::ofstream>(file_path_);
+    file_ = std::make_unique<std::ofstream>(file_path_, std::ios::app);
     current_size_ = 0;
 }
 
+// AsyncAppender实现
+// 环形队列采用Vyukov有界队列：每个槽位带序号，生产者CAS推进入队位置，后台线程推进出队位置；
+// DROP_OLDEST策略下写满的生产者也会推进出队位置以丢弃最早的记录。
+// 槽位中的LogRecord在构造时一次性分配，入队时拷贝赋值，字符串在队列转过一圈后复用已有容量
+class AsyncAppender::Impl {
+public:
+    Impl(std::unique_ptr<LogAppender> wrapped, const AsyncAppenderOptions& options)
+        : wrapped_(std::move(wrapped)), options_(options),
+          mask_(roundUp(options.queue_capacity) - 1), slots_(new Slot[mask_ + 1]),
+          enqueue_latency_(MetricsRegistry::getInstance().createHistogram(metric_names::kLogEnqueue)) {
+        if (options_.batch_size == 0) {
+            options_.batch_size = 1;
+        }
+        for (size_t i = 0; i <= mask_; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        writer_ = std::thread([this] { run(); });
+    }
+    
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        writer_cv_.notify_one();
+        if (writer_.joinable()) {
+            writer_.join();
+        }
+    }
+    
+    void enqueue(const LogRecord& record) {
+        SDK_TRACE_SPAN("log", "log.enqueue");
+        auto start = std::chrono::steady_clock::now();
+        size_t position;
+        Slot* slot = claimWrite(position);
+        if (!slot) {
+            return;
+        }
+        
+        slot->record = record;
+        slot->sequence.store(position + 1, std::memory_order_release);
+        wakeWriter();
+        enqueue_latency_->record(std::chrono::steady_clock::now() - start);
+        
+        // 高级别日志等待写出并刷新，但最多等待flush_timeout，避免输出端卡住时拖住调用线程
+        if (record.level >= options_.flush_level) {
+            requestFlush(position + 1);
+            std::unique_lock<std::mutex> lock(mutex_);
+            flushed_cv_.wait_for(lock, options_.flush_timeout,
+                                 [this, position] { return flushed_pos_ > position; });
+        }
+    }
+    
+    void flush() {
+        size_t target = enqueue_pos_.load(std::memory_order_acquire);
+        requestFlush(target);
+        
+        std::unique_lock<std::mutex> lock(mutex_);
+        flushed_cv_.wait(lock, [this, target] { return flushed_pos_ >= target || writer_done_; });
+    }
+    
+    size_t droppedCount() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+    
+    HistogramSnapshot enqueueLatency() const {
+        return enqueue_latency_->snapshot();
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+    
+    static size_t roundUp(size_t capacity) {
+        size_t result = 2;
+        while (result < capacity) {
+            result <<= 1;
+        }
+        return result;
+    }
+    
+    // 申请一个可写槽位，队列已满时按溢出策略处理；记录被丢弃时返回nullptr
+    Slot* claimWrite(size_t& position) {
+        position = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot* slot = &slots_[position & mask_];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    return slot;
+                }
+                continue;
+            }
+            
+            if (diff < 0) {
+                switch (options_.overflow_policy) {
+                    case AsyncOverflowPolicy::DROP_NEWEST:
+                        dropped_.fetch_add(1, std::memory_order_relaxed);
+                        return nullptr;
+                        
+                    case AsyncOverflowPolicy::DROP_OLDEST: {
+                        size_t oldest;
+                        if (Slot* victim = claimRead(oldest)) {
+                            release(victim, oldest);
+                            dropped_.fetch_add(1, std::memory_order_relaxed);
+                        } else {
+                            std::this_thread::yield();
+                        }
+                        break;
+                    }
+                    
+                    case AsyncOverflowPolicy::BLOCK:
+                    default:
+                        wakeWriter();
+                        std::this_thread::yield();
+                        break;
+                }
+            }
+            position = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+    
+    // 申请最早的一条已提交记录，队列为空或最早的记录尚未写完时返回nullptr
+    Slot* claimRead(size_t& position) {
+        position = dequeue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            Slot* slot = &slots_[position & mask_];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    return slot;
+                }
+            } else if (diff < 0) {
+                return nullptr;
+            } else {
+                position = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    void release(Slot* slot, size_t position) {
+        slot->sequence.store(position + mask_ + 1, std::memory_order_release);
+    }
+    
+    bool readable() const {
+        size_t position = dequeue_pos_.load(std::memory_order_relaxed);
+        return slots_[position & mask_].sequence.load(std::memory_order_acquire) == position + 1;
+    }
+    
+    // 发布后检查后台线程是否在睡眠，与run()中先置睡眠标记再检查队列的顺序对称，避免丢失唤醒
+    void wakeWriter() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (writer_sleeping_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            writer_cv_.notify_one();
+        }
+    }
+    
+    void requestFlush(size_t target) {
+        size_t current = flush_request_.load(std::memory_order_relaxed);
+        while (current < target &&
+               !flush_request_.compare_exchange_weak(current, target, std::memory_order_release)) {
+        }
+        wakeWriter();
+    }
+    
+    // 写出一批记录，返回写出的条数
+    size_t drainBatch(bool& urgent) {
+        TraceSpan span("log", "log.write");
+        size_t count = 0;
+        size_t position;
+        Slot* slot;
+        while (count < options_.batch_size && (slot = claimRead(position)) != nullptr) {
+            if (slot->record.level >= options_.flush_level) {
+                urgent = true;
+            }
+            try {
+                // 槽位中的message复用已有容量
+                formatRecordMessage(slot->record);
+                wrapped_->append(slot->record);
+            } catch (...) {
+                // 输出端异常不能终止后台线程
+            }
+            release(slot, position);
+            consumed_pos_ = position + 1;
+            ++count;
+        }
+        
+        // 队列已空：此前的位置都已被写出或被丢弃
+        if (count < options_.batch_size) {
+            consumed_pos_ = std::max(consumed_pos_, dequeue_pos_.load(std::memory_order_relaxed));
+        }
+        
+        // 空批次不记录，否则每次唤醒都会产生一条事件
+        if (count == 0) {
+            span.cancel();
+        } else {
+            span.setArg("records", static_cast<int64_t>(count));
+        }
+        return count;
+    }
+    
+    void flushWrapped(size_t consumed) {
+        SDK_TRACE_SPAN("log", "log.flush");
+        try {
+            wrapped_->flush();
+        } catch (...) {
+        }
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        flushed_pos_ = consumed;
+        flushed_cv_.notify_all();
+    }
+    
+    void run() {
+        auto last_flush = std::chrono::steady_clock::now();
+        size_t flushed = 0;
+        bool dirty = false;
+        
+        while (true) {
+            bool urgent = false;
+            size_t count = drainBatch(urgent);
+            dirty = dirty || count > 0;
+            
+            bool caught_up = count < options_.batch_size;
+            auto now = std::chrono::steady_clock::now();
+            bool requested = flush_request_.load(std::memory_order_acquire) > flushed;
+            if (urgent || (caught_up && (requested || (dirty && now - last_flush >= options_.flush_interval)))) {
+                flushWrapped(consumed_pos_);
+                flushed = consumed_pos_;
+                last_flush = now;
+                dirty = false;
+            }
+            
+            if (!caught_up) {
+                continue;
+            }
+            
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (stop_ && !readable()) {
+                break;
+            }
+            
+            writer_sleeping_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!readable() && !stop_) {
+                if (flush_request_.load(std::memory_order_acquire) > flushed) {
+                    // 请求刷新的记录已占位但尚未写完，稍后重试
+                    lock.unlock();
+                    std::this_thread::yield();
+                } else {
+                    writer_cv_.wait_for(lock, options_.flush_interval);
+                }
+            }
+            writer_sleeping_.store(false, std::memory_order_relaxed);
+        }
+        
+        bool urgent = false;
+        drainBatch(urgent);
+        flushWrapped(consumed_pos_);
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        writer_done_ = true;
+        flushed_cv_.notify_all();
+    }
+    
+    std::unique_ptr<LogAppender> wrapped_;
+    AsyncAppenderOptions options_;
+    
+    const size_t mask_;
+    const std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+    alignas(64) std::atomic<size_t> flush_request_{0};
+    std::atomic<size_t> dropped_{0};
+    std::atomic<bool> writer_sleeping_{false};
+    std::shared_ptr<LatencyHistogram> enqueue_latency_;
+    
+    // 后台线程私有：此前的位置都已写出或被丢弃
+    size_t consumed_pos_ = 0;
+    
+    std::mutex mutex_;
+    std::condition_variable writer_cv_;
+    std::condition_variable flushed_cv_;
+    size_t flushed_pos_ = 0;
+    bool stop_ = false;
+    bool writer_done_ = false;
+    
+    std::thread writer_;
+};
+
+AsyncAppender::AsyncAppender(std::unique_ptr<LogAppender> wrapped_appender, const AsyncAppenderOptions& options)
+    : pImpl_(std::make_unique<Impl>(std::move(wrapped_appender), options)) {}
+
+AsyncAppender::~AsyncAppender() = default;
+
+void AsyncAppender::append(const LogRecord& record) {
+    if (record.level < level_) {
+        return;
+    }
+    pImpl_->enqueue(record);
+}
+
+void AsyncAppender::flush() {
+    pImpl_->flush();
+}
+
+size_t AsyncAppender::droppedCount() const {
+    return pImpl_->droppedCount();
+}
+
+HistogramSnapshot AsyncAppender::enqueueLatency() const {
+    return pImpl_->enqueueLatency();
+}
+
 // Logger实现
+namespace {
+
+// 把渲染好的整行交给spdlog日志器，spdlog只负责着色和写出（异步日志器在其线程池中写出）
+// 与其他文本输出器使用相同的默认格式，控制台和文件等输出端之间共享一次渲染结果
+class SpdlogAppender : public LogAppender {
+public:
+    explicit SpdlogAppender(std::shared_ptr<spdlog::logger> logger) : logger_(std::move(logger)) {
+        formatter_ = std::make_unique<DefaultFormatter>();
+        logger_->set_pattern("%^%v%$");
+    }
+    
+    void append(const LogRecord& record) override {
+        std::string& line = t_line_buffer;
+        line.clear();
+        formatter_->formatTo(record, line);
+        appendFormatted(record, line);
+    }
+    
+    bool acceptsFormatted() const override { return true; }
+    
+    void appendFormatted(const LogRecord& record, std::string_view line) override {
+        if (record.level < level_) {
+            return;
+        }
+        logger_->log(convertLogLevel(record.level), spdlog::string_view_t(line.data(), line.size()));
+    }
+    
+    void flush() override {
+        logger_->flush();
+    }
+    
+private:
+    std::shared_ptr<spdlog::logger> logger_;
+};
+
+} // namespace
+
 class Logger::Impl {
 public:
     explicit Impl(const std::string& name) : name_(name) {
-        // 创建spdlog logger
+        // 创建spdlog logger，作为默认输出器接入分发管线
         spdlog_logger_ = spdlog::get(name);
         if (!spdlog_logger_) {
             spdlog_logger_ = spdlog::stdout_color_mt(name);
         }
+        appenders_.push_back(std::make_unique<SpdlogAppender>(spdlog_logger_));
     }
     
     void log(LogLevel level, const std::string& message, 
@@ -251,32 +1128,51 @@ public:
             return;
         }
         
-        // 使用spdlog记录日志
-        auto spdlog_level = convertLogLevel(level);
-        spdlog_logger_->log(spdlog::source_loc{file, line, function}, spdlog_level, message);
-        
-        // 创建LogRecord用于自定义appenders
         LogRecord record;
-        record.level = level;
+        fillRecord(record, level, file, line, function);
         record.message = message;
-        record.logger_name = name_;
-        record.file = file ? file : "";
-        record.line = line;
-        record.function = function ? function : "";
-        record.timestamp = std::chrono::system_clock::now();
-        record.thread_id = std::this_thread::get_id();
+        dispatch(record);
+    }
+    
+    void logAt(const LogCallSite& site, const LogArgs& args) {
+        if (site.level() < level_) {
+            return;
+        }
         
-        // 应用过滤器
-        for (const auto& filter : filters_) {
-            if (!filter->shouldLog(record)) {
-                return;
-            }
+        LogRecord record;
+        const SourceLocation& location = site.location();
+        fillRecord(record, site.level(), location.file, location.line, location.function);
+        record.format = site.format();
+        record.args = args;
+        dispatch(record);
+    }
+    
+    // 上下文以键值对保存在记录中，由各格式化器与输出器自行呈现
+    void logWithContext(LogLevel level, const std::string& message,
+                        const std::unordered_map<std::string, std::string>& context) {
+        if (level < level_) {
+            return;
         }
         
-        // 发送到自定义appenders
-        for (const auto& appender : appenders_) {
-            appender->append(record);
+        LogRecord record;
+        fillRecord(record, level, nullptr, 0, nullptr);
+        record.message = message;
+        for (const auto& pair : context) {
+            record.context.add(pair.first, pair.second);
         }
+        dispatch(record);
+    }
+    
+    // 格式串的生命周期未知，只能在调用线程上生成消息
+    void logFormat(LogLevel level, const LogFormat& format, const LogArgs& args) {
+        if (level < level_) {
+            return;
+        }
+        
+        LogRecord record;
+        fillRecord(record, level, nullptr, 0, nullptr);
+        formatLogMessage(record.message, format.c_str(), args);
+        dispatch(record);
     }
     
     void setLevel(LogLevel level) {
@@ -305,7 +1201,6 @@ public:
     }
     
     void flush() {
-        spdlog_logger_->flush();
         for (const auto& appender : appenders_) {
             appender->flush();
         }
@@ -316,6 +1211,62 @@ public:
     }
 
 private:
+    void fillRecord(LogRecord& record, LogLevel level, const char* file, int line, const char* function) {
+        record.level = level;
+        record.logger_name = name_;
+        record.file = file ? file : "";
+        record.line = line;
+        record.function = function ? function : "";
+        record.timestamp = std::chrono::system_clock::now();
+        record.thread_id = std::this_thread::get_id();
+    }
+    
+    // 过滤一次、格式化一次，再把同一份结果分发给所有输出器
+    void dispatch(LogRecord& record) {
+        for (const auto& filter : filters_) {
+            if (!filter->shouldLog(record)) {
+                return;
+            }
+        }
+        
+        // 不接受延迟格式化的输出器在此之前生成消息
+        std::vector<RenderedLine>& rendered = t_rendered_lines;
+        size_t rendered_count = 0;
+        for (const auto& appender : appenders_) {
+            if (record.level < appender->getLevel()) {
+                continue;
+            }
+            if (!appender->acceptsDeferred()) {
+                formatRecordMessage(record);
+            }
+            
+            LogFormatter* formatter = appender->acceptsFormatted() ? appender->getFormatter() : nullptr;
+            if (!formatter) {
+                appender->append(record);
+                continue;
+            }
+            
+            // 与前面输出器格式相同时直接复用渲染好的整行
+            RenderedLine* line = nullptr;
+            for (size_t i = 0; i < rendered_count; ++i) {
+                if (rendered[i].formatter->sameOutput(*formatter)) {
+                    line = &rendered[i];
+                    break;
+                }
+            }
+            if (!line) {
+                if (rendered_count == rendered.size()) {
+                    rendered.emplace_back();
+                }
+                line = &rendered[rendered_count++];
+                line->formatter = formatter;
+                line->text.clear();
+                formatter->formatTo(record, line->text);
+            }
+            appender->appendFormatted(record, line->text);
+        }
+    }
+    
     std::string name_;
     LogLevel level_ = LogLevel::INFO;
     std::shared_ptr<spdlog::logger> spdlog_logger_;
@@ -328,8 +1279,17 @@ Logger::Logger(const std::string& name)
 
 Logger::~Logger() = default;
 
-Logger::Logger(Logger&&) noexcept = default;
-Logger& Logger::operator=(Logger&&) noexcept = default;
+Logger::Logger(Logger&& other) noexcept
+    : pImpl_(std::move(other.pImpl_)), name_(std::move(other.name_)), level_(other.level_),
+      enabled_(other.enabled_.load(std::memory_order_relaxed)) {}
+
+Logger& Logger::operator=(Logger&& other) noexcept {
+    pImpl_ = std::move(other.pImpl_);
+    name_ = std::move(other.name_);
+    level_ = other.level_;
+    enabled_.store(other.enabled_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
 
 void Logger::trace(const std::string& message) {
     log(LogLevel::TRACE, message);
@@ -361,20 +1321,10 @@ void Logger::log(LogLevel level, const std::string& message) {
 
 void Logger::logWithContext(LogLevel level, const std::string& message, 
                            const std::unordered_map<std::string, std::string>& context) {
-    // 简化实现，将上下文添加到消息中
-    std::ostringstream oss;
-    oss << message;
-    if (!context.empty()) {
-        oss << " [";
-        bool first = true;
-        for (const auto& pair : context) {
-            if (!first) oss << ", ";
-            oss << pair.first << "=" << pair.second;
-            first = false;
-        }
-        oss << "]";
+    if (!isEnabled()) {
+        return;
     }
-    log(level, oss.str());
+    pImpl_->logWithContext(level, message, context);
 }
 
 void Logger::setLevel(LogLevel level) {
@@ -402,16 +1352,31 @@ void Logger::removeAllFilters() {
     pImpl_->removeAllFilters();
 }
 
-const std::string& Logger::getName() const {
-    return name_;
-}
-
 void Logger::flush() {
     pImpl_->flush();
 }
 
+// 以下入口由全部成员函数、宏与C接口共用，运行时开关在这里统一检查
+void Logger::logFormat(LogLevel level, const LogFormat& format, const LogArgs& args) {
+    if (!isEnabled()) {
+        return;
+    }
+    pImpl_->logFormat(level, format, args);
+}
+
+void Logger::logAt(LogCallSite& site, const LogArgs& args) {
+    if (!isEnabled()) {
+        return;
+    }
+    site.id();
+    pImpl_->logAt(site, args);
+}
+
 void Logger::logImpl(LogLevel level, const std::string& message, 
                     const char* file, int line, const char* function) {
+    if (!isEnabled()) {
+        return;
+    }
     pImpl_->log(level, message, file, line, function);
 }
 
@@ -432,6 +1397,9 @@ public:
         }
         
         auto logger = std::make_shared<Logger>(name);
+        if (disabled_loggers_.count(name)) {
+            logger->setEnabled(false);
+        }
         loggers_[name] = logger;
         return logger;
     }
@@ -464,9 +1432,27 @@ public:
         }
     }
 
+    void setLoggerEnabled(const std::string& name, bool enabled) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (enabled) {
+            disabled_loggers_.erase(name);
+        } else {
+            disabled_loggers_.insert(name);
+        }
+        
+        auto it = loggers_.find(name);
+        if (it != loggers_.end()) {
+            auto logger = it->second.lock();
+            if (logger) {
+                logger->setEnabled(enabled);
+            }
+        }
+    }
+
 private:
     std::mutex mutex_;
     std::unordered_map<std::string, std::weak_ptr<Logger>> loggers_;
+    std::unordered_set<std::string> disabled_loggers_;
     LogLevel global_level_ = LogLevel::INFO;
 };
 
@@ -493,6 +1479,50 @@ void LogManager::flushAll() {
     pImpl_->flushAll();
 }
 
+void LogManager::setLoggerEnabled(const std::string& name, bool enabled) {
+    pImpl_->setLoggerEnabled(name, enabled);
+}
+
+void LogManager::setCallSiteEnabled(const std::string& selector, bool enabled) {
+    CallSiteRule rule = makeRule(CallSiteRule::ENABLE, selector);
+    rule.enabled = enabled;
+    std::lock_guard<std::mutex> lock(g_site_mutex);
+    addRuleLocked(rule);
+}
+
+void LogManager::setCallSiteSampling(const std::string& selector, uint32_t one_in_n) {
+    CallSiteRule rule = makeRule(CallSiteRule::SAMPLING, selector);
+    rule.one_in_n = one_in_n;
+    std::lock_guard<std::mutex> lock(g_site_mutex);
+    addRuleLocked(rule);
+}
+
+void LogManager::setCallSiteRateLimit(const std::string& selector, double per_second, uint32_t burst) {
+    CallSiteRule rule = makeRule(CallSiteRule::RATE_LIMIT, selector);
+    rule.per_second = per_second;
+    rule.burst = burst;
+    std::lock_guard<std::mutex> lock(g_site_mutex);
+    addRuleLocked(rule);
+}
+
+void LogManager::clearCallSiteRules() {
+    std::lock_guard<std::mutex> lock(g_site_mutex);
+    g_site_rules.clear();
+    LogCallSite::forEach([](LogCallSite& site) {
+        site.setEnabled(true);
+        site.setSampling(0);
+        site.setRateLimit(0.0, 0);
+    });
+}
+
+uint64_t LogManager::suppressedCount() const {
+    uint64_t total = 0;
+    LogCallSite::forEach([&total](LogCallSite& site) {
+        total += site.suppressedCount();
+    });
+    return total;
+}
+
 // 全局日志器便利函数
 namespace log {
     std::shared_ptr<Logger> getDefault() {
@@ -614,4 +1644,48 @@ void sdk_log_with_context(sdk_log_level_t level, const char* file, int line,
     }
 }
 
+bool sdk_log_set_logger_enabled(const char* logger_name, bool enabled) {
+    try {
+        sdk::LogManager::getInstance().setLoggerEnabled(logger_name ? logger_name : "default", enabled);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool sdk_log_set_site_enabled(const char* selector, bool enabled) {
+    try {
+        sdk::LogManager::getInstance().setCallSiteEnabled(selector ? selector : "", enabled);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool sdk_log_set_site_sampling(const char* selector, uint32_t one_in_n) {
+    try {
+        sdk::LogManager::getInstance().setCallSiteSampling(selector ? selector : "", one_in_n);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool sdk_log_set_site_rate_limit(const char* selector, double per_second, uint32_t burst) {
+    try {
+        sdk::LogManager::getInstance().setCallSiteRateLimit(selector ? selector : "", per_second, burst);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+void sdk_log_clear_site_rules(void) {
+    try {
+        sdk::LogManager::getInstance().clearCallSiteRules();
+    } catch (...) {
+        // 忽略异常
+    }
+}
+
 } // extern "C"
@@ -0,0 +1,306 @@
+#include "sdk/metrics/metrics.h"
+#include "sdk/sdk_c_api.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace sdk {
+
+namespace {
+
+std::atomic<size_t> g_next_shard{0};
+
+unsigned highestBit(uint64_t value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+}
+
+void storeMax(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+namespace detail {
+
+size_t metricsShardIndex() {
+    thread_local size_t t_shard = g_next_shard.fetch_add(1, std::memory_order_relaxed) % kMetricsShards;
+    return t_shard;
+}
+
+} // namespace detail
+
+// HistogramSnapshot实现
+void HistogramSnapshot::merge(const HistogramSnapshot& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (buckets.size() < other.buckets.size()) {
+        buckets.resize(other.buckets.size(), 0);
+    }
+    for (size_t i = 0; i < other.buckets.size(); ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    count += other.count;
+    sum_us += other.sum_us;
+    max_us = std::max(max_us, other.max_us);
+}
+
+uint64_t HistogramSnapshot::percentile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    q = std::min(std::max(q, 0.0), 1.0);
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(count))));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::min(LatencyHistogram::bucketUpperBound(i), max_us);
+        }
+    }
+    return max_us;
+}
+
+double HistogramSnapshot::mean() const {
+    return count > 0 ? static_cast<double>(sum_us) / static_cast<double>(count) : 0.0;
+}
+
+LatencySummary HistogramSnapshot::summary() const {
+    LatencySummary result;
+    result.count = count;
+    result.mean_us = mean();
+    result.p50_us = percentile(0.5);
+    result.p90_us = percentile(0.9);
+    result.p99_us = percentile(0.99);
+    result.p999_us = percentile(0.999);
+    result.max_us = max_us;
+    return result;
+}
+
+// LatencyHistogram实现
+LatencyHistogram::~LatencyHistogram() {
+    for (auto& slot : shards_) {
+        delete slot.load(std::memory_order_relaxed);
+    }
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t micros) {
+    if (micros < kSubBucketCount) {
+        return static_cast<size_t>(micros);
+    }
+    micros = std::min(micros, kMaxValueUs);
+    // [32 << (g-1), 32 << g)区间内按2^(g-1)的步长分为32个桶
+    unsigned group = highestBit(micros) - kSubBucketBits + 1;
+    size_t sub = static_cast<size_t>(micros >> (group - 1)) - kSubBucketCount;
+    return group * kSubBucketCount + sub;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < kSubBucketCount) {
+        return index;
+    }
+    size_t group = index / kSubBucketCount;
+    uint64_t lower = static_cast<uint64_t>(kSubBucketCount + index % kSubBucketCount) << (group - 1);
+    return lower + (uint64_t(1) << (group - 1)) - 1;
+}
+
+LatencyHistogram::Shard& LatencyHistogram::shard() {
+    std::atomic<Shard*>& slot = shards_[detail::metricsShardIndex()];
+    Shard* current = slot.load(std::memory_order_acquire);
+    if (current) {
+        return *current;
+    }
+
+    // 值初始化将全部计数清零；竞争失败的一方释放自己的分片
+    Shard* created = new Shard();
+    if (slot.compare_exchange_strong(current, created, std::memory_order_acq_rel)) {
+        return *created;
+    }
+    delete created;
+    return *current;
+}
+
+void LatencyHistogram::recordMicros(uint64_t micros) {
+    Shard& target = shard();
+    target.buckets[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    target.sum.fetch_add(micros, std::memory_order_relaxed);
+    storeMax(target.max, micros);
+    target.count.fetch_add(1, std::memory_order_relaxed);
+}
+
+HistogramSnapshot LatencyHistogram::snapshot() const {
+    HistogramSnapshot result;
+    result.buckets.assign(kBucketCount, 0);
+    for (const auto& slot : shards_) {
+        const Shard* current = slot.load(std::memory_order_acquire);
+        if (!current) {
+            continue;
+        }
+        // 与记录并发时各字段可能相差几个样本，count取分桶之和保证分位数自洽
+        for (size_t i = 0; i < kBucketCount; ++i) {
+            uint64_t n = current->buckets[i].load(std::memory_order_relaxed);
+            result.buckets[i] += n;
+            result.count += n;
+        }
+        result.sum_us += current->sum.load(std::memory_order_relaxed);
+        result.max_us = std::max(result.max_us, current->max.load(std::memory_order_relaxed));
+    }
+    return result;
+}
+
+uint64_t LatencyHistogram::count() const {
+    uint64_t total = 0;
+    for (const auto& slot : shards_) {
+        if (const Shard* current = slot.load(std::memory_order_acquire)) {
+            total += current->count.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+double LatencyHistogram::meanMicros() const {
+    uint64_t total = 0;
+    uint64_t sum = 0;
+    for (const auto& slot : shards_) {
+        if (const Shard* current = slot.load(std::memory_order_acquire)) {
+            total += current->count.load(std::memory_order_relaxed);
+            sum += current->sum.load(std::memory_order_relaxed);
+        }
+    }
+    return total > 0 ? static_cast<double>(sum) / static_cast<double>(total) : 0.0;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& slot : shards_) {
+        Shard* current = slot.load(std::memory_order_acquire);
+        if (!current) {
+            continue;
+        }
+        for (auto& bucket : current->buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+        current->count.store(0, std::memory_order_relaxed);
+        current->sum.store(0, std::memory_order_relaxed);
+        current->max.store(0, std::memory_order_relaxed);
+    }
+}
+
+// ShardedCounter实现
+uint64_t ShardedCounter::value() const {
+    uint64_t total = 0;
+    for (const auto& cell : cells_) {
+        total += cell.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void ShardedCounter::reset() {
+    for (auto& cell : cells_) {
+        cell.value.store(0, std::memory_order_relaxed);
+    }
+}
+
+// MetricsRegistry实现
+MetricsRegistry& MetricsRegistry::getInstance() {
+    // 有意不析构：静态对象析构阶段仍可能有组件销毁自己的直方图
+    static MetricsRegistry* instance = new MetricsRegistry();
+    return *instance;
+}
+
+std::shared_ptr<LatencyHistogram> MetricsRegistry::createHistogram(const std::string& name) {
+    auto histogram = std::make_shared<LatencyHistogram>();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& instances = histograms_[name];
+    instances.erase(std::remove_if(instances.begin(), instances.end(),
+                                   [](const std::weak_ptr<LatencyHistogram>& item) { return item.expired(); }),
+                    instances.end());
+    instances.push_back(histogram);
+    return histogram;
+}
+
+bool MetricsRegistry::snapshot(const std::string& name, HistogramSnapshot& snapshot) const {
+    std::vector<std::shared_ptr<LatencyHistogram>> live;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = histograms_.find(name);
+        if (it == histograms_.end()) {
+            return false;
+        }
+        for (const auto& item : it->second) {
+            if (auto histogram = item.lock()) {
+                live.push_back(std::move(histogram));
+            }
+        }
+    }
+
+    // 合并在锁外进行，不阻塞组件创建直方图
+    snapshot = HistogramSnapshot();
+    snapshot.buckets.assign(LatencyHistogram::kBucketCount, 0);
+    for (const auto& histogram : live) {
+        snapshot.merge(histogram->snapshot());
+    }
+    return true;
+}
+
+std::vector<std::pair<std::string, HistogramSnapshot>> MetricsRegistry::snapshotAll() const {
+    std::vector<std::string> names;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& entry : histograms_) {
+            names.push_back(entry.first);
+        }
+    }
+
+    std::vector<std::pair<std::string, HistogramSnapshot>> result;
+    for (const auto& name : names) {
+        HistogramSnapshot merged;
+        if (snapshot(name, merged)) {
+            result.emplace_back(name, std::move(merged));
+        }
+    }
+    return result;
+}
+
+} // namespace sdk
+
+extern "C" {
+
+bool sdk_metrics_get_latency(const char* name, sdk_latency_summary_t* summary) {
+    if (!name || !summary) {
+        return false;
+    }
+
+    try {
+        sdk::HistogramSnapshot snapshot;
+        if (!sdk::MetricsRegistry::getInstance().snapshot(name, snapshot)) {
+            return false;
+        }
+
+        sdk::LatencySummary result = snapshot.summary();
+        summary->count = result.count;
+        summary->mean_us = result.mean_us;
+        summary->p50_us = result.p50_us;
+        summary->p90_us = result.p90_us;
+        summary->p99_us = result.p99_us;
+        summary->p999_us = result.p999_us;
+        summary->max_us = result.max_us;
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+} // extern "C"
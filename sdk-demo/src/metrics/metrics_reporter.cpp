@@ -0,0 +1,561 @@
+#include "sdk/metrics/metrics_reporter.h"
+#include "sdk/sdk_core.h"
+#include "sdk/sdk_c_api.h"
+#include "sdk/threading/thread_pool.h"
+#include "sdk/network/http_client.h"
+#include "sdk/platform/platform_utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #pragma comment(lib, "ws2_32.lib")
+#else
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <sys/time.h>
+    #include <unistd.h>
+#endif
+
+namespace sdk {
+
+namespace {
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+const SocketHandle kInvalidSocket = INVALID_SOCKET;
+
+void closeSocket(SocketHandle socket) {
+    closesocket(socket);
+}
+
+int pollSocket(SocketHandle socket, int timeout_ms) {
+    WSAPOLLFD pfd = {};
+    pfd.fd = socket;
+    pfd.events = POLLRDNORM;
+    return WSAPoll(&pfd, 1, timeout_ms);
+}
+
+constexpr int kSendFlags = 0;
+#else
+using SocketHandle = int;
+const SocketHandle kInvalidSocket = -1;
+
+void closeSocket(SocketHandle socket) {
+    close(socket);
+}
+
+int pollSocket(SocketHandle socket, int timeout_ms) {
+    struct pollfd pfd = {};
+    pfd.fd = socket;
+    pfd.events = POLLIN;
+    return poll(&pfd, 1, timeout_ms);
+}
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+#endif
+
+// "thread_pool.queue_wait" -> "sdk_thread_pool_queue_wait_seconds"
+std::string summaryName(const std::string& name) {
+    std::string result = "sdk_";
+    for (char c : name) {
+        result.push_back((c == '.' || c == '-') ? '_' : c);
+    }
+    return result + "_seconds";
+}
+
+void appendNumber(std::string& out, double value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+    out.append(buffer, static_cast<size_t>(std::max(length, 0)));
+}
+
+void appendLabelValue(std::string& out, const std::string& value) {
+    for (char c : value) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '"': out += "\\\""; break;
+            case '\n': out += "\\n"; break;
+            default: out.push_back(c); break;
+        }
+    }
+}
+
+// labels为预先渲染的"k=\"v\",..."，extra为附加的单个标签
+void appendSample(std::string& out, const std::string& name, const std::string& labels, const char* extra,
+                  double value, const std::string& timestamp) {
+    out += name;
+    if (!labels.empty() || extra) {
+        out.push_back('{');
+        out += labels;
+        if (extra) {
+            if (!labels.empty()) {
+                out.push_back(',');
+            }
+            out += extra;
+        }
+        out.push_back('}');
+    }
+    out.push_back(' ');
+    appendNumber(out, value);
+    out += timestamp;
+    out.push_back('\n');
+}
+
+} // namespace
+
+// 进程CPU占用：保存上一次采样，返回两次采样之间按全部核心归一化的占用比例
+class MetricsReporter::CpuSampler {
+public:
+    CpuSampler()
+        : cores_(std::max<uint32_t>(platform::PlatformUtils::getCpuCoreCount(), 1)),
+          wall_(std::chrono::steady_clock::now()),
+          cpu_us_(platform::PlatformUtils::getProcessCpuTimeUs()) {}
+
+    double sample() {
+        auto now = std::chrono::steady_clock::now();
+        uint64_t cpu_us = platform::PlatformUtils::getProcessCpuTimeUs();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto wall = std::chrono::duration_cast<std::chrono::microseconds>(now - wall_);
+        uint64_t previous_cpu_us = cpu_us_;
+        wall_ = now;
+        cpu_us_ = cpu_us;
+        if (wall.count() <= 0 || cpu_us < previous_cpu_us) {
+            return 0.0;
+        }
+        double usage = 100.0 * static_cast<double>(cpu_us - previous_cpu_us) /
+                       (static_cast<double>(wall.count()) * cores_);
+        return std::min(usage, 100.0);
+    }
+
+private:
+    const uint32_t cores_;
+    std::mutex mutex_;
+    std::chrono::steady_clock::time_point wall_;
+    uint64_t cpu_us_;
+};
+
+// MetricsReporter实现
+// 定时任务与HTTP回调只持有弱引用：上报器销毁后仍在排队的采样和推送回调直接返回
+class MetricsReporter::Impl : public std::enable_shared_from_this<Impl> {
+public:
+    Impl(const MetricsReporterOptions& options, std::shared_ptr<ThreadPool> pool, std::shared_ptr<HttpClient> client)
+        : options_(options), pool_(pool), client_(client) {
+        options_.batch_size = std::max<size_t>(options_.batch_size, 1);
+        options_.max_pending = std::max(options_.max_pending, options_.batch_size);
+        if (options_.interval.count() <= 0) {
+            options_.interval = std::chrono::milliseconds(10000);
+        }
+    }
+    
+    ~Impl() {
+#ifdef _WIN32
+        if (winsock_started_) {
+            WSACleanup();
+        }
+#endif
+    }
+
+    void start() {
+        auto pool = pool_.lock();
+        std::weak_ptr<Impl> weak = shared_from_this();
+        timer_ = pool->scheduleAtFixedRate(options_.interval, [weak]() {
+            if (auto self = weak.lock()) {
+                self->sample();
+            }
+        }, TaskPriority::LOW);
+
+        if (options_.listen) {
+            startListener();
+        }
+    }
+
+    void stop() {
+        if (auto pool = pool_.lock()) {
+            pool->cancelTimer(timer_);
+        }
+        if (listener_.joinable()) {
+            listener_stop_.store(true);
+            listener_.join();
+        }
+        if (listen_socket_ != kInvalidSocket) {
+            closeSocket(listen_socket_);
+            listen_socket_ = kInvalidSocket;
+        }
+    }
+
+    void sample() {
+        auto pool = pool_.lock();
+        auto client = client_.lock();
+        MetricsSnapshot snapshot = MetricsReporter::collect(pool.get(), client.get(), cpu_);
+
+        std::string text;
+        const bool push = client && !options_.endpoint.empty();
+        if (push) {
+            text = MetricsReporter::encode(snapshot, options_.labels, true);
+        }
+
+        std::vector<std::string> batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            latest_ = std::move(snapshot);
+            ++stats_.samples;
+            if (push) {
+                pending_.push_back(std::move(text));
+                trimPendingLocked();
+                if (!push_in_flight_ && pending_.size() >= options_.batch_size) {
+                    auto end = pending_.begin() + static_cast<std::ptrdiff_t>(options_.batch_size);
+                    batch.assign(std::make_move_iterator(pending_.begin()), std::make_move_iterator(end));
+                    pending_.erase(pending_.begin(), end);
+                    push_in_flight_ = true;
+                }
+            }
+        }
+
+        if (!batch.empty()) {
+            sendBatch(*client, std::move(batch));
+        }
+    }
+
+    uint16_t listenPort() const {
+        return bound_port_;
+    }
+
+    Stats getStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+private:
+    // 调用方持有mutex_
+    void trimPendingLocked() {
+        while (pending_.size() > options_.max_pending) {
+            pending_.pop_front();
+            ++stats_.dropped_samples;
+        }
+    }
+
+    void sendBatch(HttpClient& client, std::vector<std::string> batch) {
+        size_t size = 0;
+        for (const auto& text : batch) {
+            size += text.size();
+        }
+        std::string body;
+        body.reserve(size);
+        for (const auto& text : batch) {
+            body += text;
+        }
+
+        HttpRequest request(options_.endpoint);
+        request.setMethod(HttpMethod::POST)
+               .setHeader("Content-Type", "text/plain; version=0.0.4")
+               .setBody(std::move(body));
+
+        auto shared_batch = std::make_shared<std::vector<std::string>>(std::move(batch));
+        std::weak_ptr<Impl> weak = shared_from_this();
+        try {
+            client.requestAsync(request, [weak, shared_batch](const HttpResponse& response) {
+                if (auto self = weak.lock()) {
+                    self->finishPush(response.isSuccess(), *shared_batch);
+                }
+            });
+        } catch (...) {
+            finishPush(false, *shared_batch);
+        }
+    }
+
+    // 失败的批次放回队首，下个批量周期重试
+    void finishPush(bool success, std::vector<std::string>& batch) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        push_in_flight_ = false;
+        if (success) {
+            ++stats_.pushes;
+            return;
+        }
+        ++stats_.push_failures;
+        pending_.insert(pending_.begin(), std::make_move_iterator(batch.begin()),
+                        std::make_move_iterator(batch.end()));
+        trimPendingLocked();
+    }
+
+    void startListener() {
+#ifdef _WIN32
+        WSADATA wsa_data;
+        if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+            return;
+        }
+        winsock_started_ = true;
+#endif
+        SocketHandle socket_handle = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (socket_handle == kInvalidSocket) {
+            return;
+        }
+        int reuse = 1;
+        setsockopt(socket_handle, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+        // 只监听回环地址，不对外暴露
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(options_.listen_port);
+        socklen_t length = sizeof(address);
+        if (bind(socket_handle, reinterpret_cast<sockaddr*>(&address), length) != 0 ||
+            listen(socket_handle, 8) != 0 ||
+            getsockname(socket_handle, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            closeSocket(socket_handle);
+            return;
+        }
+
+        listen_socket_ = socket_handle;
+        bound_port_ = ntohs(address.sin_port);
+        listener_ = std::thread([this] { serve(); });
+    }
+
+    // 拉取端点很少被访问，逐个处理连接即可；轮询超时用于及时响应停止
+    void serve() {
+        platform::ThreadUtils::setCurrentThreadName("MetricsListener");
+        while (!listener_stop_.load()) {
+            if (pollSocket(listen_socket_, 200) <= 0) {
+                continue;
+            }
+            SocketHandle connection = accept(listen_socket_, nullptr, nullptr);
+            if (connection == kInvalidSocket) {
+                continue;
+            }
+            handleConnection(connection);
+            closeSocket(connection);
+        }
+    }
+
+    void handleConnection(SocketHandle connection) {
+#ifdef _WIN32
+        DWORD timeout = 1000;
+#else
+        struct timeval timeout = {1, 0};
+#endif
+        setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+
+        std::string head;
+        char buffer[1024];
+        while (head.find("\r\n\r\n") == std::string::npos && head.size() < 8192) {
+            int received = static_cast<int>(recv(connection, buffer, sizeof(buffer), 0));
+            if (received <= 0) {
+                return;
+            }
+            head.append(buffer, static_cast<size_t>(received));
+        }
+
+        std::string response;
+        if (head.compare(0, 13, "GET /metrics ") == 0 || head.compare(0, 13, "GET /metrics?") == 0) {
+            std::string body = scrape();
+            response = "HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                       std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+        } else {
+            response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        }
+
+        size_t sent = 0;
+        while (sent < response.size()) {
+            int n = static_cast<int>(send(connection, response.data() + sent,
+                                          static_cast<int>(response.size() - sent), kSendFlags));
+            if (n <= 0) {
+                return;
+            }
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    // 返回最近一次采样，尚未采样时现场采集，拉取频率不影响采样开销
+    std::string scrape() {
+        MetricsSnapshot snapshot;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++stats_.scrapes;
+            snapshot = latest_;
+        }
+        if (snapshot.timestamp_ms == 0) {
+            auto pool = pool_.lock();
+            auto client = client_.lock();
+            snapshot = MetricsReporter::collect(pool.get(), client.get(), cpu_);
+        }
+        return MetricsReporter::encode(snapshot, options_.labels, false);
+    }
+
+    MetricsReporterOptions options_;
+    std::weak_ptr<ThreadPool> pool_;
+    std::weak_ptr<HttpClient> client_;
+    TimerId timer_ = 0;
+    CpuSampler cpu_;   // 本上报器的CPU采样区间，定时采样与拉取共用
+
+    mutable std::mutex mutex_;
+    MetricsSnapshot latest_;
+    std::deque<std::string> pending_;   // 已编码、等待推送的快照
+    bool push_in_flight_ = false;
+    Stats stats_;
+
+    SocketHandle listen_socket_ = kInvalidSocket;
+    uint16_t bound_port_ = 0;
+    std::atomic<bool> listener_stop_{false};
+    std::thread listener_;
+#ifdef _WIN32
+    bool winsock_started_ = false;
+#endif
+};
+
+MetricsReporter::MetricsReporter(const MetricsReporterOptions& options, std::shared_ptr<ThreadPool> pool,
+                                 std::shared_ptr<HttpClient> client) {
+    if (!pool) {
+        throw std::invalid_argument("MetricsReporter requires a thread pool");
+    }
+    pImpl_ = std::make_shared<Impl>(options, std::move(pool), std::move(client));
+    pImpl_->start();
+}
+
+MetricsReporter::~MetricsReporter() {
+    pImpl_->stop();
+}
+
+void MetricsReporter::sampleNow() {
+    pImpl_->sample();
+}
+
+uint16_t MetricsReporter::listenPort() const {
+    return pImpl_->listenPort();
+}
+
+MetricsReporter::Stats MetricsReporter::getStats() const {
+    return pImpl_->getStats();
+}
+
+MetricsSnapshot MetricsReporter::collect(const ThreadPool* pool, const HttpClient* client) {
+    static CpuSampler cpu;
+    return collect(pool, client, cpu);
+}
+
+MetricsSnapshot MetricsReporter::collect(const ThreadPool* pool, const HttpClient* client, CpuSampler& cpu) {
+    MetricsSnapshot snapshot;
+    snapshot.timestamp_ms = static_cast<int64_t>(platform::PlatformUtils::getCurrentTimeMs());
+
+    snapshot.gauges.emplace_back("sdk_process_resident_memory_bytes",
+                                 static_cast<double>(platform::PlatformUtils::getProcessMemoryUsage()));
+    snapshot.gauges.emplace_back("sdk_process_cpu_usage_percent", cpu.sample());
+
+    if (pool) {
+        ThreadPoolStats stats = pool->getStats();
+        snapshot.gauges.emplace_back("sdk_thread_pool_threads", static_cast<double>(stats.thread_count));
+        snapshot.gauges.emplace_back("sdk_thread_pool_active_threads", static_cast<double>(stats.active_threads));
+        snapshot.gauges.emplace_back("sdk_thread_pool_pending_tasks", static_cast<double>(stats.pending_tasks));
+        snapshot.counters.emplace_back("sdk_thread_pool_completed_tasks_total",
+                                       static_cast<double>(stats.completed_tasks));
+        snapshot.counters.emplace_back("sdk_thread_pool_failed_tasks_total", static_cast<double>(stats.failed_tasks));
+    }
+
+    if (client) {
+        HttpClient::Stats stats = client->getStats();
+        snapshot.counters.emplace_back("sdk_http_requests_total", static_cast<double>(stats.total_requests));
+        snapshot.counters.emplace_back("sdk_http_failed_requests_total", static_cast<double>(stats.failed_requests));
+        snapshot.counters.emplace_back("sdk_http_connections_opened_total",
+                                       static_cast<double>(stats.connections_opened));
+        snapshot.counters.emplace_back("sdk_http_cache_hits_total", static_cast<double>(stats.cache_hits));
+        snapshot.counters.emplace_back("sdk_http_coalesced_requests_total",
+                                       static_cast<double>(stats.coalesced_requests));
+        snapshot.counters.emplace_back("sdk_http_retries_total", static_cast<double>(stats.retries));
+    }
+
+    // 登记表中的直方图已按名称合并了全部实例，包括日志入队耗时
+    for (const auto& entry : MetricsRegistry::getInstance().snapshotAll()) {
+        snapshot.summaries.emplace_back(summaryName(entry.first), entry.second.summary());
+    }
+    return snapshot;
+}
+
+std::string MetricsReporter::encode(const MetricsSnapshot& snapshot, const std::map<std::string, std::string>& labels,
+                                    bool with_timestamp) {
+    std::string label_text;
+    for (const auto& label : labels) {
+        if (!label_text.empty()) {
+            label_text.push_back(',');
+        }
+        label_text += label.first + "=\"";
+        appendLabelValue(label_text, label.second);
+        label_text.push_back('"');
+    }
+    std::string timestamp = with_timestamp ? " " + std::to_string(snapshot.timestamp_ms) : std::string();
+
+    std::string out;
+    out.reserve(256 + 96 * (snapshot.gauges.size() + snapshot.counters.size() + 6 * snapshot.summaries.size()));
+    for (const auto& gauge : snapshot.gauges) {
+        out += "# TYPE " + gauge.first + " gauge\n";
+        appendSample(out, gauge.first, label_text, nullptr, gauge.second, timestamp);
+    }
+    for (const auto& counter : snapshot.counters) {
+        out += "# TYPE " + counter.first + " counter\n";
+        appendSample(out, counter.first, label_text, nullptr, counter.second, timestamp);
+    }
+
+    static const std::pair<const char*, uint64_t LatencySummary::*> kQuantiles[] = {
+        {"quantile=\"0.5\"", &LatencySummary::p50_us},
+        {"quantile=\"0.9\"", &LatencySummary::p90_us},
+        {"quantile=\"0.99\"", &LatencySummary::p99_us},
+        {"quantile=\"0.999\"", &LatencySummary::p999_us},
+    };
+    for (const auto& summary : snapshot.summaries) {
+        const LatencySummary& value = summary.second;
+        out += "# TYPE " + summary.first + " summary\n";
+        for (const auto& quantile : kQuantiles) {
+            appendSample(out, summary.first, label_text, quantile.first,
+                         static_cast<double>(value.*quantile.second) / 1e6, timestamp);
+        }
+        appendSample(out, summary.first + "_sum", label_text, nullptr,
+                     value.mean_us * static_cast<double>(value.count) / 1e6, timestamp);
+        appendSample(out, summary.first + "_count", label_text, nullptr, static_cast<double>(value.count), timestamp);
+    }
+    return out;
+}
+
+} // namespace sdk
+
+extern "C" {
+
+uint32_t sdk_metrics_export_text(char* buffer, uint32_t buffer_size) {
+    if (!buffer || buffer_size == 0) {
+        return 0;
+    }
+
+    try {
+        auto& sdk_instance = sdk::SDK::getInstance();
+        auto pool = sdk_instance.isInitialized() ? sdk_instance.getThreadPool() : nullptr;
+        auto client = sdk_instance.isInitialized() ? sdk_instance.getHttpClient() : nullptr;
+        std::string text = sdk::MetricsReporter::encode(sdk::MetricsReporter::collect(pool.get(), client.get()),
+                                                        std::map<std::string, std::string>(), false);
+
+        // 缓冲区不足时截断到最后一个完整的行
+        size_t copy_size = std::min<size_t>(text.size(), buffer_size - 1);
+        if (copy_size < text.size()) {
+            size_t line_end = text.rfind('\n', copy_size == 0 ? 0 : copy_size - 1);
+            copy_size = line_end == std::string::npos ? 0 : line_end + 1;
+        }
+        std::memcpy(buffer, text.data(), copy_size);
+        buffer[copy_size] = '\0';
+        return static_cast<uint32_t>(copy_size);
+    } catch (...) {
+        return 0;
+    }
+}
+
+} // extern "C"
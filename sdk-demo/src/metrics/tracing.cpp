@@ -0,0 +1,371 @@
+#include "sdk/metrics/tracing.h"
+#include "sdk/platform/platform_utils.h"
+#include "sdk/sdk_c_api.h"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace sdk {
+
+namespace detail {
+
+std::atomic<bool> g_tracing_enabled{false};
+
+} // namespace detail
+
+namespace {
+
+constexpr size_t kChunkEvents = 512;
+
+// 事件块：写入线程写完一条事件后以release发布size，读取方只读取已发布的部分
+struct Chunk {
+    TraceEvent events[kChunkEvents];
+    std::atomic<size_t> size{0};
+    std::atomic<Chunk*> next{nullptr};
+};
+
+void freeChain(Chunk* chunk) {
+    while (chunk) {
+        Chunk* next = chunk->next.load(std::memory_order_relaxed);
+        delete chunk;
+        chunk = next;
+    }
+}
+
+// 每个线程一个缓冲区；只有写入线程追加事件，切换会话时在登记表锁内换成新的事件链
+struct ThreadBuffer {
+    uint32_t tid = 0;                 // 导出时使用的线程序号
+    std::string thread_name;
+    uint64_t session = 0;             // 写入线程持有登记表锁时修改
+    std::atomic<Chunk*> head{nullptr};
+    Chunk* tail = nullptr;            // 以下三项只由写入线程访问
+    size_t count = 0;
+    size_t capacity = 0;
+    std::atomic<size_t> dropped{0};
+    bool exited = false;              // 线程已退出，下一次start()时释放
+
+    ~ThreadBuffer() {
+        freeChain(head.load(std::memory_order_relaxed));
+    }
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    uint32_t next_tid = 1;
+    size_t capacity = 65536;
+    uint64_t session_start_ns = 0;
+};
+
+Registry& registry() {
+    // 有意不析构：线程退出时仍会访问登记表
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+std::atomic<uint64_t> g_session{0};
+std::atomic<uint64_t> g_next_id{0};
+
+// 线程退出时只做标记，已记录的事件仍可以导出
+struct BufferHandle {
+    ThreadBuffer* buffer = nullptr;
+
+    ~BufferHandle() {
+        if (buffer) {
+            std::lock_guard<std::mutex> lock(registry().mutex);
+            buffer->exited = true;
+            buffer = nullptr;
+        }
+    }
+};
+
+thread_local BufferHandle t_handle;
+
+// 首次记录或会话切换后的第一次记录才进入锁
+ThreadBuffer* acquireBuffer(uint64_t session) {
+    ThreadBuffer* buffer = t_handle.buffer;
+    if (buffer && buffer->session == session) {
+        return buffer;
+    }
+
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    if (!buffer) {
+        auto created = std::make_unique<ThreadBuffer>();
+        created->tid = reg.next_tid++;
+        buffer = created.get();
+        reg.buffers.push_back(std::move(created));
+        t_handle.buffer = buffer;
+    }
+
+    // 读取方同样持有锁，旧的事件链可以直接释放
+    freeChain(buffer->head.load(std::memory_order_relaxed));
+    Chunk* chunk = new (std::nothrow) Chunk();
+    buffer->head.store(chunk, std::memory_order_release);
+    buffer->tail = chunk;
+    buffer->count = 0;
+    buffer->capacity = chunk ? reg.capacity : 0;
+    buffer->dropped.store(0, std::memory_order_relaxed);
+    buffer->thread_name = platform::ThreadUtils::getCurrentThreadName();
+    buffer->session = session;
+    return buffer;
+}
+
+void appendEscaped(std::string& out, const char* text) {
+    out.push_back('"');
+    for (const char* p = text ? text : ""; *p; ++p) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                    out += escaped;
+                } else {
+                    out.push_back(static_cast<char>(c));
+                }
+                break;
+        }
+    }
+    out.push_back('"');
+}
+
+// Chrome trace以微秒为单位，保留纳秒精度
+void appendMicros(std::string& out, uint64_t nanos) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%llu.%03u", static_cast<unsigned long long>(nanos / 1000),
+                  static_cast<unsigned>(nanos % 1000));
+    out += buffer;
+}
+
+void appendEvent(std::string& out, const TraceEvent& event, uint64_t base_ns, uint32_t pid, uint32_t tid) {
+    out += "{\"name\":";
+    appendEscaped(out, event.name);
+    out += ",\"cat\":";
+    appendEscaped(out, event.category);
+    out += ",\"ph\":\"";
+    out.push_back(event.phase);
+    out += "\",\"ts\":";
+    appendMicros(out, event.timestamp_ns > base_ns ? event.timestamp_ns - base_ns : 0);
+    if (event.phase == 'X') {
+        out += ",\"dur\":";
+        appendMicros(out, event.duration_ns);
+    } else {
+        char id[32];
+        std::snprintf(id, sizeof(id), "\"0x%llx\"", static_cast<unsigned long long>(event.id));
+        out += ",\"id\":";
+        out += id;
+    }
+    out += ",\"pid\":" + std::to_string(pid) + ",\"tid\":" + std::to_string(tid);
+    if (event.arg_name) {
+        out += ",\"args\":{";
+        appendEscaped(out, event.arg_name);
+        out += ":" + std::to_string(event.arg_value) + "}";
+    }
+    out.push_back('}');
+}
+
+} // namespace
+
+Tracer& Tracer::getInstance() {
+    static Tracer instance;
+    return instance;
+}
+
+void Tracer::start(size_t max_events_per_thread) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.capacity = max_events_per_thread > 0 ? max_events_per_thread : 65536;
+
+    // 已退出线程的缓冲区不再有写入方，可以释放
+    auto& buffers = reg.buffers;
+    for (size_t i = 0; i < buffers.size();) {
+        if (buffers[i]->exited) {
+            buffers[i] = std::move(buffers.back());
+            buffers.pop_back();
+        } else {
+            ++i;
+        }
+    }
+
+    reg.session_start_ns = now();
+    g_session.fetch_add(1, std::memory_order_release);
+    detail::g_tracing_enabled.store(true, std::memory_order_release);
+}
+
+void Tracer::stop() {
+    detail::g_tracing_enabled.store(false, std::memory_order_release);
+}
+
+std::string Tracer::toChromeTraceJson() const {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    uint64_t session = g_session.load(std::memory_order_acquire);
+    uint32_t pid = platform::PlatformUtils::getCurrentProcessId();
+
+    std::string out = "{\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&out, &first] {
+        out += first ? "\n" : ",\n";
+        first = false;
+    };
+
+    for (const auto& buffer : reg.buffers) {
+        if (buffer->session != session) {
+            continue;
+        }
+        if (!buffer->thread_name.empty()) {
+            separator();
+            out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + std::to_string(pid) +
+                   ",\"tid\":" + std::to_string(buffer->tid) + ",\"args\":{\"name\":";
+            appendEscaped(out, buffer->thread_name.c_str());
+            out += "}}";
+        }
+        for (Chunk* chunk = buffer->head.load(std::memory_order_acquire); chunk;
+             chunk = chunk->next.load(std::memory_order_acquire)) {
+            size_t size = chunk->size.load(std::memory_order_acquire);
+            for (size_t i = 0; i < size; ++i) {
+                separator();
+                appendEvent(out, chunk->events[i], reg.session_start_ns, pid, buffer->tid);
+            }
+        }
+    }
+
+    out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return out;
+}
+
+bool Tracer::writeChromeTrace(const std::string& path) const {
+    std::string json = toChromeTraceJson();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    out.write(json.data(), static_cast<std::streamsize>(json.size()));
+    return static_cast<bool>(out);
+}
+
+size_t Tracer::eventCount() const {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    uint64_t session = g_session.load(std::memory_order_acquire);
+
+    size_t total = 0;
+    for (const auto& buffer : reg.buffers) {
+        if (buffer->session != session) {
+            continue;
+        }
+        for (Chunk* chunk = buffer->head.load(std::memory_order_acquire); chunk;
+             chunk = chunk->next.load(std::memory_order_acquire)) {
+            total += chunk->size.load(std::memory_order_acquire);
+        }
+    }
+    return total;
+}
+
+size_t Tracer::droppedEvents() const {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    uint64_t session = g_session.load(std::memory_order_acquire);
+
+    size_t total = 0;
+    for (const auto& buffer : reg.buffers) {
+        if (buffer->session == session) {
+            total += buffer->dropped.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+uint64_t Tracer::nextId() {
+    return g_next_id.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void Tracer::record(const TraceEvent& event) {
+    ThreadBuffer* buffer = acquireBuffer(g_session.load(std::memory_order_acquire));
+    if (buffer->count >= buffer->capacity) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Chunk* tail = buffer->tail;
+    size_t size = tail->size.load(std::memory_order_relaxed);
+    if (size == kChunkEvents) {
+        Chunk* chunk = new (std::nothrow) Chunk();
+        if (!chunk) {
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        tail->next.store(chunk, std::memory_order_release);
+        buffer->tail = tail = chunk;
+        size = 0;
+    }
+
+    tail->events[size] = event;
+    tail->size.store(size + 1, std::memory_order_release);
+    ++buffer->count;
+}
+
+void Tracer::recordComplete(const char* category, const char* name, uint64_t start_ns, uint64_t end_ns,
+                            const char* arg_name, int64_t arg_value) {
+    TraceEvent event;
+    event.category = category;
+    event.name = name;
+    event.arg_name = arg_name;
+    event.arg_value = arg_value;
+    event.timestamp_ns = start_ns;
+    event.duration_ns = end_ns > start_ns ? end_ns - start_ns : 0;
+    event.phase = 'X';
+    record(event);
+}
+
+void Tracer::recordAsyncBegin(const char* category, const char* name, uint64_t id, uint64_t timestamp_ns) {
+    TraceEvent event;
+    event.category = category;
+    event.name = name;
+    event.timestamp_ns = timestamp_ns;
+    event.id = id;
+    event.phase = 'b';
+    record(event);
+}
+
+void Tracer::recordAsyncEnd(const char* category, const char* name, uint64_t id, uint64_t timestamp_ns) {
+    TraceEvent event;
+    event.category = category;
+    event.name = name;
+    event.timestamp_ns = timestamp_ns;
+    event.id = id;
+    event.phase = 'e';
+    record(event);
+}
+
+} // namespace sdk
+
+extern "C" {
+
+void sdk_trace_start(uint32_t max_events_per_thread) {
+    try {
+        sdk::Tracer::getInstance().start(max_events_per_thread);
+    } catch (...) {
+    }
+}
+
+bool sdk_trace_stop(const char* file_path) {
+    try {
+        sdk::Tracer& tracer = sdk::Tracer::getInstance();
+        tracer.stop();
+        return !file_path || tracer.writeChromeTrace(file_path);
+    } catch (...) {
+        return false;
+    }
+}
+
+} // extern "C"
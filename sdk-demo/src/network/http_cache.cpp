@@ -0,0 +1,435 @@
+#include "http_cache.h"
+
+#include <curl/curl.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace sdk {
+
+namespace {
+
+const char kFileMagic[] = "SDKHTTPCACHE 1";
+
+bool equalsIgnoreCase(const std::string& a, const std::string& b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](unsigned char x, unsigned char y) {
+               return std::tolower(x) == std::tolower(y);
+           });
+}
+
+// 头部名大小写不敏感（HTTP/2的头部全为小写）
+const std::string* findHeader(const HttpHeaders& headers, const std::string& name) {
+    for (const auto& header : headers) {
+        if (equalsIgnoreCase(header.first, name)) {
+            return &header.second;
+        }
+    }
+    return nullptr;
+}
+
+std::string trim(const std::string& value) {
+    size_t begin = value.find_first_not_of(" \t");
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    size_t end = value.find_last_not_of(" \t");
+    return value.substr(begin, end - begin + 1);
+}
+
+std::string toLower(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value;
+}
+
+// 64位FNV-1a，用作磁盘文件名；文件中另存完整的键用于校验冲突
+uint64_t hashKey(const std::string& key) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// 只处理本缓存写入的文件：filePath()生成的"<16位十六进制>.cache"，以及saveToDisk遗留的".cache.tmp<序号>"临时文件，
+// 目录中的其他文件不计入用量，也不会被淘汰或清除
+bool isCacheFile(const std::filesystem::directory_entry& item) {
+    std::error_code error;
+    if (!item.is_regular_file(error)) {
+        return false;
+    }
+    const size_t hash_length = 16;
+    const std::string suffix = ".cache";
+    std::string name = item.path().filename().string();
+    if (name.size() < hash_length + suffix.size() || name.compare(hash_length, suffix.size(), suffix) != 0 ||
+        !std::all_of(name.begin(), name.begin() + hash_length, [](unsigned char c) { return std::isxdigit(c); })) {
+        return false;
+    }
+    std::string rest = name.substr(hash_length + suffix.size());
+    return rest.empty() || rest.compare(0, 4, ".tmp") == 0;
+}
+
+} // namespace
+
+size_t HttpCacheEntry::size() const {
+    size_t total = body.size() + etag.size() + last_modified.size() + sizeof(HttpCacheEntry);
+    for (const auto& header : headers) {
+        total += header.first.size() + header.second.size();
+    }
+    return total;
+}
+
+HttpCache::HttpCache(size_t memory_budget, const std::string& directory, size_t disk_budget)
+    : memory_budget_(memory_budget), directory_(directory), disk_budget_(disk_budget) {
+    if (directory_.empty()) {
+        return;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+    for (const auto& item : std::filesystem::directory_iterator(directory_, error)) {
+        if (!isCacheFile(item)) {
+            continue;
+        }
+        std::error_code size_error;
+        auto size = item.file_size(size_error);
+        if (!size_error) {
+            disk_usage_ += static_cast<size_t>(size);
+        }
+    }
+}
+
+HttpCache::~HttpCache() = default;
+
+std::shared_ptr<const HttpCacheEntry> HttpCache::lookup(const std::string& key) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            return it->second->entry;
+        }
+    }
+
+    if (directory_.empty()) {
+        return nullptr;
+    }
+    auto entry = loadFromDisk(key);
+    if (entry) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        insertLocked(key, entry);
+    }
+    return entry;
+}
+
+void HttpCache::store(const std::string& key, std::shared_ptr<const HttpCacheEntry> entry) {
+    if (!entry) {
+        return;
+    }
+    if (!directory_.empty()) {
+        saveToDisk(key, *entry);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    insertLocked(key, std::move(entry));
+}
+
+void HttpCache::remove(const std::string& key) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        eraseLocked(key);
+    }
+    if (!directory_.empty()) {
+        std::lock_guard<std::mutex> lock(disk_mutex_);
+        std::error_code error;
+        std::string path = filePath(key);
+        auto size = std::filesystem::file_size(path, error);
+        if (!error && std::filesystem::remove(path, error)) {
+            disk_usage_ -= std::min(disk_usage_, static_cast<size_t>(size));
+        }
+    }
+}
+
+void HttpCache::clear() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        lru_.clear();
+        index_.clear();
+        memory_usage_ = 0;
+    }
+    if (!directory_.empty()) {
+        std::lock_guard<std::mutex> lock(disk_mutex_);
+        std::error_code error;
+        for (const auto& item : std::filesystem::directory_iterator(directory_, error)) {
+            if (!isCacheFile(item)) {
+                continue;
+            }
+            std::error_code remove_error;
+            std::filesystem::remove(item.path(), remove_error);
+        }
+        disk_usage_ = 0;
+    }
+}
+
+size_t HttpCache::memoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return memory_usage_;
+}
+
+void HttpCache::insertLocked(const std::string& key, std::shared_ptr<const HttpCacheEntry> entry) {
+    eraseLocked(key);
+    size_t size = entry->size() + key.size();
+    if (size > memory_budget_) {
+        // 超过整个预算的条目只保存在磁盘层
+        return;
+    }
+
+    lru_.push_front(Node{key, std::move(entry), size});
+    index_[key] = lru_.begin();
+    memory_usage_ += size;
+
+    while (memory_usage_ > memory_budget_ && !lru_.empty()) {
+        memory_usage_ -= lru_.back().size;
+        index_.erase(lru_.back().key);
+        lru_.pop_back();
+    }
+}
+
+void HttpCache::eraseLocked(const std::string& key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        return;
+    }
+    memory_usage_ -= it->second->size;
+    lru_.erase(it->second);
+    index_.erase(it);
+}
+
+std::string HttpCache::filePath(const std::string& key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.cache", static_cast<unsigned long long>(hashKey(key)));
+    return (std::filesystem::path(directory_) / name).string();
+}
+
+// 文件格式：魔数、键、状态码/过期时间/no-cache、ETag、Last-Modified、头部数与各头部、正文长度，之后是正文
+std::shared_ptr<const HttpCacheEntry> HttpCache::loadFromDisk(const std::string& key) const {
+    std::ifstream in(filePath(key), std::ios::binary);
+    if (!in) {
+        return nullptr;
+    }
+
+    std::string line;
+    if (!std::getline(in, line) || line != kFileMagic || !std::getline(in, line) || line != key) {
+        return nullptr;
+    }
+
+    auto entry = std::make_shared<HttpCacheEntry>();
+    int no_cache = 0;
+    size_t header_count = 0;
+    if (!(in >> entry->status_code >> entry->expires_at >> no_cache)) {
+        return nullptr;
+    }
+    entry->no_cache = no_cache != 0;
+    in.ignore(1);
+    if (!std::getline(in, entry->etag) || !std::getline(in, entry->last_modified) || !(in >> header_count)) {
+        return nullptr;
+    }
+    in.ignore(1);
+    for (size_t i = 0; i < header_count; ++i) {
+        if (!std::getline(in, line)) {
+            return nullptr;
+        }
+        size_t colon = line.find(": ");
+        if (colon != std::string::npos) {
+            entry->headers[line.substr(0, colon)] = line.substr(colon + 2);
+        }
+    }
+
+    size_t body_size = 0;
+    if (!(in >> body_size)) {
+        return nullptr;
+    }
+    in.ignore(1);
+    entry->body.resize(body_size);
+    if (body_size > 0 && !in.read(&entry->body[0], static_cast<std::streamsize>(body_size))) {
+        return nullptr;
+    }
+    return entry;
+}
+
+void HttpCache::saveToDisk(const std::string& key, const HttpCacheEntry& entry) {
+    std::string path = filePath(key);
+    // 同一键可能被并发写入，每次写各自的临时文件再原子地改名
+    static std::atomic<uint64_t> sequence{0};
+    std::string temp = path + ".tmp" + std::to_string(sequence.fetch_add(1, std::memory_order_relaxed));
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return;
+        }
+        out << kFileMagic << '\n' << key << '\n'
+            << entry.status_code << ' ' << entry.expires_at << ' ' << (entry.no_cache ? 1 : 0) << '\n'
+            << entry.etag << '\n' << entry.last_modified << '\n' << entry.headers.size() << '\n';
+        for (const auto& header : entry.headers) {
+            out << header.first << ": " << header.second << '\n';
+        }
+        out << entry.body.size() << '\n';
+        out.write(entry.body.data(), static_cast<std::streamsize>(entry.body.size()));
+        if (!out) {
+            out.close();
+            std::remove(temp.c_str());
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(disk_mutex_);
+    std::error_code error;
+    auto old_size = std::filesystem::file_size(path, error);
+    if (!error) {
+        disk_usage_ -= std::min(disk_usage_, static_cast<size_t>(old_size));
+    }
+    auto new_size = std::filesystem::file_size(temp, error);
+    std::filesystem::rename(temp, path, error);
+    if (error) {
+        std::remove(temp.c_str());
+        return;
+    }
+    disk_usage_ += static_cast<size_t>(new_size);
+    if (disk_usage_ > disk_budget_) {
+        trimDisk();
+    }
+}
+
+// 调用方持有disk_mutex_：按修改时间从旧到新删除，直到回到预算以内
+void HttpCache::trimDisk() {
+    struct CacheFile {
+        std::filesystem::path path;
+        std::filesystem::file_time_type time;
+        size_t size;
+    };
+    std::vector<CacheFile> files;
+    std::error_code error;
+    for (const auto& item : std::filesystem::directory_iterator(directory_, error)) {
+        if (!isCacheFile(item)) {
+            continue;
+        }
+        std::error_code item_error;
+        CacheFile file{item.path(), item.last_write_time(item_error), 0};
+        file.size = static_cast<size_t>(item.file_size(item_error));
+        if (!item_error) {
+            files.push_back(std::move(file));
+        }
+    }
+    std::sort(files.begin(), files.end(), [](const CacheFile& a, const CacheFile& b) { return a.time < b.time; });
+
+    for (const auto& file : files) {
+        if (disk_usage_ <= disk_budget_) {
+            break;
+        }
+        std::error_code remove_error;
+        if (std::filesystem::remove(file.path, remove_error)) {
+            disk_usage_ -= std::min(disk_usage_, file.size);
+        }
+    }
+}
+
+bool HttpCache::describe(const HttpHeaders& headers, int64_t now, HttpCacheEntry& entry) {
+    // 除Accept-Encoding外的Vary需要按请求头区分条目，这里不缓存
+    if (const std::string* vary = findHeader(headers, "Vary")) {
+        std::string value = toLower(trim(*vary));
+        if (!value.empty() && value != "accept-encoding") {
+            return false;
+        }
+    }
+
+    bool has_max_age = false;
+    int64_t max_age = 0;
+    entry.no_cache = false;
+    if (const std::string* cache_control = findHeader(headers, "Cache-Control")) {
+        std::string directives = toLower(*cache_control);
+        size_t start = 0;
+        while (start <= directives.size()) {
+            size_t comma = directives.find(',', start);
+            std::string directive = trim(directives.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+            if (directive == "no-store") {
+                return false;
+            } else if (directive == "no-cache") {
+                entry.no_cache = true;
+            } else if (directive.compare(0, 8, "max-age=") == 0) {
+                has_max_age = true;
+                max_age = std::strtoll(directive.c_str() + 8, nullptr, 10);
+            }
+            if (comma == std::string::npos) {
+                break;
+            }
+            start = comma + 1;
+        }
+    }
+
+    entry.etag.clear();
+    entry.last_modified.clear();
+    if (const std::string* etag = findHeader(headers, "ETag")) {
+        entry.etag = *etag;
+    }
+    if (const std::string* last_modified = findHeader(headers, "Last-Modified")) {
+        entry.last_modified = *last_modified;
+    }
+
+    // 有效期：max-age优先于Expires，并扣除响应在上游缓存中已驻留的Age
+    entry.expires_at = 0;
+    if (has_max_age) {
+        int64_t age = 0;
+        if (const std::string* age_header = findHeader(headers, "Age")) {
+            age = std::strtoll(age_header->c_str(), nullptr, 10);
+        }
+        entry.expires_at = now + max_age - age;
+    } else if (const std::string* expires = findHeader(headers, "Expires")) {
+        time_t time = curl_getdate(expires->c_str(), nullptr);
+        entry.expires_at = time < 0 ? 0 : static_cast<int64_t>(time);
+    }
+
+    // 既没有有效期也没有验证器的响应无法复用
+    return entry.expires_at > now || entry.hasValidators();
+}
+
+std::shared_ptr<HttpCacheEntry> HttpCache::revalidated(const HttpCacheEntry& entry, const HttpHeaders& headers,
+                                                       int64_t now, bool& cacheable) {
+    auto updated = std::make_shared<HttpCacheEntry>(entry);
+    for (const auto& header : headers) {
+        // 304不携带正文，长度相关的头部保留原值
+        if (equalsIgnoreCase(header.first, "Content-Length") ||
+            equalsIgnoreCase(header.first, "Transfer-Encoding") ||
+            equalsIgnoreCase(header.first, "Content-Encoding")) {
+            continue;
+        }
+        const std::string* existing = nullptr;
+        for (auto& old : updated->headers) {
+            if (equalsIgnoreCase(old.first, header.first)) {
+                old.second = header.second;
+                existing = &old.second;
+                break;
+            }
+        }
+        if (!existing) {
+            updated->headers[header.first] = header.second;
+        }
+    }
+
+    // 合并后的头部仍保留304未携带的验证器
+    cacheable = describe(updated->headers, now, *updated);
+    return updated;
+}
+
+int64_t HttpCache::now() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // namespace sdk
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "sdk/network/http_client.h"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace sdk {
+
+    // 缓存的响应；expires_at为Unix秒，过期后需要用etag/last_modified条件请求重新验证
+    struct HttpCacheEntry {
+        int status_code = 0;
+        HttpHeaders headers;
+        std::string body;
+        std::string etag;
+        std::string last_modified;
+        int64_t expires_at = 0;
+        bool no_cache = false;      // Cache-Control: no-cache，每次使用前都要重新验证
+
+        bool isFresh(int64_t now) const { return !no_cache && now < expires_at; }
+        bool hasValidators() const { return !etag.empty() || !last_modified.empty(); }
+        size_t size() const;
+    };
+
+    // 客户端响应缓存：内存中按LRU淘汰，总大小不超过memory_budget；
+    // directory非空时启用磁盘层，内存未命中时从磁盘加载，磁盘总大小不超过disk_budget。线程安全
+    class HttpCache {
+    public:
+        HttpCache(size_t memory_budget, const std::string& directory, size_t disk_budget);
+        ~HttpCache();
+
+        HttpCache(const HttpCache&) = delete;
+        HttpCache& operator=(const HttpCache&) = delete;
+
+        std::shared_ptr<const HttpCacheEntry> lookup(const std::string& key);
+        void store(const std::string& key, std::shared_ptr<const HttpCacheEntry> entry);
+        void remove(const std::string& key);
+        void clear();
+
+        size_t memoryUsage() const;
+
+        // 按响应头填写entry的验证器和有效期，响应不可缓存时返回false
+        static bool describe(const HttpHeaders& headers, int64_t now, HttpCacheEntry& entry);
+
+        // 304响应：合并新的头部并重新计算有效期，cacheable返回合并后的响应是否仍可缓存
+        static std::shared_ptr<HttpCacheEntry> revalidated(const HttpCacheEntry& entry, const HttpHeaders& headers,
+                                                           int64_t now, bool& cacheable);
+
+        // 当前Unix时间（秒）
+        static int64_t now();
+
+    private:
+        struct Node {
+            std::string key;
+            std::shared_ptr<const HttpCacheEntry> entry;
+            size_t size;
+        };
+
+        // 调用方持有mutex_
+        void insertLocked(const std::string& key, std::shared_ptr<const HttpCacheEntry> entry);
+        void eraseLocked(const std::string& key);
+
+        std::string filePath(const std::string& key) const;
+        std::shared_ptr<const HttpCacheEntry> loadFromDisk(const std::string& key) const;
+        void saveToDisk(const std::string& key, const HttpCacheEntry& entry);
+        void trimDisk();
+
+        const size_t memory_budget_;
+        const std::string directory_;
+        const size_t disk_budget_;
+
+        mutable std::mutex mutex_;
+        std::list<Node> lru_;   // 头部最近使用
+        std::unordered_map<std::string, std::list<Node>::iterator> index_;
+        size_t memory_usage_ = 0;
+
+        std::mutex disk_mutex_;
+        size_t disk_usage_ = 0;
+    };
+}
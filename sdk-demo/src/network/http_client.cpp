@@ -1,12 +1,28 @@
 #include "sdk/network/http_client.h"
+#include "sdk/metrics/tracing.h"
+#include "sdk/platform/platform_utils.h"
+#include "sdk/sdk_core.h"
 #include "sdk/sdk_c_api.h"
+#include "sdk/threading/thread_pool.h"
+#include "http_cache.h"
 
 #include <curl/curl.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 #include <atomic>
 #include <future>
+#include <random>
 #include <sstream>
 
 namespace sdk {
@@ -28,10 +44,220 @@ public:
     }
 };
 
+// libcurl共享对象：DNS缓存、TLS会话缓存和连接缓存在所有easy句柄之间共享，libcurl通过回调按数据类型加锁
+class CurlShare {
+public:
+    CurlShare() : share_(curl_share_init()) {
+        if (!share_) {
+            return;
+        }
+        curl_share_setopt(share_, CURLSHOPT_LOCKFUNC, lockCallback);
+        curl_share_setopt(share_, CURLSHOPT_UNLOCKFUNC, unlockCallback);
+        curl_share_setopt(share_, CURLSHOPT_USERDATA, this);
+        curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(share_, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    }
+    
+    ~CurlShare() {
+        if (share_) {
+            curl_share_cleanup(share_);
+        }
+    }
+    
+    CurlShare(const CurlShare&) = delete;
+    CurlShare& operator=(const CurlShare&) = delete;
+    
+    CURLSH* get() const {
+        return share_;
+    }
+
+private:
+    static void lockCallback(CURL*, curl_lock_data data, curl_lock_access, void* userptr) {
+        static_cast<CurlShare*>(userptr)->mutexes_[static_cast<size_t>(data) % kLockCount].lock();
+    }
+    
+    static void unlockCallback(CURL*, curl_lock_data data, void* userptr) {
+        static_cast<CurlShare*>(userptr)->mutexes_[static_cast<size_t>(data) % kLockCount].unlock();
+    }
+    
+    static constexpr size_t kLockCount = CURL_LOCK_DATA_LAST;
+    
+    CURLSH* share_;
+    std::mutex mutexes_[kLockCount];
+};
+
+// easy句柄池：按主机缓存空闲句柄，复用时保留句柄内部的连接与状态，只重置选项
+class CurlHandlePool {
+public:
+    CurlHandlePool(size_t max_idle_per_host, std::chrono::milliseconds idle_timeout)
+        : max_idle_per_host_(max_idle_per_host), idle_timeout_(idle_timeout) {}
+    
+    ~CurlHandlePool() {
+        clear();
+    }
+    
+    CurlHandlePool(const CurlHandlePool&) = delete;
+    CurlHandlePool& operator=(const CurlHandlePool&) = delete;
+    
+    // 优先取该主机最近归还的句柄，reused表示是否命中
+    CURL* acquire(const std::string& host, bool& reused) {
+        std::vector<CURL*> expired;
+        CURL* handle = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = idle_.find(host);
+            if (it != idle_.end() && !it->second.empty()) {
+                auto& handles = it->second;
+                if (std::chrono::steady_clock::now() - handles.back().since <= idle_timeout_) {
+                    handle = handles.back().handle;
+                    handles.pop_back();
+                } else {
+                    // 最近归还的句柄都已过期，更早的自然也过期
+                    for (const auto& idle : handles) {
+                        expired.push_back(idle.handle);
+                    }
+                    handles.clear();
+                }
+            }
+        }
+        
+        for (CURL* stale : expired) {
+            curl_easy_cleanup(stale);
+        }
+        
+        reused = handle != nullptr;
+        return handle ? handle : curl_easy_init();
+    }
+    
+    void release(const std::string& host, CURL* handle) {
+        // 清除指向本次请求数据的选项，连接、DNS与会话缓存保留
+        curl_easy_reset(handle);
+        
+        std::vector<CURL*> evicted;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto now = std::chrono::steady_clock::now();
+            auto& handles = idle_[host];
+            handles.push_back({handle, now});
+            
+            size_t expired = 0;
+            while (expired < handles.size() && now - handles[expired].since > idle_timeout_) {
+                ++expired;
+            }
+            size_t excess = handles.size() - expired > max_idle_per_host_ ? handles.size() - expired - max_idle_per_host_ : 0;
+            for (size_t i = 0; i < expired + excess; ++i) {
+                evicted.push_back(handles[i].handle);
+            }
+            handles.erase(handles.begin(), handles.begin() + static_cast<std::ptrdiff_t>(expired + excess));
+        }
+        
+        for (CURL* stale : evicted) {
+            curl_easy_cleanup(stale);
+        }
+    }
+    
+    void setLimits(size_t max_idle_per_host, std::chrono::milliseconds idle_timeout) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        max_idle_per_host_ = max_idle_per_host;
+        idle_timeout_ = idle_timeout;
+    }
+    
+    void clear() {
+        std::unordered_map<std::string, std::vector<IdleHandle>> idle;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            idle.swap(idle_);
+        }
+        for (const auto& pair : idle) {
+            for (const auto& handle : pair.second) {
+                curl_easy_cleanup(handle.handle);
+            }
+        }
+    }
+
+private:
+    struct IdleHandle {
+        CURL* handle;
+        std::chrono::steady_clock::time_point since;
+    };
+    
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::vector<IdleHandle>> idle_;
+    size_t max_idle_per_host_;
+    std::chrono::milliseconds idle_timeout_;
+};
+
+// 句柄池的键：scheme://host[:port]，不含用户信息和路径
+static std::string hostKey(const std::string& url) {
+    size_t scheme_end = url.find("://");
+    size_t start = scheme_end == std::string::npos ? 0 : scheme_end + 3;
+    size_t end = url.find_first_of("/?#", start);
+    std::string authority = url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+    size_t at = authority.rfind('@');
+    if (at != std::string::npos) {
+        authority.erase(0, at + 1);
+    }
+    
+    std::string key = (scheme_end == std::string::npos ? std::string("http") : url.substr(0, scheme_end)) + "://" + authority;
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return key;
+}
+
+static bool equalsIgnoreCase(const std::string& a, const char* b) {
+    size_t length = std::strlen(b);
+    if (a.size() != length) {
+        return false;
+    }
+    for (size_t i = 0; i < length; ++i) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 请求模板：客户端配置与全局头部的不可变快照。setConfig/setGlobalHeader时构造新快照整体替换（RCU），
+// 请求开始时取得当前快照并持有到完成，之后的修改只影响新请求
+struct RequestTemplate {
+    HttpClientConfig config;
+    std::vector<std::string> header_lines;   // "Name: value"
+    std::vector<std::string> header_names;   // 小写，与header_lines一一对应
+    struct curl_slist* headers = nullptr;    // 全局头部链表，所有请求只读共享
+    
+    RequestTemplate(const HttpClientConfig& client_config, const HttpHeaders& global_headers)
+        : config(client_config) {
+        for (const auto& header : global_headers) {
+            header_lines.push_back(header.first + ": " + header.second);
+            std::string name = header.first;
+            std::transform(name.begin(), name.end(), name.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            header_names.push_back(std::move(name));
+            headers = curl_slist_append(headers, header_lines.back().c_str());
+        }
+    }
+    
+    ~RequestTemplate() {
+        curl_slist_free_all(headers);
+    }
+    
+    RequestTemplate(const RequestTemplate&) = delete;
+    RequestTemplate& operator=(const RequestTemplate&) = delete;
+};
+
 // HTTP客户端实现
 class HttpClient::Impl {
 public:
-    explicit Impl(const HttpClientConfig& config) : config_(config) {
+    explicit Impl(const HttpClientConfig& config)
+        : config_(config), handle_pool_(config.max_idle_handles_per_host, config.handle_idle_timeout),
+          max_in_flight_(config.max_concurrent_requests),
+          template_(std::make_shared<const RequestTemplate>(config, HttpHeaders())),
+          dns_latency_(MetricsRegistry::getInstance().createHistogram(metric_names::kHttpDns)),
+          connect_latency_(MetricsRegistry::getInstance().createHistogram(metric_names::kHttpConnect)),
+          tls_latency_(MetricsRegistry::getInstance().createHistogram(metric_names::kHttpTls)),
+          ttfb_latency_(MetricsRegistry::getInstance().createHistogram(metric_names::kHttpTtfb)),
+          total_latency_(MetricsRegistry::getInstance().createHistogram(metric_names::kHttpTotal)) {
         // 确保libcurl已初始化
         CurlGlobalInit::getInstance();
         
@@ -40,153 +266,1181 @@ public:
         stats_.failed_requests = 0;
         stats_.total_time = std::chrono::milliseconds(0);
         stats_.average_time = std::chrono::milliseconds(0);
+        
+        cache_ = createCache(config_);
+    }
+    
+    ~Impl() {
+        stopReactor();
+    }
+    
+    HttpResponse get(const std::string& url) {
+        HttpRequest request(url);
+        request.setMethod(HttpMethod::GET);
+        return executeRequest(request);
+    }
+    
+    HttpResponse post(const std::string& url, const std::string& body) {
+        HttpRequest request(url);
+        request.setMethod(HttpMethod::POST);
+        request.setBody(body);
+        return executeRequest(request);
+    }
+    
+    HttpResponse put(const std::string& url, const std::string& body) {
+        HttpRequest request(url);
+        request.setMethod(HttpMethod::PUT);
+        request.setBody(body);
+        return executeRequest(request);
+    }
+    
+    HttpResponse del(const std::string& url) {
+        HttpRequest request(url);
+        request.setMethod(HttpMethod::DELETE);
+        return executeRequest(request);
+    }
+    
+    HttpResponse request(const HttpRequest& request) {
+        return executeRequest(request);
+    }
+    
+    std::future<HttpResponse> getAsync(const std::string& url) {
+        HttpRequest request(url);
+        request.setMethod(HttpMethod::GET);
+        return requestAsync(request);
+    }
+    
+    std::future<HttpResponse> postAsync(const std::string& url, const std::string& body) {
+        HttpRequest request(url);
+        request.setMethod(HttpMethod::POST);
+        request.setBody(body);
+        return requestAsync(request);
+    }
+    
+    std::future<HttpResponse> putAsync(const std::string& url, const std::string& body) {
+        HttpRequest request(url);
+        request.setMethod(HttpMethod::PUT);
+        request.setBody(body);
+        return requestAsync(request);
+    }
+    
+    std::future<HttpResponse> deleteAsync(const std::string& url) {
+        HttpRequest request(url);
+        request.setMethod(HttpMethod::DELETE);
+        return requestAsync(request);
+    }
+    
+    // future在反应器线程上直接完成，不占用工作线程
+    std::future<HttpResponse> requestAsync(const HttpRequest& request) {
+        auto promise = std::make_shared<std::promise<HttpResponse>>();
+        auto future = promise->get_future();
+        submitAsync(request, [promise](HttpResponse response) {
+            promise->set_value(std::move(response));
+        }, false);
+        return future;
+    }
+    
+    // 回调投递到回调线程池，未设置线程池时在反应器线程上执行
+    void requestAsync(const HttpRequest& request, ResponseCallback callback) {
+        submitAsync(request, [callback](HttpResponse response) {
+            if (callback) {
+                callback(response);
+            }
+        }, true);
+    }
+    
+    // 下载目标文件：响应体边接收边写入，请求失败时删除不完整的文件
+    struct DownloadTarget {
+        std::string path;
+        std::FILE* file = nullptr;
+        bool write_failed = false;
+    
+        explicit DownloadTarget(const std::string& file_path)
+            : path(file_path), file(std::fopen(file_path.c_str(), "wb")) {}
+    
+        ~DownloadTarget() {
+            if (file) {
+                std::fclose(file);
+            }
+        }
+    
+        bool write(const char* data, size_t size) {
+            if (std::fwrite(data, 1, size, file) != size) {
+                write_failed = true;
+                return false;
+            }
+            return true;
+        }
+    
+        void finish(HttpResponse& response) {
+            bool closed = std::fclose(file) == 0;
+            file = nullptr;
+            if (write_failed || !closed) {
+                response.error_ = "Failed to write file: " + path;
+                response.status_code_ = 0;
+            }
+            if (!response.isSuccess()) {
+                std::remove(path.c_str());
+            }
+        }
+    
+        // 返回接收响应体的回调，target需在请求完成前有效
+        static BodyChunkCallback sink(DownloadTarget* target) {
+            return [target](const char* data, size_t size) { return target->write(data, size); };
+        }
+    };
+    
+    static HttpResponse failedResponse(const std::string& error) {
+        HttpResponse response;
+        response.error_ = error;
+        return response;
+    }
+    
+    HttpResponse downloadFile(const std::string& url, const std::string& file_path, ProgressCallback progress) {
+        DownloadTarget target(file_path);
+        if (!target.file) {
+            return failedResponse("Failed to open file: " + file_path);
+        }
+        
+        HttpRequest request(url);
+        request.setResponseSink(DownloadTarget::sink(&target));
+        request.setProgressCallback(std::move(progress));
+        HttpResponse response = executeRequest(request);
+        target.finish(response);
+        return response;
+    }
+    
+    std::future<HttpResponse> downloadFileAsync(const std::string& url, const std::string& file_path,
+                                                ProgressCallback progress) {
+        auto target = std::make_shared<DownloadTarget>(file_path);
+        auto promise = std::make_shared<std::promise<HttpResponse>>();
+        auto future = promise->get_future();
+        if (!target->file) {
+            promise->set_value(failedResponse("Failed to open file: " + file_path));
+            return future;
+        }
+        
+        HttpRequest request(url);
+        request.setResponseSink(DownloadTarget::sink(target.get()));
+        request.setProgressCallback(std::move(progress));
+        submitAsync(request, [promise, target](HttpResponse response) {
+            target->finish(response);
+            promise->set_value(std::move(response));
+        }, false);
+        return future;
+    }
+    
+    HttpResponse uploadFile(const std::string& url, const std::string& file_path,
+                            const std::string& field_name, ProgressCallback progress) {
+        HttpRequest request(url);
+        request.setMethod(HttpMethod::POST);
+        request.setUploadFile(field_name, file_path);
+        request.setProgressCallback(std::move(progress));
+        return executeRequest(request);
+    }
+    
+    std::future<HttpResponse> uploadFileAsync(const std::string& url, const std::string& file_path,
+                                              const std::string& field_name, ProgressCallback progress) {
+        HttpRequest request(url);
+        request.setMethod(HttpMethod::POST);
+        request.setUploadFile(field_name, file_path);
+        request.setProgressCallback(std::move(progress));
+        return requestAsync(request);
+    }
+    
+    void setCallbackPool(std::shared_ptr<ThreadPool> pool) {
+        std::lock_guard<std::mutex> lock(reactor_mutex_);
+        callback_pool_ = std::move(pool);
+    }
+    
+    void setMaxConcurrentRequests(size_t max_requests) {
+        {
+            std::lock_guard<std::mutex> lock(reactor_mutex_);
+            max_in_flight_ = max_requests;
+        }
+        wakeReactor();
+    }
+    
+    size_t getActiveRequestCount() const {
+        return active_requests_.load(std::memory_order_relaxed);
+    }
+    
+    void cancelAllRequests() {
+        {
+            std::lock_guard<std::mutex> lock(reactor_mutex_);
+            cancel_generation_++;
+        }
+        wakeReactor();
+    }
+    
+    // 从不可变快照复制，不读取可能正在被setConfig改写的config_
+    HttpClientConfig getConfig() const {
+        return snapshot()->config;
+    }
+    
+    void setConfig(const HttpClientConfig& config) {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        bool cache_changed = config.enable_cache != config_.enable_cache ||
+                             config.cache_memory_budget != config_.cache_memory_budget ||
+                             config.cache_on_disk != config_.cache_on_disk ||
+                             config.cache_directory != config_.cache_directory ||
+                             config.cache_disk_budget != config_.cache_disk_budget;
+        config_ = config;
+        if (cache_changed) {
+            std::atomic_store(&cache_, createCache(config_));
+        }
+        handle_pool_.setLimits(config.max_idle_handles_per_host, config.handle_idle_timeout);
+        publishTemplate();
+        {
+            std::lock_guard<std::mutex> reactor_lock(reactor_mutex_);
+            max_in_flight_ = config.max_concurrent_requests;
+            multi_options_changed_ = true;
+        }
+        wakeReactor();
+    }
+    
+    void setGlobalHeader(const std::string& key, const std::string& value) {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        global_headers_[key] = value;
+        publishTemplate();
+    }
+    
+    void removeGlobalHeader(const std::string& key) {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        global_headers_.erase(key);
+        publishTemplate();
+    }
+    
+    void clearGlobalHeaders() {
+        std::lock_guard<std::mutex> lock(config_mutex_);
+        global_headers_.clear();
+        publishTemplate();
+    }
+    
+    // 调用方持有config_mutex_，写者之间串行，读者不加锁
+    void publishTemplate() {
+        std::atomic_store(&template_, std::make_shared<const RequestTemplate>(config_, global_headers_));
+    }
+    
+    std::shared_ptr<const RequestTemplate> snapshot() const {
+        return std::atomic_load(&template_);
+    }
+    
+    Stats getStats() const {
+        Stats stats;
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats = stats_;
+        }
+        stats.dns_latency = dns_latency_->snapshot().summary();
+        stats.connect_latency = connect_latency_->snapshot().summary();
+        stats.tls_latency = tls_latency_->snapshot().summary();
+        stats.ttfb_latency = ttfb_latency_->snapshot().summary();
+        stats.total_latency = total_latency_->snapshot().summary();
+        return stats;
+    }
+    
+    void clearCache() {
+        if (auto cache = std::atomic_load(&cache_)) {
+            cache->clear();
+        }
+    }
+
+private:
+    // 一次请求的全部状态；setupCurlOptions把自身地址交给句柄的回调，设置后不能移动
+    // 同步请求直接引用调用方的请求，异步请求把请求复制到owned_request
+    struct Transfer {
+        const HttpRequest* request = nullptr;
+        HttpRequest owned_request;
+        HttpResponse response;
+        std::string host;
+        CURL* curl = nullptr;
+        std::shared_ptr<const RequestTemplate> tmpl;
+        std::vector<std::string> header_lines;         // 请求自己的头部
+        std::vector<struct curl_slist> header_nodes;   // 指向header_lines，尾部接模板的全局头部
+        curl_mime* mime = nullptr;
+        bool upload_progress = false;
+        curl_off_t last_progress = -1;
+        bool handle_reused = false;
+        std::chrono::steady_clock::time_point start_time;
+        
+        // 异步请求的完成回调，use_pool表示投递到回调线程池
+        std::function<void(HttpResponse)> on_complete;
+        bool use_pool = false;
+        bool async = false;
+        
+        // 可缓存的请求持有缓存，cached为发起条件请求时的缓存条目
+        std::shared_ptr<HttpCache> cache;
+        std::shared_ptr<const HttpCacheEntry> cached;
+        
+        // 重试：attempt为已重试次数，not_before为下次开始的最早时间
+        size_t attempt = 0;
+        std::chrono::steady_clock::time_point not_before;
+        
+        // 对冲：同一请求的两个传输互为sibling，owner持有完成回调，另一个只是副本
+        CURL* sibling = nullptr;
+        bool owner = true;
+        bool hedged = false;
+        bool is_hedge = false;
+    };
+    
+    // 合并中的请求：领头的调用方发出请求，其余调用方等待同一响应
+    struct Flight {
+        bool done = false;
+        HttpResponse response;
+        std::condition_variable cv;
+        std::vector<std::pair<std::function<void(HttpResponse)>, bool>> followers;  // 异步调用方及use_pool
+    };
+    
+    static std::shared_ptr<HttpCache> createCache(const HttpClientConfig& config) {
+        if (!config.enable_cache) {
+            return nullptr;
+        }
+        std::string directory;
+        if (config.cache_on_disk) {
+            directory = config.cache_directory;
+            if (directory.empty()) {
+                std::string base = platform::PlatformUtils::getApplicationDataPath();
+                if (!base.empty()) {
+                    directory = (std::filesystem::path(base) / "sdk" / "http_cache").string();
+                }
+            }
+        }
+        return std::make_shared<HttpCache>(config.cache_memory_budget, directory, config.cache_disk_budget);
+    }
+    
+    // 只缓存不带凭据、不流式接收正文、也没有自行发起条件请求的GET；
+    // 缓存按URL索引，关闭SSL校验、改用其他代理或User-Agent的请求既不读也不写缓存
+    static bool isCacheable(const HttpRequest& request) {
+        if (request.method_ != HttpMethod::GET || request.response_sink_ ||
+            !request.verify_ssl_ || !request.proxy_url_.empty() || !request.user_agent_.empty()) {
+            return false;
+        }
+        for (const auto& header : request.headers_) {
+            if (equalsIgnoreCase(header.first, "Authorization") ||
+                equalsIgnoreCase(header.first, "If-None-Match") ||
+                equalsIgnoreCase(header.first, "If-Modified-Since") ||
+                equalsIgnoreCase(header.first, "Cache-Control")) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    static void fillFromCache(HttpResponse& response, const HttpCacheEntry& entry) {
+        response.status_code_ = entry.status_code;
+        response.headers_ = entry.headers;
+        response.body_ = entry.body;
+        response.error_.clear();
+    }
+    
+    // 缓存新鲜时直接填好响应并返回true；过期但有验证器时改为条件请求
+    bool lookupCache(Transfer& transfer) {
+        auto cache = std::atomic_load(&cache_);
+        if (!cache || !isCacheable(*transfer.request)) {
+            return false;
+        }
+        transfer.cache = cache;
+        
+        auto entry = cache->lookup(transfer.request->getUrl());
+        if (!entry) {
+            return false;
+        }
+        if (entry->isFresh(HttpCache::now())) {
+            fillFromCache(transfer.response, *entry);
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.total_requests++;
+            stats_.successful_requests++;
+            stats_.cache_hits++;
+            stats_.average_time = stats_.total_time / stats_.total_requests;
+            return true;
+        }
+        if (entry->hasValidators()) {
+            if (transfer.request != &transfer.owned_request) {
+                transfer.owned_request = *transfer.request;
+                transfer.request = &transfer.owned_request;
+            }
+            if (!entry->etag.empty()) {
+                transfer.owned_request.setHeader("If-None-Match", entry->etag);
+            }
+            if (!entry->last_modified.empty()) {
+                transfer.owned_request.setHeader("If-Modified-Since", entry->last_modified);
+            }
+            transfer.cached = std::move(entry);
+        }
+        return false;
+    }
+    
+    // 304时用缓存的正文作为响应，200时写入缓存
+    void updateCache(Transfer& transfer) {
+        const std::string& key = transfer.request->getUrl();
+        int64_t now = HttpCache::now();
+        HttpResponse& response = transfer.response;
+        
+        if (response.status_code_ == 304 && transfer.cached) {
+            bool cacheable = false;
+            auto entry = HttpCache::revalidated(*transfer.cached, response.headers_, now, cacheable);
+            fillFromCache(response, *entry);
+            if (cacheable) {
+                transfer.cache->store(key, std::move(entry));
+            } else {
+                transfer.cache->remove(key);
+            }
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.cache_revalidations++;
+            return;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.cache_misses++;
+        }
+        if (response.status_code_ != 200) {
+            return;
+        }
+        auto entry = std::make_shared<HttpCacheEntry>();
+        if (HttpCache::describe(response.headers_, now, *entry)) {
+            entry->status_code = response.status_code_;
+            entry->headers = response.headers_;
+            entry->body = response.body_;
+            transfer.cache->store(key, std::move(entry));
+        } else if (transfer.cached) {
+            transfer.cache->remove(key);
+        }
+    }
+    
+    HttpResponse executeRequest(const HttpRequest& request) {
+        TraceSpan span("http", "http.request");
+        std::string key = coalesceKey(request);
+        std::shared_ptr<Flight> flight;
+        if (!key.empty()) {
+            std::unique_lock<std::mutex> lock(flights_mutex_);
+            auto it = flights_.find(key);
+            if (it != flights_.end()) {
+                std::shared_ptr<Flight> existing = it->second;
+                recordCoalesced();
+                existing->cv.wait(lock, [&] { return existing->done; });
+                return existing->response;
+            }
+            flight = std::make_shared<Flight>();
+            flights_.emplace(key, flight);
+        }
+        
+        HttpResponse response;
+        try {
+            response = executeWithRetry(request);
+        } catch (const std::exception& e) {
+            // 领头的请求异常退出时仍要发布结果，否则等待者与之后同一URL的请求会一直阻塞
+            if (flight) {
+                HttpResponse failed;
+                failed.error_ = e.what();
+                publish(key, flight, failed);
+            }
+            throw;
+        } catch (...) {
+            if (flight) {
+                HttpResponse failed;
+                failed.error_ = "Request aborted by an exception";
+                publish(key, flight, failed);
+            }
+            throw;
+        }
+        if (flight) {
+            publish(key, flight, response);
+        }
+        span.setArg("status", response.getStatusCode());
+        return response;
+    }
+    
+    // 同步请求的重试在调用线程上等待，调用方本就阻塞在这次请求上
+    HttpResponse executeWithRetry(const HttpRequest& request) {
+        for (size_t attempt = 0;; ++attempt) {
+            Transfer transfer;
+            transfer.request = &request;
+            transfer.attempt = attempt;
+            if (lookupCache(transfer)) {
+                return std::move(transfer.response);
+            }
+            
+            std::chrono::milliseconds hedge_delay{0};
+            if (isHedgeable(*transfer.request) && hedgeDelay(hedge_delay)) {
+                performHedged(transfer, hedge_delay);
+            } else if (beginTransfer(transfer)) {
+                finishTransfer(transfer, curl_easy_perform(transfer.curl));
+            } else {
+                finishTransfer(transfer, CURLE_FAILED_INIT);
+            }
+            
+            if (!shouldRetry(transfer)) {
+                return std::move(transfer.response);
+            }
+            recordRetry();
+            std::this_thread::sleep_for(retryDelay(attempt));
+        }
+    }
+    
+    // 同步对冲：在临时的multi句柄上同时驱动原请求和副本，先成功者为准
+    void performHedged(Transfer& primary, std::chrono::milliseconds hedge_delay) {
+        if (!beginTransfer(primary)) {
+            finishTransfer(primary, CURLE_FAILED_INIT);
+            return;
+        }
+        CURLM* multi = curl_multi_init();
+        if (!multi || curl_multi_add_handle(multi, primary.curl) != CURLM_OK) {
+            if (multi) {
+                curl_multi_cleanup(multi);
+            }
+            finishTransfer(primary, curl_easy_perform(primary.curl));
+            return;
+        }
+        
+        Transfer hedge;
+        hedge.is_hedge = true;
+        bool primary_running = true;
+        bool hedge_running = false;
+        bool hedge_started = false;
+        Transfer* winner = nullptr;
+        CURLcode winner_result = CURLE_OK;
+        auto deadline = primary.start_time + hedge_delay;
+        
+        while (!winner) {
+            int running = 0;
+            curl_multi_perform(multi, &running);
+            
+            int remaining = 0;
+            while (CURLMsg* message = curl_multi_info_read(multi, &remaining)) {
+                if (message->msg != CURLMSG_DONE) {
+                    continue;
+                }
+                bool is_primary = message->easy_handle == primary.curl;
+                Transfer& done = is_primary ? primary : hedge;
+                bool& done_running = is_primary ? primary_running : hedge_running;
+                bool other_running = is_primary ? hedge_running : primary_running;
+                curl_multi_remove_handle(multi, done.curl);
+                done_running = false;
+                
+                // 失败的一方在另一方仍在进行时直接丢弃
+                if (other_running && !succeeded(done.curl, message->data.result)) {
+                    releaseResources(done);
+                    continue;
+                }
+                winner = &done;
+                winner_result = message->data.result;
+                break;
+            }
+            if (winner) {
+                break;
+            }
+            
+            auto now = std::chrono::steady_clock::now();
+            if (!hedge_started && now >= deadline) {
+                hedge_started = true;
+                hedge.request = primary.request;
+                hedge.cache = primary.cache;
+                hedge.cached = primary.cached;
+                if (beginTransfer(hedge) && curl_multi_add_handle(multi, hedge.curl) == CURLM_OK) {
+                    hedge_running = true;
+                    recordHedge(false);
+                } else {
+                    releaseResources(hedge);
+                }
+            }
+            
+            int timeout_ms = 1000;
+            if (!hedge_started) {
+                auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - now).count();
+                timeout_ms = static_cast<int>(std::max<int64_t>(1, std::min<int64_t>(wait, timeout_ms)));
+            }
+            curl_multi_poll(multi, nullptr, 0, timeout_ms, nullptr);
+        }
+        
+        Transfer& loser = winner == &primary ? hedge : primary;
+        if (loser.curl && (winner == &primary ? hedge_running : primary_running)) {
+            curl_multi_remove_handle(multi, loser.curl);
+        }
+        releaseResources(loser);
+        curl_multi_cleanup(multi);
+        
+        finishTransfer(*winner, winner_result);
+        if (winner == &hedge) {
+            if (hedge.response.isSuccess()) {
+                recordHedge(true);
+            }
+            primary.response = std::move(hedge.response);
+        }
+    }
+    
+    // 取得句柄并设置选项，失败时response中带有错误信息
+    bool beginTransfer(Transfer& transfer) {
+        transfer.start_time = std::chrono::steady_clock::now();
+        transfer.tmpl = snapshot();
+        transfer.host = hostKey(transfer.request->getUrl());
+        transfer.curl = handle_pool_.acquire(transfer.host, transfer.handle_reused);
+        if (!transfer.curl) {
+            transfer.response.error_ = "Failed to initialize CURL";
+            return false;
+        }
+        
+        try {
+            setupCurlOptions(transfer);
+        } catch (const std::exception& e) {
+            transfer.response.error_ = e.what();
+            releaseResources(transfer);
+            return false;
+        }
+        return true;
+    }
+    
+    // 头部节点与表单必须在请求完成后才能释放，之后句柄归还句柄池
+    void releaseResources(Transfer& transfer) {
+        transfer.header_nodes.clear();
+        transfer.header_lines.clear();
+        if (transfer.mime) {
+            curl_mime_free(transfer.mime);
+            transfer.mime = nullptr;
+        }
+        if (transfer.curl) {
+            handle_pool_.release(transfer.host, transfer.curl);
+            transfer.curl = nullptr;
+        }
+    }
+    
+    // 收集结果、归还句柄并更新统计
+    void finishTransfer(Transfer& transfer, CURLcode result) {
+        bool connection_reused = false;
+        long new_connections = 0;
+        bool http2 = false;
+        if (transfer.curl) {
+            // 失败的请求也可能已经建立了连接
+            curl_easy_getinfo(transfer.curl, CURLINFO_NUM_CONNECTS, &new_connections);
+            if (result != CURLE_OK) {
+                transfer.response.error_ = curl_easy_strerror(result);
+                transfer.response.status_code_ = 0;
+            } else {
+                long response_code;
+                curl_easy_getinfo(transfer.curl, CURLINFO_RESPONSE_CODE, &response_code);
+                transfer.response.status_code_ = static_cast<int>(response_code);
+                
+                // 本次请求没有新建连接即为复用；HTTP/2下即复用了已有连接上的一个流
+                connection_reused = new_connections == 0;
+                
+                long version = 0;
+                curl_easy_getinfo(transfer.curl, CURLINFO_HTTP_VERSION, &version);
+                http2 = version == CURL_HTTP_VERSION_2_0;
+                
+                if (transfer.cache) {
+                    updateCache(transfer);
+                }
+            }
+            recordTimings(transfer.curl, new_connections > 0, transfer.start_time);
+        }
+        
+        releaseResources(transfer);
+        
+        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - transfer.start_time);
+        transfer.response.response_time_ = duration;
+        
+        updateStats(transfer.response.isSuccess(), duration, transfer.handle_reused, connection_reused,
+                    static_cast<size_t>(new_connections), http2);
+    }
+    
+    // 异步引擎：单个反应器线程驱动curl_multi，所有异步请求共用它的事件循环；
+    // 同时进行的请求数受max_in_flight_限制，超出部分在waiting_中排队
+    void submitAsync(const HttpRequest& request, std::function<void(HttpResponse)> on_complete, bool use_pool) {
+        std::string key = coalesceKey(request);
+        if (!key.empty()) {
+            std::lock_guard<std::mutex> lock(flights_mutex_);
+            auto it = flights_.find(key);
+            if (it != flights_.end()) {
+                it->second->followers.emplace_back(std::move(on_complete), use_pool);
+                active_requests_.fetch_add(1, std::memory_order_relaxed);
+                recordCoalesced();
+                return;
+            }
+            auto flight = std::make_shared<Flight>();
+            flights_.emplace(key, flight);
+            on_complete = [this, key, flight, leader = std::move(on_complete)](HttpResponse response) {
+                publish(key, flight, response);
+                leader(std::move(response));
+            };
+        }
+        
+        auto transfer = std::make_unique<Transfer>();
+        transfer->owned_request = request;
+        transfer->request = &transfer->owned_request;
+        transfer->on_complete = std::move(on_complete);
+        transfer->use_pool = use_pool;
+        transfer->async = true;
+        
+        if (lookupCache(*transfer)) {
+            active_requests_.fetch_add(1, std::memory_order_relaxed);
+            complete(std::move(transfer));
+            return;
+        }
+        
+        active_requests_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(reactor_mutex_);
+            if (!reactor_started_) {
+                multi_ = curl_multi_init();
+                if (multi_) {
+                    applyMultiOptions(snapshot()->config);
+                    reactor_started_ = true;
+                    reactor_ = std::thread([this] { runReactor(); });
+                }
+            }
+            if (multi_) {
+                waiting_.push_back(std::move(transfer));
+            }
+        }
+        if (transfer) {
+            // 完成回调可能再次进入reactor_mutex_，必须在锁外调用
+            transfer->response.error_ = "Failed to initialize CURL multi handle";
+            updateStats(false, std::chrono::milliseconds(0), false, false, 0, false);
+            complete(std::move(transfer));
+            return;
+        }
+        wakeReactor();
+    }
+    
+    // 调用方持有reactor_mutex_：反应器线程运行后只在持锁区间内调用，与curl_multi_perform不会并发
+    void applyMultiOptions(const HttpClientConfig& config) {
+        curl_multi_setopt(multi_, CURLMOPT_PIPELINING,
+                          config.enable_multiplexing ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
+        curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(config.max_connections_per_host));
+#if LIBCURL_VERSION_NUM >= 0x074300
+        curl_multi_setopt(multi_, CURLMOPT_MAX_CONCURRENT_STREAMS, static_cast<long>(config.max_streams_per_connection));
+#endif
+    }
+    
+    void wakeReactor() {
+        std::lock_guard<std::mutex> lock(reactor_mutex_);
+        if (multi_) {
+            curl_multi_wakeup(multi_);
+        }
+    }
+    
+    void stopReactor() {
+        {
+            std::lock_guard<std::mutex> lock(reactor_mutex_);
+            if (!reactor_started_) {
+                return;
+            }
+            reactor_stopping_ = true;
+            curl_multi_wakeup(multi_);
+        }
+        reactor_.join();
+        curl_multi_cleanup(multi_);
+        multi_ = nullptr;
+    }
+    
+    void runReactor() {
+        uint64_t seen_cancel = 0;
+        for (;;) {
+            std::vector<std::unique_ptr<Transfer>> starting;
+            std::vector<std::unique_ptr<Transfer>> cancelled;
+            bool stopping = false;
+            
+            // 到期的重试重新排到等待队列最前面
+            auto now = std::chrono::steady_clock::now();
+            std::vector<std::unique_ptr<Transfer>> due;
+            for (auto it = delayed_.begin(); it != delayed_.end();) {
+                if ((*it)->not_before <= now) {
+                    due.push_back(std::move(*it));
+                    it = delayed_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(reactor_mutex_);
+                for (auto it = due.rbegin(); it != due.rend(); ++it) {
+                    waiting_.push_front(std::move(*it));
+                }
+                stopping = reactor_stopping_;
+                if (multi_options_changed_) {
+                    multi_options_changed_ = false;
+                    applyMultiOptions(snapshot()->config);
+                }
+                if (stopping || cancel_generation_ != seen_cancel) {
+                    seen_cancel = cancel_generation_;
+                    for (auto& transfer : waiting_) {
+                        cancelled.push_back(std::move(transfer));
+                    }
+                    waiting_.clear();
+                } else {
+                    size_t capacity = max_in_flight_ == 0 ? waiting_.size()
+                        : (max_in_flight_ > in_flight_.size() ? max_in_flight_ - in_flight_.size() : 0);
+                    while (capacity-- > 0 && !waiting_.empty()) {
+                        starting.push_back(std::move(waiting_.front()));
+                        waiting_.pop_front();
+                    }
+                }
+            }
+            
+            if (!cancelled.empty() || stopping) {
+                // 取消时正在进行和等待重试的请求同样中止，对冲副本直接丢弃
+                for (auto& pair : in_flight_) {
+                    curl_multi_remove_handle(multi_, pair.first);
+                    if (pair.second->owner) {
+                        cancelled.push_back(std::move(pair.second));
+                    } else {
+                        releaseResources(*pair.second);
+                    }
+                }
+                in_flight_.clear();
+                for (auto& transfer : delayed_) {
+                    cancelled.push_back(std::move(transfer));
+                }
+                delayed_.clear();
+                for (auto& transfer : cancelled) {
+                    finishCancelled(std::move(transfer));
+                }
+            }
+            if (stopping) {
+                break;
+            }
+            
+            for (auto& transfer : starting) {
+                if (beginTransfer(*transfer)) {
+                    CURL* curl = transfer->curl;
+                    if (curl_multi_add_handle(multi_, curl) == CURLM_OK) {
+                        in_flight_.emplace(curl, std::move(transfer));
+                        continue;
+                    }
+                    finishTransfer(*transfer, CURLE_FAILED_INIT);
+                } else {
+                    finishTransfer(*transfer, CURLE_FAILED_INIT);
+                }
+                complete(std::move(transfer));
+            }
+            
+            int running = 0;
+            curl_multi_perform(multi_, &running);
+            
+            size_t in_flight_before = in_flight_.size();
+            int remaining = 0;
+            while (CURLMsg* message = curl_multi_info_read(multi_, &remaining)) {
+                if (message->msg != CURLMSG_DONE) {
+                    continue;
+                }
+                CURL* curl = message->easy_handle;
+                CURLcode result = message->data.result;
+                curl_multi_remove_handle(multi_, curl);
+                
+                auto it = in_flight_.find(curl);
+                if (it == in_flight_.end()) {
+                    continue;
+                }
+                std::unique_ptr<Transfer> transfer = std::move(it->second);
+                in_flight_.erase(it);
+                
+                auto sibling = transfer->sibling ? in_flight_.find(transfer->sibling) : in_flight_.end();
+                if (sibling != in_flight_.end()) {
+                    Transfer& other = *sibling->second;
+                    other.sibling = nullptr;
+                    if (!succeeded(curl, result)) {
+                        // 失败的一方丢弃，由仍在进行的另一方完成请求
+                        if (transfer->owner) {
+                            adopt(other, *transfer);
+                        }
+                        releaseResources(*transfer);
+                        continue;
+                    }
+                    curl_multi_remove_handle(multi_, other.curl);
+                    if (other.owner) {
+                        adopt(*transfer, other);
+                    }
+                    releaseResources(other);
+                    in_flight_.erase(sibling);
+                }
+                transfer->sibling = nullptr;
+                
+                finishTransfer(*transfer, result);
+                if (transfer->is_hedge && transfer->response.isSuccess()) {
+                    recordHedge(true);
+                }
+                if (shouldRetry(*transfer)) {
+                    scheduleRetry(std::move(transfer));
+                    continue;
+                }
+                complete(std::move(transfer));
+            }
+            
+            // 等待套接字事件、libcurl内部超时、重试或对冲的时间点，或curl_multi_wakeup；
+            // 本轮有请求完成时不等待，让排队的请求立即补上空出的并发名额
+            bool slots_freed = in_flight_.size() < in_flight_before;
+            int timeout_ms = startHedges();
+            if (slots_freed) {
+                timeout_ms = 0;
+            }
+            now = std::chrono::steady_clock::now();
+            for (const auto& transfer : delayed_) {
+                auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(transfer->not_before - now).count();
+                timeout_ms = static_cast<int>(std::max<int64_t>(0, std::min<int64_t>(wait, timeout_ms)));
+            }
+            curl_multi_poll(multi_, nullptr, 0, timeout_ms, nullptr);
+        }
     }
     
-    ~Impl() = default;
-    
-    HttpResponse get(const std::string& url) {
-        HttpRequest request(url);
-        request.setMethod(HttpMethod::GET);
-        return executeRequest(request);
+    // 为运行超过对冲阈值的GET启动副本，返回距下一个对冲时间点的毫秒数（最多1000）
+    int startHedges() {
+        int timeout_ms = 1000;
+        std::chrono::milliseconds hedge_delay{0};
+        if (!hedgeDelay(hedge_delay)) {
+            return timeout_ms;
+        }
+        
+        auto now = std::chrono::steady_clock::now();
+        std::vector<Transfer*> candidates;
+        for (auto& pair : in_flight_) {
+            Transfer& transfer = *pair.second;
+            if (transfer.hedged || transfer.is_hedge || !isHedgeable(*transfer.request)) {
+                continue;
+            }
+            auto elapsed = now - transfer.start_time;
+            if (elapsed >= hedge_delay) {
+                candidates.push_back(&transfer);
+            } else {
+                auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(hedge_delay - elapsed).count();
+                timeout_ms = static_cast<int>(std::max<int64_t>(1, std::min<int64_t>(wait, timeout_ms)));
+            }
+        }
+        
+        for (Transfer* primary : candidates) {
+            primary->hedged = true;
+            auto hedge = std::make_unique<Transfer>();
+            hedge->owned_request = *primary->request;
+            hedge->request = &hedge->owned_request;
+            hedge->cache = primary->cache;
+            hedge->cached = primary->cached;
+            hedge->async = true;
+            hedge->owner = false;
+            hedge->is_hedge = true;
+            if (!beginTransfer(*hedge)) {
+                continue;
+            }
+            CURL* curl = hedge->curl;
+            if (curl_multi_add_handle(multi_, curl) != CURLM_OK) {
+                releaseResources(*hedge);
+                continue;
+            }
+            hedge->sibling = primary->curl;
+            primary->sibling = curl;
+            in_flight_.emplace(curl, std::move(hedge));
+            recordHedge(false);
+        }
+        return timeout_ms;
     }
     
-    HttpResponse post(const std::string& url, const std::string& body) {
-        HttpRequest request(url);
-        request.setMethod(HttpMethod::POST);
-        request.setBody(body);
-        return executeRequest(request);
+    // 只在反应器线程上调用
+    void scheduleRetry(std::unique_ptr<Transfer> transfer) {
+        recordRetry();
+        auto delay = retryDelay(transfer->attempt);
+        transfer->attempt++;
+        transfer->response = HttpResponse();
+        transfer->upload_progress = false;
+        transfer->last_progress = -1;
+        transfer->handle_reused = false;
+        transfer->hedged = false;
+        transfer->is_hedge = false;
+        transfer->not_before = std::chrono::steady_clock::now() + delay;
+        delayed_.push_back(std::move(transfer));
     }
     
-    HttpResponse put(const std::string& url, const std::string& body) {
-        HttpRequest request(url);
-        request.setMethod(HttpMethod::PUT);
-        request.setBody(body);
-        return executeRequest(request);
+    // 对冲副本接管完成回调
+    static void adopt(Transfer& to, Transfer& from) {
+        to.on_complete = std::move(from.on_complete);
+        to.use_pool = from.use_pool;
+        to.attempt = from.attempt;
+        to.owner = true;
+        from.owner = false;
     }
     
-    HttpResponse del(const std::string& url) {
-        HttpRequest request(url);
-        request.setMethod(HttpMethod::DELETE);
-        return executeRequest(request);
+    void finishCancelled(std::unique_ptr<Transfer> transfer) {
+        if (!transfer->curl) {
+            // 仍在排队，尚未开始计时
+            transfer->start_time = std::chrono::steady_clock::now();
+        }
+        finishTransfer(*transfer, CURLE_ABORTED_BY_CALLBACK);
+        transfer->response.error_ = "Request cancelled";
+        transfer->response.status_code_ = 0;
+        complete(std::move(transfer));
     }
     
-    HttpResponse request(const HttpRequest& request) {
-        return executeRequest(request);
+    // 只在反应器线程上调用
+    void complete(std::unique_ptr<Transfer> transfer) {
+        active_requests_.fetch_sub(1, std::memory_order_relaxed);
+        if (transfer->on_complete) {
+            deliver(std::move(transfer->on_complete), transfer->use_pool, std::move(transfer->response));
+        }
     }
     
-    std::future<HttpResponse> getAsync(const std::string& url) {
-        return std::async(std::launch::async, [this, url]() {
-            return get(url);
-        });
+    void deliver(std::function<void(HttpResponse)> on_complete, bool use_pool, HttpResponse response) {
+        std::shared_ptr<ThreadPool> pool;
+        if (use_pool) {
+            std::lock_guard<std::mutex> lock(reactor_mutex_);
+            pool = callback_pool_;
+        }
+        
+        if (pool) {
+            try {
+                pool->post([on_complete, response]() mutable {
+                    on_complete(std::move(response));
+                });
+                return;
+            } catch (const std::exception&) {
+                // 线程池正在关闭，在当前线程上执行
+            }
+        }
+        
+        try {
+            on_complete(std::move(response));
+        } catch (...) {
+            // 回调异常不能中断反应器
+        }
     }
     
-    std::future<HttpResponse> postAsync(const std::string& url, const std::string& body) {
-        return std::async(std::launch::async, [this, url, body]() {
-            return post(url, body);
-        });
+    // 只合并没有请求体、也不流式接收响应的GET/HEAD；键为方法、URL、请求级设置和请求头，
+    // SSL校验、代理、User-Agent或超时不同的请求不会共用同一次传输
+    std::string coalesceKey(const HttpRequest& request) const {
+        if (!snapshot()->config.coalesce_requests ||
+            (request.method_ != HttpMethod::GET && request.method_ != HttpMethod::HEAD) ||
+            request.response_sink_ || request.progress_) {
+            return std::string();
+        }
+        std::vector<std::pair<std::string, std::string>> headers(request.headers_.begin(), request.headers_.end());
+        std::sort(headers.begin(), headers.end());
+        std::string key = (request.method_ == HttpMethod::GET ? "GET " : "HEAD ") + request.url_;
+        key += request.verify_ssl_ ? "\nverify" : "\nno-verify";
+        if (request.timeout_set_) {
+            key += "\ntimeout=" + std::to_string(request.timeout_.count());
+        }
+        if (!request.proxy_url_.empty()) {
+            key += "\nproxy=" + request.proxy_url_;
+        }
+        if (!request.user_agent_.empty()) {
+            key += "\nua=" + request.user_agent_;
+        }
+        for (const auto& header : headers) {
+            key += '\n';
+            key += header.first;
+            key += ": ";
+            key += header.second;
+        }
+        return key;
     }
     
-    std::future<HttpResponse> putAsync(const std::string& url, const std::string& body) {
-        return std::async(std::launch::async, [this, url, body]() {
-            return put(url, body);
-        });
+    // 领头的请求完成：移除合并记录，唤醒同步等待者并把响应交给异步调用方
+    void publish(const std::string& key, const std::shared_ptr<Flight>& flight, const HttpResponse& response) {
+        std::vector<std::pair<std::function<void(HttpResponse)>, bool>> followers;
+        {
+            std::lock_guard<std::mutex> lock(flights_mutex_);
+            auto it = flights_.find(key);
+            if (it != flights_.end() && it->second == flight) {
+                flights_.erase(it);
+            }
+            flight->response = response;
+            flight->done = true;
+            followers.swap(flight->followers);
+        }
+        flight->cv.notify_all();
+        
+        for (auto& follower : followers) {
+            active_requests_.fetch_sub(1, std::memory_order_relaxed);
+            deliver(std::move(follower.first), follower.second, response);
+        }
     }
     
-    std::future<HttpResponse> deleteAsync(const std::string& url) {
-        return std::async(std::launch::async, [this, url]() {
-            return del(url);
-        });
+    static bool isHedgeable(const HttpRequest& request) {
+        return request.method_ == HttpMethod::GET && !request.response_sink_;
     }
     
-    std::future<HttpResponse> requestAsync(const HttpRequest& request) {
-        return std::async(std::launch::async, [this, request]() {
-            return executeRequest(request);
-        });
+    // 传输成功且状态码不属于可重试的错误
+    static bool succeeded(CURL* curl, CURLcode result) {
+        if (result != CURLE_OK) {
+            return false;
+        }
+        long status = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+        return !isRetryableStatus(static_cast<int>(status));
     }
     
-    void requestAsync(const HttpRequest& request, ResponseCallback callback) {
-        std::thread([this, request, callback]() {
-            auto response = executeRequest(request);
-            if (callback) {
-                callback(response);
-            }
-        }).detach();
+    static bool isRetryableStatus(int status) {
+        return status == 408 || status == 429 || status == 500 || status == 502 || status == 503 || status == 504;
     }
     
-    const HttpClientConfig& getConfig() const {
-        return config_;
+    // 只重试幂等且请求体可以重放的请求；被取消的请求不重试
+    bool shouldRetry(const Transfer& transfer) const {
+        const HttpRequest& request = *transfer.request;
+        if (transfer.attempt >= snapshot()->config.max_retries || request.method_ == HttpMethod::POST ||
+            request.method_ == HttpMethod::PATCH || request.body_reader_ || request.response_sink_) {
+            return false;
+        }
+        int status = transfer.response.status_code_;
+        return status == 0 ? !transfer.response.error_.empty() : isRetryableStatus(status);
     }
     
-    void setConfig(const HttpClientConfig& config) {
-        std::lock_guard<std::mutex> lock(config_mutex_);
-        config_ = config;
+    // 指数退避加全抖动：在[0, min(max, base × 2^attempt)]内均匀取值
+    std::chrono::milliseconds retryDelay(size_t attempt) const {
+        auto tmpl = snapshot();
+        int64_t base = std::max<int64_t>(1, tmpl->config.retry_base_delay.count());
+        int64_t cap = std::max<int64_t>(base, tmpl->config.retry_max_delay.count());
+        int64_t ceiling = attempt >= 30 ? cap : std::min<int64_t>(cap, base << attempt);
+        thread_local std::mt19937_64 random(std::random_device{}());
+        return std::chrono::milliseconds(std::uniform_int_distribution<int64_t>(0, ceiling)(random));
     }
     
-    void setGlobalHeader(const std::string& key, const std::string& value) {
-        std::lock_guard<std::mutex> lock(headers_mutex_);
-        global_headers_[key] = value;
+    // 对冲阈值：最近成功请求耗时的p95，不低于hedge_min_delay；样本不足时不对冲
+    bool hedgeDelay(std::chrono::milliseconds& delay) {
+        auto tmpl = snapshot();
+        if (!tmpl->config.enable_hedging) {
+            return false;
+        }
+        std::vector<uint32_t> samples;
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            if (latency_samples_.size() < kMinHedgeSamples) {
+                return false;
+            }
+            samples = latency_samples_;
+        }
+        size_t index = samples.size() * 95 / 100;
+        std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+        delay = std::max(tmpl->config.hedge_min_delay, std::chrono::milliseconds(samples[index]));
+        return true;
     }
     
-    void removeGlobalHeader(const std::string& key) {
-        std::lock_guard<std::mutex> lock(headers_mutex_);
-        global_headers_.erase(key);
+    void recordCoalesced() {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.coalesced_requests++;
     }
     
-    void clearGlobalHeaders() {
-        std::lock_guard<std::mutex> lock(headers_mutex_);
-        global_headers_.clear();
+    void recordRetry() {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.retries++;
     }
     
-    Stats getStats() const {
+    void recordHedge(bool won) {
         std::lock_guard<std::mutex> lock(stats_mutex_);
-        return stats_;
-    }
-
-private:
-    HttpResponse executeRequest(const HttpRequest& request) {
-        auto start_time = std::chrono::steady_clock::now();
-        
-        HttpResponse response;
-        CURL* curl = curl_easy_init();
-        
-        if (!curl) {
-            response.error_ = "Failed to initialize CURL";
-            updateStats(false, std::chrono::milliseconds(0));
-            return response;
-        }
-        
-        // RAII管理CURL句柄
-        std::unique_ptr<CURL, decltype(&curl_easy_cleanup)> curl_guard(curl, curl_easy_cleanup);
-        
-        try {
-            setupCurlOptions(curl, request, response);
-            
-            CURLcode res = curl_easy_perform(curl);
-            
-            if (res != CURLE_OK) {
-                response.error_ = curl_easy_strerror(res);
-                response.status_code_ = 0;
-            } else {
-                long response_code;
-                curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
-                response.status_code_ = static_cast<int>(response_code);
-            }
-            
-        } catch (const std::exception& e) {
-            response.error_ = e.what();
-            response.status_code_ = 0;
+        if (won) {
+            stats_.hedge_wins++;
+        } else {
+            stats_.hedged_requests++;
         }
-        
-        auto end_time = std::chrono::steady_clock::now();
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-        response.response_time_ = duration;
-        
-        updateStats(response.isSuccess(), duration);
-        
-        return response;
     }
     
-    void setupCurlOptions(CURL* curl, const HttpRequest& request, HttpResponse& response) {
+    // 每个请求只设置与模板不同的部分：方法、请求体、回调、请求级覆盖项和请求头；
+    // 头部节点和表单记录在transfer中，请求完成后由releaseResources释放
+    void setupCurlOptions(Transfer& transfer) {
+        CURL* curl = transfer.curl;
+        const HttpRequest& request = *transfer.request;
+        const RequestTemplate& tmpl = *transfer.tmpl;
+        const HttpClientConfig& config = tmpl.config;
+        
+        applyTemplate(curl, tmpl, transfer.async);
+        
         // 设置URL
         curl_easy_setopt(curl, CURLOPT_URL, request.getUrl().c_str());
         
@@ -215,84 +1469,219 @@ private:
                 break;
         }
         
-        // 设置请求体
-        if (!request.getBody().empty()) {
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, request.getBody().c_str());
-            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, request.getBody().length());
-        }
-        
-        // 设置超时
-        auto timeout_ms = request.getTimeout().count();
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, timeout_ms);
-        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, config_.connection_timeout.count());
-        
-        // 设置用户代理
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, config_.user_agent.c_str());
-        
-        // 设置头部
-        struct curl_slist* headers = nullptr;
-        
-        // 添加全局头部
-        {
-            std::lock_guard<std::mutex> lock(headers_mutex_);
-            for (const auto& header : global_headers_) {
-                std::string header_str = header.first + ": " + header.second;
-                headers = curl_slist_append(headers, header_str.c_str());
+        // 设置请求体：内存中的请求体直接交给libcurl不再复制，流式请求体和上传文件在发送时读取
+        bool chunked = false;
+        std::string_view body = request.getBodyView();
+        if (request.body_reader_) {
+            curl_easy_setopt(curl, CURLOPT_POST, 1L);
+            curl_easy_setopt(curl, CURLOPT_READFUNCTION, readCallback);
+            curl_easy_setopt(curl, CURLOPT_READDATA, &transfer);
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(request.body_length_));
+            chunked = request.body_length_ < 0;
+            transfer.upload_progress = true;
+        } else if (!request.upload_file_.empty()) {
+            transfer.mime = curl_mime_init(curl);
+            curl_mimepart* part = curl_mime_addpart(transfer.mime);
+            curl_mime_name(part, request.upload_field_.c_str());
+            if (curl_mime_filedata(part, request.upload_file_.c_str()) != CURLE_OK) {
+                throw std::runtime_error("Failed to open upload file: " + request.upload_file_);
             }
+            curl_easy_setopt(curl, CURLOPT_MIMEPOST, transfer.mime);
+            transfer.upload_progress = true;
+        } else if (!body.empty()) {
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(body.size()));
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.data());
+            transfer.upload_progress = true;
         }
         
-        // 添加请求特定头部
-        for (const auto& header : request.getHeaders()) {
-            std::string header_str = header.first + ": " + header.second;
-            headers = curl_slist_append(headers, header_str.c_str());
+        // 进度回调
+        if (request.progress_) {
+            curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, progressCallback);
+            curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &transfer);
+            curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
         }
         
-        if (headers) {
-            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        // 请求级设置覆盖客户端配置；SSL校验在任一方关闭时关闭
+        auto timeout = request.timeout_set_ ? request.timeout_ : config.default_timeout;
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout.count()));
+        if (!request.user_agent_.empty()) {
+            curl_easy_setopt(curl, CURLOPT_USERAGENT, request.user_agent_.c_str());
+        }
+        if (!request.proxy_url_.empty()) {
+            curl_easy_setopt(curl, CURLOPT_PROXY, request.proxy_url_.c_str());
+        }
+        if (!request.verify_ssl_ && config.verify_ssl) {
+            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+            curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
         }
         
+        setupHeaders(transfer, chunked);
+        
         // 设置响应回调
         curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response.body_);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &transfer);
         
         // 设置头部回调
         curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, headerCallback);
-        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &response.headers_);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &transfer);
+    }
+    
+    // 模板中的静态选项：值都来自不可变的快照，无需加锁
+    void applyTemplate(CURL* curl, const RequestTemplate& tmpl, bool async) {
+        const HttpClientConfig& config = tmpl.config;
+        
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(config.connection_timeout.count()));
+        curl_easy_setopt(curl, CURLOPT_USERAGENT, config.user_agent.c_str());
+        if (!config.proxy_url.empty()) {
+            curl_easy_setopt(curl, CURLOPT_PROXY, config.proxy_url.c_str());
+        }
         
         // SSL设置
-        if (config_.verify_ssl) {
+        if (config.verify_ssl) {
             curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
             curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 2L);
         } else {
             curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
             curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
         }
+        if (!config.ca_cert_path.empty()) {
+            curl_easy_setopt(curl, CURLOPT_CAINFO, config.ca_cert_path.c_str());
+        }
         
         // 跟随重定向
         curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-        curl_easy_setopt(curl, CURLOPT_MAXREDIRS, config_.max_redirects);
+        curl_easy_setopt(curl, CURLOPT_MAXREDIRS, static_cast<long>(config.max_redirects));
         
         // 压缩支持
-        if (config_.enable_compression) {
+        if (config.enable_compression) {
             curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, "");
         }
         
-        // 清理头部列表
-        if (headers) {
-            curl_slist_free_all(headers);
+        // 连接复用
+        if (config.share_connections && share_.get()) {
+            curl_easy_setopt(curl, CURLOPT_SHARE, share_.get());
+        }
+        curl_easy_setopt(curl, CURLOPT_DNS_CACHE_TIMEOUT, static_cast<long>(config.dns_cache_timeout.count()));
+        if (config.tcp_keepalive) {
+            curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+            curl_easy_setopt(curl, CURLOPT_TCP_KEEPIDLE, static_cast<long>(config.keepalive_idle.count()));
+            curl_easy_setopt(curl, CURLOPT_TCP_KEEPINTVL, static_cast<long>(config.keepalive_interval.count()));
+        }
+        
+        // 协议版本；异步请求等待可多路复用的连接就绪，而不是并发地各自建立新连接
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, curlHttpVersion(config.http_version));
+        if (async && config.enable_multiplexing && config.http_version != HttpVersion::HTTP_1_1) {
+            curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+        }
+        
+        // 多线程下使用超时不能依赖信号
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    }
+    
+    // 请求头只为请求自己的头部分配节点，尾部直接接到模板共享的全局头部链表上；
+    // 请求覆盖了某个全局头部时才复制其余的全局头部
+    void setupHeaders(Transfer& transfer, bool chunked) {
+        const HttpRequest& request = *transfer.request;
+        const RequestTemplate& tmpl = *transfer.tmpl;
+        std::vector<std::string>& lines = transfer.header_lines;
+        
+        bool overrides_global = false;
+        for (const auto& header : request.headers_) {
+            lines.push_back(header.first + ": " + header.second);
+            if (!overrides_global && !tmpl.header_names.empty()) {
+                std::string name = header.first;
+                std::transform(name.begin(), name.end(), name.begin(),
+                               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                overrides_global = std::find(tmpl.header_names.begin(), tmpl.header_names.end(), name) !=
+                                   tmpl.header_names.end();
+            }
+        }
+        if (chunked) {
+            lines.push_back("Transfer-Encoding: chunked");
+        }
+        
+        struct curl_slist* tail = tmpl.headers;
+        if (overrides_global) {
+            for (size_t i = 0; i < tmpl.header_lines.size(); ++i) {
+                if (!hasHeaderIgnoreCase(request.headers_, tmpl.header_names[i])) {
+                    lines.push_back(tmpl.header_lines[i]);
+                }
+            }
+            tail = nullptr;
+        }
+        
+        std::vector<struct curl_slist>& nodes = transfer.header_nodes;
+        nodes.resize(lines.size());
+        for (size_t i = 0; i < lines.size(); ++i) {
+            nodes[i].data = &lines[i][0];
+            nodes[i].next = i + 1 < lines.size() ? &nodes[i + 1] : tail;
+        }
+        struct curl_slist* head = nodes.empty() ? tail : &nodes[0];
+        if (head) {
+            curl_easy_setopt(transfer.curl, CURLOPT_HTTPHEADER, head);
+        }
+    }
+    
+    static bool hasHeaderIgnoreCase(const HttpHeaders& headers, const std::string& lower_name) {
+        for (const auto& header : headers) {
+            if (equalsIgnoreCase(header.first, lower_name.c_str())) {
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    static long curlHttpVersion(HttpVersion version) {
+        switch (version) {
+            case HttpVersion::HTTP_1_1:
+                return CURL_HTTP_VERSION_1_1;
+            case HttpVersion::HTTP_2:
+                return CURL_HTTP_VERSION_2_0;
+            case HttpVersion::HTTP_2_PRIOR_KNOWLEDGE:
+                return CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE;
+            case HttpVersion::HTTP_2_TLS:
+            default:
+                return CURL_HTTP_VERSION_2TLS;
         }
     }
     
-    static size_t writeCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
+    // 设置了响应体回调时数据直接交给回调，否则追加到响应体；回调返回false时返回0使libcurl中止请求
+    static size_t writeCallback(void* contents, size_t size, size_t nmemb, Transfer* transfer) {
         size_t total_size = size * nmemb;
-        userp->append(static_cast<char*>(contents), total_size);
+        const auto& sink = transfer->request->response_sink_;
+        if (sink) {
+            return sink(static_cast<const char*>(contents), total_size) ? total_size : 0;
+        }
+        transfer->response.body_.append(static_cast<char*>(contents), total_size);
         return total_size;
     }
     
-    static size_t headerCallback(void* contents, size_t size, size_t nmemb, HttpHeaders* userp) {
+    static size_t readCallback(char* buffer, size_t size, size_t nitems, Transfer* transfer) {
+        return transfer->request->body_reader_(buffer, size * nitems);
+    }
+    
+    static int progressCallback(Transfer* transfer, curl_off_t dltotal, curl_off_t dlnow,
+                                curl_off_t ultotal, curl_off_t ulnow) {
+        curl_off_t now = transfer->upload_progress ? ulnow : dlnow;
+        curl_off_t total = transfer->upload_progress ? ultotal : dltotal;
+        // libcurl即使没有新数据也会周期性调用，只在进度变化时通知
+        if (now != transfer->last_progress) {
+            transfer->last_progress = now;
+            transfer->request->progress_(static_cast<size_t>(now), static_cast<size_t>(total));
+        }
+        return 0;
+    }
+    
+    static size_t headerCallback(void* contents, size_t size, size_t nmemb, Transfer* transfer) {
         size_t total_size = size * nmemb;
         std::string header(static_cast<char*>(contents), total_size);
         
+        // 新的响应（重定向或100 Continue之后）重新收集头部
+        if (header.compare(0, 5, "HTTP/") == 0) {
+            transfer->response.headers_.clear();
+            return total_size;
+        }
+        
         // 解析头部
         size_t colon_pos = header.find(':');
         if (colon_pos != std::string::npos) {
@@ -305,18 +1694,114 @@ private:
             value.erase(0, value.find_first_not_of(" \t"));
             value.erase(value.find_last_not_of(" \t\r\n") + 1);
             
-            (*userp)[key] = value;
+            // 按Content-Length预留响应体（上限64MB），避免逐块追加时反复扩容
+            if (!transfer->request->response_sink_ && equalsIgnoreCase(key, "Content-Length")) {
+                char* end = nullptr;
+                unsigned long long length = std::strtoull(value.c_str(), &end, 10);
+                if (end != value.c_str()) {
+                    constexpr unsigned long long kMaxReserve = 64ull * 1024 * 1024;
+                    transfer->response.body_.reserve(static_cast<size_t>(std::min(length, kMaxReserve)));
+                }
+            }
+            
+            transfer->response.headers_[key] = value;
         }
         
         return total_size;
     }
     
-    void updateStats(bool success, std::chrono::milliseconds duration) {
+    // 各阶段时间都是从请求开始计算的累计值，相减得到单个阶段的耗时；复用连接时前三个阶段没有意义
+    void recordTimings(CURL* curl, bool new_connection, std::chrono::steady_clock::time_point start_time) {
+        curl_off_t dns = 0, connect = 0, tls = 0, ttfb = 0, total = 0;
+#if LIBCURL_VERSION_NUM >= 0x073d00
+        curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME_T, &dns);
+        curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME_T, &connect);
+        curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME_T, &tls);
+        curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME_T, &ttfb);
+        curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME_T, &total);
+#else
+        double seconds[5] = {0, 0, 0, 0, 0};
+        curl_easy_getinfo(curl, CURLINFO_NAMELOOKUP_TIME, &seconds[0]);
+        curl_easy_getinfo(curl, CURLINFO_CONNECT_TIME, &seconds[1]);
+        curl_easy_getinfo(curl, CURLINFO_APPCONNECT_TIME, &seconds[2]);
+        curl_easy_getinfo(curl, CURLINFO_STARTTRANSFER_TIME, &seconds[3]);
+        curl_easy_getinfo(curl, CURLINFO_TOTAL_TIME, &seconds[4]);
+        dns = static_cast<curl_off_t>(seconds[0] * 1e6);
+        connect = static_cast<curl_off_t>(seconds[1] * 1e6);
+        tls = static_cast<curl_off_t>(seconds[2] * 1e6);
+        ttfb = static_cast<curl_off_t>(seconds[3] * 1e6);
+        total = static_cast<curl_off_t>(seconds[4] * 1e6);
+#endif
+        if (new_connection) {
+            dns_latency_->recordMicros(static_cast<uint64_t>(dns));
+            connect_latency_->recordMicros(static_cast<uint64_t>(std::max<curl_off_t>(connect - dns, 0)));
+            if (tls > 0) {
+                tls_latency_->recordMicros(static_cast<uint64_t>(std::max<curl_off_t>(tls - connect, 0)));
+            }
+        }
+        if (ttfb > 0) {
+            ttfb_latency_->recordMicros(static_cast<uint64_t>(ttfb));
+        }
+        total_latency_->recordMicros(static_cast<uint64_t>(std::max<curl_off_t>(total, 0)));
+        
+        if (Tracer::isEnabled()) {
+            traceTransfer(start_time, new_connection, dns, connect, tls, ttfb, total);
+        }
+    }
+    
+    // 传输各阶段记为同一ID下的异步区间，异步请求在反应器线程上交错进行时也能各自成组
+    static void traceTransfer(std::chrono::steady_clock::time_point start_time, bool new_connection,
+                              curl_off_t dns, curl_off_t connect, curl_off_t tls, curl_off_t ttfb, curl_off_t total) {
+        uint64_t id = Tracer::nextId();
+        uint64_t base = Tracer::toNanos(start_time);
+        auto phase = [id, base](const char* name, curl_off_t begin_us, curl_off_t end_us) {
+            if (end_us <= begin_us) {
+                return;
+            }
+            Tracer::recordAsyncBegin("http", name, id, base + static_cast<uint64_t>(begin_us) * 1000);
+            Tracer::recordAsyncEnd("http", name, id, base + static_cast<uint64_t>(end_us) * 1000);
+        };
+        
+        curl_off_t connected = std::max(connect, tls);
+        phase("http.transfer", 0, total);
+        if (new_connection) {
+            phase("http.dns", 0, dns);
+            phase("http.connect", dns, connect);
+            phase("http.tls", connect, tls);
+        }
+        if (ttfb > 0) {
+            phase("http.wait", connected, ttfb);
+            phase("http.receive", ttfb, total);
+        }
+    }
+    
+    void updateStats(bool success, std::chrono::milliseconds duration, bool handle_reused, bool connection_reused,
+                     size_t new_connections, bool http2) {
         std::lock_guard<std::mutex> lock(stats_mutex_);
         
         stats_.total_requests++;
+        stats_.connections_opened += new_connections;
+        if (http2) {
+            stats_.http2_requests++;
+        }
+        if (handle_reused) {
+            stats_.handle_reuses++;
+        } else {
+            stats_.handles_created++;
+        }
+        if (connection_reused) {
+            stats_.connection_reuses++;
+        }
         if (success) {
             stats_.successful_requests++;
+            
+            uint32_t sample = static_cast<uint32_t>(duration.count());
+            if (latency_samples_.size() < kLatencySamples) {
+                latency_samples_.push_back(sample);
+            } else {
+                latency_samples_[next_sample_] = sample;
+                next_sample_ = (next_sample_ + 1) % kLatencySamples;
+            }
         } else {
             stats_.failed_requests++;
         }
@@ -331,16 +1816,51 @@ private:
     HttpClientConfig config_;
     std::mutex config_mutex_;
     
-    HttpHeaders global_headers_;
-    std::mutex headers_mutex_;
+    // 共享对象必须比使用它的句柄活得更久
+    CurlShare share_;
+    CurlHandlePool handle_pool_;
+    
+    // 异步引擎，析构时先于句柄池停止
+    std::mutex reactor_mutex_;
+    CURLM* multi_ = nullptr;
+    std::thread reactor_;
+    bool reactor_started_ = false;
+    bool reactor_stopping_ = false;
+    
+    std::shared_ptr<HttpCache> cache_;  // 通过atomic_load/atomic_store访问，setConfig可能替换
+    bool multi_options_changed_ = false;
+    uint64_t cancel_generation_ = 0;
+    size_t max_in_flight_;
+    std::deque<std::unique_ptr<Transfer>> waiting_;
+    std::unordered_map<CURL*, std::unique_ptr<Transfer>> in_flight_;   // 只在反应器线程上访问
+    std::vector<std::unique_ptr<Transfer>> delayed_;                    // 等待重试，只在反应器线程上访问
+    std::atomic<size_t> active_requests_{0};
+    std::shared_ptr<ThreadPool> callback_pool_;
+    
+    HttpHeaders global_headers_;   // 由config_mutex_保护，读者使用template_快照
+    std::shared_ptr<const RequestTemplate> template_;   // 通过atomic_load/atomic_store访问
+    
+    std::mutex flights_mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Flight>> flights_;
+    
+    // 最近成功请求的耗时（毫秒），用于计算对冲阈值
+    static constexpr size_t kLatencySamples = 128;
+    static constexpr size_t kMinHedgeSamples = 20;
     
     mutable std::mutex stats_mutex_;
     Stats stats_;
+    std::vector<uint32_t> latency_samples_;
+    size_t next_sample_ = 0;
+    
+    // 阶段耗时直方图，在反应器线程与同步调用线程上无锁记录
+    std::shared_ptr<LatencyHistogram> dns_latency_;
+    std::shared_ptr<LatencyHistogram> connect_latency_;
+    std::shared_ptr<LatencyHistogram> tls_latency_;
+    std::shared_ptr<LatencyHistogram> ttfb_latency_;
+    std::shared_ptr<LatencyHistogram> total_latency_;
 };
 
 // HttpRequest实现
-HttpRequest::HttpRequest() = default;
-
 HttpRequest::HttpRequest(const std::string& url) : url_(url) {}
 
 HttpRequest& HttpRequest::setUrl(const std::string& url) {
@@ -363,18 +1883,69 @@ HttpRequest& HttpRequest::setHeaders(const HttpHeaders& headers) {
     return *this;
 }
 
+// 请求体的几种来源互斥，设置其中一种时清除其他
+void HttpRequest::clearBody() {
+    body_.clear();
+    body_view_ = std::string_view();
+    body_is_view_ = false;
+    body_reader_ = nullptr;
+    body_length_ = -1;
+    upload_field_.clear();
+    upload_file_.clear();
+}
+
 HttpRequest& HttpRequest::setBody(const std::string& body) {
+    clearBody();
     body_ = body;
     return *this;
 }
 
+HttpRequest& HttpRequest::setBody(std::string&& body) {
+    clearBody();
+    body_ = std::move(body);
+    return *this;
+}
+
 HttpRequest& HttpRequest::setBody(const std::vector<uint8_t>& body) {
+    clearBody();
     body_.assign(body.begin(), body.end());
     return *this;
 }
 
+HttpRequest& HttpRequest::setBodyView(std::string_view body) {
+    clearBody();
+    body_view_ = body;
+    body_is_view_ = true;
+    return *this;
+}
+
+HttpRequest& HttpRequest::setBodyReader(BodyReader reader, int64_t content_length) {
+    clearBody();
+    body_reader_ = std::move(reader);
+    body_length_ = content_length;
+    return *this;
+}
+
+HttpRequest& HttpRequest::setUploadFile(const std::string& field_name, const std::string& file_path) {
+    clearBody();
+    upload_field_ = field_name;
+    upload_file_ = file_path;
+    return *this;
+}
+
+HttpRequest& HttpRequest::setResponseSink(BodyChunkCallback sink) {
+    response_sink_ = std::move(sink);
+    return *this;
+}
+
+HttpRequest& HttpRequest::setProgressCallback(ProgressCallback progress) {
+    progress_ = std::move(progress);
+    return *this;
+}
+
 HttpRequest& HttpRequest::setTimeout(std::chrono::milliseconds timeout) {
     timeout_ = timeout;
+    timeout_set_ = true;
     return *this;
 }
 
@@ -407,8 +1978,6 @@ HttpRequest& HttpRequest::setVerifySSL(bool verify) {
 }
 
 // HttpResponse实现
-HttpResponse::HttpResponse() = default;
-
 std::string HttpResponse::getHeader(const std::string& key) const {
     auto it = headers_.find(key);
     return it != headers_.end() ? it->second : "";
@@ -471,7 +2040,7 @@ void HttpClient::setConfig(const HttpClientConfig& config) {
     pImpl_->setConfig(config);
 }
 
-const HttpClientConfig& HttpClient::getConfig() const {
+HttpClientConfig HttpClient::getConfig() const {
     return pImpl_->getConfig();
 }
 
@@ -487,10 +2056,49 @@ void HttpClient::clearGlobalHeaders() {
     pImpl_->clearGlobalHeaders();
 }
 
-HttpClient::Stats HttpClient::getStats() const {
+HttpClient::HttpClient::Stats HttpClient::getStats() const {
     return pImpl_->getStats();
 }
 
+void HttpClient::clearCache() {
+    pImpl_->clearCache();
+}
+
+void HttpClient::setMaxConcurrentRequests(size_t max_requests) {
+    pImpl_->setMaxConcurrentRequests(max_requests);
+}
+
+size_t HttpClient::getActiveRequestCount() const {
+    return pImpl_->getActiveRequestCount();
+}
+
+void HttpClient::cancelAllRequests() {
+    pImpl_->cancelAllRequests();
+}
+
+HttpResponse HttpClient::downloadFile(const std::string& url, const std::string& file_path) {
+    return pImpl_->downloadFile(url, file_path, nullptr);
+}
+
+std::future<HttpResponse> HttpClient::downloadFileAsync(const std::string& url, const std::string& file_path,
+                                                        ProgressCallback progress) {
+    return pImpl_->downloadFileAsync(url, file_path, std::move(progress));
+}
+
+HttpResponse HttpClient::uploadFile(const std::string& url, const std::string& file_path,
+                                    const std::string& field_name) {
+    return pImpl_->uploadFile(url, file_path, field_name, nullptr);
+}
+
+std::future<HttpResponse> HttpClient::uploadFileAsync(const std::string& url, const std::string& file_path,
+                                                      const std::string& field_name, ProgressCallback progress) {
+    return pImpl_->uploadFileAsync(url, file_path, field_name, std::move(progress));
+}
+
+void HttpClient::setCallbackPool(std::shared_ptr<ThreadPool> pool) {
+    pImpl_->setCallbackPool(std::move(pool));
+}
+
 } // namespace sdk
 
 // =============================================================================
@@ -524,6 +2132,14 @@ static sdk::HttpMethod convertMethod(sdk_http_method_t method) {
     }
 }
 
+static void applyHeaders(const sdk_http_headers_t* headers, sdk::HttpRequest& request) {
+    if (!headers || !headers->headers) return;
+    
+    for (uint32_t i = 0; i < headers->count; ++i) {
+        request.setHeader(headers->headers[i].key, headers->headers[i].value);
+    }
+}
+
 static void convertResponse(const sdk::HttpResponse& cpp_response, sdk_http_response_t* c_response) {
     if (!c_response) return;
     
@@ -589,7 +2205,11 @@ bool sdk_http_get(const char* url, const sdk_http_headers_t* headers, sdk_http_r
             return false;
         }
         
-        auto cpp_response = http_client->get(url);
+        sdk::HttpRequest request(url);
+        request.setMethod(sdk::HttpMethod::GET);
+        applyHeaders(headers, request);
+        
+        auto cpp_response = http_client->request(request);
         convertResponse(cpp_response, response);
         
         return cpp_response.isSuccess();
@@ -615,12 +2235,15 @@ bool sdk_http_post(const char* url, const sdk_http_headers_t* headers,
             return false;
         }
         
-        std::string body_str;
+        sdk::HttpRequest request(url);
+        request.setMethod(sdk::HttpMethod::POST);
+        applyHeaders(headers, request);
         if (body && body_size > 0) {
-            body_str.assign(static_cast<const char*>(body), body_size);
+            // 同步调用期间body一直有效，直接引用不复制
+            request.setBodyView(std::string_view(static_cast<const char*>(body), body_size));
         }
         
-        auto cpp_response = http_client->post(url, body_str);
+        auto cpp_response = http_client->request(request);
         convertResponse(cpp_response, response);
         
         return cpp_response.isSuccess();
@@ -652,52 +2275,28 @@ sdk_http_request_id_t sdk_http_request_async(
         sdk::HttpRequest request(url);
         request.setMethod(convertMethod(method));
         request.setTimeout(std::chrono::milliseconds(timeout_ms));
+        applyHeaders(headers, request);
         
         if (body && body_size > 0) {
-            std::string body_str(static_cast<const char*>(body), body_size);
-            request.setBody(body_str);
+            request.setBody(std::string(static_cast<const char*>(body), body_size));
         }
         
         sdk_http_request_id_t request_id = g_next_request_id.fetch_add(1);
         
-        auto future = http_client->requestAsync(request);
-        
-        {
+        // 有回调时由异步引擎在完成时直接调用，不再为等待结果创建线程
+        if (callback) {
+            http_client->requestAsync(request, [request_id, callback, user_data](const sdk::HttpResponse& cpp_response) {
+                sdk_http_response_t c_response = {};
+                convertResponse(cpp_response, &c_response);
+                callback(request_id, &c_response, user_data);
+                sdk_http_response_free(&c_response);
+            });
+        } else {
+            auto future = http_client->requestAsync(request);
             std::lock_guard<std::mutex> lock(g_async_requests_mutex);
             g_async_requests[request_id] = std::move(future);
         }
         
-        // 如果有回调，启动异步处理
-        if (callback) {
-            std::thread([request_id, callback, user_data]() {
-                try {
-                    std::future<sdk::HttpResponse> future;
-                    {
-                        std::lock_guard<std::mutex> lock(g_async_requests_mutex);
-                        auto it = g_async_requests.find(request_id);
-                        if (it != g_async_requests.end()) {
-                            future = std::move(it->second);
-                            g_async_requests.erase(it);
-                        }
-                    }
-                    
-                    if (future.valid()) {
-                        auto cpp_response = future.get();
-                        
-                        sdk_http_response_t c_response = {};
-                        convertResponse(cpp_response, &c_response);
-                        
-                        callback(request_id, &c_response, user_data);
-                        
-                        // 清理响应
-                        sdk_http_response_free(&c_response);
-                    }
-                } catch (...) {
-                    // 错误处理
-                }
-            }).detach();
-        }
-        
         return request_id;
     } catch (...) {
         return 0;
@@ -1,7 +1,10 @@
 #include "sdk/platform/file_system.h"
 #include <fstream>
-#include <sstream>
 #include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <memory>
+#include <utility>
 
 #ifdef _WIN32
     #include <windows.h>
@@ -9,14 +12,233 @@
     #include <io.h>
 #else
     #include <unistd.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
     #include <sys/stat.h>
     #include <dirent.h>
     #include <errno.h>
+    #if defined(__linux__) || defined(__ANDROID__)
+        #include <sys/sendfile.h>
+    #endif
+    #ifdef __APPLE__
+        #include <copyfile.h>
+        #include <sys/clonefile.h>
+    #endif
+#endif
+
+// glibc 2.27起提供copy_file_range封装
+#if defined(__linux__) && defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+    #define SDK_HAS_COPY_FILE_RANGE 1
 #endif
 
 namespace sdk {
 namespace platform {
 
+namespace {
+
+#ifdef POSIX_FADV_DONTNEED
+// 分块读取时每读过这么多数据释放一次页缓存
+constexpr uint64_t kDropCacheWindow = 8 * 1024 * 1024;
+#endif
+
+#ifdef _WIN32
+
+// 大文件复制时绕过缓存管理器，避免挤掉页缓存中的其他数据
+constexpr uint64_t kUnbufferedCopyThreshold = 64 * 1024 * 1024;
+// 单次ReadFile/WriteFile的长度上限
+constexpr size_t kMaxIoChunk = 1u << 30;
+
+HANDLE toHandle(intptr_t handle) {
+    return reinterpret_cast<HANDLE>(handle);
+}
+
+HANDLE openForRead(const std::string& path, DWORD flags) {
+    return CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | flags, nullptr);
+}
+
+// 从offset处读满size字节，遇到文件末尾或出错时提前返回
+size_t readAt(HANDLE file, void* buffer, size_t size, uint64_t offset) {
+    auto* out = static_cast<uint8_t*>(buffer);
+    size_t total = 0;
+    while (total < size) {
+        uint64_t at = offset + total;
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(at);
+        overlapped.OffsetHigh = static_cast<DWORD>(at >> 32);
+        DWORD chunk = static_cast<DWORD>(std::min(size - total, kMaxIoChunk));
+        DWORD n = 0;
+        if (!ReadFile(file, out + total, chunk, &n, &overlapped) || n == 0) {
+            break;
+        }
+        total += n;
+    }
+    return total;
+}
+
+bool writeAll(HANDLE file, const void* data, size_t size) {
+    const auto* in = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        DWORD chunk = static_cast<DWORD>(std::min(size, kMaxIoChunk));
+        DWORD n = 0;
+        if (!WriteFile(file, in, chunk, &n, nullptr) || n == 0) {
+            return false;
+        }
+        in += n;
+        size -= n;
+    }
+    return true;
+}
+
+// 与文本模式的流一致，把CRLF转换为LF
+void normalizeNewlines(std::string& text) {
+    size_t out = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\r' && i + 1 < text.size() && text[i + 1] == '\n') {
+            continue;
+        }
+        text[out++] = text[i];
+    }
+    text.resize(out);
+}
+
+#else
+
+int openForRead(const std::string& path) {
+    int fd;
+    do {
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+    return fd;
+}
+
+// 从offset处读满size字节，遇到文件末尾或出错时提前返回
+size_t readAt(int fd, void* buffer, size_t size, uint64_t offset) {
+    auto* out = static_cast<uint8_t*>(buffer);
+    size_t total = 0;
+    while (total < size) {
+        ssize_t n = ::pread(fd, out + total, size - total, static_cast<off_t>(offset + total));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        total += static_cast<size_t>(n);
+    }
+    return total;
+}
+
+bool writeAll(int fd, const void* data, size_t size) {
+    const auto* in = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t n = ::write(fd, in, size);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        in += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+#ifndef __APPLE__
+// 复制时的兜底缓冲区
+constexpr size_t kCopyBufferSize = 1024 * 1024;
+
+// 依次使用copy_file_range（数据不出内核，部分文件系统上直接共享数据块）、sendfile，
+// 最后用read/write读到文件末尾，兼容不支持前两者的文件系统和不报告大小的文件
+bool copyContents(int in, int out, uint64_t size) {
+    uint64_t remaining = size;
+#ifdef SDK_HAS_COPY_FILE_RANGE
+    while (remaining > 0) {
+        ssize_t n = ::copy_file_range(in, nullptr, out, nullptr, static_cast<size_t>(remaining), 0);
+        if (n > 0) {
+            remaining -= static_cast<uint64_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            break;
+        }
+    }
+#endif
+#if defined(__linux__) || defined(__ANDROID__)
+    while (remaining > 0) {
+        size_t chunk = static_cast<size_t>(std::min<uint64_t>(remaining, 1u << 30));
+        ssize_t n = ::sendfile(out, in, nullptr, chunk);
+        if (n > 0) {
+            remaining -= static_cast<uint64_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            break;
+        }
+    }
+#endif
+
+    // 内核内复制已完成时不再分配缓冲区；大小为0的文件可能并非真的为空，仍需读到文件末尾
+    if (remaining == 0 && size != 0) {
+        return true;
+    }
+
+    std::unique_ptr<uint8_t[]> buffer(new uint8_t[kCopyBufferSize]);
+    for (;;) {
+        ssize_t n = ::read(in, buffer.get(), kCopyBufferSize);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0) {
+            return false;
+        }
+        if (n == 0) {
+            return true;
+        }
+        if (!writeAll(out, buffer.get(), static_cast<size_t>(n))) {
+            return false;
+        }
+    }
+}
+#endif
+
+#endif
+
+// 读取整个文件：按fstat得到的大小一次读入未初始化的缓冲区，再据此构造目标容器，
+// 避免resize先把整块内存清零再被读取覆盖
+// 不使用映射：读取过程中文件被截断时映射访问会触发SIGBUS，需要映射的调用方显式使用MappedFile
+template <typename Container>
+bool readWholeFile(const std::string& path, Container& out) {
+    using Value = typename Container::value_type;
+    static_assert(sizeof(Value) == 1, "readWholeFile expects a byte container");
+
+    FileReaderOptions options;
+    options.sequential = false;
+    FileReader reader;
+    if (!reader.open(path, options)) {
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(reader.size());
+    std::unique_ptr<Value[]> buffer(new Value[size]);
+    size_t n = reader.read(buffer.get(), size);
+    out.assign(buffer.get(), buffer.get() + n);
+
+    // /proc这类不报告大小的文件需要一直读到文件末尾
+    if (reader.size() == 0) {
+        Value chunk[4096];
+        size_t n;
+        while ((n = reader.read(chunk, sizeof(chunk))) > 0) {
+            out.insert(out.end(), chunk, chunk + n);
+        }
+    }
+    return true;
+}
+
+} // namespace
+
 // FileSystem实现
 bool FileSystem::exists(const std::string& path) {
 #ifdef _WIN32
@@ -112,17 +334,35 @@ bool FileSystem::removeDirectory(const std::string& path) {
 
 bool FileSystem::copyFile(const std::string& source, const std::string& destination) {
 #ifdef _WIN32
-    return CopyFileA(source.c_str(), destination.c_str(), FALSE) != 0;
+    DWORD flags = getFileSize(source) >= kUnbufferedCopyThreshold ? COPY_FILE_NO_BUFFERING : 0;
+    BOOL cancel = FALSE;
+    return CopyFileExA(source.c_str(), destination.c_str(), nullptr, nullptr, &cancel, flags) != 0;
+#elif defined(__APPLE__)
+    // 目标不存在时在APFS上克隆（写时复制），否则由copyfile在内核中复制数据
+    if (clonefile(source.c_str(), destination.c_str(), 0) == 0) {
+        return true;
+    }
+    return copyfile(source.c_str(), destination.c_str(), nullptr, COPYFILE_DATA) == 0;
 #else
-    std::ifstream src(source, std::ios::binary);
-    std::ofstream dst(destination, std::ios::binary);
-    
-    if (!src || !dst) {
+    int in = openForRead(source);
+    if (in < 0) {
         return false;
     }
-    
-    dst << src.rdbuf();
-    return src.good() && dst.good();
+    struct stat st;
+    if (fstat(in, &st) != 0) {
+        ::close(in);
+        return false;
+    }
+
+    int out = ::open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, st.st_mode & 0777);
+    if (out < 0) {
+        ::close(in);
+        return false;
+    }
+
+    bool ok = copyContents(in, out, static_cast<uint64_t>(st.st_size));
+    ::close(in);
+    return ::close(out) == 0 && ok;
 #endif
 }
 
@@ -135,14 +375,14 @@ bool FileSystem::moveFile(const std::string& source, const std::string& destinat
 }
 
 std::string FileSystem::readTextFile(const std::string& path) {
-    std::ifstream file(path);
-    if (!file) {
+    std::string content;
+    if (!readWholeFile(path, content)) {
         return "";
     }
-    
-    std::ostringstream content;
-    content << file.rdbuf();
-    return content.str();
+#ifdef _WIN32
+    normalizeNewlines(content);
+#endif
+    return content;
 }
 
 bool FileSystem::writeTextFile(const std::string& path, const std::string& content) {
@@ -156,21 +396,36 @@ bool FileSystem::writeTextFile(const std::string& path, const std::string& conte
 }
 
 std::vector<uint8_t> FileSystem::readBinaryFile(const std::string& path) {
-    std::ifstream file(path, std::ios::binary);
-    if (!file) {
+    std::vector<uint8_t> data;
+    if (!readWholeFile(path, data)) {
         return {};
     }
-    
-    file.seekg(0, std::ios::end);
-    size_t size = file.tellg();
-    file.seekg(0, std::ios::beg);
-    
-    std::vector<uint8_t> data(size);
-    file.read(reinterpret_cast<char*>(data.data()), size);
-    
     return data;
 }
 
+size_t FileSystem::readInto(const std::string& path, void* buffer, size_t size, uint64_t offset) {
+    if (size == 0) {
+        return 0;
+    }
+#ifdef _WIN32
+    HANDLE file = openForRead(path, 0);
+    if (file == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    size_t n = readAt(file, buffer, size, offset);
+    CloseHandle(file);
+    return n;
+#else
+    int fd = openForRead(path);
+    if (fd < 0) {
+        return 0;
+    }
+    size_t n = readAt(fd, buffer, size, offset);
+    ::close(fd);
+    return n;
+#endif
+}
+
 bool FileSystem::writeBinaryFile(const std::string& path, const std::vector<uint8_t>& data) {
     std::ofstream file(path, std::ios::binary);
     if (!file) {
@@ -303,4 +558,325 @@ std::string FileSystem::joinPath(const std::string& path1, const std::string& pa
     return result;
 }
 
+// MappedFile实现
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      open_(std::exchange(other.open_, false)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        open_ = std::exchange(other.open_, false);
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    HANDLE file = openForRead(path, 0);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || static_cast<uint64_t>(size.QuadPart) > SIZE_MAX) {
+        CloseHandle(file);
+        return false;
+    }
+    if (size.QuadPart == 0) {
+        CloseHandle(file);
+        open_ = true;
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) {
+        return false;
+    }
+    // 视图持有映射对象的引用，句柄可以立即关闭
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) {
+        return false;
+    }
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = openForRead(path);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || static_cast<uint64_t>(st.st_size) > SIZE_MAX) {
+        ::close(fd);
+        return false;
+    }
+    if (st.st_size == 0) {
+        ::close(fd);
+        open_ = true;
+        return true;
+    }
+
+    // 映射建立后不再需要文件描述符
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    data_ = static_cast<const uint8_t*>(view);
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+    open_ = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (data_) {
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+#else
+        munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+}
+
+void MappedFile::advise(Access access) const {
+    if (!data_) {
+        return;
+    }
+#ifdef _WIN32
+    #if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+    if (access == Access::WILL_NEED) {
+        WIN32_MEMORY_RANGE_ENTRY range;
+        range.VirtualAddress = const_cast<uint8_t*>(data_);
+        range.NumberOfBytes = size_;
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+    #else
+    (void)access;
+    #endif
+#else
+    int advice = MADV_NORMAL;
+    switch (access) {
+        case Access::SEQUENTIAL: advice = MADV_SEQUENTIAL; break;
+        case Access::RANDOM: advice = MADV_RANDOM; break;
+        case Access::WILL_NEED: advice = MADV_WILLNEED; break;
+        case Access::NORMAL: break;
+    }
+    madvise(const_cast<uint8_t*>(data_), size_, advice);
+#endif
+}
+
+// FileReader实现
+FileReader::~FileReader() {
+    close();
+}
+
+FileReader::FileReader(FileReader&& other) noexcept
+    : handle_(std::exchange(other.handle_, -1)),
+      position_(std::exchange(other.position_, 0)),
+      size_(std::exchange(other.size_, 0)),
+      dropped_(std::exchange(other.dropped_, 0)),
+      options_(other.options_) {}
+
+FileReader& FileReader::operator=(FileReader&& other) noexcept {
+    if (this != &other) {
+        close();
+        handle_ = std::exchange(other.handle_, -1);
+        position_ = std::exchange(other.position_, 0);
+        size_ = std::exchange(other.size_, 0);
+        dropped_ = std::exchange(other.dropped_, 0);
+        options_ = other.options_;
+    }
+    return *this;
+}
+
+bool FileReader::open(const std::string& path, const FileReaderOptions& options) {
+    close();
+#ifdef _WIN32
+    // Windows没有按区间释放缓存的接口，drop_cache_behind在此忽略
+    HANDLE file = openForRead(path, options.sequential ? FILE_FLAG_SEQUENTIAL_SCAN : 0);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return false;
+    }
+    handle_ = reinterpret_cast<intptr_t>(file);
+    size_ = static_cast<uint64_t>(size.QuadPart);
+#else
+    int fd = openForRead(path);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+#ifdef POSIX_FADV_SEQUENTIAL
+    if (options.sequential) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+#ifdef __APPLE__
+    // Apple平台没有posix_fadvise，改为不经过统一缓冲区缓存
+    if (options.drop_cache_behind) {
+        fcntl(fd, F_NOCACHE, 1);
+    }
+#endif
+    handle_ = fd;
+    size_ = static_cast<uint64_t>(st.st_size);
+#endif
+    position_ = 0;
+    dropped_ = 0;
+    options_ = options;
+    return true;
+}
+
+void FileReader::close() {
+    if (handle_ == -1) {
+        return;
+    }
+#ifdef _WIN32
+    CloseHandle(toHandle(handle_));
+#else
+    ::close(static_cast<int>(handle_));
+#endif
+    handle_ = -1;
+    position_ = 0;
+    size_ = 0;
+}
+
+size_t FileReader::read(void* buffer, size_t size) {
+    if (handle_ == -1 || size == 0) {
+        return 0;
+    }
+#ifdef _WIN32
+    size_t n = readAt(toHandle(handle_), buffer, size, position_);
+#else
+    size_t n = readAt(static_cast<int>(handle_), buffer, size, position_);
+#endif
+    position_ += n;
+
+#ifdef POSIX_FADV_DONTNEED
+    // 攒够一个窗口再释放，避免每次小块读取都多一次系统调用
+    if (options_.drop_cache_behind && position_ - dropped_ >= kDropCacheWindow) {
+        posix_fadvise(static_cast<int>(handle_), static_cast<off_t>(dropped_),
+                      static_cast<off_t>(position_ - dropped_), POSIX_FADV_DONTNEED);
+        dropped_ = position_;
+    }
+#endif
+    return n;
+}
+
+bool FileReader::seek(uint64_t offset) {
+    if (handle_ == -1) {
+        return false;
+    }
+    position_ = offset;
+    dropped_ = offset;
+    return true;
+}
+
+// FileWriter实现
+FileWriter::~FileWriter() {
+    close();
+}
+
+FileWriter::FileWriter(FileWriter&& other) noexcept
+    : handle_(std::exchange(other.handle_, -1)),
+      bytes_written_(std::exchange(other.bytes_written_, 0)) {}
+
+FileWriter& FileWriter::operator=(FileWriter&& other) noexcept {
+    if (this != &other) {
+        close();
+        handle_ = std::exchange(other.handle_, -1);
+        bytes_written_ = std::exchange(other.bytes_written_, 0);
+    }
+    return *this;
+}
+
+bool FileWriter::open(const std::string& path, bool append) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                              append ? OPEN_ALWAYS : CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    if (append) {
+        LARGE_INTEGER zero{};
+        SetFilePointerEx(file, zero, nullptr, FILE_END);
+    }
+    handle_ = reinterpret_cast<intptr_t>(file);
+#else
+    int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC);
+    int fd;
+    do {
+        fd = ::open(path.c_str(), flags, 0666);
+    } while (fd < 0 && errno == EINTR);
+    if (fd < 0) {
+        return false;
+    }
+    handle_ = fd;
+#endif
+    bytes_written_ = 0;
+    return true;
+}
+
+bool FileWriter::close() {
+    if (handle_ == -1) {
+        return true;
+    }
+#ifdef _WIN32
+    bool ok = CloseHandle(toHandle(handle_)) != 0;
+#else
+    bool ok = ::close(static_cast<int>(handle_)) == 0;
+#endif
+    handle_ = -1;
+    return ok;
+}
+
+bool FileWriter::write(const void* data, size_t size) {
+    if (handle_ == -1) {
+        return false;
+    }
+#ifdef _WIN32
+    bool ok = writeAll(toHandle(handle_), data, size);
+#else
+    bool ok = writeAll(static_cast<int>(handle_), data, size);
+#endif
+    if (ok) {
+        bytes_written_ += size;
+    }
+    return ok;
+}
+
+bool FileWriter::sync() {
+    if (handle_ == -1) {
+        return false;
+    }
+#ifdef _WIN32
+    return FlushFileBuffers(toHandle(handle_)) != 0;
+#elif defined(__linux__) || defined(__ANDROID__)
+    return fdatasync(static_cast<int>(handle_)) == 0;
+#else
+    return fsync(static_cast<int>(handle_)) == 0;
+#endif
+}
+
 }} // namespace sdk::platform
@@ -22,14 +22,43 @@
     #include <unistd.h>
     #include <sys/sysinfo.h>
     #include <ifaddrs.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
 #else
     #include <unistd.h>
     #include <sys/sysinfo.h>
     #include <sys/utsname.h>
     #include <ifaddrs.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
     #include <fstream>
 #endif
 
+// 线程工具所需的系统头文件
+#if defined(__linux__)
+    #include <sched.h>
+    #include <pthread.h>
+    #include <dirent.h>
+    #include <sys/resource.h>
+    #include <sys/syscall.h>
+    #include <fstream>
+    #include <ctime>
+#elif defined(__APPLE__)
+    #include <pthread.h>
+    #include <pthread/qos.h>
+    #include <ctime>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <mutex>
+
+#ifndef _WIN32
+    #include <sys/resource.h>
+    #include <sys/time.h>
+#endif
+
 namespace sdk {
 namespace platform {
 
@@ -305,10 +334,58 @@ uint32_t PlatformUtils::getCpuCoreCount() {
     return getSystemInfo().cpu_core_count;
 }
 
+uint64_t PlatformUtils::getProcessCpuTimeUs() {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        return 0;
+    }
+    auto ticks = [](const FILETIME& time) {
+        return (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    // FILETIME以100纳秒为单位
+    return (ticks(kernel) + ticks(user)) / 10;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    auto micros = [](const struct timeval& time) {
+        return static_cast<uint64_t>(time.tv_sec) * 1000000 + static_cast<uint64_t>(time.tv_usec);
+    };
+    return micros(usage.ru_utime) + micros(usage.ru_stime);
+#endif
+}
+
+namespace {
+
+struct CpuSample {
+    std::chrono::steady_clock::time_point wall = std::chrono::steady_clock::now();
+    uint64_t cpu_us = PlatformUtils::getProcessCpuTimeUs();
+};
+
+std::mutex g_cpu_mutex;
+CpuSample g_cpu_sample;   // 首次调用的区间从进程加载本模块时开始
+
+} // namespace
+
 double PlatformUtils::getCpuUsage() {
-    // 简化实现，返回0表示未实现
-    // 实际项目中需要平台特定的CPU使用率计算
-    return 0.0;
+    CpuSample current;
+    CpuSample previous;
+    {
+        std::lock_guard<std::mutex> lock(g_cpu_mutex);
+        previous = g_cpu_sample;
+        g_cpu_sample = current;
+    }
+    
+    auto wall = std::chrono::duration_cast<std::chrono::microseconds>(current.wall - previous.wall);
+    if (wall.count() <= 0 || current.cpu_us < previous.cpu_us) {
+        return 0.0;
+    }
+    static const uint32_t cores = std::max<uint32_t>(getCpuCoreCount(), 1);
+    double usage = 100.0 * static_cast<double>(current.cpu_us - previous.cpu_us) /
+                   (static_cast<double>(wall.count()) * cores);
+    return std::min(usage, 100.0);
 }
 
 NetworkInfo PlatformUtils::getNetworkInfo() {
@@ -466,4 +543,323 @@ uint32_t PlatformUtils::getLastErrorCode() {
 #endif
 }
 
+// ThreadUtils实现
+namespace {
+
+#if defined(__linux__)
+// 解析sysfs中的CPU列表，例如"0-3,8-11"
+std::vector<uint32_t> parseCpuList(const std::string& list) {
+    std::vector<uint32_t> cpus;
+    std::stringstream ss(list);
+    std::string range;
+    while (std::getline(ss, range, ',')) {
+        if (range.empty() || range == "\n") {
+            continue;
+        }
+        size_t dash = range.find('-');
+        try {
+            uint32_t first = static_cast<uint32_t>(std::stoul(range.substr(0, dash)));
+            uint32_t last = dash == std::string::npos 
+                ? first : static_cast<uint32_t>(std::stoul(range.substr(dash + 1)));
+            for (uint32_t cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (...) {
+            // 忽略无法解析的片段
+        }
+    }
+    return cpus;
+}
+
+pid_t currentKernelThreadId() {
+    return static_cast<pid_t>(syscall(SYS_gettid));
+}
+#endif
+
+#if defined(__linux__)
+// Linux/Android没有线程级QoS，映射到线程的nice值（降低nice值需要相应权限）
+int niceForQoS(ThreadUtils::QoS qos) {
+    switch (qos) {
+        case ThreadUtils::QoS::BACKGROUND:       return 19;
+        case ThreadUtils::QoS::UTILITY:          return 10;
+        case ThreadUtils::QoS::DEFAULT:          return 0;
+        case ThreadUtils::QoS::USER_INITIATED:   return -4;
+        case ThreadUtils::QoS::USER_INTERACTIVE: return -8;
+    }
+    return 0;
+}
+#endif
+
+#ifdef __APPLE__
+qos_class_t appleQoS(ThreadUtils::QoS qos) {
+    switch (qos) {
+        case ThreadUtils::QoS::BACKGROUND:       return QOS_CLASS_BACKGROUND;
+        case ThreadUtils::QoS::UTILITY:          return QOS_CLASS_UTILITY;
+        case ThreadUtils::QoS::DEFAULT:          return QOS_CLASS_DEFAULT;
+        case ThreadUtils::QoS::USER_INITIATED:   return QOS_CLASS_USER_INITIATED;
+        case ThreadUtils::QoS::USER_INTERACTIVE: return QOS_CLASS_USER_INTERACTIVE;
+    }
+    return QOS_CLASS_DEFAULT;
+}
+#endif
+
+#ifdef _WIN32
+int windowsPriorityForQoS(ThreadUtils::QoS qos) {
+    switch (qos) {
+        case ThreadUtils::QoS::BACKGROUND:       return THREAD_PRIORITY_IDLE;
+        case ThreadUtils::QoS::UTILITY:          return THREAD_PRIORITY_BELOW_NORMAL;
+        case ThreadUtils::QoS::DEFAULT:          return THREAD_PRIORITY_NORMAL;
+        case ThreadUtils::QoS::USER_INITIATED:   return THREAD_PRIORITY_ABOVE_NORMAL;
+        case ThreadUtils::QoS::USER_INTERACTIVE: return THREAD_PRIORITY_HIGHEST;
+    }
+    return THREAD_PRIORITY_NORMAL;
+}
+
+// SetThreadDescription/GetThreadDescription从Windows 10 1607开始提供，运行时动态查找
+typedef HRESULT (WINAPI *SetThreadDescriptionFunc)(HANDLE, PCWSTR);
+typedef HRESULT (WINAPI *GetThreadDescriptionFunc)(HANDLE, PWSTR*);
+
+template<typename Func>
+Func kernel32Function(const char* name) {
+    HMODULE module = GetModuleHandleW(L"kernel32.dll");
+    return module ? reinterpret_cast<Func>(GetProcAddress(module, name)) : nullptr;
+}
+#endif
+
+} // namespace
+
+bool ThreadUtils::setCurrentThreadPriority(Priority priority) {
+    switch (priority) {
+        case Priority::LOW:
+            return setCurrentThreadQoS(QoS::UTILITY);
+        case Priority::NORMAL:
+            return setCurrentThreadQoS(QoS::DEFAULT);
+        case Priority::HIGH:
+            return setCurrentThreadQoS(QoS::USER_INITIATED);
+        case Priority::CRITICAL:
+            return setCurrentThreadQoS(QoS::USER_INTERACTIVE);
+    }
+    return false;
+}
+
+bool ThreadUtils::setCurrentThreadQoS(QoS qos) {
+#ifdef _WIN32
+    return SetThreadPriority(GetCurrentThread(), windowsPriorityForQoS(qos)) != 0;
+#elif defined(__APPLE__)
+    return pthread_set_qos_class_self_np(appleQoS(qos), 0) == 0;
+#elif defined(__linux__)
+    return setpriority(PRIO_PROCESS, static_cast<id_t>(currentKernelThreadId()), niceForQoS(qos)) == 0;
+#else
+    (void)qos;
+    return false;
+#endif
+}
+
+bool ThreadUtils::setCurrentThreadName(const std::string& name) {
+#ifdef _WIN32
+    auto set_description = kernel32Function<SetThreadDescriptionFunc>("SetThreadDescription");
+    if (!set_description) {
+        return false;
+    }
+    int length = MultiByteToWideChar(CP_UTF8, 0, name.c_str(), -1, nullptr, 0);
+    if (length <= 0) {
+        return false;
+    }
+    std::wstring wide_name(static_cast<size_t>(length), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, name.c_str(), -1, &wide_name[0], length);
+    return SUCCEEDED(set_description(GetCurrentThread(), wide_name.c_str()));
+#elif defined(__APPLE__)
+    return pthread_setname_np(name.substr(0, 63).c_str()) == 0;
+#elif defined(__linux__)
+    // Linux线程名最长15个字符
+    return pthread_setname_np(pthread_self(), name.substr(0, 15).c_str()) == 0;
+#else
+    (void)name;
+    return false;
+#endif
+}
+
+std::string ThreadUtils::getCurrentThreadName() {
+#ifdef _WIN32
+    auto get_description = kernel32Function<GetThreadDescriptionFunc>("GetThreadDescription");
+    PWSTR description = nullptr;
+    if (!get_description || FAILED(get_description(GetCurrentThread(), &description))) {
+        return "";
+    }
+    int length = WideCharToMultiByte(CP_UTF8, 0, description, -1, nullptr, 0, nullptr, nullptr);
+    std::string name;
+    if (length > 1) {
+        name.resize(static_cast<size_t>(length));
+        WideCharToMultiByte(CP_UTF8, 0, description, -1, &name[0], length, nullptr, nullptr);
+        name.resize(static_cast<size_t>(length - 1));
+    }
+    LocalFree(description);
+    return name;
+#elif defined(__APPLE__) || defined(__linux__)
+    char buffer[64] = {0};
+    if (pthread_getname_np(pthread_self(), buffer, sizeof(buffer)) != 0) {
+        return "";
+    }
+    return std::string(buffer);
+#else
+    return "";
+#endif
+}
+
+bool ThreadUtils::setThreadAffinity(uint64_t cpu_mask) {
+    std::vector<uint32_t> cpus;
+    for (uint32_t cpu = 0; cpu < 64; ++cpu) {
+        if (cpu_mask & (uint64_t(1) << cpu)) {
+            cpus.push_back(cpu);
+        }
+    }
+    return setCurrentThreadAffinity(cpus);
+}
+
+bool ThreadUtils::setCurrentThreadAffinity(const std::vector<uint32_t>& cpus) {
+    if (cpus.empty()) {
+        return false;
+    }
+    
+#ifdef _WIN32
+    // CPU编号 = 处理器组 × 64 + 组内编号，一个线程只能属于一个处理器组
+    GROUP_AFFINITY affinity = {};
+    affinity.Group = static_cast<WORD>(cpus.front() / 64);
+    for (uint32_t cpu : cpus) {
+        if (cpu / 64 == affinity.Group) {
+            affinity.Mask |= KAFFINITY(1) << (cpu % 64);
+        }
+    }
+    return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (uint32_t cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    // Apple平台不支持硬亲和性，调度由QoS决定
+    return false;
+#endif
+}
+
+int ThreadUtils::getCurrentCpu() {
+#ifdef _WIN32
+    PROCESSOR_NUMBER number;
+    GetCurrentProcessorNumberEx(&number);
+    return static_cast<int>(number.Group) * 64 + static_cast<int>(number.Number);
+#elif defined(__linux__)
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+std::vector<std::vector<uint32_t>> ThreadUtils::getNumaNodes() {
+    std::vector<std::vector<uint32_t>> nodes;
+    
+#ifdef _WIN32
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationNumaNode, nullptr, &length);
+    if (GetLastError() == ERROR_INSUFFICIENT_BUFFER && length > 0) {
+        std::vector<char> buffer(length);
+        auto* info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data());
+        if (GetLogicalProcessorInformationEx(RelationNumaNode, info, &length)) {
+            for (DWORD offset = 0; offset < length;) {
+                auto* entry = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*>(buffer.data() + offset);
+                if (entry->Relationship == RelationNumaNode) {
+                    const GROUP_AFFINITY& mask = entry->NumaNode.GroupMask;
+                    std::vector<uint32_t> cpus;
+                    for (uint32_t bit = 0; bit < 64; ++bit) {
+                        if (mask.Mask & (KAFFINITY(1) << bit)) {
+                            cpus.push_back(static_cast<uint32_t>(mask.Group) * 64 + bit);
+                        }
+                    }
+                    if (!cpus.empty()) {
+                        nodes.push_back(std::move(cpus));
+                    }
+                }
+                offset += entry->Size;
+            }
+        }
+    }
+#elif defined(__linux__)
+    // /sys/devices/system/node/nodeN/cpulist
+    if (DIR* dir = opendir("/sys/devices/system/node")) {
+        std::vector<std::pair<int, std::vector<uint32_t>>> found;
+        while (struct dirent* entry = readdir(dir)) {
+            int node_id = -1;
+            if (std::sscanf(entry->d_name, "node%d", &node_id) != 1) {
+                continue;
+            }
+            std::ifstream file(std::string("/sys/devices/system/node/") + entry->d_name + "/cpulist");
+            std::string list;
+            if (std::getline(file, list)) {
+                auto cpus = parseCpuList(list);
+                if (!cpus.empty()) {
+                    found.emplace_back(node_id, std::move(cpus));
+                }
+            }
+        }
+        closedir(dir);
+        
+        std::sort(found.begin(), found.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+        for (auto& node : found) {
+            nodes.push_back(std::move(node.second));
+        }
+    }
+#endif
+    
+    // 不支持NUMA或查询失败时视为单个节点
+    if (nodes.empty()) {
+        uint32_t count = std::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+        std::vector<uint32_t> cpus(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            cpus[i] = i;
+        }
+        nodes.push_back(std::move(cpus));
+    }
+    return nodes;
+}
+
+double ThreadUtils::getCurrentThreadCpuUsage() {
+    // 每个线程记录上一次采样，返回两次调用之间的CPU占用百分比
+    thread_local uint64_t last_cpu_ns = 0;
+    thread_local uint64_t last_wall_ns = 0;
+    
+    uint64_t cpu_ns = 0;
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+        return 0.0;
+    }
+    auto to_ns = [](const FILETIME& time) {
+        return ((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) * 100;
+    };
+    cpu_ns = to_ns(kernel) + to_ns(user);
+#elif defined(__APPLE__) || defined(__linux__)
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0.0;
+    }
+    cpu_ns = static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#else
+    return 0.0;
+#endif
+    
+    uint64_t wall_ns = PlatformUtils::getHighResolutionTime();
+    double usage = 0.0;
+    if (last_wall_ns != 0 && wall_ns > last_wall_ns) {
+        usage = 100.0 * static_cast<double>(cpu_ns - last_cpu_ns) / static_cast<double>(wall_ns - last_wall_ns);
+    }
+    last_cpu_ns = cpu_ns;
+    last_wall_ns = wall_ns;
+    return usage;
+}
+
 }} // namespace sdk::platform
@@ -3,12 +3,15 @@
 #include "sdk/threading/thread_pool.h"
 #include "sdk/network/http_client.h"
 #include "sdk/logging/logger.h"
+#include "sdk/metrics/metrics_reporter.h"
 #include "sdk/platform/platform_utils.h"
 
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/rotating_file_sink.h>
+#include <spdlog/async.h>
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <atomic>
@@ -50,6 +53,9 @@ public:
                 return InitResult::DEPENDENCY_ERROR;
             }
             
+            // 指标上报失败不影响SDK使用
+            initializeMetrics();
+            
             // 设置错误回调
             if (error_callback_) {
                 // 注册全局错误处理
@@ -85,6 +91,9 @@ public:
             logger_->info("SDK shutting down...");
         }
         
+        // 先停止指标上报，它依赖线程池与HTTP客户端
+        metrics_reporter_.reset();
+        
         // 关闭HTTP客户端
         http_client_.reset();
         
@@ -164,8 +173,17 @@ private:
                 sinks.push_back(file_sink);
             }
             
-            // 创建logger
-            auto spdlog_logger = std::make_shared<spdlog::logger>("sdk", sinks.begin(), sinks.end());
+            // 创建logger，异步模式下共享spdlog全局线程池
+            std::shared_ptr<spdlog::logger> spdlog_logger;
+            if (config_.async_logging) {
+                spdlog::init_thread_pool(std::max<size_t>(config_.async_log_queue_size, 1),
+                                         std::max<size_t>(config_.async_log_threads, 1));
+                spdlog_logger = std::make_shared<spdlog::async_logger>(
+                    "sdk", sinks.begin(), sinks.end(), spdlog::thread_pool(),
+                    spdlog::async_overflow_policy::block);
+            } else {
+                spdlog_logger = std::make_shared<spdlog::logger>("sdk", sinks.begin(), sinks.end());
+            }
             spdlog_logger->set_level(stringToLogLevel(config_.log_level));
             spdlog_logger->flush_on(spdlog::level::warn);
             
@@ -207,12 +225,42 @@ private:
             http_config.max_concurrent_requests = config_.max_concurrent_requests;
             
             http_client_ = std::make_shared<HttpClient>(http_config);
+            
+            // 异步请求回调在SDK线程池中执行
+            http_client_->setCallbackPool(thread_pool_);
             return true;
         } catch (const std::exception& e) {
             return false;
         }
     }
     
+    void initializeMetrics() {
+        if (!config_.enable_metrics || (config_.metrics_endpoint.empty() && config_.metrics_listen_port <= 0)) {
+            return;
+        }
+        
+        try {
+            MetricsReporterOptions options;
+            options.endpoint = config_.metrics_endpoint;
+            options.interval = std::chrono::milliseconds(config_.metrics_interval_ms);
+            options.labels["platform"] = platform::PlatformUtils::getSystemInfo().os_name;
+            options.labels["version"] = getVersion();
+            if (config_.metrics_listen_port > 0) {
+                options.listen = true;
+                options.listen_port = static_cast<uint16_t>(config_.metrics_listen_port);
+            }
+            
+            metrics_reporter_ = std::make_unique<MetricsReporter>(options, thread_pool_, http_client_);
+            if (options.listen && metrics_reporter_->listenPort() == 0 && logger_) {
+                logger_->warn("Metrics endpoint could not listen on port {}", config_.metrics_listen_port);
+            }
+        } catch (const std::exception& e) {
+            if (logger_) {
+                logger_->warn("Metrics reporter disabled: {}", e.what());
+            }
+        }
+    }
+    
     spdlog::level::level_enum stringToLogLevel(const std::string& level) {
         if (level == "trace") return spdlog::level::trace;
         if (level == "debug") return spdlog::level::debug;
@@ -231,6 +279,7 @@ private:
     std::shared_ptr<ThreadPool> thread_pool_;
     std::shared_ptr<HttpClient> http_client_;
     std::shared_ptr<Logger> logger_;
+    std::unique_ptr<MetricsReporter> metrics_reporter_;
     
     std::function<void(const std::string&)> error_callback_;
 };
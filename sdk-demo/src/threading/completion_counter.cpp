@@ -0,0 +1,159 @@
+#include "sdk/threading/completion_counter.h"
+
+#if defined(__linux__)
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+    #include <climits>
+    #include <ctime>
+    #define SDK_HAS_ADDRESS_WAIT 1
+#elif defined(_WIN32)
+    #include <windows.h>
+    #pragma comment(lib, "Synchronization.lib")
+    #define SDK_HAS_ADDRESS_WAIT 1
+#else
+    #define SDK_HAS_ADDRESS_WAIT 0
+#endif
+
+namespace sdk {
+
+namespace {
+
+#if SDK_HAS_ADDRESS_WAIT
+// 在state仍等于expected时休眠，timeout为空表示无限等待；被唤醒、值已改变或超时都会返回
+void addressWait(std::atomic<uint32_t>& state, uint32_t expected, const std::chrono::nanoseconds* timeout) {
+#if defined(__linux__)
+    struct timespec ts;
+    struct timespec* ts_ptr = nullptr;
+    if (timeout) {
+        ts.tv_sec = static_cast<time_t>(timeout->count() / 1000000000);
+        ts.tv_nsec = static_cast<long>(timeout->count() % 1000000000);
+        ts_ptr = &ts;
+    }
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&state), FUTEX_WAIT_PRIVATE, expected, ts_ptr, nullptr, 0);
+#else
+    DWORD ms = INFINITE;
+    if (timeout) {
+        // 向上取整到毫秒，避免在截止时间前空转
+        ms = static_cast<DWORD>((timeout->count() + 999999) / 1000000);
+    }
+    WaitOnAddress(&state, &expected, sizeof(expected), ms);
+#endif
+}
+
+void addressWakeAll(std::atomic<uint32_t>& state) {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&state), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+    WakeByAddressAll(&state);
+#endif
+}
+#endif
+
+} // namespace
+
+void CompletionCounter::add(size_t count) noexcept {
+    state_.fetch_add(static_cast<uint32_t>(count));
+}
+
+size_t CompletionCounter::count() const noexcept {
+    return state_.load() & kCountMask;
+}
+
+void CompletionCounter::done(size_t count) noexcept {
+    const uint32_t delta = static_cast<uint32_t>(count);
+    uint32_t state = state_.load();
+
+#if SDK_HAS_ADDRESS_WAIT
+    // 归零时在同一次CAS中清除等待者标志，之后只按地址唤醒，不再读取任何成员
+    uint32_t next;
+    do {
+        next = state - delta;
+        if ((next & kCountMask) == 0) {
+            next = 0;
+        }
+    } while (!state_.compare_exchange_weak(state, next));
+
+    if (next == 0 && (state & kWaiterBit)) {
+        addressWakeAll(state_);
+    }
+#else
+    // 没有等待者时无锁递减；等待者在锁内设置标志，CAS失败后转入加锁路径
+    while (!(state & kWaiterBit)) {
+        if (state_.compare_exchange_weak(state, state - delta)) {
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    state = state_.load();
+    uint32_t next;
+    do {
+        next = state - delta;
+        if ((next & kCountMask) == 0) {
+            next = 0;
+        }
+    } while (!state_.compare_exchange_weak(state, next));
+
+    if (next == 0) {
+        condition_.notify_all();
+    }
+#endif
+}
+
+void CompletionCounter::wait() const {
+    waitUntil(nullptr);
+}
+
+bool CompletionCounter::waitFor(const std::chrono::milliseconds& timeout) const {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    return waitUntil(&deadline);
+}
+
+bool CompletionCounter::waitUntil(const std::chrono::steady_clock::time_point* deadline) const {
+#if SDK_HAS_ADDRESS_WAIT
+    while (true) {
+        uint32_t state = state_.load();
+        if ((state & kCountMask) == 0) {
+            return true;
+        }
+
+        // 先登记等待者再休眠，futex在值改变后不会进入休眠，不会丢失唤醒
+        if (!(state & kWaiterBit)) {
+            if (!state_.compare_exchange_weak(state, state | kWaiterBit)) {
+                continue;
+            }
+            state |= kWaiterBit;
+        }
+
+        if (deadline) {
+            auto remaining = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                *deadline - std::chrono::steady_clock::now());
+            if (remaining.count() <= 0) {
+                return (state_.load() & kCountMask) == 0;
+            }
+            addressWait(state_, state, &remaining);
+        } else {
+            addressWait(state_, state, nullptr);
+        }
+    }
+#else
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // 在锁内设置等待者标志：之后的done()都会加锁并在归零时通知
+    uint32_t previous = state_.fetch_or(kWaiterBit);
+    if ((previous & kCountMask) == 0) {
+        state_.fetch_and(kCountMask);
+        return true;
+    }
+
+    auto finished = [this] { return (state_.load() & kCountMask) == 0; };
+    if (deadline) {
+        return condition_.wait_until(lock, *deadline, finished);
+    }
+    condition_.wait(lock, finished);
+    return true;
+#endif
+}
+
+} // namespace sdk
@@ -0,0 +1,120 @@
+#include "sdk/threading/future.h"
+
+namespace sdk {
+
+namespace detail {
+
+void FutureStateBase::wait() const {
+    if (isReady()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return isReady(); });
+}
+
+bool FutureStateBase::waitFor(const std::chrono::milliseconds& timeout) const {
+    if (isReady()) {
+        return true;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    return condition_.wait_for(lock, timeout, [this] { return isReady(); });
+}
+
+void FutureStateBase::onReady(TaskFunction callback) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!isReady()) {
+            callbacks_.push_back(std::move(callback));
+            return;
+        }
+    }
+    callback();
+}
+
+void FutureStateBase::setException(std::exception_ptr error) {
+    if (!trySetException(std::move(error))) {
+        throw std::future_error(std::future_errc::promise_already_satisfied);
+    }
+}
+
+bool FutureStateBase::trySetException(std::exception_ptr error) noexcept {
+    if (!claim()) {
+        return false;
+    }
+    publishError(std::move(error));
+    return true;
+}
+
+bool FutureStateBase::claim() noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (satisfied_) {
+        return false;
+    }
+    satisfied_ = true;
+    return true;
+}
+
+void FutureStateBase::publishError(std::exception_ptr error) noexcept {
+    error_ = std::move(error);
+    publish();
+}
+
+void FutureStateBase::publish() noexcept {
+    std::vector<TaskFunction> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ready_.store(true, std::memory_order_release);
+        callbacks.swap(callbacks_);
+    }
+    condition_.notify_all();
+
+    // 回调在锁外执行，其中可以继续注册延续
+    for (auto& callback : callbacks) {
+        try {
+            callback();
+        } catch (...) {
+            // 回调异常不能影响写入结果的线程
+        }
+    }
+}
+
+} // namespace detail
+
+Future<void> whenAll(std::vector<Future<void>> futures) {
+    struct State {
+        explicit State(size_t count) : remaining(count), inputs(count) {}
+
+        std::atomic<size_t> remaining;
+        std::vector<std::shared_ptr<detail::FutureState<void>>> inputs;
+        std::shared_ptr<detail::FutureState<void>> result = std::make_shared<detail::FutureState<void>>();
+    };
+
+    auto state = std::make_shared<State>(futures.size());
+    Future<void> result = detail::FutureAccess::make(state->result);
+    if (futures.empty()) {
+        state->result->setValue();
+        return result;
+    }
+
+    for (size_t i = 0; i < futures.size(); ++i) {
+        state->inputs[i] = detail::FutureAccess::release(futures[i]);
+    }
+
+    for (auto& input : state->inputs) {
+        input->onReady([state]() {
+            if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+            for (auto& input : state->inputs) {
+                if (input->error()) {
+                    state->result->trySetException(input->error());
+                    return;
+                }
+            }
+            state->result->setValue();
+        });
+    }
+    return result;
+}
+
+} // namespace sdk
@@ -0,0 +1,192 @@
+#include "sdk/threading/task_graph.h"
+
+#include <stdexcept>
+
+namespace sdk {
+
+namespace {
+
+// 一次运行的共享状态
+class GraphExecution : public std::enable_shared_from_this<GraphExecution> {
+public:
+    struct Node {
+        std::function<void()> fn;
+        TaskPriority priority;
+        std::vector<size_t> successors;
+        std::atomic<size_t> pending;
+    };
+
+    GraphExecution(ThreadPool& pool, size_t count)
+        : pool_(pool), nodes_(count), remaining_(count) {}
+
+    std::vector<Node>& nodes() { return nodes_; }
+
+    Future<void> getFuture() { return done_.getFuture(); }
+
+    // 把就绪节点投递到线程池
+    void dispatch(size_t index);
+
+private:
+    // 节点任务：执行节点，未执行就被销毁（线程池关闭）时按失败处理，保证整张图总能结束
+    class NodeTask {
+    public:
+        NodeTask(std::shared_ptr<GraphExecution> execution, size_t index) noexcept
+            : execution_(std::move(execution)), index_(index) {}
+        NodeTask(NodeTask&& other) noexcept = default;
+        NodeTask& operator=(NodeTask&&) = delete;
+        NodeTask(const NodeTask&) = delete;
+
+        ~NodeTask() {
+            if (execution_) {
+                execution_->fail(detail::brokenPromise());
+                execution_->finish(index_);
+            }
+        }
+
+        void operator()() {
+            std::shared_ptr<GraphExecution> execution = std::move(execution_);
+            execution->execute(index_);
+        }
+
+    private:
+        std::shared_ptr<GraphExecution> execution_;
+        size_t index_;
+    };
+
+    void execute(size_t index);
+    void fail(std::exception_ptr error);
+    void finish(size_t index);
+
+    ThreadPool& pool_;
+    std::vector<Node> nodes_;
+    std::atomic<size_t> remaining_;
+    std::atomic<bool> failed_{false};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+    Promise<void> done_;
+};
+
+void GraphExecution::dispatch(size_t index) {
+    try {
+        pool_.post(nodes_[index].priority, NodeTask(shared_from_this(), index));
+    } catch (...) {
+        // 投递失败时NodeTask已随异常销毁并按失败完成
+    }
+}
+
+void GraphExecution::execute(size_t index) {
+    // 已有节点失败时跳过剩余节点，依赖计数照常推进以便整张图结束
+    if (!failed_.load(std::memory_order_acquire)) {
+        try {
+            nodes_[index].fn();
+        } catch (...) {
+            fail(std::current_exception());
+        }
+    }
+    finish(index);
+}
+
+void GraphExecution::fail(std::exception_ptr error) {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    if (!error_) {
+        error_ = std::move(error);
+    }
+    failed_.store(true, std::memory_order_release);
+}
+
+void GraphExecution::finish(size_t index) {
+    for (size_t successor : nodes_[index].successors) {
+        if (nodes_[successor].pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            dispatch(successor);
+        }
+    }
+
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::exception_ptr error;
+        {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            error = error_;
+        }
+        if (error) {
+            done_.setException(error);
+        } else {
+            done_.setValue();
+        }
+    }
+}
+
+} // namespace
+
+TaskGraph::NodeId TaskGraph::addTask(std::function<void()> fn, TaskPriority priority) {
+    if (!fn) {
+        throw std::invalid_argument("Task function is empty");
+    }
+
+    Node node;
+    node.fn = std::move(fn);
+    node.priority = priority;
+    nodes_.push_back(std::move(node));
+    return nodes_.size() - 1;
+}
+
+void TaskGraph::precede(NodeId before, NodeId after) {
+    if (before >= nodes_.size() || after >= nodes_.size()) {
+        throw std::out_of_range("Invalid task graph node");
+    }
+    if (before == after) {
+        throw std::invalid_argument("Task cannot depend on itself");
+    }
+
+    nodes_[before].successors.push_back(after);
+    ++nodes_[after].dependency_count;
+}
+
+Future<void> TaskGraph::run(ThreadPool& pool) const {
+    if (nodes_.empty()) {
+        return makeReadyFuture();
+    }
+
+    // 拓扑排序检查环，同时收集入度为0的起始节点
+    std::vector<size_t> in_degree(nodes_.size());
+    std::vector<NodeId> roots;
+    std::vector<NodeId> ready;
+    for (NodeId id = 0; id < nodes_.size(); ++id) {
+        in_degree[id] = nodes_[id].dependency_count;
+        if (in_degree[id] == 0) {
+            roots.push_back(id);
+        }
+    }
+
+    ready = roots;
+    size_t visited = 0;
+    while (!ready.empty()) {
+        NodeId id = ready.back();
+        ready.pop_back();
+        ++visited;
+        for (NodeId successor : nodes_[id].successors) {
+            if (--in_degree[successor] == 0) {
+                ready.push_back(successor);
+            }
+        }
+    }
+    if (visited != nodes_.size()) {
+        throw std::invalid_argument("Task graph contains a cycle");
+    }
+
+    auto execution = std::make_shared<GraphExecution>(pool, nodes_.size());
+    auto& nodes = execution->nodes();
+    for (NodeId id = 0; id < nodes_.size(); ++id) {
+        nodes[id].fn = nodes_[id].fn;
+        nodes[id].priority = nodes_[id].priority;
+        nodes[id].successors = nodes_[id].successors;
+        nodes[id].pending.store(nodes_[id].dependency_count, std::memory_order_relaxed);
+    }
+
+    Future<void> result = execution->getFuture();
+    for (NodeId root : roots) {
+        execution->dispatch(root);
+    }
+    return result;
+}
+
+} // namespace sdk
@@ -0,0 +1,37 @@
+#include "sdk/threading/task_group.h"
+
+namespace sdk {
+
+TaskGroup::TaskGroup(ThreadPool& pool, TaskPriority priority)
+    : pool_(pool), priority_(priority) {}
+
+TaskGroup::~TaskGroup() {
+    counter_.wait();
+}
+
+void TaskGroup::wait() {
+    counter_.wait();
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        error = std::move(error_);
+        error_ = nullptr;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+bool TaskGroup::waitFor(const std::chrono::milliseconds& timeout) {
+    return counter_.waitFor(timeout);
+}
+
+void TaskGroup::fail(std::exception_ptr error) {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    if (!error_) {
+        error_ = std::move(error);
+    }
+}
+
+} // namespace sdk
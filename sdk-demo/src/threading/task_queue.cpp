@@ -1,63 +1,149 @@
 #include "sdk/threading/task_queue.h"
 #include <algorithm>
+#include <stdexcept>
 
 namespace sdk {
 
-TaskQueue::TaskQueue() = default;
+namespace {
+
+inline size_t priorityIndex(TaskPriority priority) {
+    return static_cast<size_t>(priority);
+}
+
+// top()只提供const引用，任务在pop()前移出，避免拷贝
+void popTop(std::priority_queue<Task>& queue, Task& task) {
+    task = std::move(const_cast<Task&>(queue.top()));
+    queue.pop();
+}
+
+} // namespace
+
+TaskQueue::TaskQueue() : TaskQueue(QueueBackend::PRIORITY_HEAP) {}
+
+TaskQueue::TaskQueue(QueueBackend backend, size_t ring_capacity, QueueOverflowPolicy overflow_policy)
+    : backend_(backend) {
+    if (backend_ == QueueBackend::RING_BUFFER) {
+        rings_ = std::make_unique<PriorityRingQueue<Task, 4>>(std::max<size_t>(ring_capacity, 2), overflow_policy);
+    }
+}
 
 TaskQueue::~TaskQueue() = default;
 
 void TaskQueue::push(Task task) {
+    task.sequence = next_sequence_.fetch_add(1, std::memory_order_relaxed);
+
+    if (rings_) {
+        // 计数先于入队增加，保证计数始终不小于队列中的实际任务数
+        ring_size_.fetch_add(1);
+        if (!rings_->push(priorityIndex(task.priority), std::move(task))) {
+            ring_size_.fetch_sub(1);
+            throw std::runtime_error("Task queue is full");
+        }
+
+        // 先发布计数再检查等待者，与waitAndPop中的顺序对称，避免丢失唤醒
+        notifyRingWaiters();
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
     queue_.push(std::move(task));
     condition_.notify_one();
 }
 
+void TaskQueue::notifyRingWaiters() {
+    if (waiters_.load() > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        condition_.notify_all();
+    }
+}
+
+bool TaskQueue::popRing(Task& task) {
+    // 计数大于0但入队尚未完成时返回false，调用方稍后重试
+    if (ring_size_.load() == 0 || !rings_->tryPop(task)) {
+        return false;
+    }
+    ring_size_.fetch_sub(1);
+    return true;
+}
+
 bool TaskQueue::tryPop(Task& task) {
+    if (rings_) {
+        return popRing(task);
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
     if (queue_.empty()) {
         return false;
     }
-    
-    task = queue_.top();
-    queue_.pop();
+
+    popTop(queue_, task);
     return true;
 }
 
 bool TaskQueue::waitAndPop(Task& task) {
+    if (rings_) {
+        while (!popRing(task)) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            waiters_.fetch_add(1);
+            condition_.wait(lock, [this] { return ring_size_.load() > 0 || stop_; });
+            waiters_.fetch_sub(1);
+
+            if (stop_ && ring_size_.load() == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     std::unique_lock<std::mutex> lock(mutex_);
     condition_.wait(lock, [this] { return !queue_.empty() || stop_; });
-    
+
     if (stop_ && queue_.empty()) {
         return false;
     }
-    
-    task = queue_.top();
-    queue_.pop();
+
+    popTop(queue_, task);
     return true;
 }
 
 bool TaskQueue::waitAndPop(Task& task, const std::chrono::milliseconds& timeout) {
+    if (rings_) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!popRing(task)) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            waiters_.fetch_add(1);
+            bool ready = condition_.wait_until(lock, deadline, [this] { return ring_size_.load() > 0 || stop_; });
+            waiters_.fetch_sub(1);
+
+            if (!ready || (stop_ && ring_size_.load() == 0)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     std::unique_lock<std::mutex> lock(mutex_);
     if (!condition_.wait_for(lock, timeout, [this] { return !queue_.empty() || stop_; })) {
         return false;
     }
-    
+
     if (stop_ && queue_.empty()) {
         return false;
     }
-    
-    task = queue_.top();
-    queue_.pop();
+
+    popTop(queue_, task);
     return true;
 }
 
 bool TaskQueue::empty() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return queue_.empty();
+    return size() == 0;
 }
 
 size_t TaskQueue::size() const {
+    if (rings_) {
+        return ring_size_.load();
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
     return queue_.size();
 }
@@ -69,39 +155,88 @@ void TaskQueue::stop() {
 }
 
 void TaskQueue::clear() {
+    if (rings_) {
+        Task task;
+        while (popRing(task)) {
+        }
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
     std::priority_queue<Task> empty;
     queue_.swap(empty);
 }
 
 std::vector<Task> TaskQueue::getAllTasks() {
-    std::lock_guard<std::mutex> lock(mutex_);
     std::vector<Task> tasks;
-    
+
+    if (rings_) {
+        // 按优先级取出全部任务，复制一份后原样放回（保留原入队序号）
+        Task task;
+        while (popRing(task)) {
+            tasks.push_back(std::move(task));
+        }
+        for (const auto& queued : tasks) {
+            ring_size_.fetch_add(1);
+            if (!rings_->push(priorityIndex(queued.priority), Task(queued))) {
+                ring_size_.fetch_sub(1);
+            }
+        }
+        notifyRingWaiters();
+        return tasks;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
     auto temp_queue = queue_;
     while (!temp_queue.empty()) {
-        tasks.push_back(temp_queue.top());
-        temp_queue.pop();
+        Task task;
+        popTop(temp_queue, task);
+        tasks.push_back(std::move(task));
     }
-    
+
     return tasks;
 }
 
 void TaskQueue::removeTasksWithId(const std::string& task_id) {
+    auto matches = [&task_id](const Task& task) {
+        return task.info && task.info->id == task_id;
+    };
+
+    if (rings_) {
+        std::vector<Task> kept;
+        Task task;
+        while (popRing(task)) {
+            if (matches(task)) {
+                task.info->status = TaskStatus::CANCELLED;
+            } else {
+                kept.push_back(std::move(task));
+            }
+        }
+        for (auto& queued : kept) {
+            ring_size_.fetch_add(1);
+            if (!rings_->push(priorityIndex(queued.priority), std::move(queued))) {
+                ring_size_.fetch_sub(1);
+            }
+        }
+        notifyRingWaiters();
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(mutex_);
-    
+
     std::priority_queue<Task> new_queue;
     while (!queue_.empty()) {
-        Task task = queue_.top();
-        queue_.pop();
-        
-        if (task.info->id != task_id) {
-            new_queue.push(task);
+        Task task;
+        popTop(queue_, task);
+
+        if (!matches(task)) {
+            new_queue.push(std::move(task));
         } else {
             task.info->status = TaskStatus::CANCELLED;
         }
     }
-    
+
     queue_ = std::move(new_queue);
 }
 
@@ -0,0 +1,241 @@
+#include "task_registry.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace sdk {
+
+namespace {
+
+constexpr size_t kMinCapacity = 16;
+
+// 状态字：高位为数字任务ID，低3位为TaskStatus，0表示空槽位
+// 取消、开始执行等状态迁移通过对状态字CAS完成，槽位被新任务复用时CAS自然失败
+constexpr uint64_t kStatusBits = 3;
+constexpr uint64_t kStatusMask = (1u << kStatusBits) - 1;
+
+inline uint64_t makeState(uint64_t seq, TaskStatus status) {
+    return (seq << kStatusBits) | static_cast<uint64_t>(status);
+}
+
+inline uint64_t stateSeq(uint64_t state) {
+    return state >> kStatusBits;
+}
+
+inline TaskStatus stateStatus(uint64_t state) {
+    return static_cast<TaskStatus>(state & kStatusMask);
+}
+
+size_t roundUpPowerOfTwo(size_t value) {
+    size_t result = kMinCapacity;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+// 槽位：状态字可无锁读取和迁移，字符串与时间字段由槽位自旋锁保护
+struct alignas(64) TaskRegistry::Slot {
+    std::atomic<uint64_t> state{0};
+    mutable std::atomic_flag busy = ATOMIC_FLAG_INIT;
+    TaskInfo info;
+
+    void lock() const {
+        while (busy.test_and_set(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+    }
+
+    void unlock() const {
+        busy.clear(std::memory_order_release);
+    }
+};
+
+namespace {
+
+// 槽位自旋锁的RAII守卫
+template<typename SlotT>
+class SlotGuard {
+public:
+    explicit SlotGuard(SlotT& slot) : slot_(slot) { slot_.lock(); }
+    ~SlotGuard() { slot_.unlock(); }
+
+    SlotGuard(const SlotGuard&) = delete;
+    SlotGuard& operator=(const SlotGuard&) = delete;
+
+private:
+    SlotT& slot_;
+};
+
+} // namespace
+
+TaskRegistry::TaskRegistry(size_t capacity, std::chrono::milliseconds retention)
+    : mask_(roundUpPowerOfTwo(capacity) - 1),
+      retention_(retention),
+      slots_(new Slot[mask_ + 1]) {
+    name_index_.reserve(mask_ + 1);
+}
+
+TaskRegistry::~TaskRegistry() = default;
+
+TaskRegistry::Slot& TaskRegistry::slotFor(uint64_t seq) const {
+    return slots_[seq & mask_];
+}
+
+bool TaskRegistry::isExpired(const TaskInfo& info, std::chrono::system_clock::time_point now) const {
+    // 只有已结束的记录会按时间过期，待处理和运行中的任务始终可查
+    if (retention_.count() <= 0) {
+        return false;
+    }
+    if (info.status == TaskStatus::PENDING || info.status == TaskStatus::RUNNING) {
+        return false;
+    }
+    return now - info.end_time > retention_;
+}
+
+void TaskRegistry::record(uint64_t seq, const std::string& task_id, TaskPriority priority,
+                          std::chrono::system_clock::time_point submit_time) {
+    Slot& slot = slotFor(seq);
+    SlotGuard<Slot> guard(slot);
+
+    // 在槽位锁内更新名字索引，同一槽位的覆盖与索引更新顺序一致
+    indexName(slot.info.id, stateSeq(slot.state.load(std::memory_order_acquire)), task_id, seq);
+
+    // 复用槽位中字符串的已有容量，稳定运行后不再分配内存
+    slot.info.id.assign(task_id);
+    slot.info.priority = priority;
+    slot.info.status = TaskStatus::PENDING;
+    slot.info.submit_time = submit_time;
+    slot.info.start_time = {};
+    slot.info.end_time = {};
+    slot.info.error_message.clear();
+    slot.state.store(makeState(seq, TaskStatus::PENDING), std::memory_order_release);
+}
+
+void TaskRegistry::indexName(const std::string& old_name, uint64_t old_seq,
+                             const std::string& task_id, uint64_t seq) {
+    std::lock_guard<std::mutex> lock(name_mutex_);
+
+    // 旧名字仍指向被覆盖的记录时删除，同名的更新提交保留；摘下的节点留给新名字复用，不再分配
+    std::unordered_map<std::string, uint64_t>::node_type node;
+    if (old_seq != 0) {
+        auto it = name_index_.find(old_name);
+        if (it != name_index_.end() && it->second == old_seq) {
+            node = name_index_.extract(it);
+        }
+    }
+
+    // 并发提交同名任务时只保留较新的数字ID
+    auto it = name_index_.find(task_id);
+    if (it != name_index_.end()) {
+        it->second = std::max(it->second, seq);
+    } else if (node) {
+        node.key().assign(task_id);
+        node.mapped() = seq;
+        name_index_.insert(std::move(node));
+    } else {
+        name_index_.emplace(task_id, seq);
+    }
+}
+
+bool TaskRegistry::markRunning(uint64_t seq, std::chrono::system_clock::time_point start_time) {
+    Slot& slot = slotFor(seq);
+
+    uint64_t expected = makeState(seq, TaskStatus::PENDING);
+    if (!slot.state.compare_exchange_strong(expected, makeState(seq, TaskStatus::RUNNING),
+                                            std::memory_order_acq_rel)) {
+        // 记录已被新任务覆盖时照常执行，仅在确认被取消时跳过
+        return !(stateSeq(expected) == seq && stateStatus(expected) == TaskStatus::CANCELLED);
+    }
+
+    SlotGuard<Slot> guard(slot);
+    if (stateSeq(slot.state.load(std::memory_order_acquire)) == seq) {
+        slot.info.status = TaskStatus::RUNNING;
+        slot.info.start_time = start_time;
+    }
+    return true;
+}
+
+void TaskRegistry::markFinished(uint64_t seq, TaskStatus status,
+                                std::chrono::system_clock::time_point end_time,
+                                const char* error_message) {
+    Slot& slot = slotFor(seq);
+    SlotGuard<Slot> guard(slot);
+
+    if (stateSeq(slot.state.load(std::memory_order_acquire)) != seq) {
+        return;
+    }
+
+    slot.info.status = status;
+    slot.info.end_time = end_time;
+    if (error_message) {
+        slot.info.error_message.assign(error_message);
+    }
+    slot.state.store(makeState(seq, status), std::memory_order_release);
+}
+
+bool TaskRegistry::cancel(uint64_t seq) {
+    Slot& slot = slotFor(seq);
+
+    uint64_t expected = makeState(seq, TaskStatus::PENDING);
+    if (!slot.state.compare_exchange_strong(expected, makeState(seq, TaskStatus::CANCELLED),
+                                            std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    SlotGuard<Slot> guard(slot);
+    if (stateSeq(slot.state.load(std::memory_order_acquire)) == seq) {
+        slot.info.status = TaskStatus::CANCELLED;
+        slot.info.end_time = std::chrono::system_clock::now();
+    }
+    return true;
+}
+
+uint64_t TaskRegistry::findByName(const std::string& task_id) const {
+    std::lock_guard<std::mutex> lock(name_mutex_);
+    auto it = name_index_.find(task_id);
+    return it != name_index_.end() ? it->second : 0;
+}
+
+bool TaskRegistry::get(uint64_t seq, TaskInfo& info) const {
+    const Slot& slot = slotFor(seq);
+    SlotGuard<const Slot> guard(slot);
+
+    if (stateSeq(slot.state.load(std::memory_order_acquire)) != seq ||
+        isExpired(slot.info, std::chrono::system_clock::now())) {
+        return false;
+    }
+
+    info = slot.info;
+    return true;
+}
+
+std::vector<TaskInfo> TaskRegistry::snapshot() const {
+    auto now = std::chrono::system_clock::now();
+
+    std::vector<TaskInfo> infos;
+    infos.reserve(std::min<size_t>(mask_ + 1, 256));
+
+    // 逐槽位加锁复制，任何时刻最多持有一个槽位锁
+    for (size_t i = 0; i <= mask_; ++i) {
+        const Slot& slot = slots_[i];
+        if (slot.state.load(std::memory_order_acquire) == 0) {
+            continue;
+        }
+
+        SlotGuard<const Slot> guard(slot);
+        if (!isExpired(slot.info, now)) {
+            infos.push_back(slot.info);
+        }
+    }
+
+    // 按提交时间排序，便于调用方查看最近的任务
+    std::sort(infos.begin(), infos.end(), [](const TaskInfo& a, const TaskInfo& b) {
+        return a.submit_time < b.submit_time;
+    });
+    return infos;
+}
+
+} // namespace sdk
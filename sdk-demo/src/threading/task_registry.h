@@ -0,0 +1,69 @@
+#pragma once
+
+#include "sdk/threading/thread_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sdk {
+
+    // 固定容量的任务记录表
+    // 记录按数字任务ID映射到槽位（seq & mask），新记录覆盖最早的记录，内存占用不随提交量增长
+    // 按数字ID查找只做下标计算和单槽位自旋锁，按名字查找走独立的哈希索引，都不接触线程池的调度锁
+    class TaskRegistry {
+    public:
+        TaskRegistry(size_t capacity, std::chrono::milliseconds retention);
+        ~TaskRegistry();
+
+        TaskRegistry(const TaskRegistry&) = delete;
+        TaskRegistry& operator=(const TaskRegistry&) = delete;
+
+        // 登记新提交的任务
+        void record(uint64_t seq, const std::string& task_id, TaskPriority priority,
+                    std::chrono::system_clock::time_point submit_time);
+
+        // 标记任务开始执行，任务已被取消时返回false
+        bool markRunning(uint64_t seq, std::chrono::system_clock::time_point start_time);
+
+        // 标记任务结束
+        void markFinished(uint64_t seq, TaskStatus status,
+                          std::chrono::system_clock::time_point end_time,
+                          const char* error_message);
+
+        // 将待处理任务标记为取消
+        bool cancel(uint64_t seq);
+
+        // 按字符串ID查找数字ID，找不到返回0
+        uint64_t findByName(const std::string& task_id) const;
+
+        // 获取单条记录
+        bool get(uint64_t seq, TaskInfo& info) const;
+
+        // 获取保留期内全部记录的快照
+        std::vector<TaskInfo> snapshot() const;
+
+        size_t capacity() const { return mask_ + 1; }
+
+    private:
+        struct Slot;
+
+        Slot& slotFor(uint64_t seq) const;
+        bool isExpired(const TaskInfo& info, std::chrono::system_clock::time_point now) const;
+
+        void indexName(const std::string& old_name, uint64_t old_seq,
+                       const std::string& task_id, uint64_t seq);
+
+        size_t mask_;
+        std::chrono::milliseconds retention_;
+        std::unique_ptr<Slot[]> slots_;
+
+        // 字符串ID到最近一次提交的数字ID，槽位被覆盖时删除旧名字，条目数不超过容量
+        mutable std::mutex name_mutex_;
+        std::unordered_map<std::string, uint64_t> name_index_;
+    };
+}
@@ -1,17 +1,281 @@
 #include "sdk/threading/thread_pool.h"
+#include "sdk/sdk_core.h"
 #include "sdk/sdk_c_api.h"
 #include "sdk/platform/platform_utils.h"
+#include "sdk/metrics/tracing.h"
+#include "task_registry.h"
+#include "timer_wheel.h"
 
 #include <algorithm>
+#include <cstring>
+#include <deque>
 #include <sstream>
-#include <random>
+#include <cstdint>
 #include <unordered_map>
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #include <immintrin.h>
+#endif
+
 namespace sdk {
 
+namespace detail {
+
+namespace {
+
+// 固定容量的任务节点池：空闲链表头为(版本号<<32 | 块索引)，用版本号规避ABA问题
+class TaskNodePool {
+public:
+    static constexpr uint32_t kCapacity = 4096;
+    static constexpr uint32_t kNil = 0xFFFFFFFFu;
+    
+    static TaskNodePool& instance() {
+        // 有意不析构：静态对象析构阶段仍可能有任务归还节点
+        static TaskNodePool* pool = new TaskNodePool();
+        return *pool;
+    }
+    
+    void* allocate() {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        while (true) {
+            uint32_t index = static_cast<uint32_t>(head);
+            if (index == kNil) {
+                return nullptr;
+            }
+            uint32_t next = next_[index].load(std::memory_order_relaxed);
+            uint64_t new_head = (((head >> 32) + 1) << 32) | next;
+            if (head_.compare_exchange_weak(head, new_head, 
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+                return blocks_[index].data;
+            }
+        }
+    }
+    
+    bool owns(const void* ptr) const {
+        auto address = reinterpret_cast<uintptr_t>(ptr);
+        auto begin = reinterpret_cast<uintptr_t>(blocks_.get());
+        return address >= begin && address < begin + sizeof(Block) * kCapacity;
+    }
+    
+    void deallocate(void* ptr) {
+        auto index = static_cast<uint32_t>(static_cast<Block*>(ptr) - blocks_.get());
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        uint64_t new_head;
+        do {
+            next_[index].store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+            new_head = (((head >> 32) + 1) << 32) | index;
+        } while (!head_.compare_exchange_weak(head, new_head,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+    
+private:
+    struct alignas(std::max_align_t) Block {
+        unsigned char data[kTaskNodeSize];
+    };
+    
+    TaskNodePool()
+        : blocks_(new Block[kCapacity]), next_(new std::atomic<uint32_t>[kCapacity]) {
+        for (uint32_t i = 0; i < kCapacity; ++i) {
+            next_[i].store(i + 1 < kCapacity ? i + 1 : kNil, std::memory_order_relaxed);
+        }
+        head_.store(0, std::memory_order_release);
+    }
+    
+    std::unique_ptr<Block[]> blocks_;
+    std::unique_ptr<std::atomic<uint32_t>[]> next_;
+    std::atomic<uint64_t> head_{0};
+};
+
+} // namespace
+
+void* allocateTaskNode(size_t size) {
+    if (size <= kTaskNodeSize) {
+        if (void* ptr = TaskNodePool::instance().allocate()) {
+            return ptr;
+        }
+    }
+    return ::operator new(size);
+}
+
+void deallocateTaskNode(void* ptr, size_t size) noexcept {
+    if (size <= kTaskNodeSize && TaskNodePool::instance().owns(ptr)) {
+        TaskNodePool::instance().deallocate(ptr);
+        return;
+    }
+    ::operator delete(ptr);
+}
+
+} // namespace detail
+
+namespace {
+
+constexpr size_t kPriorityLevels = 4;
+
+inline size_t priorityIndex(TaskPriority priority) {
+    return static_cast<size_t>(priority);
+}
+
+// 自旋等待时降低功耗并让出流水线
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// 排队区间的开始事件，被拒绝的任务不会留下没有结束的区间：
+// 环形队列在push成功后记录，共享队列与本地队列在计数后的停止检查通过、push不会再失败时记录
+inline void traceQueued(uint64_t trace_id, std::chrono::steady_clock::time_point enqueue_time) {
+    if (trace_id != 0) {
+        Tracer::recordAsyncBegin("thread_pool", "task.queue", trace_id, Tracer::toNanos(enqueue_time));
+    }
+}
+
+// 当前线程所属的线程池及其工作线程序号，用于把线程内提交的任务放入本地队列
+thread_local ThreadPool* t_current_pool = nullptr;
+thread_local size_t t_worker_index = 0;
+
+} // namespace
+
+namespace detail {
+
+BatchState::BatchState(size_t count)
+    : total(count), remaining(count), failed(0), dropped(0) {}
+
+void BatchState::complete(std::exception_ptr error) noexcept {
+    if (error) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!first_error) {
+                first_error = error;
+            }
+        }
+        failed.fetch_add(1);
+    }
+    arrive();
+}
+
+void BatchState::drop() noexcept {
+    dropped.fetch_add(1);
+    arrive();
+}
+
+void BatchState::arrive() noexcept {
+    // 最后一个子任务负责唤醒等待者，其余子任务只做一次原子减法
+    if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(mutex);
+        done.notify_all();
+    }
+}
+
+} // namespace detail
+
+// BatchHandle实现
+void BatchHandle::wait() const {
+    if (!state_ || state_->remaining.load(std::memory_order_acquire) == 0) {
+        return;
+    }
+    
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->done.wait(lock, [this] {
+        return state_->remaining.load(std::memory_order_acquire) == 0;
+    });
+}
+
+bool BatchHandle::waitFor(const std::chrono::milliseconds& timeout) const {
+    if (!state_ || state_->remaining.load(std::memory_order_acquire) == 0) {
+        return true;
+    }
+    
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    return state_->done.wait_for(lock, timeout, [this] {
+        return state_->remaining.load(std::memory_order_acquire) == 0;
+    });
+}
+
+bool BatchHandle::isDone() const {
+    return !state_ || state_->remaining.load(std::memory_order_acquire) == 0;
+}
+
+size_t BatchHandle::size() const {
+    return state_ ? state_->total : 0;
+}
+
+size_t BatchHandle::pending() const {
+    return state_ ? state_->remaining.load() : 0;
+}
+
+size_t BatchHandle::failedCount() const {
+    return state_ ? state_->failed.load() : 0;
+}
+
+size_t BatchHandle::droppedCount() const {
+    return state_ ? state_->dropped.load() : 0;
+}
+
+void BatchHandle::get() const {
+    wait();
+    if (!state_) {
+        return;
+    }
+    
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        error = state_->first_error;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// 工作线程本地队列：每个优先级一个双端队列
+// 所有者从尾部取（后进先出，缓存友好），窃取者从头部取（最早提交的任务）
+struct ThreadPool::WorkerQueue {
+    std::mutex mutex;
+    std::deque<Task> tasks[kPriorityLevels];
+    std::atomic<size_t> size{0};
+};
+
 // 线程池实现
 ThreadPool::ThreadPool(size_t thread_count) 
-    : stop_(false), force_stop_(false), active_threads_(0), task_counter_(0) {
+    : ThreadPool([thread_count] {
+          ThreadPoolConfig config;
+          config.thread_count = thread_count;
+          return config;
+      }()) {}
+
+ThreadPool::ThreadPool(const ThreadPoolConfig& config) 
+    : registry_(std::make_unique<TaskRegistry>(config.task_history_capacity,
+                                               config.task_history_retention)),
+      config_(config), next_queue_(0), sleeping_threads_(0), worker_count_(0),
+      stop_(false), force_stop_(false), active_threads_(0), task_counter_(0),
+      queue_wait_(MetricsRegistry::getInstance().createHistogram(metric_names::kThreadPoolQueueWait)),
+      run_time_(MetricsRegistry::getInstance().createHistogram(metric_names::kThreadPoolRunTime)) {
+    
+    size_t thread_count = std::max<size_t>(config_.thread_count, 1);
+    if (config_.max_threads == 0) {
+        config_.max_threads = std::max<size_t>(thread_count, std::thread::hardware_concurrency());
+    }
+    if (config_.scheduling_mode == SchedulingMode::WORK_STEALING) {
+        thread_count = std::min(thread_count, config_.max_threads);
+    }
+    
+    AutoScalePolicy& policy = config_.auto_scale;
+    if (policy.max_threads == 0 || 
+        (config_.scheduling_mode == SchedulingMode::WORK_STEALING && policy.max_threads > config_.max_threads)) {
+        policy.max_threads = config_.max_threads;
+    }
+    policy.min_threads = std::min(std::max<size_t>(policy.min_threads, 1), policy.max_threads);
+    
+    for (auto& counter : pending_by_priority_) {
+        counter.store(0);
+    }
     
     stats_.thread_count = thread_count;
     stats_.active_threads = 0;
@@ -21,10 +285,32 @@ ThreadPool::ThreadPool(size_t thread_count)
     stats_.average_task_duration_ms = 0.0;
     stats_.start_time = std::chrono::system_clock::now();
     
+    if (config_.scheduling_mode == SchedulingMode::SHARED_QUEUE && 
+        config_.queue_backend == QueueBackend::RING_BUFFER) {
+        ring_queue_ = std::make_unique<PriorityRingQueue<Task, kPriorityLevels>>(
+            std::max<size_t>(config_.ring_capacity, 2), config_.overflow_policy);
+    }
+    
+    // 工作窃取模式下一次性分配全部本地队列，避免运行期间扩容与窃取者竞争
+    if (config_.scheduling_mode == SchedulingMode::WORK_STEALING) {
+        worker_queues_.reserve(config_.max_threads);
+        for (size_t i = 0; i < config_.max_threads; ++i) {
+            worker_queues_.push_back(std::make_unique<WorkerQueue>());
+        }
+    }
+    
+    buildPlacement();
+    
     // 创建工作线程
+    worker_count_.store(thread_count);
     workers_.reserve(thread_count);
     for (size_t i = 0; i < thread_count; ++i) {
-        workers_.emplace_back(&ThreadPool::workerThread, this);
+        retire_flags_.push_back(std::make_shared<std::atomic<bool>>(false));
+        workers_.emplace_back(&ThreadPool::workerThread, this, i, retire_flags_.back());
+    }
+    
+    if (policy.enabled) {
+        scaler_ = std::thread(&ThreadPool::autoScaleThread, this);
     }
 }
 
@@ -32,21 +318,481 @@ ThreadPool::~ThreadPool() {
     shutdown();
 }
 
-void ThreadPool::workerThread() {
+void ThreadPool::buildPlacement() {
+    if (config_.affinity == CpuAffinityMode::NONE) {
+        return;
+    }
+    
+    // 按节点顺序整理可用CPU，cpu_list不为空时只保留其中的CPU
+    std::vector<std::vector<uint32_t>> nodes;
+    for (auto& node : platform::ThreadUtils::getNumaNodes()) {
+        std::vector<uint32_t> cpus;
+        for (uint32_t cpu : node) {
+            if (config_.cpu_list.empty() || 
+                std::find(config_.cpu_list.begin(), config_.cpu_list.end(), cpu) != config_.cpu_list.end()) {
+                cpus.push_back(cpu);
+            }
+        }
+        if (!cpus.empty()) {
+            nodes.push_back(std::move(cpus));
+        }
+    }
+    if (nodes.empty()) {
+        // cpu_list与系统拓扑不符时按单个节点处理
+        if (config_.cpu_list.empty()) {
+            return;
+        }
+        nodes.push_back(config_.cpu_list);
+    }
+    
+    std::vector<std::pair<uint32_t, size_t>> ordered;   // (CPU, 节点)，同一节点的CPU相邻
+    for (size_t n = 0; n < nodes.size(); ++n) {
+        for (uint32_t cpu : nodes[n]) {
+            ordered.emplace_back(cpu, n);
+            cpu_node_[cpu] = n;
+        }
+    }
+    
+    size_t placement_count = std::max(config_.max_threads, std::max<size_t>(config_.thread_count, 1));
+    placement_.resize(placement_count);
+    for (size_t i = 0; i < placement_count; ++i) {
+        WorkerPlacement& placement = placement_[i];
+        if (config_.affinity == CpuAffinityMode::PER_CORE) {
+            placement.node = ordered[i % ordered.size()].second;
+            placement.cpus.assign(1, ordered[i % ordered.size()].first);
+        } else {
+            placement.node = i % nodes.size();
+            placement.cpus = nodes[placement.node];
+        }
+    }
+    
+    // 工作窃取模式：多节点时先窃取同节点的队列，减少跨节点访问
+    if (config_.scheduling_mode != SchedulingMode::WORK_STEALING || nodes.size() < 2) {
+        return;
+    }
+    
+    const size_t queue_count = worker_queues_.size();
+    node_queues_.resize(nodes.size());
+    for (size_t q = 0; q < queue_count; ++q) {
+        node_queues_[placement_[q].node].push_back(q);
+    }
+    
+    steal_order_.resize(queue_count);
+    for (size_t q = 0; q < queue_count; ++q) {
+        auto& order = steal_order_[q];
+        order.reserve(queue_count - 1);
+        for (bool same_node : {true, false}) {
+            for (size_t offset = 1; offset < queue_count; ++offset) {
+                size_t victim = (q + offset) % queue_count;
+                if ((placement_[victim].node == placement_[q].node) == same_node) {
+                    order.push_back(victim);
+                }
+            }
+        }
+    }
+}
+
+void ThreadPool::applyPlacement(size_t worker_index) {
+    if (!placement_.empty()) {
+        platform::ThreadUtils::setCurrentThreadAffinity(placement_[worker_index % placement_.size()].cpus);
+    }
+    if (config_.qos) {
+        platform::ThreadUtils::setCurrentThreadQoS(*config_.qos);
+    }
+}
+
+size_t ThreadPool::selectQueue() {
+    size_t worker_count = std::max<size_t>(worker_count_.load(), 1);
+    size_t ticket = next_queue_.fetch_add(1, std::memory_order_relaxed);
+    
+    if (!node_queues_.empty()) {
+        int cpu = platform::ThreadUtils::getCurrentCpu();
+        auto it = cpu >= 0 ? cpu_node_.find(static_cast<uint32_t>(cpu)) : cpu_node_.end();
+        if (it != cpu_node_.end()) {
+            const auto& queues = node_queues_[it->second];
+            if (!queues.empty()) {
+                size_t queue_index = queues[ticket % queues.size()];
+                if (queue_index < worker_count) {
+                    return queue_index;
+                }
+            }
+        }
+    }
+    return ticket % worker_count;
+}
+
+void ThreadPool::recordTask(uint64_t seq, const std::string& task_id, TaskPriority priority) {
+    registry_->record(seq, task_id, priority, std::chrono::system_clock::now());
+}
+
+void ThreadPool::addPending(const Task& task) {
+    size_t level = priorityIndex(task.priority);
+    in_flight_.add();
+    pending_by_priority_[level].fetch_add(1);
+    
+    // 计数增加后再检查停止标志：工作线程退出前先读stop_再读计数，
+    // 两边都是顺序一致的原子操作，要么这里看到停止，要么工作线程看到计数并继续取任务
+    if (stop_.load()) {
+        pending_by_priority_[level].fetch_sub(1);
+        in_flight_.done();
+        if (task.tracked) {
+            registry_->cancel(task.seq);
+        }
+        throw std::runtime_error("ThreadPool is shutting down");
+    }
+}
+
+void ThreadPool::enqueueTask(Task&& task) {
+    if (stop_.load()) {
+        if (task.tracked) {
+            registry_->cancel(task.seq);
+        }
+        throw std::runtime_error("ThreadPool is shutting down");
+    }
+    
+    task.enqueue_time = std::chrono::steady_clock::now();
+    if (Tracer::isEnabled()) {
+        task.trace_id = Tracer::nextId();
+    }
+    const uint64_t trace_id = task.trace_id;
+    const auto enqueue_time = task.enqueue_time;
+    
+    if (ring_queue_) {
+        // 无锁入队：先增加计数，被拒绝时回滚
+        size_t level = priorityIndex(task.priority);
+        addPending(task);
+        if (!ring_queue_->push(level, std::move(task))) {
+            pending_by_priority_[level].fetch_sub(1);
+            in_flight_.done();
+            if (task.tracked) {
+                registry_->cancel(task.seq);
+            }
+            throw std::runtime_error("ThreadPool task queue is full");
+        }
+        traceQueued(trace_id, enqueue_time);
+        
+        if (sleeping_threads_.load() > 0) {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            condition_.notify_one();
+        }
+        return;
+    }
+    
+    if (config_.scheduling_mode == SchedulingMode::SHARED_QUEUE) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            
+            if (stop_.load()) {
+                if (task.tracked) {
+                    registry_->cancel(task.seq);
+                }
+                throw std::runtime_error("ThreadPool is shutting down");
+            }
+            
+            in_flight_.add();
+            pending_by_priority_[priorityIndex(task.priority)].fetch_add(1);
+            traceQueued(trace_id, enqueue_time);
+            tasks_.push(std::move(task));
+        }
+        
+        condition_.notify_one();
+        return;
+    }
+    
+    // 工作线程内部提交的任务进入自己的本地队列，外部提交的任务轮询分发
+    size_t queue_index;
+    if (t_current_pool == this) {
+        queue_index = t_worker_index;
+    } else {
+        queue_index = selectQueue();
+    }
+    
+    // 先增加计数再入队，保证计数始终不小于队列中的实际任务数
+    size_t level = priorityIndex(task.priority);
+    addPending(task);
+    {
+        WorkerQueue& queue = *worker_queues_[queue_index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        traceQueued(trace_id, enqueue_time);
+        queue.tasks[level].push_back(std::move(task));
+        queue.size.fetch_add(1);
+    }
+    
+    // 只有存在休眠线程时才需要获取锁唤醒，避免提交路径上的全局锁竞争
+    if (sleeping_threads_.load() > 0) {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        condition_.notify_one();
+    }
+}
+
+void ThreadPool::addPendingBatch(const std::vector<Task>& tasks) {
+    in_flight_.add(tasks.size());
+    for (const auto& task : tasks) {
+        pending_by_priority_[priorityIndex(task.priority)].fetch_add(1);
+    }
+    
+    // 计数增加后再检查停止标志，见addPending
+    if (stop_.load()) {
+        for (const auto& task : tasks) {
+            pending_by_priority_[priorityIndex(task.priority)].fetch_sub(1);
+        }
+        in_flight_.done(tasks.size());
+        throw std::runtime_error("ThreadPool is shutting down");
+    }
+}
+
+void ThreadPool::enqueueBatch(std::vector<Task>& tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+    
+    if (stop_.load()) {
+        throw std::runtime_error("ThreadPool is shutting down");
+    }
+    
+    auto enqueue_time = std::chrono::steady_clock::now();
+    const bool tracing = Tracer::isEnabled();
+    for (auto& task : tasks) {
+        task.enqueue_time = enqueue_time;
+        if (tracing) {
+            task.trace_id = Tracer::nextId();
+        }
+    }
+    
+    if (ring_queue_) {
+        // REJECT策略下放不下的子任务随tasks一起销毁，计入批量句柄的丢弃数
+        size_t accepted = 0;
+        addPendingBatch(tasks);
+        for (auto& task : tasks) {
+            size_t level = priorityIndex(task.priority);
+            const uint64_t trace_id = task.trace_id;
+            if (ring_queue_->push(level, std::move(task))) {
+                ++accepted;
+                traceQueued(trace_id, enqueue_time);
+            } else {
+                pending_by_priority_[level].fetch_sub(1);
+            }
+        }
+        size_t rejected = tasks.size() - accepted;
+        tasks.clear();
+        if (rejected > 0) {
+            in_flight_.done(rejected);
+        }
+        
+        if (accepted > 0 && sleeping_threads_.load() > 0) {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            condition_.notify_all();
+        }
+        return;
+    }
+    
+    if (config_.scheduling_mode == SchedulingMode::SHARED_QUEUE) {
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            
+            if (stop_.load()) {
+                throw std::runtime_error("ThreadPool is shutting down");
+            }
+            
+            in_flight_.add(tasks.size());
+            for (auto& task : tasks) {
+                pending_by_priority_[priorityIndex(task.priority)].fetch_add(1);
+                traceQueued(task.trace_id, enqueue_time);
+                tasks_.push(std::move(task));
+            }
+        }
+        
+        if (tasks.size() == 1) {
+            condition_.notify_one();
+        } else {
+            condition_.notify_all();
+        }
+        tasks.clear();
+        return;
+    }
+    
+    // 先增加计数再入队，与enqueueTask保持一致
+    addPendingBatch(tasks);
+    
+    if (t_current_pool == this) {
+        // 工作线程内部提交的批量任务放入本地队列，由空闲线程窃取
+        WorkerQueue& queue = *worker_queues_[t_worker_index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (auto& task : tasks) {
+            traceQueued(task.trace_id, enqueue_time);
+            queue.tasks[priorityIndex(task.priority)].push_back(std::move(task));
+        }
+        queue.size.fetch_add(tasks.size());
+    } else {
+        // 外部提交的批量任务切成连续片段分发到各个本地队列
+        size_t queue_count = std::max<size_t>(worker_count_.load(), 1);
+        size_t first_queue = next_queue_.fetch_add(1, std::memory_order_relaxed);
+        size_t per_queue = (tasks.size() + queue_count - 1) / queue_count;
+        
+        for (size_t offset = 0, q = 0; offset < tasks.size(); offset += per_queue, ++q) {
+            size_t chunk_end = std::min(offset + per_queue, tasks.size());
+            WorkerQueue& queue = *worker_queues_[(first_queue + q) % queue_count];
+            
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            for (size_t i = offset; i < chunk_end; ++i) {
+                traceQueued(tasks[i].trace_id, enqueue_time);
+                queue.tasks[priorityIndex(tasks[i].priority)].push_back(std::move(tasks[i]));
+            }
+            queue.size.fetch_add(chunk_end - offset);
+        }
+    }
+    tasks.clear();
+    
+    if (sleeping_threads_.load() > 0) {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        condition_.notify_all();
+    }
+}
+
+bool ThreadPool::hasPendingWork() const {
+    for (const auto& counter : pending_by_priority_) {
+        if (counter.load() > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::tryPopTask(size_t worker_index, Task& task) {
+    if (ring_queue_) {
+        for (size_t level = kPriorityLevels; level-- > 0;) {
+            if (pending_by_priority_[level].load() > 0 && ring_queue_->tryPop(level, task)) {
+                active_threads_.fetch_add(1);
+                pending_by_priority_[level].fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    const size_t queue_count = worker_queues_.size();
+    
+    // 从最高优先级开始逐级查找，保证CRITICAL任务先于LOW任务执行
+    for (size_t level = kPriorityLevels; level-- > 0;) {
+        if (pending_by_priority_[level].load() == 0) {
+            continue;
+        }
+        
+        // 先查本地队列（尾部）
+        {
+            WorkerQueue& own = *worker_queues_[worker_index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            auto& deque = own.tasks[level];
+            if (!deque.empty()) {
+                task = std::move(deque.back());
+                deque.pop_back();
+                own.size.fetch_sub(1);
+                active_threads_.fetch_add(1);
+                pending_by_priority_[level].fetch_sub(1);
+                return true;
+            }
+        }
+        
+        // 再从其他线程的队列头部窃取，配置了NUMA分组时同节点优先
+        const std::vector<size_t>* order = steal_order_.empty() ? nullptr : &steal_order_[worker_index];
+        for (size_t offset = 1; offset < queue_count; ++offset) {
+            size_t victim_index = order ? (*order)[offset - 1] : (worker_index + offset) % queue_count;
+            WorkerQueue& victim = *worker_queues_[victim_index];
+            if (victim.size.load() == 0) {
+                continue;
+            }
+            
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            auto& deque = victim.tasks[level];
+            if (!deque.empty()) {
+                task = std::move(deque.front());
+                deque.pop_front();
+                victim.size.fetch_sub(1);
+                active_threads_.fetch_add(1);
+                pending_by_priority_[level].fetch_sub(1);
+                return true;
+            }
+        }
+    }
+    
+    return false;
+}
+
+bool ThreadPool::spinForWork(const std::atomic<bool>& retiring) const {
+    if (config_.idle_spin.count() <= 0) {
+        return false;
+    }
+    
+    auto deadline = std::chrono::steady_clock::now() + config_.idle_spin;
+    do {
+        for (int i = 0; i < 64; ++i) {
+            if (hasPendingWork() || stop_.load(std::memory_order_relaxed) || 
+                force_stop_.load(std::memory_order_relaxed) || retiring.load()) {
+                return true;
+            }
+            cpuRelax();
+        }
+    } while (std::chrono::steady_clock::now() < deadline);
+    
+    return false;
+}
+
+void ThreadPool::workerThread(size_t worker_index, std::shared_ptr<std::atomic<bool>> retiring_flag) {
     // 设置线程名称
     std::ostringstream oss;
     oss << "ThreadPool-" << std::this_thread::get_id();
     platform::ThreadUtils::setCurrentThreadName(oss.str());
+    applyPlacement(worker_index);
+    
+    t_current_pool = this;
+    t_worker_index = worker_index;
+    const std::atomic<bool>& retiring = *retiring_flag;
+    
+    // 工作窃取与环形队列模式无锁取任务，只在休眠时使用queue_mutex_
+    const bool lock_free_pop = ring_queue_ || config_.scheduling_mode == SchedulingMode::WORK_STEALING;
     
     while (true) {
         Task task;
         
-        {
+        // 收缩时被回收的线程退出，本地队列中剩余的任务由其他线程窃取
+        if (force_stop_.load() || retiring.load()) {
+            break;
+        }
+        
+        if (lock_free_pop) {
+            if (!tryPopTask(worker_index, task)) {
+                if (spinForWork(retiring)) {
+                    if (stop_.load() && !hasPendingWork()) {
+                        break;
+                    }
+                    continue;
+                }
+                
+                std::unique_lock<std::mutex> lock(queue_mutex_);
+                
+                // 先登记为休眠再检查任务，与提交方的计数形成对称，避免丢失唤醒
+                sleeping_threads_.fetch_add(1);
+                condition_.wait(lock, [this, &retiring] {
+                    return hasPendingWork() || stop_.load() || force_stop_.load() || retiring.load();
+                });
+                sleeping_threads_.fetch_sub(1);
+                
+                if ((stop_.load() && !hasPendingWork()) || force_stop_.load()) {
+                    break;
+                }
+                continue;
+            }
+        } else {
+            // 队列为空时先自旋等待，仍无任务再休眠
+            if (!hasPendingWork()) {
+                spinForWork(retiring);
+            }
+            
             std::unique_lock<std::mutex> lock(queue_mutex_);
             
             // 等待任务或停止信号
-            condition_.wait(lock, [this] {
-                return !tasks_.empty() || stop_.load() || force_stop_.load();
+            condition_.wait(lock, [this, &retiring] {
+                return !tasks_.empty() || stop_.load() || force_stop_.load() || retiring.load();
             });
             
             // 检查是否需要停止
@@ -56,133 +802,257 @@ void ThreadPool::workerThread() {
             
             // 获取任务
             if (!tasks_.empty()) {
-                task = tasks_.top();
+                // top()只提供const引用，任务在pop()前移出，避免拷贝
+                task = std::move(const_cast<Task&>(tasks_.top()));
                 tasks_.pop();
                 active_threads_.fetch_add(1);
+                pending_by_priority_[priorityIndex(task.priority)].fetch_sub(1);
             } else {
                 continue;
             }
         }
         
-        // 执行任务
-        if (task.function) {
-            task.info->status = TaskStatus::RUNNING;
-            task.info->start_time = std::chrono::system_clock::now();
+        auto dequeue_time = std::chrono::steady_clock::now();
+        queue_wait_->record(dequeue_time - task.enqueue_time);
+        if (task.trace_id != 0) {
+            Tracer::recordAsyncEnd("thread_pool", "task.queue", task.trace_id, Tracer::toNanos(dequeue_time));
+        }
+        
+        // 执行任务：submit()提交的任务在runTracked中自行维护记录与统计
+        if (task.tracked) {
+            SDK_TRACE_SPAN("thread_pool", "task.run");
+            task.function();
+        } else if (task.function) {
+            SDK_TRACE_SPAN("thread_pool", "task.run");
+            TaskStatus status = TaskStatus::COMPLETED;
+            auto start_time = std::chrono::system_clock::now();
             
             try {
                 task.function();
-                task.info->status = TaskStatus::COMPLETED;
-            } catch (const std::exception& e) {
-                task.info->status = TaskStatus::FAILED;
-                task.info->error_message = e.what();
             } catch (...) {
-                task.info->status = TaskStatus::FAILED;
-                task.info->error_message = "Unknown exception";
+                status = TaskStatus::FAILED;
             }
             
-            task.info->end_time = std::chrono::system_clock::now();
-            
             // 更新统计信息
-            updateStats(*task.info);
+            updateStats(status, start_time, std::chrono::system_clock::now());
         }
         
+        // 任务结束后才减少在途计数，等待者被唤醒时任务的记录与统计均已更新
         active_threads_.fetch_sub(1);
+        in_flight_.done();
     }
+    
+    t_current_pool = nullptr;
 }
 
-std::string ThreadPool::generateTaskId() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<uint64_t> dis;
-    
-    uint64_t id = dis(gen);
-    std::ostringstream oss;
-    oss << "task_" << id;
-    return oss.str();
+bool ThreadPool::beginTrackedTask(uint64_t seq, std::chrono::system_clock::time_point start_time) {
+    return registry_->markRunning(seq, start_time);
 }
 
-void ThreadPool::updateStats(const TaskInfo& info) {
-    std::lock_guard<std::mutex> lock(stats_mutex_);
-    
-    if (info.status == TaskStatus::COMPLETED) {
-        stats_.completed_tasks++;
-    } else if (info.status == TaskStatus::FAILED) {
-        stats_.failed_tasks++;
+void ThreadPool::finishTrackedTask(uint64_t seq, TaskStatus status,
+                                   std::chrono::system_clock::time_point start_time,
+                                   std::chrono::system_clock::time_point end_time,
+                                   const std::string& error_message) {
+    registry_->markFinished(seq, status, end_time, 
+                            error_message.empty() ? nullptr : error_message.c_str());
+    updateStats(status, start_time, end_time);
+}
+
+TimerId ThreadPool::addTimer(std::chrono::milliseconds delay, std::chrono::milliseconds period,
+                             TaskFunction action) {
+    TimerWheel* timers = timerWheel(true);
+    TimerId timer_id = timers ? timers->add(delay, period, std::move(action)) : 0;
+    if (timer_id == 0) {
+        throw std::runtime_error("ThreadPool is shutting down");
     }
-    
-    // 计算平均执行时间
-    if (info.end_time > info.start_time) {
-        auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            info.end_time - info.start_time).count();
-        
-        double total_duration = stats_.average_task_duration_ms * (stats_.completed_tasks + stats_.failed_tasks - 1);
-        stats_.average_task_duration_ms = (total_duration + duration) / (stats_.completed_tasks + stats_.failed_tasks);
+    return timer_id;
+}
+
+bool ThreadPool::cancelTimer(TimerId timer_id) {
+    TimerWheel* timers = timerWheel(false);
+    return timers && timers->cancel(timer_id);
+}
+
+TimerWheel* ThreadPool::timerWheel(bool create) {
+    // 时间轮创建后直到线程池析构都不会释放，返回的指针可以在锁外使用
+    std::lock_guard<std::mutex> lock(timers_mutex_);
+    if (!timers_ && create && !stop_.load() && !force_stop_.load()) {
+        timers_ = std::make_unique<TimerWheel>();
+    }
+    return timers_.get();
+}
+
+uint64_t ThreadPool::nextTaskSeq() {
+    return task_counter_.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+std::string ThreadPool::generateTaskId(uint64_t seq) {
+    // 短字符串优化范围内无需堆分配
+    return "task_" + std::to_string(seq);
+}
+
+void ThreadPool::updateStats(TaskStatus status, 
+                             std::chrono::system_clock::time_point start_time,
+                             std::chrono::system_clock::time_point end_time) {
+    if (status == TaskStatus::COMPLETED) {
+        completed_tasks_.add();
+    } else if (status == TaskStatus::FAILED) {
+        failed_tasks_.add();
     }
+    
+    run_time_->record(end_time > start_time ? end_time - start_time : std::chrono::system_clock::duration::zero());
 }
 
 void ThreadPool::waitForAll() {
-    std::unique_lock<std::mutex> lock(queue_mutex_);
-    condition_.wait(lock, [this] {
-        return tasks_.empty() && active_threads_.load() == 0;
-    });
+    // 等待者只在在途计数归零时被唤醒，不与工作线程共用条件变量
+    in_flight_.wait();
 }
 
 bool ThreadPool::waitFor(const std::chrono::milliseconds& timeout) {
-    std::unique_lock<std::mutex> lock(queue_mutex_);
-    return condition_.wait_for(lock, timeout, [this] {
-        return tasks_.empty() && active_threads_.load() == 0;
-    });
+    return in_flight_.waitFor(timeout);
 }
 
 void ThreadPool::cancelPendingTasks() {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
+    // 任务在锁外销毁：析构时可能交付broken_promise并触发延续，延续会再次提交任务
+    std::vector<Task> cancelled;
+    
+    // 工作窃取模式：逐个清空本地队列
+    for (auto& queue : worker_queues_) {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        for (size_t level = 0; level < kPriorityLevels; ++level) {
+            for (auto& task : queue->tasks[level]) {
+                if (task.tracked) {
+                    registry_->cancel(task.seq);
+                }
+                cancelled.push_back(std::move(task));
+            }
+            queue->size.fetch_sub(queue->tasks[level].size());
+            pending_by_priority_[level].fetch_sub(queue->tasks[level].size());
+            queue->tasks[level].clear();
+        }
+    }
+    
+    if (ring_queue_) {
+        Task task;
+        while (ring_queue_->tryPop(task)) {
+            if (task.tracked) {
+                registry_->cancel(task.seq);
+            }
+            pending_by_priority_[priorityIndex(task.priority)].fetch_sub(1);
+            cancelled.push_back(std::move(task));
+        }
+    }
     
-    // 将所有待处理任务标记为取消
-    std::priority_queue<Task> empty_queue;
-    while (!tasks_.empty()) {
-        Task task = tasks_.top();
-        tasks_.pop();
-        task.info->status = TaskStatus::CANCELLED;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        
+        // 将所有待处理任务标记为取消
+        while (!tasks_.empty()) {
+            Task& task = const_cast<Task&>(tasks_.top());
+            if (task.tracked) {
+                registry_->cancel(task.seq);
+            }
+            pending_by_priority_[priorityIndex(task.priority)].fetch_sub(1);
+            cancelled.push_back(std::move(task));
+            tasks_.pop();
+        }
     }
     
-    tasks_.swap(empty_queue);
+    size_t count = cancelled.size();
+    cancelled.clear();
+    in_flight_.done(count);
 }
 
 bool ThreadPool::cancelTask(const std::string& task_id) {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    
-    auto it = task_infos_.find(task_id);
-    if (it != task_infos_.end() && it->second->status == TaskStatus::PENDING) {
-        it->second->status = TaskStatus::CANCELLED;
-        return true;
-    }
-    
-    return false;
+    // 只修改记录状态，任务仍留在队列中，由工作线程取出时跳过
+    uint64_t seq = registry_->findByName(task_id);
+    return seq != 0 && registry_->cancel(seq);
 }
 
 void ThreadPool::resize(size_t new_size) {
-    if (new_size == workers_.size()) {
-        return;
-    }
-    
-    if (new_size > workers_.size()) {
-        // 增加线程
+    std::vector<std::thread> retired;
+    {
+        std::lock_guard<std::mutex> resize_lock(resize_mutex_);
+        
+        if (stop_.load() || force_stop_.load()) {
+            return;
+        }
+        
+        // 至少保留一个线程；工作窃取模式下线程数不能超过预分配的本地队列数量
+        new_size = std::max<size_t>(new_size, 1);
+        if (config_.scheduling_mode == SchedulingMode::WORK_STEALING) {
+            new_size = std::min(new_size, config_.max_threads);
+        }
+        
         size_t old_size = workers_.size();
-        workers_.reserve(new_size);
-        for (size_t i = old_size; i < new_size; ++i) {
-            workers_.emplace_back(&ThreadPool::workerThread, this);
+        if (new_size == old_size) {
+            return;
         }
-    } else {
-        // 减少线程（通过设置停止标志，让多余的线程自然退出）
-        // 这里简化实现，实际项目中需要更精细的控制
+        
+        if (new_size > old_size) {
+            // 新线程使用新的退出标志，仍在退出中的旧线程即使编号相同也不会被重新启用
+            worker_count_.store(new_size);
+            workers_.reserve(new_size);
+            for (size_t i = old_size; i < new_size; ++i) {
+                retire_flags_.push_back(std::make_shared<std::atomic<bool>>(false));
+                workers_.emplace_back(&ThreadPool::workerThread, this, i, retire_flags_.back());
+            }
+        } else {
+            // 编号最大的线程完成当前任务后退出
+            retired.assign(std::make_move_iterator(workers_.begin() + new_size),
+                           std::make_move_iterator(workers_.end()));
+            workers_.resize(new_size);
+            
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex_);
+                for (size_t i = new_size; i < retire_flags_.size(); ++i) {
+                    retire_flags_[i]->store(true);
+                }
+                worker_count_.store(new_size);
+            }
+            retire_flags_.resize(new_size);
+            condition_.notify_all();
+            
+            // 之前在自身任务中收缩而未能join的线程一并回收
+            for (auto& worker : retired_workers_) {
+                retired.push_back(std::move(worker));
+            }
+            retired_workers_.clear();
+        }
+        
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.thread_count = new_size;
     }
     
-    std::lock_guard<std::mutex> lock(stats_mutex_);
-    stats_.thread_count = workers_.size();
+    // 在锁外等待退出，被回收的线程仍可在当前任务中调用resize
+    joinWorkers(retired);
+    if (!retired.empty()) {
+        std::lock_guard<std::mutex> resize_lock(resize_mutex_);
+        for (auto& worker : retired) {
+            retired_workers_.push_back(std::move(worker));
+        }
+    }
+}
+
+void ThreadPool::joinWorkers(std::vector<std::thread>& threads) {
+    // 线程在自身任务中收缩线程池时不能join自己，保留在threads中留待之后回收
+    std::vector<std::thread> deferred;
+    for (auto& worker : threads) {
+        if (!worker.joinable()) {
+            continue;
+        }
+        
+        if (worker.get_id() == std::this_thread::get_id()) {
+            deferred.push_back(std::move(worker));
+        } else {
+            worker.join();
+        }
+    }
+    threads.swap(deferred);
 }
 
 size_t ThreadPool::size() const {
-    return workers_.size();
+    return worker_count_.load();
 }
 
 size_t ThreadPool::activeThreads() const {
@@ -190,34 +1060,43 @@ size_t ThreadPool::activeThreads() const {
 }
 
 size_t ThreadPool::pendingTasks() const {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    return tasks_.size();
+    size_t pending = 0;
+    for (const auto& counter : pending_by_priority_) {
+        pending += counter.load();
+    }
+    return pending;
+}
+
+SchedulingMode ThreadPool::schedulingMode() const {
+    return config_.scheduling_mode;
 }
 
 ThreadPoolStats ThreadPool::getStats() const {
-    std::lock_guard<std::mutex> lock(stats_mutex_);
-    ThreadPoolStats stats = stats_;
-    stats.active_threads = active_threads_.load();
-    
+    ThreadPoolStats stats;
     {
-        std::lock_guard<std::mutex> queue_lock(queue_mutex_);
-        stats.pending_tasks = tasks_.size();
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats = stats_;
     }
+    stats.active_threads = active_threads_.load();
+    stats.pending_tasks = pendingTasks();
+    stats.completed_tasks = completed_tasks_.value();
+    stats.failed_tasks = failed_tasks_.value();
+    
+    HistogramSnapshot run_time = run_time_->snapshot();
+    stats.average_task_duration_ms = run_time.mean() / 1000.0;
+    stats.run_time = run_time.summary();
+    stats.queue_wait = queue_wait_->snapshot().summary();
     
     return stats;
 }
 
 std::vector<TaskInfo> ThreadPool::getTaskInfos() const {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    
-    std::vector<TaskInfo> infos;
-    infos.reserve(task_infos_.size());
-    
-    for (const auto& pair : task_infos_) {
-        infos.push_back(*pair.second);
-    }
-    
-    return infos;
+    return registry_->snapshot();
+}
+
+bool ThreadPool::getTaskInfo(const std::string& task_id, TaskInfo& info) const {
+    uint64_t seq = registry_->findByName(task_id);
+    return seq != 0 && registry_->get(seq, info);
 }
 
 bool ThreadPool::isShuttingDown() const {
@@ -231,31 +1110,111 @@ void ThreadPool::shutdown() {
     }
     
     condition_.notify_all();
-    
-    for (auto& worker : workers_) {
-        if (worker.joinable()) {
-            worker.join();
-        }
-    }
-    
-    workers_.clear();
+    joinAllWorkers();
 }
 
 void ThreadPool::forceShutdown() {
     {
         std::lock_guard<std::mutex> lock(queue_mutex_);
+        stop_.store(true);
         force_stop_.store(true);
     }
     
     condition_.notify_all();
+    joinAllWorkers();
+    
+    // 丢弃未执行的任务，等待中的waitForAll随之返回；
+    // 停止前已通过检查的提交可能在清空后才入队，计数归零前反复清空
+    cancelPendingTasks();
+    while (hasPendingWork()) {
+        std::this_thread::yield();
+        cancelPendingTasks();
+    }
+}
+
+void ThreadPool::joinAllWorkers() {
+    // 先停止定时线程，未触发的定时器直接丢弃
+    if (TimerWheel* timers = timerWheel(false)) {
+        timers->stop();
+    }
+    
+    // 再停止自动伸缩线程，避免回收过程中再次扩容
+    {
+        std::lock_guard<std::mutex> lock(scaler_mutex_);
+    }
+    scaler_condition_.notify_all();
+    if (scaler_.joinable() && scaler_.get_id() != std::this_thread::get_id()) {
+        scaler_.join();
+    }
+    
+    std::vector<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> resize_lock(resize_mutex_);
+        threads.swap(workers_);
+        for (auto& worker : retired_workers_) {
+            threads.push_back(std::move(worker));
+        }
+        retired_workers_.clear();
+    }
     
-    for (auto& worker : workers_) {
+    for (auto& worker : threads) {
         if (worker.joinable()) {
             worker.join();
         }
     }
     
-    workers_.clear();
+    worker_count_.store(0);
+}
+
+void ThreadPool::autoScaleThread() {
+    const AutoScalePolicy& policy = config_.auto_scale;
+    auto idle_since = std::chrono::steady_clock::time_point();
+    
+    std::unique_lock<std::mutex> lock(scaler_mutex_);
+    while (!scaler_condition_.wait_for(lock, policy.check_interval, [this] {
+        return stop_.load() || force_stop_.load();
+    })) {
+        lock.unlock();
+        autoScaleOnce(idle_since);
+        lock.lock();
+    }
+}
+
+void ThreadPool::autoScaleOnce(std::chrono::steady_clock::time_point& idle_since) {
+    const AutoScalePolicy& policy = config_.auto_scale;
+    const size_t current = std::max<size_t>(worker_count_.load(), 1);
+    const size_t pending = pendingTasks();
+    const size_t active = active_threads_.load();
+    
+    double average_ms = run_time_->meanMicros() / 1000.0;
+    
+    // 积压过深或预计排队时间过长时扩容，每次最多增加一半
+    double expected_delay_ms = average_ms * static_cast<double>(pending) / static_cast<double>(current);
+    bool overloaded = pending > current * policy.queue_depth_per_thread ||
+                      (average_ms > 0.0 && expected_delay_ms > policy.max_queue_delay_ms);
+    
+    if (overloaded) {
+        idle_since = std::chrono::steady_clock::time_point();
+        if (current < policy.max_threads) {
+            resize(std::min(policy.max_threads, current + std::max<size_t>(current / 2, 1)));
+        }
+        return;
+    }
+    
+    // 队列为空且存在空闲线程持续超过idle_timeout时收缩，每次回收一半空闲线程
+    if (pending == 0 && active < current) {
+        auto now = std::chrono::steady_clock::now();
+        if (idle_since == std::chrono::steady_clock::time_point()) {
+            idle_since = now;
+        } else if (now - idle_since >= policy.idle_timeout && current > policy.min_threads) {
+            size_t idle = current - active;
+            resize(std::max(policy.min_threads, current - std::max<size_t>(idle / 2, 1)));
+            idle_since = now;
+        }
+        return;
+    }
+    
+    idle_since = std::chrono::steady_clock::time_point();
 }
 
 } // namespace sdk
@@ -264,11 +1223,50 @@ void ThreadPool::forceShutdown() {
 // C API实现
 // =============================================================================
 
-// 全局任务管理
-static std::unordered_map<sdk_task_id_t, std::shared_ptr<sdk::TaskInfo>> g_task_infos;
-static std::mutex g_task_infos_mutex;
+// 全局任务管理：任务状态直接查询线程池的任务记录表，数字ID以字符串形式登记
 static std::atomic<sdk_task_id_t> g_next_task_id{1};
 
+// submit_task_with_id提交的任务以调用方的字符串ID登记，这里记录数字ID到字符串ID的映射
+// 按数字ID取模覆盖，容量与线程池默认的任务记录容量一致，被覆盖的任务通常已从记录表淘汰
+namespace {
+
+class NamedTaskIds {
+public:
+    void add(sdk_task_id_t task_id, const char* name) {
+        Entry& entry = entries_[task_id % kCapacity];
+        std::lock_guard<std::mutex> lock(mutex_);
+        entry.task_id = task_id;
+        entry.name.assign(name);
+    }
+    
+    // 返回任务在线程池中登记的字符串ID
+    std::string nameOf(sdk_task_id_t task_id) const {
+        const Entry& entry = entries_[task_id % kCapacity];
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entry.task_id == task_id ? entry.name : std::to_string(task_id);
+    }
+    
+private:
+    static constexpr size_t kCapacity = 4096;
+    
+    struct Entry {
+        sdk_task_id_t task_id = 0;
+        std::string name;
+    };
+    
+    mutable std::mutex mutex_;
+    Entry entries_[kCapacity];
+};
+
+NamedTaskIds g_named_task_ids;
+
+} // namespace
+
+// 批量任务句柄
+struct sdk_task_batch {
+    sdk::BatchHandle handle;
+};
+
 // 任务包装器
 struct TaskWrapper {
     sdk_task_func_t func;
@@ -282,30 +1280,8 @@ struct TaskWrapper {
         }
         
         if (callback) {
-            // 获取任务状态
-            sdk_task_status_t status = SDK_TASK_STATUS_COMPLETED;
-            {
-                std::lock_guard<std::mutex> lock(g_task_infos_mutex);
-                auto it = g_task_infos.find(task_id);
-                if (it != g_task_infos.end()) {
-                    switch (it->second->status) {
-                        case sdk::TaskStatus::COMPLETED:
-                            status = SDK_TASK_STATUS_COMPLETED;
-                            break;
-                        case sdk::TaskStatus::FAILED:
-                            status = SDK_TASK_STATUS_FAILED;
-                            break;
-                        case sdk::TaskStatus::CANCELLED:
-                            status = SDK_TASK_STATUS_CANCELLED;
-                            break;
-                        default:
-                            status = SDK_TASK_STATUS_COMPLETED;
-                            break;
-                    }
-                }
-            }
-            
-            callback(task_id, status, user_data);
+            // C任务函数不会抛出异常，执行到这里即视为完成
+            callback(task_id, SDK_TASK_STATUS_COMPLETED, user_data);
         }
     }
 };
@@ -326,6 +1302,20 @@ static sdk::TaskPriority convertPriority(sdk_task_priority_t priority) {
     }
 }
 
+static bool lookupTaskInfo(sdk_task_id_t task_id, sdk::TaskInfo& info) {
+    auto& sdk_instance = sdk::SDK::getInstance();
+    if (!sdk_instance.isInitialized()) {
+        return false;
+    }
+    
+    auto thread_pool = sdk_instance.getThreadPool();
+    if (!thread_pool) {
+        return false;
+    }
+    
+    return thread_pool->getTaskInfo(g_named_task_ids.nameOf(task_id), info);
+}
+
 static sdk_task_status_t convertStatus(sdk::TaskStatus status) {
     switch (status) {
         case sdk::TaskStatus::PENDING:
@@ -410,6 +1400,7 @@ sdk_task_id_t sdk_thread_pool_submit_task_with_id(
         }
         
         sdk_task_id_t numeric_task_id = g_next_task_id.fetch_add(1);
+        g_named_task_ids.add(numeric_task_id, task_id);
         
         TaskWrapper wrapper;
         wrapper.func = func;
@@ -430,14 +1421,161 @@ sdk_task_id_t sdk_thread_pool_submit_task_with_id(
     }
 }
 
+sdk_timer_id_t sdk_thread_pool_schedule_task(
+    sdk_task_func_t func,
+    void* user_data,
+    uint32_t delay_ms,
+    uint32_t period_ms,
+    sdk_task_priority_t priority
+) {
+    if (!func) {
+        return 0;
+    }
+    
+    try {
+        auto& sdk_instance = sdk::SDK::getInstance();
+        if (!sdk_instance.isInitialized()) {
+            return 0;
+        }
+        
+        auto thread_pool = sdk_instance.getThreadPool();
+        if (!thread_pool) {
+            return 0;
+        }
+        
+        auto task = [func, user_data]() { func(user_data); };
+        if (period_ms > 0) {
+            return thread_pool->scheduleAtFixedRate(
+                std::chrono::milliseconds(period_ms), task, convertPriority(priority));
+        }
+        return thread_pool->schedule(
+            std::chrono::milliseconds(delay_ms), task, convertPriority(priority));
+        
+    } catch (...) {
+        return 0;
+    }
+}
+
+bool sdk_thread_pool_cancel_timer(sdk_timer_id_t timer_id) {
+    try {
+        auto& sdk_instance = sdk::SDK::getInstance();
+        if (!sdk_instance.isInitialized()) {
+            return false;
+        }
+        
+        auto thread_pool = sdk_instance.getThreadPool();
+        if (!thread_pool) {
+            return false;
+        }
+        
+        return thread_pool->cancelTimer(timer_id);
+    } catch (...) {
+        return false;
+    }
+}
+
+sdk_task_batch_t* sdk_thread_pool_submit_batch(
+    sdk_task_func_t func,
+    void* const* user_data_array,
+    uint32_t count,
+    sdk_task_priority_t priority
+) {
+    if (!func || (!user_data_array && count > 0)) {
+        return nullptr;
+    }
+    
+    try {
+        auto& sdk_instance = sdk::SDK::getInstance();
+        if (!sdk_instance.isInitialized()) {
+            return nullptr;
+        }
+        
+        auto thread_pool = sdk_instance.getThreadPool();
+        if (!thread_pool) {
+            return nullptr;
+        }
+        
+        auto batch = std::make_unique<sdk_task_batch>();
+        batch->handle = thread_pool->submitBatch(
+            user_data_array, user_data_array + count,
+            [func](void* user_data) { func(user_data); },
+            convertPriority(priority));
+        return batch.release();
+        
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+sdk_task_batch_t* sdk_thread_pool_parallel_for(
+    uint64_t begin,
+    uint64_t end,
+    uint64_t grain,
+    sdk_index_func_t func,
+    void* user_data,
+    sdk_task_priority_t priority
+) {
+    if (!func) {
+        return nullptr;
+    }
+    
+    try {
+        auto& sdk_instance = sdk::SDK::getInstance();
+        if (!sdk_instance.isInitialized()) {
+            return nullptr;
+        }
+        
+        auto thread_pool = sdk_instance.getThreadPool();
+        if (!thread_pool) {
+            return nullptr;
+        }
+        
+        auto batch = std::make_unique<sdk_task_batch>();
+        batch->handle = thread_pool->parallelFor(
+            begin, end, grain,
+            [func, user_data](uint64_t index) { func(index, user_data); },
+            convertPriority(priority));
+        return batch.release();
+        
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+bool sdk_task_batch_wait(sdk_task_batch_t* batch, uint32_t timeout_ms) {
+    if (!batch) {
+        return false;
+    }
+    
+    try {
+        if (timeout_ms == 0) {
+            batch->handle.wait();
+            return true;
+        }
+        return batch->handle.waitFor(std::chrono::milliseconds(timeout_ms));
+    } catch (...) {
+        return false;
+    }
+}
+
+uint32_t sdk_task_batch_pending(const sdk_task_batch_t* batch) {
+    if (!batch) {
+        return 0;
+    }
+    return static_cast<uint32_t>(batch->handle.pending());
+}
+
+void sdk_task_batch_release(sdk_task_batch_t* batch) {
+    delete batch;
+}
+
 sdk_task_status_t sdk_thread_pool_get_task_status(sdk_task_id_t task_id) {
     try {
-        std::lock_guard<std::mutex> lock(g_task_infos_mutex);
-        auto it = g_task_infos.find(task_id);
-        if (it != g_task_infos.end()) {
-            return convertStatus(it->second->status);
+        sdk::TaskInfo task_info;
+        if (lookupTaskInfo(task_id, task_info)) {
+            return convertStatus(task_info.status);
         }
-        return SDK_TASK_STATUS_PENDING;
+        return SDK_TASK_STATUS_UNKNOWN;
     } catch (...) {
         return SDK_TASK_STATUS_FAILED;
     }
@@ -449,10 +1587,8 @@ bool sdk_thread_pool_get_task_info(sdk_task_id_t task_id, sdk_task_info_t* info)
     }
     
     try {
-        std::lock_guard<std::mutex> lock(g_task_infos_mutex);
-        auto it = g_task_infos.find(task_id);
-        if (it != g_task_infos.end()) {
-            const auto& task_info = *it->second;
+        sdk::TaskInfo task_info;
+        if (lookupTaskInfo(task_id, task_info)) {
             
             std::strncpy(info->id, task_info.id.c_str(), sizeof(info->id) - 1);
             info->id[sizeof(info->id) - 1] = '\0';
@@ -490,7 +1626,7 @@ bool sdk_thread_pool_cancel_task(sdk_task_id_t task_id) {
             return false;
         }
         
-        return thread_pool->cancelTask(std::to_string(task_id));
+        return thread_pool->cancelTask(g_named_task_ids.nameOf(task_id));
     } catch (...) {
         return false;
     }
@@ -510,6 +1646,11 @@ bool sdk_thread_pool_wait_task(sdk_task_id_t task_id, uint32_t timeout_ms) {
                 return true;
             }
             
+            // 任务ID不存在或记录已被淘汰，继续等待不会有结果
+            if (status == SDK_TASK_STATUS_UNKNOWN) {
+                return false;
+            }
+            
             if (timeout_ms > 0) {
                 auto elapsed = std::chrono::steady_clock::now() - start_time;
                 if (elapsed >= timeout) {
@@ -0,0 +1,279 @@
+#include "timer_wheel.h"
+
+#include <algorithm>
+
+namespace sdk {
+
+namespace {
+
+constexpr uint64_t kNoWake = std::numeric_limits<uint64_t>::max();
+
+} // namespace
+
+TimerWheel::TimerWheel()
+    : epoch_(std::chrono::steady_clock::now()) {
+    thread_ = std::thread(&TimerWheel::run, this);
+}
+
+TimerWheel::~TimerWheel() {
+    stop();
+}
+
+uint64_t TimerWheel::currentTimeTick() const {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - epoch_).count());
+}
+
+uint64_t TimerWheel::add(std::chrono::milliseconds delay, std::chrono::milliseconds period,
+                         TaskFunction action) {
+    auto* node = new Node();
+    node->action = std::move(action);
+    node->period_ticks = period.count() > 0 ? static_cast<uint64_t>(period.count()) : 0;
+
+    bool wake = false;
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) {
+            delete node;
+            return 0;
+        }
+
+        uint64_t now = currentTimeTick();
+        if (linked_count_ == 0 && current_tick_ < now) {
+            // 空轮直接对齐到当前时间，避免定时线程追赶空转的刻度
+            current_tick_ = now;
+        }
+
+        // 多加一个刻度，保证不会早于delay触发
+        node->expire_tick = now + static_cast<uint64_t>(std::max<int64_t>(delay.count(), 0)) + 1;
+        node->id = next_id_++;
+        id = node->id;
+
+        nodes_.emplace(id, node);
+        insert(node);
+
+        wake = node->expire_tick < wake_tick_;
+    }
+
+    // 只有新定时器早于定时线程的下一次唤醒时间时才需要通知
+    if (wake) {
+        condition_.notify_one();
+    }
+    return id;
+}
+
+bool TimerWheel::cancel(uint64_t id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = nodes_.find(id);
+    if (it == nodes_.end()) {
+        return false;
+    }
+
+    Node* node = it->second;
+    if (node->slot) {
+        unlink(node);
+        nodes_.erase(it);
+        delete node;
+        return true;
+    }
+
+    // 正在执行到期回调：周期定时器标记后不再重新插入，单次定时器视为已触发
+    if (node->period_ticks > 0 && !node->cancelled) {
+        node->cancelled = true;
+        return true;
+    }
+    return false;
+}
+
+void TimerWheel::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) {
+            return;
+        }
+        stop_ = true;
+    }
+    condition_.notify_all();
+
+    if (thread_.joinable()) {
+        if (thread_.get_id() == std::this_thread::get_id()) {
+            thread_.detach();
+        } else {
+            thread_.join();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& pair : nodes_) {
+        delete pair.second;
+    }
+    nodes_.clear();
+    linked_count_ = 0;
+    for (auto& level : wheel_) {
+        for (auto& slot : level) {
+            slot.head = nullptr;
+        }
+    }
+}
+
+size_t TimerWheel::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nodes_.size();
+}
+
+void TimerWheel::insert(Node* node) {
+    if (node->expire_tick <= current_tick_) {
+        node->expire_tick = current_tick_ + 1;
+    }
+
+    uint64_t delta = node->expire_tick - current_tick_;
+    uint64_t slot_tick = node->expire_tick;
+
+    size_t level = 0;
+    while (level + 1 < kLevels && delta >= (uint64_t(1) << (kSlotBits * (level + 1)))) {
+        ++level;
+    }
+
+    // 超出整个时间轮范围时放在最高层最远的槽位，级联时重新计算位置
+    if (level + 1 == kLevels && delta >= (uint64_t(1) << (kSlotBits * kLevels))) {
+        slot_tick = current_tick_ + (kSlotMask << (kSlotBits * level));
+    }
+
+    Slot& slot = wheel_[level][(slot_tick >> (kSlotBits * level)) & kSlotMask];
+    node->prev = nullptr;
+    node->next = slot.head;
+    if (slot.head) {
+        slot.head->prev = node;
+    }
+    slot.head = node;
+    node->slot = &slot;
+    ++linked_count_;
+}
+
+void TimerWheel::unlink(Node* node) {
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        node->slot->head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
+    node->prev = nullptr;
+    node->next = nullptr;
+    node->slot = nullptr;
+    --linked_count_;
+}
+
+void TimerWheel::cascade(size_t level) {
+    Slot& slot = wheel_[level][(current_tick_ >> (kSlotBits * level)) & kSlotMask];
+    Node* node = slot.head;
+    slot.head = nullptr;
+
+    while (node) {
+        Node* next = node->next;
+        node->prev = nullptr;
+        node->next = nullptr;
+        node->slot = nullptr;
+        --linked_count_;
+        insert(node);
+        node = next;
+    }
+}
+
+void TimerWheel::advance(std::vector<Node*>& expired) {
+    ++current_tick_;
+
+    // 低层转完一圈时，把高层对应槽位的定时器重新分配到低层
+    for (size_t level = 1; level < kLevels; ++level) {
+        if (((current_tick_ >> (kSlotBits * (level - 1))) & kSlotMask) != 0) {
+            break;
+        }
+        cascade(level);
+    }
+
+    Slot& slot = wheel_[0][current_tick_ & kSlotMask];
+    Node* node = slot.head;
+    slot.head = nullptr;
+
+    while (node) {
+        Node* next = node->next;
+        node->prev = nullptr;
+        node->next = nullptr;
+        node->slot = nullptr;
+        --linked_count_;
+
+        if (node->expire_tick <= current_tick_) {
+            expired.push_back(node);
+        } else {
+            insert(node);
+        }
+        node = next;
+    }
+}
+
+uint64_t TimerWheel::nextWakeTick() const {
+    if (linked_count_ == 0) {
+        return kNoWake;
+    }
+
+    // 最多扫描到下一个级联点，级联点本身也需要唤醒
+    for (uint64_t tick = current_tick_ + 1;; ++tick) {
+        if (wheel_[0][tick & kSlotMask].head || (tick & kSlotMask) == 0) {
+            return tick;
+        }
+    }
+}
+
+void TimerWheel::run() {
+    std::vector<Node*> expired;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!stop_) {
+        uint64_t now = currentTimeTick();
+        while (current_tick_ < now && linked_count_ > 0) {
+            advance(expired);
+        }
+        if (linked_count_ == 0 && current_tick_ < now) {
+            current_tick_ = now;
+        }
+
+        if (!expired.empty()) {
+            // 在锁外执行到期回调，回调中可以再添加或取消定时器
+            wake_tick_ = 0;
+            lock.unlock();
+            for (Node* node : expired) {
+                try {
+                    node->action();
+                } catch (...) {
+                    // 回调异常不能影响定时线程
+                }
+            }
+            lock.lock();
+
+            for (Node* node : expired) {
+                if (node->period_ticks > 0 && !node->cancelled && !stop_) {
+                    // 固定频率：以上一次计划时间为基准推进，不累积回调耗时
+                    node->expire_tick += node->period_ticks;
+                    insert(node);
+                } else if (!stop_) {
+                    nodes_.erase(node->id);
+                    delete node;
+                }
+            }
+            expired.clear();
+            continue;
+        }
+
+        wake_tick_ = nextWakeTick();
+        if (wake_tick_ == kNoWake) {
+            condition_.wait(lock);
+        } else {
+            condition_.wait_until(lock, epoch_ + std::chrono::milliseconds(wake_tick_));
+        }
+    }
+}
+
+} // namespace sdk
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "sdk/threading/task_function.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace sdk {
+
+    // 分层时间轮：4层 × 64槽，精度1毫秒，由独立的定时线程推进
+    // 插入与取消都是O(1)；到期回调在定时线程上执行，只应做投递任务这类轻量操作
+    class TimerWheel {
+    public:
+        TimerWheel();
+        ~TimerWheel();
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        // 添加定时器，period为0表示只触发一次，返回定时器ID（从1开始）
+        uint64_t add(std::chrono::milliseconds delay, std::chrono::milliseconds period,
+                     TaskFunction action);
+
+        // 取消定时器，定时器不存在或单次定时器已触发时返回false
+        bool cancel(uint64_t id);
+
+        // 停止定时线程，丢弃所有未触发的定时器
+        void stop();
+
+        // 未触发的定时器数量
+        size_t size() const;
+
+    private:
+        static constexpr size_t kLevels = 4;
+        static constexpr size_t kSlotBits = 6;
+        static constexpr size_t kSlots = size_t(1) << kSlotBits;
+        static constexpr uint64_t kSlotMask = kSlots - 1;
+
+        struct Node;
+
+        struct Slot {
+            Node* head = nullptr;
+        };
+
+        // 定时器节点：双向链表挂在所属槽位上，取消时直接摘除
+        struct Node {
+            uint64_t id = 0;
+            uint64_t expire_tick = 0;
+            uint64_t period_ticks = 0;
+            TaskFunction action;
+            Node* prev = nullptr;
+            Node* next = nullptr;
+            Slot* slot = nullptr;     // 为空表示不在时间轮中（正在执行回调）
+            bool cancelled = false;
+        };
+
+        void run();
+        void insert(Node* node);
+        void unlink(Node* node);
+        void cascade(size_t level);
+        void advance(std::vector<Node*>& expired);
+        uint64_t nextWakeTick() const;
+        uint64_t currentTimeTick() const;
+
+        const std::chrono::steady_clock::time_point epoch_;
+        uint64_t current_tick_ = 0;
+        uint64_t next_id_ = 1;
+        Slot wheel_[kLevels][kSlots];
+        std::unordered_map<uint64_t, Node*> nodes_;
+        size_t linked_count_ = 0;
+        uint64_t wake_tick_ = std::numeric_limits<uint64_t>::max();   // 定时线程的下一次唤醒刻度
+
+        mutable std::mutex mutex_;
+        std::condition_variable condition_;
+        bool stop_ = false;
+        std::thread thread_;
+    };
+}
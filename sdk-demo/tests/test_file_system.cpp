@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <sdk/platform/file_system.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace sdk::platform;
+
+namespace {
+
+std::vector<uint8_t> makeData(size_t size) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+    return data;
+}
+
+} // namespace
+
+// 各种大小的文件都应完整读回，包括大于单次读取缓冲区的文件
+TEST(FileSystemTest, ReadsSmallAndLargeFiles) {
+    const std::string path = "fs_read_test.bin";
+    for (size_t size : {size_t(0), size_t(100), size_t(64 * 1024), size_t(1024 * 1024), size_t(3 * 1024 * 1024 + 17)}) {
+        std::vector<uint8_t> data = makeData(size);
+        ASSERT_TRUE(FileSystem::writeBinaryFile(path, data));
+        EXPECT_EQ(FileSystem::readBinaryFile(path), data) << size;
+
+        EXPECT_EQ(FileSystem::readTextFile(path), std::string(data.begin(), data.end())) << size;
+    }
+    std::remove(path.c_str());
+
+    EXPECT_TRUE(FileSystem::readBinaryFile("fs_missing_file.bin").empty());
+    EXPECT_EQ(FileSystem::readTextFile("fs_missing_file.bin"), "");
+}
+
+TEST(FileSystemTest, ReadIntoHonorsOffsetAndEof) {
+    const std::string path = "fs_read_into_test.bin";
+    std::vector<uint8_t> data = makeData(1000);
+    ASSERT_TRUE(FileSystem::writeBinaryFile(path, data));
+
+    std::vector<uint8_t> buffer(300);
+    ASSERT_EQ(FileSystem::readInto(path, buffer.data(), buffer.size(), 100), 300u);
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), data.begin() + 100));
+
+    // 越过文件末尾时只返回剩余部分
+    EXPECT_EQ(FileSystem::readInto(path, buffer.data(), buffer.size(), 900), 100u);
+    EXPECT_EQ(FileSystem::readInto(path, buffer.data(), buffer.size(), 2000), 0u);
+    EXPECT_EQ(FileSystem::readInto("fs_missing_file.bin", buffer.data(), buffer.size()), 0u);
+    std::remove(path.c_str());
+}
+
+TEST(FileSystemTest, CopyFileOverwritesDestination) {
+    const std::string src = "fs_copy_src.bin";
+    const std::string dst = "fs_copy_dst.bin";
+    std::vector<uint8_t> data = makeData(5 * 1024 * 1024 + 3);
+    ASSERT_TRUE(FileSystem::writeBinaryFile(src, data));
+    ASSERT_TRUE(FileSystem::writeBinaryFile(dst, makeData(16 * 1024 * 1024)));
+
+    ASSERT_TRUE(FileSystem::copyFile(src, dst));
+    EXPECT_EQ(FileSystem::getFileSize(dst), data.size());
+    EXPECT_EQ(FileSystem::readBinaryFile(dst), data);
+
+    EXPECT_FALSE(FileSystem::copyFile("fs_missing_file.bin", dst));
+    std::remove(src.c_str());
+    std::remove(dst.c_str());
+}
+
+TEST(MappedFileTest, MapsContentsAndMoves) {
+    const std::string path = "fs_mapped_test.bin";
+    std::vector<uint8_t> data = makeData(200 * 1024);
+    ASSERT_TRUE(FileSystem::writeBinaryFile(path, data));
+
+    MappedFile mapped;
+    ASSERT_TRUE(mapped.open(path));
+    mapped.advise(MappedFile::Access::RANDOM);
+    ASSERT_EQ(mapped.size(), data.size());
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), mapped.data()));
+    EXPECT_EQ(mapped.view().size(), data.size());
+
+    MappedFile moved(std::move(mapped));
+    EXPECT_FALSE(mapped.isOpen());
+    EXPECT_TRUE(moved.isOpen());
+    EXPECT_EQ(moved.data()[12345], data[12345]);
+    moved.close();
+    EXPECT_FALSE(moved.isOpen());
+
+    // 空文件可以打开，大小为0
+    ASSERT_TRUE(FileSystem::writeBinaryFile(path, {}));
+    ASSERT_TRUE(mapped.open(path));
+    EXPECT_EQ(mapped.size(), 0u);
+    EXPECT_TRUE(mapped.view().empty());
+    mapped.close();
+
+    EXPECT_FALSE(mapped.open("fs_missing_file.bin"));
+    std::remove(path.c_str());
+}
+
+// 按块写出再按块读回，块大小与文件大小互不整除
+TEST(FileStreamTest, ChunkedWriteAndRead) {
+    const std::string path = "fs_chunked_test.bin";
+    std::vector<uint8_t> data = makeData(1024 * 1024 + 511);
+
+    FileWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    const size_t chunk = 4000;
+    for (size_t offset = 0; offset < data.size(); offset += chunk) {
+        ASSERT_TRUE(writer.write(data.data() + offset, std::min(chunk, data.size() - offset)));
+    }
+    EXPECT_EQ(writer.bytesWritten(), data.size());
+    EXPECT_TRUE(writer.sync());
+    EXPECT_TRUE(writer.close());
+
+    FileReaderOptions options;
+    options.drop_cache_behind = true;
+    FileReader reader;
+    ASSERT_TRUE(reader.open(path, options));
+    EXPECT_EQ(reader.size(), data.size());
+
+    std::vector<uint8_t> result;
+    std::vector<uint8_t> buffer(chunk);
+    size_t n;
+    while ((n = reader.read(buffer.data(), buffer.size())) > 0) {
+        result.insert(result.end(), buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(n));
+    }
+    EXPECT_EQ(result, data);
+    EXPECT_EQ(reader.position(), data.size());
+
+    ASSERT_TRUE(reader.seek(10));
+    ASSERT_EQ(reader.read(buffer.data(), 5), 5u);
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.begin() + 5, data.begin() + 10));
+    reader.close();
+
+    // 追加模式保留原有内容
+    ASSERT_TRUE(writer.open(path, true));
+    ASSERT_TRUE(writer.write("xyz", 3));
+    writer.close();
+    EXPECT_EQ(FileSystem::getFileSize(path), data.size() + 3);
+    std::remove(path.c_str());
+
+    EXPECT_FALSE(reader.open("fs_missing_file.bin"));
+    EXPECT_EQ(reader.read(buffer.data(), buffer.size()), 0u);
+}
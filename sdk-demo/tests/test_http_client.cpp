@@ -0,0 +1,854 @@
+#include <gtest/gtest.h>
+#include <sdk/metrics/metrics_reporter.h>
+#include <sdk/metrics/tracing.h>
+#include <sdk/network/http_client.h>
+#include <sdk/threading/thread_pool.h>
+
+#ifndef _WIN32
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sdk;
+
+namespace {
+
+// 回环HTTP/1.1服务器：支持keep-alive，统计建立的连接数
+class LoopbackServer {
+public:
+    struct Request {
+        std::string method;
+        std::string path;
+        std::string head;   // 请求行与头部原文
+        std::string body;
+    };
+
+    struct Response {
+        int status = 200;
+        std::string body;
+        std::vector<std::string> headers;
+    };
+
+    using Handler = std::function<Response(const Request&)>;
+
+    explicit LoopbackServer(Handler handler) : handler_(std::move(handler)) {
+        listen_fd_ = ::socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        ::setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        ::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        ::listen(listen_fd_, 16);
+
+        socklen_t len = sizeof(addr);
+        ::getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+        port_ = ntohs(addr.sin_port);
+
+        acceptor_ = std::thread([this] { acceptLoop(); });
+    }
+
+    ~LoopbackServer() {
+        stopping_ = true;
+        ::shutdown(listen_fd_, SHUT_RDWR);
+        ::close(listen_fd_);
+        acceptor_.join();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int fd : client_fds_) {
+            ::shutdown(fd, SHUT_RDWR);
+        }
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        for (int fd : client_fds_) {
+            ::close(fd);
+        }
+    }
+
+    std::string url(const std::string& path = "/") const {
+        return "http://127.0.0.1:" + std::to_string(port_) + path;
+    }
+
+    int connectionCount() const {
+        return connections_.load();
+    }
+
+private:
+    void acceptLoop() {
+        while (!stopping_) {
+            int fd = ::accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            connections_++;
+            std::lock_guard<std::mutex> lock(mutex_);
+            client_fds_.push_back(fd);
+            workers_.emplace_back([this, fd] { serve(fd); });
+        }
+    }
+
+    void serve(int fd) {
+        std::string buffer;
+        char chunk[4096];
+        for (;;) {
+            size_t header_end;
+            while ((header_end = buffer.find("\r\n\r\n")) == std::string::npos) {
+                ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) {
+                    return;
+                }
+                buffer.append(chunk, static_cast<size_t>(n));
+            }
+
+            Request request;
+            std::string head = buffer.substr(0, header_end);
+            size_t space = head.find(' ');
+            request.method = head.substr(0, space);
+            request.path = head.substr(space + 1, head.find(' ', space + 1) - space - 1);
+            request.head = head;
+
+            size_t content_length = 0;
+            size_t pos = head.find("Content-Length:");
+            if (pos == std::string::npos) {
+                pos = head.find("content-length:");
+            }
+            if (pos != std::string::npos) {
+                content_length = std::stoul(head.substr(pos + 15));
+            }
+
+            while (buffer.size() < header_end + 4 + content_length) {
+                ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) {
+                    return;
+                }
+                buffer.append(chunk, static_cast<size_t>(n));
+            }
+            request.body = buffer.substr(header_end + 4, content_length);
+            buffer.erase(0, header_end + 4 + content_length);
+
+            Response response = handler_(request);
+            std::string out = "HTTP/1.1 " + std::to_string(response.status) + " OK\r\n";
+            out += "Content-Length: " + std::to_string(response.body.size()) + "\r\n";
+            for (const auto& header : response.headers) {
+                out += header + "\r\n";
+            }
+            out += "\r\n";
+            out += response.body;
+            if (::send(fd, out.data(), out.size(), MSG_NOSIGNAL) < 0) {
+                return;
+            }
+        }
+    }
+
+    Handler handler_;
+    int listen_fd_ = -1;
+    int port_ = 0;
+    std::atomic<bool> stopping_{false};
+    std::atomic<int> connections_{0};
+    std::thread acceptor_;
+    std::mutex mutex_;
+    std::vector<int> client_fds_;
+    std::vector<std::thread> workers_;
+};
+
+LoopbackServer::Response echoPath(const LoopbackServer::Request& request) {
+    LoopbackServer::Response response;
+    response.body = request.method + " " + request.path;
+    return response;
+}
+
+LoopbackServer::Response echoBody(const LoopbackServer::Request& request) {
+    LoopbackServer::Response response;
+    response.body = request.body;
+    return response;
+}
+
+std::string readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream content;
+    content << in.rdbuf();
+    return content.str();
+}
+
+} // namespace
+
+// 连续请求同一主机复用句柄和连接
+TEST(HttpClientTest, ReusesHandlesAndConnections) {
+    LoopbackServer server(echoPath);
+    HttpClient client;
+
+    for (int i = 0; i < 5; ++i) {
+        auto response = client.get(server.url("/item/" + std::to_string(i)));
+        ASSERT_EQ(200, response.getStatusCode()) << response.getError();
+        EXPECT_EQ("GET /item/" + std::to_string(i), response.getBody());
+    }
+
+    auto stats = client.getStats();
+    EXPECT_EQ(5u, stats.total_requests);
+    EXPECT_EQ(1u, stats.handles_created);
+    EXPECT_EQ(4u, stats.handle_reuses);
+    EXPECT_EQ(4u, stats.connection_reuses);
+    EXPECT_EQ(1, server.connectionCount());
+}
+
+TEST(HttpClientTest, PoolingCanBeDisabled) {
+    LoopbackServer server(echoPath);
+    HttpClientConfig config;
+    config.max_idle_handles_per_host = 0;
+    config.share_connections = false;
+    HttpClient client(config);
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(200, client.get(server.url()).getStatusCode());
+    }
+
+    auto stats = client.getStats();
+    EXPECT_EQ(0u, stats.handle_reuses);
+    EXPECT_EQ(0u, stats.connection_reuses);
+    EXPECT_EQ(3, server.connectionCount());
+}
+
+// 请求完成空出并发名额后，排队的请求立即开始，而不是等到下一次轮询超时
+TEST(HttpClientTest, QueuedAsyncRequestsStartPromptly) {
+    LoopbackServer server(echoPath);
+    HttpClientConfig config;
+    config.max_concurrent_requests = 1;
+    HttpClient client(config);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::future<HttpResponse>> futures;
+    for (int i = 0; i < 20; ++i) {
+        futures.push_back(client.getAsync(server.url("/queued/" + std::to_string(i))));
+    }
+    for (auto& future : futures) {
+        EXPECT_EQ(200, future.get().getStatusCode());
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+}
+
+// 异步请求共用一个反应器线程，并发数不超过上限，超出部分排队
+TEST(HttpClientTest, AsyncRequestsRespectConcurrencyLimit) {
+    std::atomic<int> current{0};
+    std::atomic<int> peak{0};
+    LoopbackServer server([&](const LoopbackServer::Request& request) {
+        int now = ++current;
+        int expected = peak.load();
+        while (now > expected && !peak.compare_exchange_weak(expected, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        --current;
+        return echoPath(request);
+    });
+
+    HttpClientConfig config;
+    config.max_concurrent_requests = 2;
+    HttpClient client(config);
+
+    std::vector<std::future<HttpResponse>> futures;
+    for (int i = 0; i < 8; ++i) {
+        futures.push_back(client.getAsync(server.url("/async/" + std::to_string(i))));
+    }
+    for (int i = 0; i < 8; ++i) {
+        auto response = futures[i].get();
+        EXPECT_EQ(200, response.getStatusCode()) << response.getError();
+        EXPECT_EQ("GET /async/" + std::to_string(i), response.getBody());
+    }
+
+    EXPECT_LE(peak.load(), 2);
+    EXPECT_EQ(0u, client.getActiveRequestCount());
+    EXPECT_EQ(8u, client.getStats().total_requests);
+}
+
+// setConfig修改的并发上限对之后排队的异步请求生效
+TEST(HttpClientTest, SetConfigUpdatesConcurrencyLimit) {
+    std::atomic<int> current{0};
+    std::atomic<int> peak{0};
+    LoopbackServer server([&](const LoopbackServer::Request& request) {
+        int now = ++current;
+        int expected = peak.load();
+        while (now > expected && !peak.compare_exchange_weak(expected, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        --current;
+        return echoPath(request);
+    });
+
+    HttpClient client;
+    HttpClientConfig config = client.getConfig();
+    config.max_concurrent_requests = 1;
+    client.setConfig(config);
+
+    std::vector<std::future<HttpResponse>> futures;
+    for (int i = 0; i < 6; ++i) {
+        futures.push_back(client.getAsync(server.url("/limited/" + std::to_string(i))));
+    }
+    for (auto& future : futures) {
+        EXPECT_EQ(200, future.get().getStatusCode());
+    }
+
+    EXPECT_EQ(1, peak.load());
+}
+
+TEST(HttpClientTest, CallbacksRunOnThreadPool) {
+    LoopbackServer server(echoPath);
+    auto pool = std::make_shared<ThreadPool>(2);
+    HttpClient client;
+    client.setCallbackPool(pool);
+
+    std::promise<std::pair<bool, std::string>> done;
+    auto result = done.get_future();
+    ThreadPool* workers = pool.get();
+    client.requestAsync(HttpRequest(server.url("/callback")), [&done, workers](const HttpResponse& response) {
+        done.set_value({workers->activeThreads() > 0, response.getBody()});
+    });
+
+    auto value = result.get();
+    EXPECT_TRUE(value.first);
+    EXPECT_EQ("GET /callback", value.second);
+}
+
+TEST(HttpClientTest, CancelAllRequests) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool release = false;
+    LoopbackServer server([&](const LoopbackServer::Request& request) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait_for(lock, std::chrono::seconds(5), [&] { return release; });
+        return echoPath(request);
+    });
+
+    HttpClientConfig config;
+    config.max_concurrent_requests = 1;
+    HttpClient client(config);
+    auto running = client.getAsync(server.url("/running"));
+    auto queued = client.getAsync(server.url("/queued"));
+    EXPECT_EQ(2u, client.getActiveRequestCount());
+
+    client.cancelAllRequests();
+    EXPECT_EQ("Request cancelled", running.get().getError());
+    EXPECT_EQ("Request cancelled", queued.get().getError());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    cv.notify_all();
+}
+
+// 每主机连接数受限时异步请求排队复用同一连接；HTTP/1.1服务端不会产生HTTP/2流
+TEST(HttpClientTest, CapsConnectionsPerHost) {
+    LoopbackServer server(echoPath);
+    HttpClientConfig config;
+    config.http_version = HttpVersion::HTTP_2;
+    config.max_concurrent_requests = 0;
+    config.max_connections_per_host = 1;
+    HttpClient client(config);
+
+    std::vector<std::future<HttpResponse>> futures;
+    for (int i = 0; i < 6; ++i) {
+        futures.push_back(client.getAsync(server.url("/h/" + std::to_string(i))));
+    }
+    for (int i = 0; i < 6; ++i) {
+        auto response = futures[i].get();
+        EXPECT_EQ("GET /h/" + std::to_string(i), response.getBody()) << response.getError();
+    }
+
+    auto stats = client.getStats();
+    EXPECT_EQ(1, server.connectionCount());
+    EXPECT_EQ(1u, stats.connections_opened);
+    EXPECT_EQ(5u, stats.connection_reuses);
+    EXPECT_EQ(0u, stats.http2_requests);
+}
+
+// 请求级的头部与User-Agent覆盖客户端设置，同名头部不会重复发送；全局头部的修改只影响之后的请求
+TEST(HttpClientTest, RequestSettingsOverrideGlobals) {
+    LoopbackServer server([](const LoopbackServer::Request& request) {
+        LoopbackServer::Response response;
+        response.body = request.head;
+        return response;
+    });
+    HttpClientConfig config;
+    config.user_agent = "client-agent";
+    HttpClient client(config);
+    client.setGlobalHeader("X-App", "demo");
+    client.setGlobalHeader("X-Trace", "global");
+
+    HttpRequest request(server.url("/headers"));
+    request.setHeader("x-trace", "request").setUserAgent("request-agent");
+    std::string head = client.request(request).getBody();
+    EXPECT_NE(std::string::npos, head.find("X-App: demo"));
+    EXPECT_NE(std::string::npos, head.find("x-trace: request"));
+    EXPECT_EQ(std::string::npos, head.find("X-Trace: global"));
+    EXPECT_NE(std::string::npos, head.find("User-Agent: request-agent"));
+
+    head = client.get(server.url("/headers")).getBody();
+    EXPECT_NE(std::string::npos, head.find("X-Trace: global"));
+    EXPECT_NE(std::string::npos, head.find("User-Agent: client-agent"));
+
+    client.removeGlobalHeader("X-App");
+    head = client.get(server.url("/headers")).getBody();
+    EXPECT_EQ(std::string::npos, head.find("X-App"));
+    EXPECT_NE(std::string::npos, head.find("X-Trace: global"));
+}
+
+// getConfig返回副本，与setConfig并发调用时读到的是某一次完整的配置
+TEST(HttpClientTest, GetConfigIsSafeDuringSetConfig) {
+    HttpClientConfig initial;
+    initial.user_agent = "agent-even";
+    initial.max_retries = 2;
+    HttpClient client(initial);
+    std::atomic<bool> stop{false};
+    std::thread writer([&] {
+        for (int i = 0; !stop; ++i) {
+            HttpClientConfig config;
+            config.user_agent = i % 2 ? "agent-odd" : "agent-even";
+            config.max_retries = i % 2 ? 1 : 2;
+            client.setConfig(config);
+        }
+    });
+    for (int i = 0; i < 2000; ++i) {
+        HttpClientConfig config = client.getConfig();
+        EXPECT_EQ(config.user_agent == "agent-odd" ? 1u : 2u, config.max_retries) << config.user_agent;
+    }
+    stop = true;
+    writer.join();
+}
+
+// 指标上报器攒够批量后通过客户端异步推送，请求体为带时间戳的文本格式
+TEST(HttpClientTest, MetricsReporterPushesBatches) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<LoopbackServer::Request> pushes;
+    LoopbackServer server([&](const LoopbackServer::Request& request) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pushes.push_back(request);
+        }
+        cv.notify_all();
+        return LoopbackServer::Response();
+    });
+
+    auto pool = std::make_shared<ThreadPool>(2);
+    auto client = std::make_shared<HttpClient>();
+    MetricsReporterOptions options;
+    options.endpoint = server.url("/import");
+    options.interval = std::chrono::hours(1);
+    options.batch_size = 2;
+    MetricsReporter reporter(options, pool, client);
+
+    reporter.sampleNow();
+    reporter.sampleNow();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&] { return !pushes.empty(); }));
+        EXPECT_EQ("POST", pushes[0].method);
+        EXPECT_EQ("/import", pushes[0].path);
+        EXPECT_NE(std::string::npos, pushes[0].head.find("text/plain; version=0.0.4"));
+
+        // 两次采样各自带时间戳，类型行各出现两次
+        const std::string type_line = "# TYPE sdk_thread_pool_threads gauge\n";
+        size_t first = pushes[0].body.find(type_line);
+        ASSERT_NE(std::string::npos, first);
+        EXPECT_NE(std::string::npos, pushes[0].body.find(type_line, first + 1));
+    }
+
+    for (int i = 0; i < 100 && reporter.getStats().pushes == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    MetricsReporter::Stats stats = reporter.getStats();
+    EXPECT_EQ(2u, stats.samples);
+    EXPECT_EQ(1u, stats.pushes);
+    EXPECT_EQ(0u, stats.push_failures);
+}
+
+// 追踪开启时同步请求记录整体区间与各传输阶段
+TEST(HttpClientTest, TracesRequestPhases) {
+    LoopbackServer server(echoPath);
+    HttpClient client;
+    
+    Tracer::getInstance().start();
+    EXPECT_EQ(200, client.get(server.url("/traced")).getStatusCode());
+    Tracer::getInstance().stop();
+    
+    std::string json = Tracer::getInstance().toChromeTraceJson();
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"http.request\",\"cat\":\"http\",\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, json.find("\"args\":{\"status\":200}"));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"http.transfer\",\"cat\":\"http\",\"ph\":\"b\""));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"http.receive\""));
+}
+
+// 新鲜的响应直接从缓存返回，同步与异步请求共用同一缓存
+TEST(HttpClientTest, ServesFreshResponsesFromCache) {
+    std::atomic<int> hits{0};
+    LoopbackServer server([&](const LoopbackServer::Request& request) {
+        hits++;
+        auto response = echoPath(request);
+        response.headers.push_back("Cache-Control: max-age=60");
+        return response;
+    });
+    HttpClientConfig config;
+    config.enable_cache = true;
+    HttpClient client(config);
+
+    EXPECT_EQ("GET /config", client.get(server.url("/config")).getBody());
+    EXPECT_EQ("GET /config", client.get(server.url("/config")).getBody());
+    EXPECT_EQ("GET /config", client.getAsync(server.url("/config")).get().getBody());
+    EXPECT_EQ(1, hits.load());
+
+    auto stats = client.getStats();
+    EXPECT_EQ(3u, stats.total_requests);
+    EXPECT_EQ(2u, stats.cache_hits);
+    EXPECT_EQ(1u, stats.cache_misses);
+
+    client.clearCache();
+    client.get(server.url("/config"));
+    EXPECT_EQ(2, hits.load());
+}
+
+// no-cache的响应每次都用ETag条件请求验证，304时不传输正文
+TEST(HttpClientTest, RevalidatesWithETag) {
+    std::atomic<int> full{0};
+    LoopbackServer server([&](const LoopbackServer::Request& request) {
+        LoopbackServer::Response response;
+        response.headers.push_back("ETag: \"v1\"");
+        response.headers.push_back("Cache-Control: no-cache");
+        if (request.head.find("If-None-Match: \"v1\"") != std::string::npos) {
+            response.status = 304;
+        } else {
+            full++;
+            response.body = "metadata";
+        }
+        return response;
+    });
+    HttpClientConfig config;
+    config.enable_cache = true;
+    HttpClient client(config);
+
+    for (int i = 0; i < 3; ++i) {
+        auto response = client.get(server.url("/meta"));
+        EXPECT_EQ(200, response.getStatusCode());
+        EXPECT_EQ("metadata", response.getBody());
+    }
+    EXPECT_EQ(1, full.load());
+
+    auto stats = client.getStats();
+    EXPECT_EQ(0u, stats.cache_hits);
+    EXPECT_EQ(2u, stats.cache_revalidations);
+    EXPECT_EQ(1u, stats.cache_misses);
+}
+
+TEST(HttpClientTest, DiskCacheSurvivesRestart) {
+    std::atomic<int> hits{0};
+    LoopbackServer server([&](const LoopbackServer::Request& request) {
+        hits++;
+        auto response = echoPath(request);
+        response.headers.push_back("Cache-Control: max-age=60");
+        return response;
+    });
+    HttpClientConfig config;
+    config.enable_cache = true;
+    config.cache_on_disk = true;
+    config.cache_directory = ::testing::TempDir() + "http_cache_test";
+
+    {
+        HttpClient client(config);
+        client.clearCache();
+        EXPECT_EQ("GET /disk", client.get(server.url("/disk")).getBody());
+    }
+    HttpClient client(config);
+    EXPECT_EQ("GET /disk", client.get(server.url("/disk")).getBody());
+    EXPECT_EQ(1, hits.load());
+    EXPECT_EQ(1u, client.getStats().cache_hits);
+    client.clearCache();
+}
+
+// 磁盘缓存只计入、淘汰和清除自己的文件，共用目录中的其他文件保持不变
+TEST(HttpClientTest, DiskCacheLeavesForeignFilesAlone) {
+    LoopbackServer server([&](const LoopbackServer::Request& request) {
+        auto response = echoPath(request);
+        response.headers.push_back("Cache-Control: max-age=60");
+        return response;
+    });
+    std::filesystem::path directory = ::testing::TempDir() + "http_cache_foreign_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    std::filesystem::path foreign = directory / "notes.txt";
+    std::filesystem::path stale = directory / "0123456789abcdef.cache.tmp7";
+    std::ofstream(foreign, std::ios::binary) << std::string(8192, 'x');
+    std::ofstream(stale, std::ios::binary) << "partial";
+
+    HttpClientConfig config;
+    config.enable_cache = true;
+    config.cache_on_disk = true;
+    config.cache_directory = directory.string();
+    config.cache_disk_budget = 4096;
+    HttpClient client(config);
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(200, client.get(server.url("/foreign/" + std::to_string(i))).getStatusCode());
+    }
+    EXPECT_TRUE(std::filesystem::exists(foreign));
+
+    client.clearCache();
+    EXPECT_TRUE(std::filesystem::exists(foreign));
+    EXPECT_FALSE(std::filesystem::exists(stale));
+    size_t remaining = 0;
+    for (const auto& item : std::filesystem::directory_iterator(directory)) {
+        (void)item;
+        ++remaining;
+    }
+    EXPECT_EQ(1u, remaining);
+    std::filesystem::remove_all(directory);
+}
+
+// 同一URL的并发GET只发送一次，同步与异步调用方共享响应
+TEST(HttpClientTest, CoalescesConcurrentGets) {
+    std::atomic<int> hits{0};
+    LoopbackServer server([&](const LoopbackServer::Request& request) {
+        hits++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        return echoPath(request);
+    });
+    HttpClient client;
+
+    auto async = client.getAsync(server.url("/shared"));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    std::vector<std::thread> callers;
+    std::atomic<int> matched{0};
+    for (int i = 0; i < 6; ++i) {
+        callers.emplace_back([&] {
+            if (client.get(server.url("/shared")).getBody() == "GET /shared") {
+                matched++;
+            }
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+
+    EXPECT_EQ("GET /shared", async.get().getBody());
+    EXPECT_EQ(6, matched.load());
+    EXPECT_EQ(1, hits.load());
+    EXPECT_EQ(6u, client.getStats().coalesced_requests);
+    EXPECT_EQ(0u, client.getActiveRequestCount());
+}
+
+// 请求级设置不同的GET各自发送，也不读写共享缓存
+TEST(HttpClientTest, RequestOverridesAreNotShared) {
+    std::atomic<int> hits{0};
+    LoopbackServer server([&](const LoopbackServer::Request& request) {
+        hits++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto response = echoPath(request);
+        response.headers.push_back("Cache-Control: max-age=60");
+        return response;
+    });
+    HttpClientConfig config;
+    config.enable_cache = true;
+    HttpClient client(config);
+
+    HttpRequest unverified(server.url("/settings"));
+    unverified.setVerifySSL(false);
+    HttpRequest custom_agent(server.url("/settings"));
+    custom_agent.setUserAgent("other-agent");
+
+    std::thread first([&] { EXPECT_EQ(200, client.request(unverified).getStatusCode()); });
+    std::thread second([&] { EXPECT_EQ(200, client.request(custom_agent).getStatusCode()); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(200, client.get(server.url("/settings")).getStatusCode());
+    first.join();
+    second.join();
+
+    EXPECT_EQ(3, hits.load());
+    EXPECT_EQ(0u, client.getStats().coalesced_requests);
+    EXPECT_EQ(200, client.request(unverified).getStatusCode());
+    EXPECT_EQ(4, hits.load());
+    client.clearCache();
+}
+
+// 幂等请求遇到5xx按退避重试，POST不重试
+TEST(HttpClientTest, RetriesIdempotentRequests) {
+    std::atomic<int> failures{0};
+    LoopbackServer server([&](const LoopbackServer::Request& request) {
+        auto response = echoPath(request);
+        if (failures > 0) {
+            failures--;
+            response.status = 503;
+        }
+        return response;
+    });
+    HttpClientConfig config;
+    config.max_retries = 3;
+    config.retry_base_delay = std::chrono::milliseconds(5);
+    config.retry_max_delay = std::chrono::milliseconds(20);
+    HttpClient client(config);
+
+    failures = 2;
+    EXPECT_EQ(200, client.get(server.url("/sync")).getStatusCode());
+    failures = 2;
+    EXPECT_EQ(200, client.getAsync(server.url("/async")).get().getStatusCode());
+    EXPECT_EQ(4u, client.getStats().retries);
+
+    failures = 1;
+    EXPECT_EQ(503, client.post(server.url("/post"), "body").getStatusCode());
+    EXPECT_EQ(4u, client.getStats().retries);
+
+    failures = 10;
+    EXPECT_EQ(503, client.get(server.url("/exhausted")).getStatusCode());
+    EXPECT_EQ(7u, client.getStats().retries);
+}
+
+// 慢请求超过p95阈值后发出副本，副本先返回
+TEST(HttpClientTest, HedgesSlowGets) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool release = false;
+    std::atomic<int> slow_calls{0};
+    LoopbackServer server([&](const LoopbackServer::Request& request) {
+        if (request.path.compare(0, 5, "/slow") == 0 && slow_calls++ % 2 == 0) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait_for(lock, std::chrono::seconds(3), [&] { return release; });
+        }
+        return echoPath(request);
+    });
+    HttpClientConfig config;
+    config.enable_hedging = true;
+    config.hedge_min_delay = std::chrono::milliseconds(30);
+    HttpClient client(config);
+
+    for (int i = 0; i < 20; ++i) {
+        client.get(server.url("/fast"));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ("GET /slow/sync", client.get(server.url("/slow/sync")).getBody());
+    EXPECT_EQ("GET /slow/async", client.getAsync(server.url("/slow/async")).get().getBody());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+
+    auto stats = client.getStats();
+    EXPECT_EQ(2u, stats.hedged_requests);
+    EXPECT_EQ(2u, stats.hedge_wins);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    cv.notify_all();
+}
+
+// 响应体直接写入文件，进度回调收到最终字节数；失败时不留下不完整的文件
+TEST(HttpClientTest, DownloadsStreamToFile) {
+    const std::string payload(1024 * 1024 + 17, 'x');
+    LoopbackServer server([&](const LoopbackServer::Request& request) {
+        LoopbackServer::Response response;
+        if (request.path == "/missing") {
+            response.status = 404;
+        } else {
+            response.body = payload;
+        }
+        return response;
+    });
+    HttpClient client;
+    const std::string path = ::testing::TempDir() + "http_download.bin";
+
+    auto response = client.downloadFile(server.url("/file"), path);
+    ASSERT_TRUE(response.isSuccess()) << response.getError();
+    EXPECT_TRUE(response.getBody().empty());
+    EXPECT_EQ(payload, readFile(path));
+
+    std::atomic<size_t> last{0};
+    auto async = client.downloadFileAsync(server.url("/file"), path, [&](size_t transferred, size_t) {
+        last = transferred;
+    });
+    ASSERT_TRUE(async.get().isSuccess());
+    EXPECT_EQ(payload.size(), last.load());
+    EXPECT_EQ(payload, readFile(path));
+
+    EXPECT_FALSE(client.downloadFile(server.url("/missing"), path).isSuccess());
+    EXPECT_FALSE(std::ifstream(path).good());
+}
+
+TEST(HttpClientTest, ResponseSinkCanAbort) {
+    LoopbackServer server([](const LoopbackServer::Request&) {
+        LoopbackServer::Response response;
+        response.body = std::string(256 * 1024, 'y');
+        return response;
+    });
+    HttpClient client;
+
+    size_t received = 0;
+    HttpRequest request(server.url());
+    request.setResponseSink([&](const char*, size_t size) {
+        received += size;
+        return false;
+    });
+    auto response = client.request(request);
+    EXPECT_FALSE(response.isSuccess());
+    EXPECT_GT(received, 0u);
+    EXPECT_LT(received, 256u * 1024);
+}
+
+// 请求体可以引用调用方的数据，或在发送时从reader读取
+TEST(HttpClientTest, StreamsRequestBodies) {
+    LoopbackServer server(echoBody);
+    HttpClient client;
+
+    const std::string data = "view body";
+    HttpRequest view(server.url());
+    view.setMethod(HttpMethod::POST).setBodyView(data);
+    EXPECT_EQ(data, client.request(view).getBody());
+
+    const std::string source(100000, 'z');
+    size_t offset = 0;
+    HttpRequest streamed(server.url());
+    streamed.setMethod(HttpMethod::PUT).setBodyReader([&](char* buffer, size_t size) {
+        size_t n = std::min(size, source.size() - offset);
+        std::copy(source.data() + offset, source.data() + offset + n, buffer);
+        offset += n;
+        return n;
+    }, static_cast<int64_t>(source.size()));
+    auto response = client.request(streamed);
+    ASSERT_TRUE(response.isSuccess()) << response.getError();
+    EXPECT_EQ(source, response.getBody());
+}
+
+TEST(HttpClientTest, UploadsFileAsMultipart) {
+    LoopbackServer server(echoBody);
+    HttpClient client;
+    const std::string path = ::testing::TempDir() + "http_upload.txt";
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "upload content";
+    }
+
+    auto response = client.uploadFile(server.url("/upload"), path, "attachment");
+    ASSERT_TRUE(response.isSuccess()) << response.getError();
+    EXPECT_NE(std::string::npos, response.getBody().find("name=\"attachment\""));
+    EXPECT_NE(std::string::npos, response.getBody().find("upload content"));
+
+    EXPECT_FALSE(client.uploadFile(server.url("/upload"), path + ".missing").isSuccess());
+    std::remove(path.c_str());
+}
+
+#endif // _WIN32
@@ -0,0 +1,700 @@
+#include <gtest/gtest.h>
+#include <sdk/logging/logger.h>
+#include <sdk/logging/binary_log.h>
+#include <sdk/logging/file_appender.h>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace sdk;
+
+namespace {
+
+// 记录收到的日志，可选地在每条日志上停顿以模拟慢速输出端
+class CaptureAppender : public LogAppender {
+public:
+    struct State {
+        std::mutex mutex;
+        std::vector<std::string> messages;
+        std::atomic<int> flushes{0};
+        std::string last_file;
+        std::string last_function;
+        int last_line = 0;
+    };
+
+    CaptureAppender(std::shared_ptr<State> state, std::chrono::microseconds delay = std::chrono::microseconds(0))
+        : state_(std::move(state)), delay_(delay) {}
+
+    void append(const LogRecord& record) override {
+        if (delay_.count() > 0) {
+            std::this_thread::sleep_for(delay_);
+        }
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->messages.push_back(record.message);
+        state_->last_file = std::string(record.file);
+        state_->last_function = std::string(record.function);
+        state_->last_line = record.line;
+    }
+
+    void flush() override {
+        state_->flushes++;
+    }
+
+private:
+    std::shared_ptr<State> state_;
+    std::chrono::microseconds delay_;
+};
+
+LogRecord makeRecord(LogLevel level, const std::string& message) {
+    LogRecord record;
+    record.level = level;
+    record.message = message;
+    record.timestamp = std::chrono::system_clock::now();
+    record.thread_id = std::this_thread::get_id();
+    return record;
+}
+
+size_t messageCount(CaptureAppender::State& state) {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.messages.size();
+}
+
+} // namespace
+
+// 阻塞策略下多线程写入的日志全部按各线程的提交顺序写出
+TEST(AsyncAppenderTest, BlockPolicyKeepsEveryRecord) {
+    auto state = std::make_shared<CaptureAppender::State>();
+    AsyncAppenderOptions options;
+    options.queue_capacity = 16;
+    options.overflow_policy = AsyncOverflowPolicy::BLOCK;
+
+    AsyncAppender appender(std::make_unique<CaptureAppender>(state), options);
+
+    const int thread_count = 4;
+    const int per_thread = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&appender, t, per_thread]() {
+            for (int i = 0; i < per_thread; ++i) {
+                appender.append(makeRecord(LogLevel::INFO, std::to_string(t) + ":" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    appender.flush();
+    EXPECT_EQ(0u, appender.droppedCount());
+    ASSERT_EQ(static_cast<size_t>(thread_count * per_thread), messageCount(*state));
+    EXPECT_GT(state->flushes.load(), 0);
+    EXPECT_EQ(static_cast<uint64_t>(thread_count * per_thread), appender.enqueueLatency().count);
+
+    std::vector<int> next(thread_count, 0);
+    for (const auto& message : state->messages) {
+        auto sep = message.find(':');
+        int t = std::stoi(message.substr(0, sep));
+        EXPECT_EQ(next[t]++, std::stoi(message.substr(sep + 1)));
+    }
+}
+
+// 丢弃策略下调用线程不被慢速输出端阻塞，写出数与丢弃数之和等于提交数
+TEST(AsyncAppenderTest, DropPoliciesCountDroppedRecords) {
+    for (auto policy : {AsyncOverflowPolicy::DROP_NEWEST, AsyncOverflowPolicy::DROP_OLDEST}) {
+        auto state = std::make_shared<CaptureAppender::State>();
+        AsyncAppenderOptions options;
+        options.queue_capacity = 8;
+        options.overflow_policy = policy;
+
+        const size_t total = 200;
+        {
+            AsyncAppender appender(std::make_unique<CaptureAppender>(state, std::chrono::microseconds(500)), options);
+            for (size_t i = 0; i < total; ++i) {
+                appender.append(makeRecord(LogLevel::INFO, std::to_string(i)));
+            }
+            appender.flush();
+
+            EXPECT_GT(appender.droppedCount(), 0u);
+            EXPECT_EQ(total, messageCount(*state) + appender.droppedCount());
+        }
+
+        if (policy == AsyncOverflowPolicy::DROP_OLDEST) {
+            // 最新的记录总会被保留
+            EXPECT_EQ(std::to_string(total - 1), state->messages.back());
+        }
+    }
+}
+
+// 不低于flush_level的日志在append()返回前写出并刷新
+TEST(AsyncAppenderTest, FlushOnLevel) {
+    auto state = std::make_shared<CaptureAppender::State>();
+    AsyncAppenderOptions options;
+    options.flush_level = LogLevel::ERROR;
+    options.flush_timeout = std::chrono::milliseconds(5000);
+    options.flush_interval = std::chrono::milliseconds(60000);
+
+    AsyncAppender appender(std::make_unique<CaptureAppender>(state), options);
+    appender.append(makeRecord(LogLevel::INFO, "info"));
+    appender.append(makeRecord(LogLevel::ERROR, "error"));
+
+    EXPECT_EQ(2u, messageCount(*state));
+    EXPECT_GT(state->flushes.load(), 0);
+}
+
+// 析构时写出队列中剩余的日志
+TEST(AsyncAppenderTest, DestructorDrainsQueue) {
+    auto state = std::make_shared<CaptureAppender::State>();
+    {
+        AsyncAppender appender(std::make_unique<CaptureAppender>(state, std::chrono::microseconds(100)));
+        for (int i = 0; i < 100; ++i) {
+            appender.append(makeRecord(LogLevel::DEBUG, std::to_string(i)));
+        }
+    }
+    EXPECT_EQ(100u, messageCount(*state));
+}
+
+// 占位符个数在编译期检查
+static_assert(sdk::detail::countPlaceholders("a {} b {:>8} {{literal}}") == 2, "placeholder count");
+static_assert(sdk::detail::countPlaceholders("unclosed {") == -1, "unclosed placeholder");
+static_assert(sdk::detail::countPlaceholders("positional {0}") == -1, "positional placeholder");
+
+TEST(LogFormatTest, SubstitutesPlaceholders) {
+    std::string out;
+    auto format = [&out](const char* fmt, auto&&... args) {
+        formatLogMessage(out, fmt, LogArgs::capture(args...));
+        return out;
+    };
+
+    EXPECT_EQ("Version: 1.2.3", format("Version: {}", std::string("1.2.3")));
+    EXPECT_EQ("42 -7 true x", format("{} {} {} {}", 42u, -7, true, 'x'));
+    EXPECT_EQ("0x1f|00042|  ab|ab  |*ab*", format("{:#x}|{:05}|{:>4}|{:<4}|{:*^4}", 31, 42, "ab", "ab", "ab"));
+    EXPECT_EQ("3.14 2.5 abc", format("{:.2f} {} {:.3}", 3.14159, 2.5, "abcdef"));
+    EXPECT_EQ("{} braces", format("{{}} braces"));
+
+    // 参数不足时保留占位符，多余的参数被忽略
+    EXPECT_EQ("1 {}", format("{} {}", 1));
+    EXPECT_EQ("1", format("{}", 1, 2));
+}
+
+TEST(LogFormatTest, LongStringsAreTruncated) {
+    std::string out;
+    std::string big(1000, 'a');
+    formatLogMessage(out, "{}!", LogArgs::capture(big));
+    EXPECT_LT(out.size(), big.size());
+    EXPECT_EQ('!', out.back());
+}
+
+// 字面量格式串通过异步输出器时在后台线程上格式化
+TEST(LogFormatTest, LoggerDefersFormattingToAsyncAppender) {
+    auto state = std::make_shared<CaptureAppender::State>();
+    Logger logger("deferred_format_test");
+    logger.setLevel(LogLevel::INFO);
+    logger.addAppender(std::make_unique<AsyncAppender>(std::make_unique<CaptureAppender>(state)));
+
+    std::string name = "worker";
+    SDK_LOG_INFO(&logger, "task {} finished in {:.1f} ms on {}", 7, 12.25, name);
+    logger.info(std::string("dynamic {}"), 1);
+    logger.flush();
+
+    ASSERT_EQ(2u, messageCount(*state));
+    EXPECT_EQ("task 7 finished in 12.2 ms on worker", state->messages[0]);
+    EXPECT_EQ("dynamic 1", state->messages[1]);
+}
+
+// 成员函数接口的const char*格式串可能来自临时缓冲区，写出前被覆盖也不影响结果
+TEST(LogFormatTest, MemberFormatDoesNotKeepFormatPointer) {
+    auto state = std::make_shared<CaptureAppender::State>();
+    Logger logger("transient_format_test");
+    logger.setLevel(LogLevel::INFO);
+    logger.addAppender(std::make_unique<AsyncAppender>(std::make_unique<CaptureAppender>(state)));
+
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "value {}");
+    logger.info(static_cast<const char*>(buffer), 42);
+    std::snprintf(buffer, sizeof(buffer), "overwritten");
+    logger.flush();
+
+    ASSERT_EQ(1u, messageCount(*state));
+    EXPECT_EQ("value 42", state->messages[0]);
+}
+
+// 二进制日志写出后可以还原级别、日志器名、时间戳与格式化结果
+TEST(BinaryLogTest, RoundTrip) {
+    const std::string path = "binary_log_test.bin";
+    auto now = std::chrono::system_clock::now();
+    {
+        BinaryFileAppender appender(path);
+        ASSERT_TRUE(appender.isOpen());
+
+        for (int i = 0; i < 3; ++i) {
+            LogRecord record = makeRecord(LogLevel::WARN, "");
+            record.logger_name = "binary";
+            record.timestamp = now + std::chrono::milliseconds(i);
+            record.format = "request {} took {:.1f} ms";
+            record.args = LogArgs::capture(i, 1.25 * i);
+            appender.append(record);
+        }
+
+        LogRecord text = makeRecord(LogLevel::ERROR, "plain text message");
+        text.file = "test_logging.cpp";
+        text.line = 42;
+        appender.append(text);
+    }
+
+    BinaryLogReader reader(path);
+    ASSERT_TRUE(reader.isOpen());
+
+    std::vector<BinaryLogEntry> entries;
+    BinaryLogEntry entry;
+    while (reader.next(entry)) {
+        formatRecordMessage(entry.record);
+        entries.push_back(entry);
+    }
+    EXPECT_FALSE(reader.corrupted());
+    ASSERT_EQ(4u, entries.size());
+
+    EXPECT_EQ("request 2 took 2.5 ms", entries[2].record.message);
+    EXPECT_EQ(LogLevel::WARN, entries[2].record.level);
+    EXPECT_EQ("binary", entries[2].record.logger_name);
+    EXPECT_EQ(std::chrono::duration_cast<std::chrono::microseconds>((now + std::chrono::milliseconds(2)).time_since_epoch()),
+              std::chrono::duration_cast<std::chrono::microseconds>(entries[2].record.timestamp.time_since_epoch()));
+    EXPECT_EQ(entries[0].thread, entries[3].thread);
+
+    EXPECT_EQ("plain text message", entries[3].record.message);
+    EXPECT_EQ("test_logging.cpp", entries[3].record.file);
+    EXPECT_EQ(42, entries[3].record.line);
+
+    std::remove(path.c_str());
+}
+
+// logWithContext的键值对作为结构化上下文写出，消息本身不变
+TEST(BinaryLogTest, LogWithContextKeepsStructuredContext) {
+    const std::string path = "binary_log_context_test.bin";
+    {
+        Logger logger("context_test");
+        logger.removeAllAppenders();
+        logger.addAppender(std::make_unique<BinaryFileAppender>(path));
+        logger.logWithContext(LogLevel::WARN, "login ok", {{"user", "alice"}, {"region", "eu"}});
+        logger.warn("no context");
+        logger.flush();
+    }
+
+    BinaryLogReader reader(path);
+    BinaryLogEntry entry;
+    ASSERT_TRUE(reader.next(entry));
+    formatRecordMessage(entry.record);
+    EXPECT_EQ("login ok", entry.record.message);
+    ASSERT_EQ(2u, entry.record.context.size());
+    ASSERT_NE(nullptr, entry.record.context.find("user"));
+    EXPECT_EQ("alice", *entry.record.context.find("user"));
+    EXPECT_EQ("eu", *entry.record.context.find("region"));
+
+    ASSERT_TRUE(reader.next(entry));
+    EXPECT_TRUE(entry.record.context.empty());
+    EXPECT_FALSE(reader.next(entry));
+    EXPECT_FALSE(reader.corrupted());
+    std::remove(path.c_str());
+
+    LogRecord record = makeRecord(LogLevel::INFO, "done");
+    record.context.add("id", "7");
+    EXPECT_EQ("done [id=7]", DefaultFormatter("%v").format(record));
+}
+
+// 同一地址上先后出现不同的格式串时，各自按内容登记
+TEST(BinaryLogTest, ReusedFormatAddressKeepsContent) {
+    const std::string path = "binary_log_reuse_test.bin";
+    {
+        BinaryFileAppender appender(path);
+        ASSERT_TRUE(appender.isOpen());
+
+        char format[32];
+        for (const char* text : {"first {}", "second {}", "first {}"}) {
+            std::snprintf(format, sizeof(format), "%s", text);
+            LogRecord record = makeRecord(LogLevel::INFO, "");
+            record.format = format;
+            record.args = LogArgs::capture(1);
+            appender.append(record);
+        }
+    }
+
+    BinaryLogReader reader(path);
+    std::vector<std::string> messages;
+    BinaryLogEntry entry;
+    while (reader.next(entry)) {
+        formatRecordMessage(entry.record);
+        messages.push_back(entry.record.message);
+    }
+    EXPECT_EQ((std::vector<std::string>{"first 1", "second 1", "first 1"}), messages);
+    std::remove(path.c_str());
+}
+
+// 轮转只在行边界处切分，历史文件按编号保留，所有行都能在文件中找到
+TEST(BufferedFileAppenderTest, RotatesAtLineBoundaries) {
+    const std::string path = "buffered_appender_test.log";
+    auto remove_files = [&path] {
+        std::remove(path.c_str());
+        for (int i = 1; i <= 4; ++i) {
+            std::remove((path + "." + std::to_string(i)).c_str());
+            std::remove((path + "." + std::to_string(i) + ".gz").c_str());
+        }
+    };
+    remove_files();
+
+    BufferedFileAppenderOptions options;
+    options.buffer_size = 256;
+    options.max_file_size = 1024;
+    options.max_files = 3;
+    {
+        BufferedFileAppender appender(path, options);
+        ASSERT_TRUE(appender.isOpen());
+        appender.setFormatter(std::make_unique<DefaultFormatter>("%v"));
+        for (int i = 0; i < 200; ++i) {
+            appender.append(makeRecord(LogLevel::INFO, "line " + std::to_string(i) + std::string(20, '.')));
+        }
+        appender.flush();
+        EXPECT_GE(appender.rotationCount(), 3u);
+    }
+
+    // 最新的行在当前文件中，历史文件中的行依次更早；超出max_files的历史文件被删除
+    std::vector<std::string> lines;
+    for (int i = 3; i >= 0; --i) {
+        std::ifstream file(i == 0 ? path : path + "." + std::to_string(i));
+        if (i == 3) {
+            EXPECT_TRUE(file.is_open());
+        }
+        std::string line;
+        size_t bytes = 0;
+        while (std::getline(file, line)) {
+            EXPECT_EQ(0u, line.rfind("line ", 0));
+            lines.push_back(line);
+            bytes += line.size() + 1;
+        }
+        EXPECT_LE(bytes, options.max_file_size);
+    }
+    std::ifstream dropped(path + ".4");
+    EXPECT_FALSE(dropped.is_open());
+
+    ASSERT_FALSE(lines.empty());
+    EXPECT_EQ("line 199" + std::string(20, '.'), lines.back());
+    int first = std::stoi(lines.front().substr(5));
+    for (size_t i = 0; i < lines.size(); ++i) {
+        EXPECT_EQ(first + static_cast<int>(i), std::stoi(lines[i].substr(5)));
+    }
+    remove_files();
+}
+
+TEST(BufferedFileAppenderTest, CompressesRotatedSegments) {
+    if (!BufferedFileAppender::compressionSupported(LogCompression::GZIP)) {
+        GTEST_SKIP() << "built without zlib";
+    }
+
+    const std::string path = "buffered_appender_gzip_test.log";
+    BufferedFileAppenderOptions options;
+    options.max_file_size = 512;
+    options.max_files = 1;
+    options.compression = LogCompression::GZIP;
+    {
+        BufferedFileAppender appender(path, options);
+        for (int i = 0; i < 40; ++i) {
+            appender.append(makeRecord(LogLevel::INFO, "compressed line " + std::to_string(i)));
+        }
+        appender.flush();
+    }
+
+    std::ifstream archive(path + ".1.gz", std::ios::binary);
+    ASSERT_TRUE(archive.is_open());
+    unsigned char magic[2] = {0, 0};
+    archive.read(reinterpret_cast<char*>(magic), 2);
+    EXPECT_EQ(0x1f, magic[0]);
+    EXPECT_EQ(0x8b, magic[1]);
+    archive.close();
+
+    std::remove(path.c_str());
+    std::remove((path + ".1.gz").c_str());
+}
+
+// 宏展开处的静态调用点携带源码位置，并且只登记一次
+TEST(LogCallSiteTest, MacrosCaptureSourceLocation) {
+    auto state = std::make_shared<CaptureAppender::State>();
+    Logger logger("call_site_test");
+    logger.setLevel(LogLevel::INFO);
+    logger.addAppender(std::make_unique<CaptureAppender>(state));
+
+    int expected_line = 0;
+    for (int i = 0; i < 3; ++i) {
+        expected_line = __LINE__ + 1;
+        SDK_LOG_WARN(&logger, "iteration {}", i);
+    }
+
+    ASSERT_EQ(3u, messageCount(*state));
+    EXPECT_EQ("iteration 2", state->messages.back());
+    EXPECT_EQ(expected_line, state->last_line);
+    EXPECT_NE(std::string::npos, state->last_file.find("test_logging.cpp"));
+    EXPECT_EQ("TestBody", state->last_function);
+
+    size_t matches = 0;
+    LogCallSite::forEach([&](LogCallSite& site) {
+        if (std::string(site.format()) == "iteration {}") {
+            ++matches;
+            EXPECT_EQ(LogLevel::WARN, site.level());
+            EXPECT_EQ(expected_line, site.location().line);
+            EXPECT_GT(site.id(), 0u);
+        }
+    });
+    EXPECT_EQ(1u, matches);
+}
+
+// 关闭的调用点不求值参数；规则先于调用点登记设置时在登记时生效
+TEST(LogCallSiteTest, DisabledSiteSkipsArgumentEvaluation) {
+    auto state = std::make_shared<CaptureAppender::State>();
+    Logger logger("site_switch_test");
+    logger.setLevel(LogLevel::INFO);
+    logger.addAppender(std::make_unique<CaptureAppender>(state));
+
+    int evaluations = 0;
+    auto argument = [&evaluations]() { return ++evaluations; };
+
+    const uint64_t suppressed_before = LogManager::getInstance().suppressedCount();
+    const int line = __LINE__ + 3;
+    LogManager::getInstance().setCallSiteEnabled("test_logging.cpp:" + std::to_string(line), false);
+    for (int i = 0; i < 5; ++i) {
+        SDK_LOG_INFO(&logger, "value {}", argument());
+    }
+    EXPECT_EQ(0, evaluations);
+    EXPECT_EQ(0u, messageCount(*state));
+    EXPECT_EQ(suppressed_before + 5, LogManager::getInstance().suppressedCount());
+
+    LogManager::getInstance().clearCallSiteRules();
+    SDK_LOG_INFO(&logger, "value {}", argument());
+    EXPECT_EQ(1, evaluations);
+
+    logger.setEnabled(false);
+    SDK_LOG_CRITICAL(&logger, "value {}", argument());
+    EXPECT_EQ(1, evaluations);
+    EXPECT_EQ(1u, messageCount(*state));
+}
+
+// 运行时开关对所有入口生效，不只是SDK_LOG_*宏
+TEST(LoggerTest, DisabledLoggerSilencesEveryEntryPoint) {
+    auto state = std::make_shared<CaptureAppender::State>();
+    Logger logger("enable_switch_test");
+    logger.setLevel(LogLevel::TRACE);
+    logger.addAppender(std::make_unique<CaptureAppender>(state));
+    logger.setEnabled(false);
+
+    logger.info(std::string("member"));
+    logger.warn("format {}", 1);
+    logger.log(LogLevel::ERROR, std::string("level"));
+    logger.log(LogLevel::ERROR, "level {}", 2);
+    logger.log_if(true, LogLevel::ERROR, "conditional {}", 3);
+    logger.logWithContext(LogLevel::ERROR, "context", {{"key", "value"}});
+    logger.logImpl(LogLevel::ERROR, "located", __FILE__, __LINE__, __func__);
+    SDK_LOG_ERROR(&logger, "macro {}", 4);
+    EXPECT_EQ(0u, messageCount(*state));
+
+    logger.setEnabled(true);
+    logger.log_if(true, LogLevel::ERROR, "conditional {}", 5);
+    logger.logWithContext(LogLevel::ERROR, "context", {{"key", "value"}});
+    EXPECT_EQ(2u, messageCount(*state));
+
+}
+
+TEST(LogCallSiteTest, SamplingAndRateLimit) {
+    auto state = std::make_shared<CaptureAppender::State>();
+    Logger logger("site_sampling_test");
+    logger.setLevel(LogLevel::INFO);
+    logger.addAppender(std::make_unique<CaptureAppender>(state));
+
+    const int sampled_line = __LINE__ + 3;
+    LogManager::getInstance().setCallSiteSampling("test_logging.cpp:" + std::to_string(sampled_line), 4);
+    for (int i = 0; i < 12; ++i) {
+        SDK_LOG_INFO(&logger, "sampled {}", i);
+    }
+    ASSERT_EQ(3u, messageCount(*state));
+    EXPECT_EQ("sampled 0", state->messages[0]);
+    EXPECT_EQ("sampled 4", state->messages[1]);
+
+    // 速率极低时只放行突发容量内的日志
+    const int limited_line = __LINE__ + 3;
+    LogManager::getInstance().setCallSiteRateLimit("test_logging.cpp:" + std::to_string(limited_line), 0.001, 2);
+    for (int i = 0; i < 10; ++i) {
+        SDK_LOG_INFO(&logger, "limited {}", i);
+    }
+    EXPECT_EQ(5u, messageCount(*state));
+    LogManager::getInstance().clearCallSiteRules();
+}
+
+// 文本输出器：记录Logger分发过来的整行
+class LineCaptureAppender : public LogAppender {
+public:
+    explicit LineCaptureAppender(std::unique_ptr<LogFormatter> formatter) {
+        formatter_ = std::move(formatter);
+    }
+
+    void append(const LogRecord& record) override {
+        std::string line;
+        formatter_->formatTo(record, line);
+        appendFormatted(record, line);
+    }
+
+    bool acceptsFormatted() const override { return true; }
+
+    void appendFormatted(const LogRecord&, std::string_view line) override {
+        lines.emplace_back(line);
+    }
+
+    void flush() override {}
+
+    std::vector<std::string> lines;
+};
+
+class CountingFormatter : public DefaultFormatter {
+public:
+    CountingFormatter(const std::string& pattern, std::atomic<int>& calls)
+        : DefaultFormatter(pattern), calls_(calls) {}
+
+    void formatTo(const LogRecord& record, std::string& out) override {
+        calls_++;
+        DefaultFormatter::formatTo(record, out);
+    }
+
+private:
+    std::atomic<int>& calls_;
+};
+
+// 过滤器在所有输出端之前执行，格式相同的输出器共享一次渲染
+TEST(LoggerPipelineTest, FiltersOnceAndSharesRenderedLines) {
+    Logger logger("pipeline_test");
+    logger.removeAllAppenders();
+    logger.setLevel(LogLevel::INFO);
+
+    std::atomic<int> calls{0};
+    auto first = std::make_unique<LineCaptureAppender>(std::make_unique<CountingFormatter>("%l %v", calls));
+    auto second = std::make_unique<LineCaptureAppender>(std::make_unique<CountingFormatter>("%l %v", calls));
+    auto json = std::make_unique<LineCaptureAppender>(std::make_unique<JsonFormatter>());
+    LineCaptureAppender* first_ptr = first.get();
+    LineCaptureAppender* second_ptr = second.get();
+    LineCaptureAppender* json_ptr = json.get();
+    logger.addAppender(std::move(first));
+    logger.addAppender(std::move(second));
+    logger.addAppender(std::move(json));
+    logger.addFilter(std::make_unique<LevelFilter>(LogLevel::WARN));
+
+    logger.info("filtered {}", 1);
+    logger.warn("shared {}", 2);
+
+    EXPECT_EQ(1, calls.load());
+    ASSERT_EQ(1u, first_ptr->lines.size());
+    ASSERT_EQ(1u, second_ptr->lines.size());
+    EXPECT_EQ("WARN shared 2", first_ptr->lines[0]);
+    EXPECT_EQ(first_ptr->lines[0], second_ptr->lines[0]);
+    ASSERT_EQ(1u, json_ptr->lines.size());
+    EXPECT_NE(std::string::npos, json_ptr->lines[0].find("\"message\":\"shared 2\""));
+}
+
+TEST(LogContextTest, InlineAndOverflowEntries) {
+    LogContext context;
+    for (int i = 0; i < 6; ++i) {
+        context.add("key" + std::to_string(i), std::to_string(i * i));
+    }
+
+    ASSERT_EQ(6u, context.size());
+    EXPECT_EQ("key5", context[5].first);
+    ASSERT_NE(nullptr, context.find("key4"));
+    EXPECT_EQ("16", *context.find("key4"));
+    EXPECT_EQ(nullptr, context.find("missing"));
+
+    LogContext copy;
+    copy = context;
+    EXPECT_EQ(6u, copy.size());
+    EXPECT_EQ("9", *copy.find("key3"));
+
+    context.clear();
+    EXPECT_TRUE(context.empty());
+    EXPECT_EQ(6u, copy.size());
+}
+
+TEST(FormatterTest, DefaultFormatterCompilesPattern) {
+    LogRecord record = makeRecord(LogLevel::WARN, "disk almost full");
+    record.logger_name = "storage";
+    record.file = "/src/storage/volume.cpp";
+    record.line = 87;
+    record.function = "checkSpace";
+
+    std::time_t second = 1700000000;
+    record.timestamp = std::chrono::system_clock::from_time_t(second) + std::chrono::milliseconds(42);
+
+    std::tm tm{};
+#ifdef _WIN32
+    localtime_s(&tm, &second);
+#else
+    localtime_r(&second, &tm);
+#endif
+    char date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", &tm);
+
+    DefaultFormatter formatter("[%Y-%m-%d %T.%e] [%l|%L] [%n] %s:%# %! %v 100%%");
+    EXPECT_EQ(std::string("[") + date + ".042] [WARN|W] [storage] volume.cpp:87 checkSpace disk almost full 100%",
+              formatter.format(record));
+
+    // 同一秒内只更新毫秒，跨秒后重新渲染
+    record.timestamp += std::chrono::milliseconds(500);
+    EXPECT_EQ(std::string("[") + date + ".542] [WARN|W] [storage] volume.cpp:87 checkSpace disk almost full 100%",
+              formatter.format(record));
+
+    record.timestamp += std::chrono::seconds(1);
+    std::time_t next = second + 1;
+#ifdef _WIN32
+    localtime_s(&tm, &next);
+#else
+    localtime_r(&next, &tm);
+#endif
+    std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", &tm);
+    std::string out = "prefix ";
+    formatter.formatTo(record, out);
+    EXPECT_EQ(std::string("prefix [") + date + ".542] [WARN|W] [storage] volume.cpp:87 checkSpace disk almost full 100%", out);
+}
+
+TEST(FormatterTest, JsonFormatterEscapesStrings) {
+    LogRecord record = makeRecord(LogLevel::ERROR, "say \"hi\"\n\tpath=C:\\tmp \x01");
+    record.logger_name = "json";
+    record.line = 3;
+    record.timestamp = std::chrono::system_clock::time_point(std::chrono::milliseconds(1234));
+    record.context.add("user", "a\"b");
+
+    JsonFormatter formatter;
+    EXPECT_EQ("{\"timestamp\":\"1234\",\"level\":\"4\",\"logger\":\"json\","
+              "\"message\":\"say \\\"hi\\\"\\n\\tpath=C:\\\\tmp \\u0001\",\"file\":\"\",\"line\":3,"
+              "\"function\":\"\",\"context\":{\"user\":\"a\\\"b\"}}",
+              formatter.format(record));
+}
+
+// C接口的便利宏与上面使用的C++宏同名，放在文件末尾包含
+#undef SDK_LOG_TRACE
+#undef SDK_LOG_DEBUG
+#undef SDK_LOG_INFO
+#undef SDK_LOG_WARN
+#undef SDK_LOG_ERROR
+#undef SDK_LOG_CRITICAL
+#include <sdk/sdk_c_api.h>
+
+// C接口经由默认日志器输出，同样受运行时开关控制
+TEST(LoggerTest, DisabledLoggerSilencesCApi) {
+    auto default_state = std::make_shared<CaptureAppender::State>();
+    auto default_logger = log::getDefault();
+    default_logger->addAppender(std::make_unique<CaptureAppender>(default_state));
+    ASSERT_TRUE(sdk_log_set_logger_enabled("default", false));
+    sdk_log(SDK_LOG_LEVEL_ERROR, "c api %d", 6);
+    sdk_log_with_context(SDK_LOG_LEVEL_ERROR, __FILE__, __LINE__, __func__, "c api %d", 7);
+    EXPECT_EQ(0u, messageCount(*default_state));
+
+    ASSERT_TRUE(sdk_log_set_logger_enabled("default", true));
+    sdk_log(SDK_LOG_LEVEL_ERROR, "c api %d", 8);
+    EXPECT_EQ(1u, messageCount(*default_state));
+}
@@ -0,0 +1,311 @@
+#include <gtest/gtest.h>
+#include <sdk/metrics/metrics.h>
+#include <sdk/metrics/metrics_reporter.h>
+#include <sdk/metrics/tracing.h>
+#include <sdk/network/http_client.h>
+#include <sdk/platform/platform_utils.h>
+#include <sdk/threading/thread_pool.h>
+#include <sdk/sdk_c_api.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sdk;
+
+// 桶上界相对误差不超过1/32，且相邻桶首尾相接
+TEST(LatencyHistogramTest, BucketsCoverRangeWithBoundedError) {
+    for (uint64_t value : {0ull, 1ull, 31ull, 32ull, 33ull, 1000ull, 123456ull, 1ull << 35}) {
+        size_t index = LatencyHistogram::bucketIndex(value);
+        uint64_t upper = LatencyHistogram::bucketUpperBound(index);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(upper - value, value / 32) << value;
+        if (index > 0) {
+            EXPECT_LT(LatencyHistogram::bucketUpperBound(index - 1), value);
+        }
+    }
+
+    // 超出范围的值记入最后一个桶
+    EXPECT_EQ(LatencyHistogram::kBucketCount - 1, LatencyHistogram::bucketIndex(UINT64_MAX));
+    EXPECT_EQ(LatencyHistogram::kMaxValueUs, LatencyHistogram::bucketUpperBound(LatencyHistogram::kBucketCount - 1));
+}
+
+TEST(LatencyHistogramTest, ReportsPercentiles) {
+    LatencyHistogram histogram;
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        histogram.recordMicros(i);
+    }
+    histogram.record(std::chrono::milliseconds(50));
+
+    LatencySummary summary = histogram.snapshot().summary();
+    EXPECT_EQ(1001u, summary.count);
+    EXPECT_NEAR(500.0, static_cast<double>(summary.p50_us), 500.0 / 32);
+    EXPECT_NEAR(990.0, static_cast<double>(summary.p99_us), 990.0 / 32);
+    EXPECT_NEAR(1000.0, static_cast<double>(summary.p999_us), 1000.0 / 32);
+    EXPECT_EQ(50000u, summary.max_us);
+    EXPECT_NEAR((500500.0 + 50000.0) / 1001.0, summary.mean_us, 1e-9);
+    EXPECT_DOUBLE_EQ(summary.mean_us, histogram.meanMicros());
+
+    histogram.reset();
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(0u, histogram.snapshot().percentile(0.5));
+}
+
+// 多个线程并发写入不同分片，快照合并后不丢样本
+TEST(LatencyHistogramTest, MergesConcurrentShards) {
+    LatencyHistogram histogram;
+    ShardedCounter counter;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 10000; ++i) {
+                histogram.recordMicros(static_cast<uint64_t>(t * 100 + i % 100));
+                counter.add();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    HistogramSnapshot snapshot = histogram.snapshot();
+    EXPECT_EQ(80000u, snapshot.count);
+    EXPECT_EQ(80000u, histogram.count());
+    EXPECT_EQ(799u, snapshot.max_us);
+    EXPECT_EQ(80000u, counter.value());
+}
+
+// 同名实例在登记表中合并，销毁的实例不再计入
+TEST(MetricsRegistryTest, MergesInstancesByName) {
+    auto& registry = MetricsRegistry::getInstance();
+    auto first = registry.createHistogram("test.registry");
+    auto second = registry.createHistogram("test.registry");
+    first->recordMicros(10);
+    second->recordMicros(20);
+    second->recordMicros(30);
+
+    HistogramSnapshot merged;
+    ASSERT_TRUE(registry.snapshot("test.registry", merged));
+    EXPECT_EQ(3u, merged.count);
+    EXPECT_EQ(60u, merged.sum_us);
+    EXPECT_EQ(30u, merged.max_us);
+
+    sdk_latency_summary_t summary;
+    ASSERT_TRUE(sdk_metrics_get_latency("test.registry", &summary));
+    EXPECT_EQ(3u, summary.count);
+    EXPECT_EQ(20u, summary.p50_us);
+
+    second.reset();
+    ASSERT_TRUE(registry.snapshot("test.registry", merged));
+    EXPECT_EQ(1u, merged.count);
+
+    EXPECT_FALSE(registry.snapshot("test.missing", merged));
+    EXPECT_FALSE(sdk_metrics_get_latency("test.missing", &summary));
+}
+
+// 标签转义、分位数换算为秒，以及_sum/_count序列
+TEST(MetricsReporterTest, EncodesPrometheusText) {
+    MetricsSnapshot snapshot;
+    snapshot.timestamp_ms = 1700000000000;
+    snapshot.gauges.emplace_back("sdk_test_gauge", 2.5);
+    snapshot.counters.emplace_back("sdk_test_total", 7);
+    LatencySummary summary;
+    summary.count = 4;
+    summary.mean_us = 1500.0;
+    summary.p50_us = 1000;
+    summary.p90_us = 2000;
+    summary.p99_us = 2000;
+    summary.p999_us = 2000;
+    summary.max_us = 2000;
+    snapshot.summaries.emplace_back("sdk_test_seconds", summary);
+
+    std::string text = MetricsReporter::encode(snapshot, {{"app", "de\"mo"}}, true);
+    EXPECT_NE(std::string::npos, text.find("# TYPE sdk_test_gauge gauge\nsdk_test_gauge{app=\"de\\\"mo\"} 2.5 1700000000000\n"));
+    EXPECT_NE(std::string::npos, text.find("# TYPE sdk_test_total counter\n"));
+    EXPECT_NE(std::string::npos, text.find("# TYPE sdk_test_seconds summary\n"));
+    EXPECT_NE(std::string::npos, text.find("sdk_test_seconds{app=\"de\\\"mo\",quantile=\"0.5\"} 0.001 1700000000000\n"));
+    EXPECT_NE(std::string::npos, text.find("sdk_test_seconds_sum{app=\"de\\\"mo\"} 0.006 1700000000000\n"));
+    EXPECT_NE(std::string::npos, text.find("sdk_test_seconds_count{app=\"de\\\"mo\"} 4 1700000000000\n"));
+
+    text = MetricsReporter::encode(snapshot, {}, false);
+    EXPECT_NE(std::string::npos, text.find("sdk_test_gauge 2.5\n"));
+}
+
+// 本地拉取端点返回最近一次采样，其他路径返回404
+TEST(MetricsReporterTest, ServesPullEndpoint) {
+    auto pool = std::make_shared<ThreadPool>(2);
+    auto client = std::make_shared<HttpClient>();
+    MetricsReporterOptions options;
+    options.interval = std::chrono::hours(1);
+    options.labels["app"] = "test";
+    options.listen = true;
+    options.listen_port = 0;
+
+    MetricsReporter reporter(options, pool, nullptr);
+    ASSERT_NE(0, reporter.listenPort());
+    reporter.sampleNow();
+
+    std::string base = "http://127.0.0.1:" + std::to_string(reporter.listenPort());
+    HttpResponse response = client->get(base + "/metrics");
+    EXPECT_EQ(200, response.getStatusCode());
+    EXPECT_NE(std::string::npos, response.getBody().find("sdk_thread_pool_threads{app=\"test\"} 2\n"));
+    EXPECT_NE(std::string::npos, response.getBody().find("# TYPE sdk_process_cpu_usage_percent gauge"));
+    EXPECT_EQ(404, client->get(base + "/other").getStatusCode());
+
+    MetricsReporter::Stats stats = reporter.getStats();
+    EXPECT_EQ(1u, stats.samples);
+    EXPECT_EQ(1u, stats.scrapes);
+    EXPECT_THROW(MetricsReporter(options, nullptr, nullptr), std::invalid_argument);
+}
+
+TEST(MetricsReporterTest, CpuUsageIsPercentage) {
+    platform::PlatformUtils::getCpuUsage();
+    volatile uint64_t sink = 0;
+    for (uint64_t i = 0; i < 10000000; ++i) {
+        sink = sink + i;
+    }
+    double usage = platform::PlatformUtils::getCpuUsage();
+    EXPECT_GE(usage, 0.0);
+    EXPECT_LE(usage, 100.0);
+}
+
+// 上报器的CPU采样区间不会被其他调用方的采样重置
+TEST(MetricsReporterTest, CpuUsageIntervalIsPerReporter) {
+    auto pool = std::make_shared<ThreadPool>(2);
+    auto client = std::make_shared<HttpClient>();
+    MetricsReporterOptions options;
+    options.interval = std::chrono::hours(1);
+    options.listen = true;
+    options.listen_port = 0;
+    MetricsReporter reporter(options, pool, nullptr);
+    ASSERT_NE(0, reporter.listenPort());
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    volatile uint64_t sink = 0;
+    while (std::chrono::steady_clock::now() < deadline) {
+        sink = sink + 1;
+    }
+    // 其他调用方在繁忙区间之后采样，随后的空闲区间不应覆盖上报器看到的繁忙区间
+    MetricsReporter::collect(nullptr, nullptr);
+    platform::PlatformUtils::getCpuUsage();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    reporter.sampleNow();
+
+    std::string body = client->get("http://127.0.0.1:" + std::to_string(reporter.listenPort()) + "/metrics").getBody();
+    const std::string name = "\nsdk_process_cpu_usage_percent ";
+    size_t pos = body.find(name);
+    ASSERT_NE(std::string::npos, pos);
+    double usage = std::stod(body.substr(pos + name.size()));
+    uint32_t cores = std::max<uint32_t>(platform::PlatformUtils::getCpuCoreCount(), 1);
+    EXPECT_GT(usage, 20.0 / cores);
+    EXPECT_LE(usage, 100.0);
+}
+
+// 线程池任务的排队区间跨线程配对，执行区间记录在工作线程上
+TEST(TracerTest, RecordsThreadPoolTimeline) {
+    Tracer& tracer = Tracer::getInstance();
+    tracer.start();
+    {
+        ThreadPool pool(2);
+        std::vector<std::future<int>> results;
+        for (int i = 0; i < 8; ++i) {
+            results.push_back(pool.submit([i] { return i; }));
+        }
+        for (auto& result : results) {
+            result.get();
+        }
+        {
+            TraceSpan span("test", "test.span");
+            span.setArg("items", 8);
+        }
+    }
+    tracer.stop();
+
+    // 停止后不再记录
+    size_t events = tracer.eventCount();
+    { SDK_TRACE_SPAN("test", "test.after_stop"); }
+    EXPECT_EQ(events, tracer.eventCount());
+
+    std::string json = tracer.toChromeTraceJson();
+    EXPECT_EQ(0u, json.find("{\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, json.find("{\"name\":\"task.queue\",\"cat\":\"thread_pool\",\"ph\":\"b\""));
+    EXPECT_NE(std::string::npos, json.find("{\"name\":\"task.queue\",\"cat\":\"thread_pool\",\"ph\":\"e\""));
+    EXPECT_NE(std::string::npos, json.find("{\"name\":\"task.run\",\"cat\":\"thread_pool\",\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, json.find("\"args\":{\"items\":8}"));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"thread_name\""));
+    EXPECT_EQ(std::string::npos, json.find("test.after_stop"));
+
+    std::string path = "trace_test.json";
+    ASSERT_TRUE(tracer.writeChromeTrace(path));
+    std::ifstream in(path);
+    std::stringstream content;
+    content << in.rdbuf();
+    EXPECT_EQ(json, content.str());
+    std::remove(path.c_str());
+}
+
+// 队列写满被拒绝的任务不记录排队区间，开始与结束事件数量一致
+TEST(TracerTest, RejectedTasksLeaveNoQueueSpan) {
+    Tracer& tracer = Tracer::getInstance();
+    tracer.start();
+    {
+        ThreadPoolConfig config;
+        config.thread_count = 1;
+        config.queue_backend = QueueBackend::RING_BUFFER;
+        config.ring_capacity = 4;
+        config.overflow_policy = QueueOverflowPolicy::REJECT;
+        ThreadPool pool(config);
+        
+        std::promise<void> release;
+        std::shared_future<void> gate = release.get_future().share();
+        pool.post([gate] { gate.wait(); });
+        
+        int rejected = 0;
+        for (int i = 0; i < 32; ++i) {
+            try {
+                pool.post([] {});
+            } catch (const std::runtime_error&) {
+                ++rejected;
+            }
+        }
+        EXPECT_GT(rejected, 0);
+        release.set_value();
+        pool.waitForAll();
+    }
+    tracer.stop();
+
+    auto count = [](const std::string& json, const std::string& needle) {
+        size_t n = 0;
+        for (size_t pos = json.find(needle); pos != std::string::npos; pos = json.find(needle, pos + 1)) {
+            ++n;
+        }
+        return n;
+    };
+    std::string json = tracer.toChromeTraceJson();
+    size_t begins = count(json, "{\"name\":\"task.queue\",\"cat\":\"thread_pool\",\"ph\":\"b\"");
+    EXPECT_GT(begins, 0u);
+    EXPECT_EQ(begins, count(json, "{\"name\":\"task.queue\",\"cat\":\"thread_pool\",\"ph\":\"e\""));
+}
+
+// 超出每线程容量的事件计入丢弃数，新会话丢弃旧事件
+TEST(TracerTest, BoundsEventsPerThread) {
+    Tracer& tracer = Tracer::getInstance();
+    tracer.start(10);
+    for (int i = 0; i < 25; ++i) {
+        SDK_TRACE_SPAN("test", "test.bounded");
+    }
+    tracer.stop();
+    EXPECT_EQ(10u, tracer.eventCount());
+    EXPECT_EQ(15u, tracer.droppedEvents());
+
+    tracer.start();
+    tracer.stop();
+    EXPECT_EQ(0u, tracer.eventCount());
+    EXPECT_EQ(0u, tracer.droppedEvents());
+    EXPECT_EQ(std::string::npos, tracer.toChromeTraceJson().find("test.bounded"));
+}
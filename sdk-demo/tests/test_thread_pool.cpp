@@ -1,10 +1,15 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <sdk/threading/thread_pool.h>
+#include <sdk/threading/future.h>
+#include <sdk/threading/task_graph.h>
+#include <sdk/threading/task_group.h>
+#include <sdk/threading/task_queue.h>
 #include <atomic>
 #include <vector>
 #include <future>
 #include <chrono>
+#include <array>
 
 using namespace sdk;
 
@@ -200,6 +205,13 @@ TEST_F(ThreadPoolTest, Statistics) {
     auto stats_after = pool_->getStats();
     EXPECT_EQ(4, stats_after.thread_count);
     EXPECT_EQ(5, stats_after.completed_tasks);
+    
+    // 耗时分布为微秒精度，平均值由同一直方图计算
+    EXPECT_EQ(5u, stats_after.run_time.count);
+    EXPECT_EQ(5u, stats_after.queue_wait.count);
+    EXPECT_GE(stats_after.run_time.p50_us, 9000u);
+    EXPECT_GE(stats_after.run_time.p999_us, stats_after.run_time.p50_us);
+    EXPECT_NEAR(stats_after.run_time.mean_us / 1000.0, stats_after.average_task_duration_ms, 1e-9);
 }
 
 // 关闭测试
@@ -266,3 +278,807 @@ TEST_F(ThreadPoolTest, StressTest) {
     std::cout << "Throughput: " << (task_count * 1000.0 / duration.count()) 
               << " tasks/second" << std::endl;
 }
+
+// 工作窃取模式测试
+class WorkStealingThreadPoolTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ThreadPoolConfig config;
+        config.thread_count = 4;
+        config.scheduling_mode = SchedulingMode::WORK_STEALING;
+        pool_ = std::make_unique<ThreadPool>(config);
+    }
+    
+    void TearDown() override {
+        if (pool_) {
+            pool_->shutdown();
+            pool_.reset();
+        }
+    }
+    
+    std::unique_ptr<ThreadPool> pool_;
+};
+
+TEST_F(WorkStealingThreadPoolTest, ConcurrentTasks) {
+    EXPECT_EQ(SchedulingMode::WORK_STEALING, pool_->schedulingMode());
+    
+    const int task_count = 1000;
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < task_count; ++i) {
+        futures.push_back(pool_->submit([i]() {
+            return i * 2;
+        }));
+    }
+    
+    for (int i = 0; i < task_count; ++i) {
+        EXPECT_EQ(i * 2, futures[i].get());
+    }
+}
+
+// 工作线程内提交的子任务进入本地队列，并能被其他线程窃取执行
+TEST_F(WorkStealingThreadPoolTest, NestedSubmission) {
+    const int parent_count = 8;
+    const int child_count = 100;
+    std::atomic<int> counter{0};
+    
+    for (int i = 0; i < parent_count; ++i) {
+        pool_->submit([this, &counter]() {
+            for (int j = 0; j < child_count; ++j) {
+                pool_->submit([&counter]() {
+                    counter.fetch_add(1);
+                });
+            }
+        });
+    }
+    
+    EXPECT_TRUE(pool_->waitFor(std::chrono::seconds(5)));
+    EXPECT_EQ(parent_count * child_count, counter.load());
+    EXPECT_EQ(0u, pool_->pendingTasks());
+    EXPECT_EQ(static_cast<size_t>(parent_count * child_count + parent_count), 
+              pool_->getStats().completed_tasks);
+}
+
+TEST_F(WorkStealingThreadPoolTest, CancelPendingTasks) {
+    std::promise<void> gate;
+    std::shared_future<void> gate_future = gate.get_future().share();
+    
+    // 占满所有工作线程
+    for (int i = 0; i < 4; ++i) {
+        pool_->submit([gate_future]() { gate_future.wait(); });
+    }
+    
+    std::atomic<int> executed{0};
+    for (int i = 0; i < 100; ++i) {
+        pool_->submit(TaskPriority::LOW, [&executed]() { executed.fetch_add(1); });
+    }
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    pool_->cancelPendingTasks();
+    EXPECT_EQ(0u, pool_->pendingTasks());
+    
+    gate.set_value();
+    pool_->waitForAll();
+    EXPECT_EQ(0, executed.load());
+}
+
+// 轻量级提交测试
+TEST_F(ThreadPoolTest, PostLightweightTasks) {
+    const int task_count = 10000;
+    std::atomic<int> counter{0};
+    
+    uint64_t last_id = 0;
+    for (int i = 0; i < task_count; ++i) {
+        uint64_t id = pool_->post([&counter]() {
+            counter.fetch_add(1);
+        });
+        EXPECT_GT(id, last_id);
+        last_id = id;
+    }
+    
+    pool_->waitForAll();
+    EXPECT_EQ(task_count, counter.load());
+    EXPECT_EQ(static_cast<size_t>(task_count), pool_->getStats().completed_tasks);
+    
+    // post()提交的任务不产生TaskInfo
+    EXPECT_TRUE(pool_->getTaskInfos().empty());
+}
+
+// 超出内联缓冲区的捕获走任务节点池
+TEST_F(ThreadPoolTest, PostLargeCapture) {
+    std::array<uint64_t, 12> payload{};
+    payload.fill(7);
+    std::atomic<uint64_t> sum{0};
+    
+    for (int i = 0; i < 100; ++i) {
+        pool_->post(TaskPriority::HIGH, [payload, &sum]() {
+            uint64_t local = 0;
+            for (auto value : payload) {
+                local += value;
+            }
+            sum.fetch_add(local);
+        });
+    }
+    
+    pool_->waitForAll();
+    EXPECT_EQ(100u * 12u * 7u, sum.load());
+}
+
+TEST_F(ThreadPoolTest, PostExceptionCountsAsFailed) {
+    pool_->post([]() {
+        throw std::runtime_error("post failure");
+    });
+    
+    pool_->waitForAll();
+    EXPECT_EQ(1u, pool_->getStats().failed_tasks);
+}
+
+TEST(TaskFunctionTest, MoveOnlyCallable) {
+    auto value = std::make_unique<int>(41);
+    int result = 0;
+    
+    TaskFunction function([value = std::move(value), &result]() {
+        result = *value + 1;
+    });
+    TaskFunction moved(std::move(function));
+    
+    EXPECT_FALSE(static_cast<bool>(function));
+    ASSERT_TRUE(static_cast<bool>(moved));
+    moved();
+    EXPECT_EQ(42, result);
+}
+
+// 任务记录表容量固定，只保留最近的记录
+TEST(TaskRegistryTest, HistoryIsBounded) {
+    ThreadPoolConfig config;
+    config.thread_count = 4;
+    config.task_history_capacity = 32;
+    ThreadPool pool(config);
+    
+    for (int i = 0; i < 1000; ++i) {
+        pool.submit("job_" + std::to_string(i), TaskPriority::NORMAL, []() {});
+    }
+    pool.waitForAll();
+    
+    EXPECT_LE(pool.getTaskInfos().size(), 32u);
+    
+    TaskInfo info;
+    ASSERT_TRUE(pool.getTaskInfo("job_999", info));
+    EXPECT_EQ(TaskStatus::COMPLETED, info.status);
+    EXPECT_FALSE(pool.getTaskInfo("job_0", info));
+}
+
+// 按名字查找：同名任务返回最近一次提交，记录被覆盖后名字不再可查
+TEST(TaskRegistryTest, NameLookupFollowsLatestRecord) {
+    ThreadPoolConfig config;
+    config.thread_count = 2;
+    config.task_history_capacity = 16;
+    ThreadPool pool(config);
+    
+    pool.submit("dup", TaskPriority::NORMAL, []() {});
+    pool.submit("dup", TaskPriority::HIGH, []() {});
+    for (int i = 0; i < 15; ++i) {
+        pool.submit("job_" + std::to_string(i), TaskPriority::NORMAL, []() {});
+    }
+    pool.waitForAll();
+    
+    // 第一条dup的槽位已被覆盖，名字仍指向第二条
+    TaskInfo info;
+    ASSERT_TRUE(pool.getTaskInfo("dup", info));
+    EXPECT_EQ(TaskPriority::HIGH, info.priority);
+    ASSERT_TRUE(pool.getTaskInfo("job_0", info));
+    EXPECT_EQ("job_0", info.id);
+    
+    pool.submit("last", TaskPriority::NORMAL, []() {}).get();
+    EXPECT_FALSE(pool.getTaskInfo("dup", info));
+    EXPECT_FALSE(pool.getTaskInfo("missing", info));
+}
+
+// 已取消的待处理任务不会被执行
+TEST(TaskRegistryTest, CancelledTaskIsSkipped) {
+    ThreadPool pool(1);
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    std::atomic<bool> executed{false};
+    
+    pool.submit([gate]() { gate.wait(); });
+    auto victim = pool.submit("victim", TaskPriority::NORMAL, [&executed]() {
+        executed.store(true);
+    });
+    
+    EXPECT_TRUE(pool.cancelTask("victim"));
+    EXPECT_FALSE(pool.cancelTask("victim"));
+    release.set_value();
+    
+    EXPECT_THROW(victim.get(), std::future_error);
+    pool.waitForAll();
+    EXPECT_FALSE(executed.load());
+    
+    TaskInfo info;
+    ASSERT_TRUE(pool.getTaskInfo("victim", info));
+    EXPECT_EQ(TaskStatus::CANCELLED, info.status);
+}
+
+// 已结束的记录超过保留时长后不再出现在快照中
+TEST(TaskRegistryTest, TimeBasedRetention) {
+    ThreadPoolConfig config;
+    config.thread_count = 2;
+    config.task_history_retention = std::chrono::milliseconds(1);
+    ThreadPool pool(config);
+    
+    pool.submit([]() {}).get();
+    pool.waitForAll();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    
+    EXPECT_TRUE(pool.getTaskInfos().empty());
+}
+
+// 批量提交测试
+TEST_F(ThreadPoolTest, SubmitBatch) {
+    std::vector<int> values(1000);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<int>(i);
+    }
+    std::atomic<long> sum{0};
+    
+    BatchHandle batch = pool_->submitBatch(values, [&sum](int value) {
+        sum.fetch_add(value);
+    });
+    batch.wait();
+    
+    EXPECT_TRUE(batch.isDone());
+    EXPECT_EQ(values.size(), batch.size());
+    EXPECT_EQ(999L * 1000 / 2, sum.load());
+}
+
+TEST_F(WorkStealingThreadPoolTest, ParallelFor) {
+    std::vector<int> hits(10007, 0);
+    
+    BatchHandle batch = pool_->parallelFor<size_t>(0, hits.size(), 64, [&hits](size_t i) {
+        hits[i]++;
+    });
+    batch.get();
+    
+    EXPECT_EQ((hits.size() + 63) / 64, batch.size());
+    EXPECT_TRUE(std::all_of(hits.begin(), hits.end(), [](int h) { return h == 1; }));
+}
+
+// 子任务异常通过聚合句柄传播，被丢弃的子任务也会结束等待
+TEST_F(ThreadPoolTest, BatchFailureAndCancellation) {
+    BatchHandle failing = pool_->parallelFor(0, 100, 0, [](int i) {
+        if (i == 42) {
+            throw std::runtime_error("bad index");
+        }
+    });
+    EXPECT_THROW(failing.get(), std::runtime_error);
+    EXPECT_EQ(1u, failing.failedCount());
+    
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    for (int i = 0; i < 4; ++i) {
+        pool_->post([gate]() { gate.wait(); });
+    }
+    while (pool_->activeThreads() < 4) {
+        std::this_thread::yield();
+    }
+    
+    BatchHandle blocked = pool_->parallelFor(0, 16, 1, [](int) {});
+    pool_->cancelPendingTasks();
+    release.set_value();
+    
+    EXPECT_TRUE(blocked.waitFor(std::chrono::seconds(5)));
+    EXPECT_EQ(16u, blocked.droppedCount());
+}
+
+// 收缩后被回收线程本地队列中的任务仍会被执行
+TEST_F(WorkStealingThreadPoolTest, ShrinkKeepsQueuedTasks) {
+    std::atomic<int> counter{0};
+    for (int i = 0; i < 1000; ++i) {
+        pool_->post([&counter]() { counter.fetch_add(1); });
+    }
+    
+    pool_->resize(1);
+    EXPECT_EQ(1u, pool_->size());
+    
+    pool_->waitForAll();
+    EXPECT_EQ(1000, counter.load());
+    
+    pool_->resize(3);
+    EXPECT_EQ(3u, pool_->size());
+    pool_->submit([]() {}).get();
+}
+
+// 并发收缩与扩容：正在退出的线程不会被重新启用，resize不会卡在join上
+TEST_F(WorkStealingThreadPoolTest, ConcurrentShrinkAndGrow) {
+    std::atomic<int> counter{0};
+    for (int i = 0; i < 1000; ++i) {
+        pool_->post([&counter]() { counter.fetch_add(1); });
+    }
+    
+    auto shrink = std::async(std::launch::async, [this]() {
+        for (int i = 0; i < 50; ++i) pool_->resize(1);
+    });
+    auto grow = std::async(std::launch::async, [this]() {
+        for (int i = 0; i < 50; ++i) pool_->resize(4);
+    });
+    ASSERT_EQ(std::future_status::ready, shrink.wait_for(std::chrono::seconds(10)));
+    ASSERT_EQ(std::future_status::ready, grow.wait_for(std::chrono::seconds(10)));
+    
+    pool_->waitForAll();
+    EXPECT_EQ(1000, counter.load());
+    pool_->submit([]() {}).get();
+}
+
+// 与shutdown并发的提交要么被拒绝，要么在shutdown返回前执行完毕
+TEST(ThreadPoolShutdownTest, ConcurrentSubmitIsRunOrRejected) {
+    for (auto backend : {QueueBackend::PRIORITY_HEAP, QueueBackend::RING_BUFFER}) {
+        for (int round = 0; round < 50; ++round) {
+            ThreadPoolConfig config;
+            config.thread_count = 2;
+            config.scheduling_mode = backend == QueueBackend::RING_BUFFER ? SchedulingMode::SHARED_QUEUE
+                                                                          : SchedulingMode::WORK_STEALING;
+            config.queue_backend = backend;
+            ThreadPool pool(config);
+            
+            std::atomic<bool> go{false};
+            std::vector<std::future<void>> accepted;
+            std::thread producer([&] {
+                while (!go.load()) {
+                    std::this_thread::yield();
+                }
+                for (int i = 0; i < 2000; ++i) {
+                    try {
+                        accepted.push_back(pool.submit([] {}));
+                        std::vector<int> items{1, 2, 3};
+                        pool.submitBatch(items.begin(), items.end(), [](int) {});
+                    } catch (const std::runtime_error&) {
+                        break;
+                    }
+                }
+            });
+            go.store(true);
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            pool.shutdown();
+            producer.join();
+            
+            for (auto& future : accepted) {
+                ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(0)));
+            }
+            EXPECT_TRUE(pool.waitFor(std::chrono::milliseconds(100)));
+        }
+    }
+}
+
+// 自动伸缩：积压时扩容，空闲后收缩回下限
+TEST(AutoScaleTest, GrowsUnderLoadAndShrinksWhenIdle) {
+    ThreadPoolConfig config;
+    config.thread_count = 1;
+    config.max_threads = 4;
+    config.auto_scale.enabled = true;
+    config.auto_scale.min_threads = 1;
+    config.auto_scale.max_threads = 4;
+    config.auto_scale.queue_depth_per_thread = 2;
+    config.auto_scale.check_interval = std::chrono::milliseconds(5);
+    config.auto_scale.idle_timeout = std::chrono::milliseconds(50);
+    ThreadPool pool(config);
+    
+    size_t peak = pool.size();
+    for (int i = 0; i < 200; ++i) {
+        pool.post([]() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); });
+    }
+    while (pool.pendingTasks() > 0) {
+        peak = std::max(peak, pool.size());
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    pool.waitForAll();
+    EXPECT_GT(peak, 1u);
+    EXPECT_LE(peak, 4u);
+    
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (pool.size() > 1 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(1u, pool.size());
+}
+
+// 定时任务测试
+TEST_F(ThreadPoolTest, ScheduleDelayedTask) {
+    std::promise<std::chrono::steady_clock::time_point> fired;
+    auto future = fired.get_future();
+    
+    auto start = std::chrono::steady_clock::now();
+    TimerId timer_id = pool_->schedule(std::chrono::milliseconds(30), [&fired]() {
+        fired.set_value(std::chrono::steady_clock::now());
+    });
+    EXPECT_NE(0u, timer_id);
+    
+    ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds(5)));
+    EXPECT_GE(future.get() - start, std::chrono::milliseconds(30));
+    EXPECT_FALSE(pool_->cancelTimer(timer_id));
+}
+
+TEST_F(ThreadPoolTest, CancelScheduledTasks) {
+    std::atomic<int> fired{0};
+    std::vector<TimerId> timers;
+    for (int i = 0; i < 2000; ++i) {
+        timers.push_back(pool_->schedule(std::chrono::milliseconds(50 + i % 100), [&fired]() {
+            fired.fetch_add(1);
+        }));
+    }
+    for (size_t i = 0; i < timers.size(); i += 2) {
+        EXPECT_TRUE(pool_->cancelTimer(timers[i]));
+    }
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    pool_->waitForAll();
+    EXPECT_EQ(1000, fired.load());
+}
+
+TEST_F(ThreadPoolTest, ScheduleAtFixedRate) {
+    std::atomic<int> runs{0};
+    TimerId timer_id = pool_->scheduleAtFixedRate(std::chrono::milliseconds(10), [&runs]() {
+        runs.fetch_add(1);
+    });
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_TRUE(pool_->cancelTimer(timer_id));
+    pool_->waitForAll();
+    
+    int after_cancel = runs.load();
+    EXPECT_GE(after_cancel, 5);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(after_cancel, runs.load());
+}
+
+// CPU绑定与QoS：绑定后任务正常执行，每个工作线程运行在分配给它的CPU上
+TEST(AffinityTest, PinnedWorkersRunTasks) {
+    // 受限的cpuset中可能无法绑定到0号CPU，先在独立线程上探测
+    bool pinnable = false;
+    std::thread([&pinnable]() {
+        pinnable = platform::ThreadUtils::setCurrentThreadAffinity({0});
+    }).join();
+    
+    ThreadPoolConfig config;
+    config.thread_count = 2;
+    config.max_threads = 2;
+    config.scheduling_mode = SchedulingMode::WORK_STEALING;
+    config.affinity = CpuAffinityMode::PER_CORE;
+    config.cpu_list = {0};
+    config.qos = platform::ThreadUtils::QoS::DEFAULT;
+    ThreadPool pool(config);
+    
+    std::atomic<int> counter{0};
+    std::atomic<int> off_cpu{0};
+    for (int i = 0; i < 200; ++i) {
+        pool.post([&counter, &off_cpu]() {
+            int cpu = platform::ThreadUtils::getCurrentCpu();
+            if (cpu > 0) {
+                off_cpu.fetch_add(1);
+            }
+            counter.fetch_add(1);
+        });
+    }
+    pool.waitForAll();
+    
+    EXPECT_EQ(2u, pool.size());
+    EXPECT_EQ(200, counter.load());
+    if (pinnable) {
+        EXPECT_EQ(0, off_cpu.load());
+    }
+}
+
+TEST(AffinityTest, NumaNodesCoverAllCpus) {
+    auto nodes = platform::ThreadUtils::getNumaNodes();
+    ASSERT_FALSE(nodes.empty());
+    
+    size_t cpu_count = 0;
+    for (const auto& node : nodes) {
+        cpu_count += node.size();
+    }
+    EXPECT_GE(cpu_count, 1u);
+}
+
+// 延续：各阶段依次投递到线程池，中间不阻塞工作线程
+TEST_F(ThreadPoolTest, FutureThenChain) {
+    auto result = runAsync(*pool_, []() { return 20; })
+        .then(*pool_, [](int value) { return value + 1; })
+        .then(*pool_, [](int value) { return std::to_string(value * 2); });
+    
+    EXPECT_EQ("42", result.get());
+    
+    // 前驱失败时跳过后续阶段，异常传递到最终结果
+    std::atomic<bool> called{false};
+    auto failed = runAsync(*pool_, []() -> int { throw std::runtime_error("fetch failed"); })
+        .then(*pool_, [&called](int value) { called = true; return value; });
+    EXPECT_THROW(failed.get(), std::runtime_error);
+    EXPECT_FALSE(called.load());
+    
+    Future<int> broken;
+    {
+        Promise<int> promise;
+        broken = promise.getFuture();
+    }
+    EXPECT_THROW(broken.get(), std::future_error);
+}
+
+// 结果的构造函数抛出异常时，Future以该异常就绪，而不是一直等待
+TEST_F(ThreadPoolTest, FutureReadyWhenValueConstructionThrows) {
+    struct ThrowingCopy {
+        ThrowingCopy() = default;
+        ThrowingCopy(const ThrowingCopy&) { throw std::runtime_error("copy failed"); }
+    };
+    
+    Promise<ThrowingCopy> promise;
+    auto future = promise.getFuture();
+    ThrowingCopy value;
+    EXPECT_THROW(promise.setValue(value), std::runtime_error);
+    ASSERT_TRUE(future.isReady());
+    EXPECT_THROW(future.get(), std::runtime_error);
+    EXPECT_THROW(promise.setValue(value), std::future_error);
+}
+
+TEST_F(ThreadPoolTest, WhenAllAndWhenAny) {
+    std::vector<Future<int>> futures;
+    for (int i = 0; i < 8; ++i) {
+        futures.push_back(runAsync(*pool_, [i]() { return i * i; }));
+    }
+    auto squares = whenAll(std::move(futures)).get();
+    ASSERT_EQ(8u, squares.size());
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(i * i, squares[i]);
+    }
+    
+    Promise<int> never;
+    std::vector<Future<int>> candidates;
+    candidates.push_back(never.getFuture());
+    candidates.push_back(runAsync(*pool_, []() { return 7; }));
+    auto any = whenAny(std::move(candidates)).get();
+    EXPECT_EQ(1u, any.index);
+    EXPECT_EQ(7, any.futures[any.index].get());
+    EXPECT_FALSE(any.futures[0].isReady());
+}
+
+// 任务图：节点在全部前驱完成后执行
+TEST_F(ThreadPoolTest, TaskGraphRespectsDependencies) {
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&mutex, &order](int id) {
+        return [&mutex, &order, id]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(id);
+        };
+    };
+    
+    TaskGraph graph;
+    auto fetch = graph.addTask(record(0));
+    auto parse_a = graph.addTask(record(1));
+    auto parse_b = graph.addTask(record(2));
+    auto log = graph.addTask(record(3));
+    graph.precede(fetch, parse_a);
+    graph.precede(fetch, parse_b);
+    graph.precede(parse_a, log);
+    graph.precede(parse_b, log);
+    
+    graph.run(*pool_).get();
+    ASSERT_EQ(4u, order.size());
+    EXPECT_EQ(0, order.front());
+    EXPECT_EQ(3, order.back());
+    
+    // 节点失败后下游节点不再执行
+    std::atomic<bool> downstream{false};
+    TaskGraph failing;
+    auto first = failing.addTask([]() { throw std::runtime_error("parse failed"); });
+    auto second = failing.addTask([&downstream]() { downstream = true; });
+    failing.precede(first, second);
+    EXPECT_THROW(failing.run(*pool_).get(), std::runtime_error);
+    EXPECT_FALSE(downstream.load());
+    
+    TaskGraph cyclic;
+    auto a = cyclic.addTask([]() {});
+    auto b = cyclic.addTask([]() {});
+    cyclic.precede(a, b);
+    cyclic.precede(b, a);
+    EXPECT_THROW(cyclic.run(*pool_), std::invalid_argument);
+}
+
+// 等待者在最后一个任务结束时被唤醒，不依赖新的提交或超时
+TEST_F(ThreadPoolTest, WaitWakesOnCompletion) {
+    std::atomic<bool> finished{false};
+    pool_->post([&finished]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        finished = true;
+    });
+    
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(pool_->waitFor(std::chrono::seconds(5)));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    
+    EXPECT_TRUE(finished.load());
+    EXPECT_LT(elapsed, std::chrono::seconds(1));
+}
+
+// 任务组只等待本组的任务
+TEST_F(ThreadPoolTest, TaskGroupWaitsOnlyForItsTasks) {
+    std::atomic<bool> release{false};
+    pool_->post([&release]() {
+        while (!release.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    
+    std::atomic<int> counter{0};
+    {
+        TaskGroup group(*pool_);
+        for (int i = 0; i < 100; ++i) {
+            group.run([&counter]() { counter.fetch_add(1); });
+        }
+        group.wait();
+        EXPECT_EQ(100, counter.load());
+        EXPECT_EQ(0u, group.pending());
+        
+        group.run([]() { throw std::runtime_error("group task failed"); });
+        EXPECT_THROW(group.wait(), std::runtime_error);
+    }
+    
+    EXPECT_FALSE(pool_->waitFor(std::chrono::milliseconds(10)));
+    release = true;
+    pool_->waitForAll();
+}
+
+TEST(CompletionCounterTest, WaitForTimesOut) {
+    CompletionCounter counter;
+    EXPECT_TRUE(counter.waitFor(std::chrono::milliseconds(0)));
+    
+    counter.add(2);
+    EXPECT_FALSE(counter.waitFor(std::chrono::milliseconds(10)));
+    
+    std::thread finisher([&counter]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        counter.done(2);
+    });
+    counter.wait();
+    EXPECT_EQ(0u, counter.count());
+    finisher.join();
+}
+
+// 无锁环形队列后端
+class RingBufferThreadPoolTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ThreadPoolConfig config;
+        config.thread_count = 4;
+        config.queue_backend = QueueBackend::RING_BUFFER;
+        config.ring_capacity = 64;
+        pool_ = std::make_unique<ThreadPool>(config);
+    }
+    
+    void TearDown() override {
+        if (pool_) {
+            pool_->shutdown();
+            pool_.reset();
+        }
+    }
+    
+    std::unique_ptr<ThreadPool> pool_;
+};
+
+TEST_F(RingBufferThreadPoolTest, ConcurrentTasksWithSpill) {
+    // 任务数远超环形队列容量，溢出部分进入后备队列
+    std::atomic<int> counter{0};
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 2000; ++i) {
+        futures.push_back(pool_->submit([i, &counter]() {
+            counter.fetch_add(1);
+            return i;
+        }));
+    }
+    
+    for (int i = 0; i < 2000; ++i) {
+        EXPECT_EQ(i, futures[i].get());
+    }
+    pool_->waitForAll();
+    EXPECT_EQ(2000, counter.load());
+    EXPECT_EQ(0u, pool_->pendingTasks());
+}
+
+TEST_F(RingBufferThreadPoolTest, CancelPendingTasks) {
+    std::atomic<bool> release{false};
+    for (int i = 0; i < 4; ++i) {
+        pool_->post([&release]() {
+            while (!release.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+    while (pool_->activeThreads() < 4) {
+        std::this_thread::yield();
+    }
+    
+    std::atomic<int> executed{0};
+    for (int i = 0; i < 100; ++i) {
+        pool_->post([&executed]() { executed.fetch_add(1); });
+    }
+    pool_->cancelPendingTasks();
+    EXPECT_EQ(0u, pool_->pendingTasks());
+    
+    release = true;
+    pool_->waitForAll();
+    EXPECT_EQ(0, executed.load());
+}
+
+TEST(TaskQueueTest, RingBufferPriorityOrder) {
+    for (auto backend : {QueueBackend::PRIORITY_HEAP, QueueBackend::RING_BUFFER}) {
+        TaskQueue queue(backend, 4, QueueOverflowPolicy::SPILL);
+        
+        const TaskPriority priorities[] = {
+            TaskPriority::LOW, TaskPriority::HIGH, TaskPriority::NORMAL, TaskPriority::CRITICAL
+        };
+        for (int round = 0; round < 3; ++round) {
+            for (auto priority : priorities) {
+                Task task;
+                task.priority = priority;
+                task.info = std::make_shared<TaskInfo>();
+                task.info->id = std::to_string(static_cast<int>(priority)) + "-" + std::to_string(round);
+                queue.push(std::move(task));
+            }
+        }
+        EXPECT_EQ(12u, queue.size());
+        
+        // 高优先级先出队，同优先级按入队顺序
+        std::vector<std::string> order;
+        Task task;
+        while (queue.tryPop(task)) {
+            order.push_back(task.info->id);
+        }
+        ASSERT_EQ(12u, order.size());
+        EXPECT_EQ("3-0", order[0]);
+        EXPECT_EQ("3-2", order[2]);
+        EXPECT_EQ("0-2", order[11]);
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(TaskQueueTest, RingBufferRejectsWhenFull) {
+    TaskQueue queue(QueueBackend::RING_BUFFER, 4, QueueOverflowPolicy::REJECT);
+    for (int i = 0; i < 4; ++i) {
+        queue.push(Task());
+    }
+    EXPECT_THROW(queue.push(Task()), std::runtime_error);
+    EXPECT_EQ(4u, queue.size());
+}
+
+TEST(MpmcRingQueueTest, ConcurrentProducersAndConsumers) {
+    MpmcRingQueue<int> queue(256);
+    const int per_producer = 20000;
+    std::atomic<long long> sum{0};
+    std::atomic<int> consumed{0};
+    
+    std::vector<std::thread> threads;
+    for (int p = 0; p < 2; ++p) {
+        threads.emplace_back([&queue]() {
+            for (int i = 1; i <= per_producer; ++i) {
+                int value = i;
+                while (!queue.tryPush(std::move(value))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < 2; ++c) {
+        threads.emplace_back([&queue, &sum, &consumed]() {
+            int value;
+            while (consumed.load() < 2 * per_producer) {
+                if (queue.tryPop(value)) {
+                    sum.fetch_add(value);
+                    consumed.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    EXPECT_EQ(2LL * per_producer * (per_producer + 1) / 2, sum.load());
+}
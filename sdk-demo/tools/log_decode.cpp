@@ -0,0 +1,55 @@
+#include "sdk/logging/binary_log.h"
+#include <iostream>
+#include <memory>
+#include <string>
+
+using namespace sdk;
+
+// 把BinaryFileAppender写出的二进制日志解码为文本
+// 用法: sdk_log_decode [--json] <file>
+int main(int argc, char* argv[]) {
+    bool json = false;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--json") {
+            json = true;
+        } else if (path.empty()) {
+            path = arg;
+        } else {
+            path.clear();
+            break;
+        }
+    }
+
+    if (path.empty()) {
+        std::cerr << "usage: " << argv[0] << " [--json] <file>" << '\n';
+        return 2;
+    }
+
+    BinaryLogReader reader(path);
+    if (!reader.isOpen()) {
+        std::cerr << "not a binary log file: " << path << '\n';
+        return 1;
+    }
+
+    std::unique_ptr<LogFormatter> formatter;
+    if (json) {
+        formatter = std::make_unique<JsonFormatter>();
+    } else {
+        formatter = std::make_unique<DefaultFormatter>();
+    }
+
+    BinaryLogEntry entry;
+    while (reader.next(entry)) {
+        formatRecordMessage(entry.record);
+        std::cout << formatter->format(entry.record) << '\n';
+    }
+    std::cout.flush();
+
+    if (reader.corrupted()) {
+        std::cerr << "stopped at a corrupted or truncated record" << '\n';
+        return 1;
+    }
+    return 0;
+}